@@ -0,0 +1,384 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/ginkgo.hpp>
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+#include "benchmark/utils/general.hpp"
+#include "benchmark/utils/iteration_control.hpp"
+#include "benchmark/utils/runner.hpp"
+#include "benchmark/utils/timer.hpp"
+#include "benchmark/utils/types.hpp"
+#include "core/base/batch_utilities.hpp"
+
+
+const auto benchmark_name = "batch_solver";
+
+
+// Command-line arguments
+DEFINE_string(formats, "csr,ell,dense",
+              "A comma-separated list of batch matrix formats to run. "
+              "Supported values are: csr, ell, dense");
+
+DEFINE_string(batch_solver, "bicgstab",
+              "The batch solver to use. Supported values are: bicgstab");
+
+DEFINE_uint32(max_iters, 1000,
+              "Maximal number of iterations the solver will be run for");
+
+DEFINE_double(rel_res_goal, 1e-6, "The relative residual goal of the solver");
+
+
+using batch_itype = gko::int32;
+using batch_vec = gko::batch::MultiVector<etype>;
+using batch_real_vec = gko::batch::MultiVector<rc_etype>;
+using batch_mat_data = gko::matrix_data<etype, batch_itype>;
+using batch_csr = gko::batch::matrix::Csr<etype, batch_itype>;
+
+
+// the matrix and right-hand side of every system in the batch
+struct batch_solver_benchmark_state {
+    std::vector<batch_mat_data> data;
+    gko::size_type max_row_nnz;
+    std::unique_ptr<batch_vec> b;
+    std::unique_ptr<batch_vec> x;
+};
+
+
+/**
+ * Generates a batch of systems with a common random sparsity pattern, which
+ * contains the diagonal and up to `nonzeros_per_row - 1` off-diagonal entries
+ * per row. The off-diagonal values are drawn independently for every item,
+ * the diagonal is the sum of the absolute off-diagonal values in its row,
+ * scaled by `diagonal_dominance`. Values closer to 1 thus lead to worse
+ * conditioned systems.
+ */
+batch_solver_benchmark_state generate_batch_system(
+    std::shared_ptr<const gko::Executor> exec, const json& test_case)
+{
+    const auto num_items = test_case["num_batch_items"].get<gko::size_type>();
+    const auto num_rows = test_case["rows"].get<gko::size_type>();
+    const auto nnz_per_row = std::min(
+        test_case.contains("nonzeros_per_row")
+            ? test_case["nonzeros_per_row"].get<gko::size_type>()
+            : gko::size_type{5},
+        num_rows);
+    const auto dominance =
+        test_case.contains("diagonal_dominance")
+            ? test_case["diagonal_dominance"].get<double>()
+            : 1.5;
+    auto& engine = get_engine();
+    std::vector<std::vector<batch_itype>> pattern(num_rows);
+    std::uniform_int_distribution<batch_itype> col_dist(
+        0, static_cast<batch_itype>(num_rows) - 1);
+    gko::size_type max_row_nnz{};
+    for (gko::size_type row = 0; row < num_rows; row++) {
+        std::set<batch_itype> cols{static_cast<batch_itype>(row)};
+        // limit the number of draws for nearly dense rows
+        for (gko::size_type i = 0; cols.size() < nnz_per_row && i < num_rows;
+             i++) {
+            cols.insert(col_dist(engine));
+        }
+        pattern[row].assign(cols.begin(), cols.end());
+        max_row_nnz = std::max(max_row_nnz, pattern[row].size());
+    }
+
+    batch_solver_benchmark_state state;
+    state.max_row_nnz = max_row_nnz;
+    std::uniform_real_distribution<rc_etype> value_dist(-1.0, 1.0);
+    std::vector<batch_mat_data> rhs_data;
+    for (gko::size_type item = 0; item < num_items; item++) {
+        batch_mat_data data{gko::dim<2>{num_rows}};
+        for (gko::size_type row = 0; row < num_rows; row++) {
+            const auto diag_pos = data.nonzeros.size();
+            rc_etype off_diag_sum{};
+            for (const auto col : pattern[row]) {
+                auto value = gko::zero<etype>();
+                if (col != static_cast<batch_itype>(row)) {
+                    value =
+                        gko::detail::get_rand_value<etype>(value_dist, engine);
+                    off_diag_sum += gko::abs(value);
+                }
+                data.nonzeros.emplace_back(row, col, value);
+            }
+            for (auto i = diag_pos; i < data.nonzeros.size(); i++) {
+                if (data.nonzeros[i].row == data.nonzeros[i].column) {
+                    data.nonzeros[i].value = static_cast<etype>(
+                        off_diag_sum > 0 ? dominance * off_diag_sum : 1.0);
+                }
+            }
+        }
+        state.data.push_back(std::move(data));
+        rhs_data.emplace_back(gko::dim<2>{num_rows, 1}, value_dist, engine);
+    }
+    state.b = gko::batch::read<etype, batch_itype, batch_vec>(exec, rhs_data);
+    state.x = batch_vec::create(exec, state.b->get_size());
+    state.x->fill(gko::zero<etype>());
+    return state;
+}
+
+
+const std::map<std::string,
+               std::function<std::unique_ptr<gko::batch::BatchLinOp>(
+                   std::shared_ptr<const gko::Executor>,
+                   const batch_solver_benchmark_state&)>>
+    format_map{
+        {"csr",
+         [](std::shared_ptr<const gko::Executor> exec,
+            const batch_solver_benchmark_state& state) {
+             return gko::batch::read<etype, batch_itype, batch_csr>(
+                 exec, state.data,
+                 static_cast<batch_itype>(state.data[0].nonzeros.size()));
+         }},
+        {"ell",
+         [](std::shared_ptr<const gko::Executor> exec,
+            const batch_solver_benchmark_state& state) {
+             return gko::batch::read<etype, batch_itype,
+                                     gko::batch::matrix::Ell<etype>>(
+                 exec, state.data, static_cast<batch_itype>(state.max_row_nnz));
+         }},
+        {"dense", [](std::shared_ptr<const gko::Executor> exec,
+                     const batch_solver_benchmark_state& state) {
+             return gko::batch::read<etype, batch_itype,
+                                     gko::batch::matrix::Dense<etype>>(
+                 exec, state.data);
+         }}};
+
+
+const std::map<std::string,
+               std::function<std::unique_ptr<gko::batch::BatchLinOpFactory>(
+                   std::shared_ptr<const gko::Executor>)>>
+    batch_solver_factory{
+        {"bicgstab", [](std::shared_ptr<const gko::Executor> exec) {
+             return gko::batch::solver::Bicgstab<etype>::build()
+                 .with_max_iterations(static_cast<int>(FLAGS_max_iters))
+                 .with_tolerance(FLAGS_rel_res_goal)
+                 .with_tolerance_type(
+                     gko::batch::stop::tolerance_type::relative)
+                 .on(exec);
+         }}};
+
+
+// Applies a batch solver created by batch_solver_factory
+void apply_batch_solver(const gko::batch::BatchLinOp* solver,
+                        const batch_vec* b, batch_vec* x)
+{
+    if (auto bicgstab =
+            dynamic_cast<const gko::batch::solver::Bicgstab<etype>*>(solver)) {
+        bicgstab->apply(b, x);
+    } else {
+        GKO_NOT_SUPPORTED(solver);
+    }
+}
+
+
+// Returns the relative residual norm ||b - Ax|| / ||b|| of every system
+std::vector<rc_etype> compute_batch_residual_norms(const batch_csr* mtx,
+                                                   const batch_vec* b,
+                                                   const batch_vec* x)
+{
+    const auto exec = b->get_executor();
+    const auto num_items = b->get_num_batch_items();
+    const gko::batch_dim<2> norm_size{num_items, gko::dim<2>{1}};
+    auto one = batch_vec::create(exec, norm_size);
+    auto neg_one = batch_vec::create(exec, norm_size);
+    one->fill(gko::one<etype>());
+    neg_one->fill(-gko::one<etype>());
+    auto res = b->clone();
+    mtx->apply(neg_one, x, one, res);
+    auto res_norm = batch_real_vec::create(exec, norm_size);
+    auto b_norm = batch_real_vec::create(exec, norm_size);
+    res->compute_norm2(res_norm);
+    b->compute_norm2(b_norm);
+    auto host_res_norm = gko::clone(exec->get_master(), res_norm);
+    auto host_b_norm = gko::clone(exec->get_master(), b_norm);
+    std::vector<rc_etype> result(num_items);
+    for (gko::size_type i = 0; i < num_items; i++) {
+        result[i] = host_res_norm->get_const_values()[i] /
+                    host_b_norm->get_const_values()[i];
+    }
+    return result;
+}
+
+
+struct BatchSolverBenchmark : Benchmark<batch_solver_benchmark_state> {
+    std::string name;
+    std::vector<std::string> formats;
+
+    BatchSolverBenchmark() : name{"batch_solver"}, formats{split(FLAGS_formats)}
+    {}
+
+    const std::string& get_name() const override { return name; }
+
+    const std::vector<std::string>& get_operations() const override
+    {
+        return formats;
+    }
+
+    bool should_print() const override { return true; }
+
+    std::string get_example_config() const override
+    {
+        return json::parse(
+                   R"([{"num_batch_items": 1000, "rows": 32},
+                       {"num_batch_items": 1000, "rows": 128,
+                        "nonzeros_per_row": 9, "diagonal_dominance": 1.05}])")
+            .dump(4);
+    }
+
+    bool validate_config(const json& value) const override
+    {
+        return value.contains("num_batch_items") &&
+               value["num_batch_items"].is_number_integer() &&
+               value.contains("rows") && value["rows"].is_number_integer();
+    }
+
+    std::string describe_config(const json& test_case) const override
+    {
+        std::stringstream ss;
+        ss << test_case["num_batch_items"].get<gko::int64>() << " systems of "
+           << test_case["rows"].get<gko::int64>() << " rows";
+        return ss.str();
+    }
+
+    double get_runtime(const json& operation_case) const override
+    {
+        return operation_case.at("apply").at("time").get<double>();
+    }
+
+    batch_solver_benchmark_state setup(std::shared_ptr<gko::Executor> exec,
+                                       json& test_case) const override
+    {
+        auto state = generate_batch_system(exec, test_case);
+        test_case["nonzeros"] = state.data[0].nonzeros.size();
+        std::clog << "Batch of " << state.data.size() << " systems of size "
+                  << state.data[0].size << ", " << state.data[0].nonzeros.size()
+                  << " nonzeros" << std::endl;
+        return state;
+    }
+
+    void run(std::shared_ptr<gko::Executor> exec, std::shared_ptr<Timer> timer,
+             annotate_functor annotate, batch_solver_benchmark_state& state,
+             const std::string& format_name,
+             json& format_case) const override
+    {
+        const auto num_items = state.b->get_num_batch_items();
+        auto mtx = gko::share(format_map.at(format_name)(exec, state));
+        auto factory = batch_solver_factory.at(FLAGS_batch_solver)(exec);
+        format_case["solver"] = FLAGS_batch_solver;
+
+        IterationControl ic{timer};
+
+        // warm run
+        {
+            auto range = annotate("warmup", FLAGS_warmup > 0);
+            for (auto _ : ic.warmup_run()) {
+                auto x_clone = state.x->clone();
+                auto solver = factory->generate(mtx);
+                apply_batch_solver(solver.get(), state.b.get(), x_clone.get());
+                exec->synchronize();
+            }
+        }
+
+        // timed run
+        auto logger =
+            gko::share(gko::batch::log::BatchConvergence<etype>::create());
+        auto generate_timer = get_timer(exec, FLAGS_gpu_timer);
+        auto apply_timer = ic.get_timer();
+        auto x_clone = state.x->clone();
+        std::unique_ptr<gko::batch::BatchLinOp> solver;
+        for (auto status : ic.run(false)) {
+            auto range = annotate("repetition");
+            x_clone->copy_from(state.x);
+
+            exec->synchronize();
+            generate_timer->tic();
+            solver = factory->generate(mtx);
+            generate_timer->toc();
+
+            if (ic.get_num_repetitions() == 0) {
+                solver->add_logger(logger);
+            }
+            apply_timer->tic();
+            apply_batch_solver(solver.get(), state.b.get(), x_clone.get());
+            apply_timer->toc();
+            if (ic.get_num_repetitions() == 0) {
+                solver->remove_logger(logger);
+            }
+        }
+        const auto generate_time =
+            generate_timer->compute_time(FLAGS_timer_method);
+        const auto apply_time = apply_timer->compute_time(FLAGS_timer_method);
+        format_case["generate"]["time"] = generate_time;
+        format_case["apply"]["time"] = apply_time;
+        format_case["repetitions"] = apply_timer->get_num_repetitions();
+        format_case["throughput"] = num_items / apply_time;
+
+        auto iterations = gko::make_temporary_clone(
+            exec->get_master(), &logger->get_num_iterations());
+        const auto iter_begin = iterations->get_const_data();
+        const auto iter_end = iter_begin + iterations->get_size();
+        auto& iteration_case = format_case["apply"]["iterations"];
+        iteration_case["min"] = *std::min_element(iter_begin, iter_end);
+        iteration_case["max"] = *std::max_element(iter_begin, iter_end);
+        iteration_case["mean"] =
+            std::accumulate(iter_begin, iter_end, 0.0) / iterations->get_size();
+
+        const auto csr_mtx =
+            gko::batch::read<etype, batch_itype, batch_csr>(
+                exec, state.data,
+                static_cast<batch_itype>(state.data[0].nonzeros.size()));
+        const auto residuals = compute_batch_residual_norms(
+            csr_mtx.get(), state.b.get(), x_clone.get());
+        format_case["residual_norm"] =
+            *std::max_element(residuals.begin(), residuals.end());
+        format_case["converged"] = std::count_if(
+            residuals.begin(), residuals.end(),
+            [](rc_etype res) { return res <= FLAGS_rel_res_goal; });
+    }
+};
+
+
+int main(int argc, char* argv[])
+{
+    std::string header = R"("
+A benchmark for measuring the throughput of Ginkgo's batched solvers.
+Parameters for a benchmark case are:
+    num_batch_items: number of systems in the batch (required)
+    rows: number of rows of every system (required)
+    nonzeros_per_row: maximal number of nonzeros per row (optional, default 5)
+    diagonal_dominance: ratio between the diagonal and the sum of absolute
+        off-diagonal values in every row, values close to 1 lead to badly
+        conditioned systems (optional, default 1.5)
+)";
+    std::string format = BatchSolverBenchmark{}.get_example_config();
+    initialize_argument_parsing(&argc, &argv, header, format);
+
+    std::string extra_information = "The formats are " + FLAGS_formats +
+                                    "\nThe batch solver is " +
+                                    FLAGS_batch_solver;
+    print_general_information(extra_information);
+    auto exec = executor_factory.at(FLAGS_executor)(FLAGS_gpu_timer);
+
+    auto test_cases = json::parse(get_input_stream());
+
+    run_test_cases(BatchSolverBenchmark{}, exec,
+                   get_timer(exec, FLAGS_gpu_timer), test_cases);
+
+    std::cout << std::setw(4) << test_cases << std::endl;
+}
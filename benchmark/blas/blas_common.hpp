@@ -495,4 +495,11 @@ struct BlasBenchmark : Benchmark<dimensions> {
         operation_case["bandwidth"] = mem / runtime;
         operation_case["repetitions"] = repetitions;
     }
+
+    double get_memory(const dimensions& dims,
+                      const json& operation_case) const override
+    {
+        return operation_case["bandwidth"].get<double>() *
+               operation_case["time"].get<double>();
+    }
 };
@@ -0,0 +1,219 @@
+#!/usr/bin/env bash
+################################################################################
+# Solver benchmark suite
+#
+# Runs a fixed set of solver workflows on generated matrices, and either stores
+# the results as the baseline for this system (MODE=baseline), or compares them
+# against the stored baseline and reports statistically significant slowdowns
+# (MODE=compare). No matrices need to be downloaded, all inputs are generated
+# from stencils or by the matrix_generator.
+#
+# The workflows are
+#   repeated_solves:  multiple solves with the same solver instance
+#   refactorization:  regeneration of the solver after value updates
+#   multi_rhs:        solves with multiple right hand sides
+#   mixed_precision:  compressed Krylov bases, adaptive precision Jacobi
+#                     and single precision solvers
+#
+# The results are stored in ${RESULT_DIR}/{baseline,current}/<workflow>.json,
+# the regression report in ${RESULT_DIR}/report.md.
+
+print_default() {
+    local var=$1
+    echo "$var  environment variable not set - assuming \"${!var}\"" 1>&2
+}
+
+if [ ! "${MODE}" ]; then
+    MODE="compare"
+    print_default MODE
+fi
+
+if [ "${MODE}" != "baseline" ] && [ "${MODE}" != "compare" ]; then
+    echo "MODE is set to the not supported \"${MODE}\"." 1>&2
+    echo "Currently supported values: \"baseline\" and \"compare\"" 1>&2
+    exit 1
+fi
+
+if [ ! "${EXECUTOR}" ]; then
+    EXECUTOR="cuda"
+    print_default EXECUTOR
+fi
+
+if [ ! "${DEVICE_ID}" ]; then
+    DEVICE_ID="0"
+    print_default DEVICE_ID
+fi
+
+if [ ! "${SYSTEM_NAME}" ]; then
+    SYSTEM_NAME="unknown"
+    print_default SYSTEM_NAME
+fi
+
+if [ ! "${GPU_TIMER}" ]; then
+    GPU_TIMER="false"
+    print_default GPU_TIMER
+fi
+
+if [ ! "${REPETITIONS}" ]; then
+    REPETITIONS=10
+    print_default REPETITIONS
+fi
+
+# The number of rows of the stencil matrices
+if [ ! "${SUITE_SIZE}" ]; then
+    SUITE_SIZE=1000000
+    print_default SUITE_SIZE
+fi
+
+# The number of rows of the matrices used with direct solvers
+if [ ! "${SUITE_DIRECT_SIZE}" ]; then
+    SUITE_DIRECT_SIZE=100000
+    print_default SUITE_DIRECT_SIZE
+fi
+
+if [ ! "${SUITE_NRHS}" ]; then
+    SUITE_NRHS=16
+    print_default SUITE_NRHS
+fi
+
+if [ ! "${SUITE_REPEATED_SOLVES}" ]; then
+    SUITE_REPEATED_SOLVES=10
+    print_default SUITE_REPEATED_SOLVES
+fi
+
+if [ ! "${SUITE_REFACTORIZATIONS}" ]; then
+    SUITE_REFACTORIZATIONS=10
+    print_default SUITE_REFACTORIZATIONS
+fi
+
+# The significance level and the minimal slowdown in percent for regressions
+if [ ! "${REGRESSION_ALPHA}" ]; then
+    REGRESSION_ALPHA=0.01
+    print_default REGRESSION_ALPHA
+fi
+
+if [ ! "${REGRESSION_THRESHOLD}" ]; then
+    REGRESSION_THRESHOLD=5
+    print_default REGRESSION_THRESHOLD
+fi
+
+if [ ! "${RESULT_DIR}" ]; then
+    RESULT_DIR="results/${SYSTEM_NAME}/${EXECUTOR}/suite"
+    print_default RESULT_DIR
+fi
+
+REGRESSION_SCRIPT="@Ginkgo_SOURCE_DIR@/benchmark/tools/regression.py"
+
+
+################################################################################
+# Inputs
+
+# Prints the test cases for the stencil matrices $2 with $1 rows
+stencil_cases() {
+    local cases=""
+    for stencil in ${@:2}; do
+        cases="${cases}${cases:+,}
+    {\"size\": $1, \"stencil\": \"${stencil}\", \"optimal\": {\"spmv\": \"csr\"}}"
+    done
+    echo "${cases}"
+}
+
+# Generates a block-diagonal matrix with roughly $1 rows, unless it already
+# exists, and prints the test case for it. The matrix is stored next to the
+# results, so baseline and comparison use the same file name.
+block_diagonal_case() {
+    local filename="${RESULT_DIR}/block_diagonal_$1.mtx"
+    if [ ! -f "${filename}" ]; then
+        ./matrix_generator/matrix_generator --input="[{
+            \"filename\": \"${filename}\",
+            \"problem\": {\"type\": \"block-diagonal\",
+                          \"num_blocks\": $(($1 / 10)), \"block_size\": 10}
+        }]" >/dev/null
+    fi
+    echo "{\"filename\": \"${filename}\", \"optimal\": {\"spmv\": \"csr\"}}"
+}
+
+
+################################################################################
+# Workflows
+
+# Runs the solver benchmark with the input $1 and the flags ${@:3}, using the
+# benchmark binary with the precision suffix $2, and prints the results.
+run_solver() {
+    local input="$1"
+    local suffix="$2"
+    ./solver/solver${suffix} --input="${input}" \
+        --executor="${EXECUTOR}" --device_id="${DEVICE_ID}" \
+        --gpu_timer=${GPU_TIMER} --repetitions="${REPETITIONS}" \
+        --detailed=false --time_samples "${@:3}"
+}
+
+# Runs all workflows and writes their results to directory $1
+run_suite() {
+    local output="$1"
+    local stencils="[$(stencil_cases "${SUITE_SIZE}" 5pt 7pt 27pt)]"
+    local direct="[$(stencil_cases "${SUITE_DIRECT_SIZE}" 5pt 7pt),
+    $(block_diagonal_case "${SUITE_DIRECT_SIZE}")]"
+
+    echo -e "Running repeated solves" 1>&2
+    run_solver "${stencils}" "" --solvers=cg,gmres \
+        --preconditioners=none,jacobi \
+        --repeated_solves="${SUITE_REPEATED_SOLVES}" \
+        >"${output}/repeated_solves.json"
+
+    echo -e "Running refactorizations" 1>&2
+    run_solver "${direct}" "" --solvers=direct \
+        --refactorizations="${SUITE_REFACTORIZATIONS}" \
+        >"${output}/refactorization.json"
+    run_solver "${stencils}" "" --solvers=cg --preconditioners=ilu,ic \
+        --refactorizations="${SUITE_REFACTORIZATIONS}" \
+        >"${output}/refactorization_preconditioned.json"
+
+    echo -e "Running multiple right hand sides" 1>&2
+    run_solver "${stencils}" "" --solvers=cg,bicgstab --nrhs="${SUITE_NRHS}" \
+        --rhs_generation=random --repeated_solves="${SUITE_REPEATED_SOLVES}" \
+        >"${output}/multi_rhs.json"
+
+    echo -e "Running mixed precision" 1>&2
+    run_solver "${stencils}" "" \
+        --solvers=cb_gmres_keep,cb_gmres_reduce1,cb_gmres_reduce2 \
+        >"${output}/mixed_precision_cb_gmres.json"
+    run_solver "${stencils}" "" --solvers=cg --preconditioners=jacobi \
+        --jacobi_storage=autodetect \
+        >"${output}/mixed_precision_jacobi.json"
+    run_solver "${stencils}" "_single" --solvers=cg,gmres \
+        >"${output}/mixed_precision_single.json"
+}
+
+
+################################################################################
+# Main
+
+if [ "${MODE}" == "baseline" ]; then
+    mkdir -p "${RESULT_DIR}/baseline"
+    run_suite "${RESULT_DIR}/baseline"
+    exit 0
+fi
+
+if [ ! -d "${RESULT_DIR}/baseline" ]; then
+    echo "No baseline found in ${RESULT_DIR}/baseline, run with MODE=baseline" 1>&2
+    exit 1
+fi
+
+mkdir -p "${RESULT_DIR}/current"
+run_suite "${RESULT_DIR}/current"
+
+STATUS=0
+REPORT="${RESULT_DIR}/report.md"
+rm -f "${REPORT}"
+for baseline in "${RESULT_DIR}"/baseline/*.json; do
+    workflow="$(basename "${baseline}" .json)"
+    echo -e "## ${workflow}\n" >>"${REPORT}"
+    python3 "${REGRESSION_SCRIPT}" --alpha="${REGRESSION_ALPHA}" \
+        --threshold="${REGRESSION_THRESHOLD}" \
+        "${baseline}" "${RESULT_DIR}/current/${workflow}.json" >>"${REPORT}" ||
+        STATUS=1
+    echo >>"${REPORT}"
+done
+cat "${REPORT}"
+exit ${STATUS}
@@ -0,0 +1,455 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/ginkgo.hpp>
+
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+#include "benchmark/utils/general_matrix.hpp"
+#include "benchmark/utils/generator.hpp"
+#include "benchmark/utils/iteration_control.hpp"
+#include "benchmark/utils/runner.hpp"
+#include "benchmark/utils/types.hpp"
+#include "core/factorization/elimination_forest.hpp"
+#include "core/factorization/symbolic.hpp"
+
+
+const auto benchmark_name = "setup";
+
+
+const char* operations_string =
+    "Comma-separated list of operations whose setup is benchmarked. Can be "
+    "lu, cholesky, reorder_amd, reorder_rcm, reorder_mc64, "
+#if GKO_HAVE_METIS
+    "reorder_nd, "
+#endif
+    "pgm";
+
+DEFINE_string(operations, "lu,cholesky,reorder_amd,reorder_rcm,pgm",
+              operations_string);
+
+DEFINE_bool(memory, true,
+            "Record the peak amount of memory allocated during every setup "
+            "phase, using an additional untimed run.");
+
+
+using Mtx = gko::matrix::Csr<etype, itype>;
+
+
+/**
+ * The setup of a solver, preconditioner or reordering, split into phases that
+ * are timed separately.
+ */
+class SetupOperation {
+public:
+    virtual ~SetupOperation() = default;
+
+    /**
+     * Returns the names of the setup phases, in the order in which they need
+     * to be executed.
+     */
+    virtual std::vector<std::string> get_phases() const = 0;
+
+    /**
+     * Executes a single setup phase. All previous phases have been executed
+     * at least once before.
+     */
+    virtual void run(const std::string& phase) = 0;
+
+    /**
+     * Allows the operation to write arbitrary information to the JSON output.
+     */
+    virtual void write_stats(json& object) {}
+};
+
+
+/**
+ * The setup of a sparse direct factorization: The `generate` phase computes
+ * the whole factorization like a solver or preconditioner would, `symbolic`
+ * and `numeric` compute the sparsity pattern of the factors and the factors
+ * for a known sparsity pattern separately. `refactorize` reuses the pattern
+ * for matrices with the same pattern and changing values, as in a sequence of
+ * nonlinear or time-stepping iterations.
+ */
+template <typename Factorization>
+class FactorizationOperation : public SetupOperation {
+    using pattern_type = gko::matrix::SparsityCsr<etype, itype>;
+    using symbolic_type =
+        std::function<void(const Mtx*, std::unique_ptr<Mtx>&)>;
+
+public:
+    FactorizationOperation(std::shared_ptr<const Mtx> mtx,
+                           std::shared_ptr<const Mtx> updated_mtx,
+                           symbolic_type symbolic)
+        : mtx_{std::move(mtx)},
+          updated_mtx_{std::move(updated_mtx)},
+          symbolic_{std::move(symbolic)},
+          num_refactorizations_{}
+    {}
+
+    std::vector<std::string> get_phases() const override
+    {
+        return {"generate", "symbolic", "numeric", "refactorize"};
+    }
+
+    void run(const std::string& phase) override
+    {
+        const auto exec = mtx_->get_executor();
+        if (phase == "generate") {
+            result_ = Factorization::build().on(exec)->generate(mtx_);
+        } else if (phase == "symbolic") {
+            symbolic_(mtx_.get(), factors_);
+            auto pattern = pattern_type::create(exec);
+            factors_->convert_to(pattern);
+            pattern_ = std::move(pattern);
+            factory_ = Factorization::build()
+                           .with_symbolic_factorization(pattern_)
+                           .on(exec);
+        } else if (phase == "numeric") {
+            result_ = factory_->generate(mtx_);
+        } else if (phase == "refactorize") {
+            // alternate between the values, so every repetition sees new ones
+            result_ = factory_->generate(num_refactorizations_++ % 2
+                                             ? mtx_
+                                             : updated_mtx_);
+        }
+    }
+
+    void write_stats(json& object) override
+    {
+        object["factor_nonzeros"] = factors_->get_num_stored_elements();
+    }
+
+private:
+    std::shared_ptr<const Mtx> mtx_;
+    std::shared_ptr<const Mtx> updated_mtx_;
+    symbolic_type symbolic_;
+    std::unique_ptr<Mtx> factors_;
+    std::shared_ptr<const pattern_type> pattern_;
+    std::unique_ptr<gko::LinOpFactory> factory_;
+    std::unique_ptr<gko::LinOp> result_;
+    gko::size_type num_refactorizations_;
+};
+
+
+/**
+ * The generation of a reordering, which only consists of a single phase.
+ */
+class ReorderOperation : public SetupOperation {
+public:
+    ReorderOperation(std::shared_ptr<const Mtx> mtx,
+                     std::shared_ptr<const gko::LinOpFactory> factory)
+        : mtx_{std::move(mtx)}, factory_{std::move(factory)}
+    {}
+
+    std::vector<std::string> get_phases() const override
+    {
+        return {"generate"};
+    }
+
+    void run(const std::string& phase) override
+    {
+        result_ = factory_->generate(mtx_);
+    }
+
+private:
+    std::shared_ptr<const Mtx> mtx_;
+    std::shared_ptr<const gko::LinOpFactory> factory_;
+    std::unique_ptr<gko::LinOp> result_;
+};
+
+
+/**
+ * The construction of an aggregation-based algebraic multigrid hierarchy:
+ * `coarsen` computes the aggregation and Galerkin product of the finest level
+ * only, `hierarchy` generates the whole Multigrid solver including the
+ * smoothers and the coarsest level solver.
+ */
+class PgmOperation : public SetupOperation {
+    using pgm_type = gko::multigrid::Pgm<etype, itype>;
+
+public:
+    explicit PgmOperation(std::shared_ptr<const Mtx> mtx) : mtx_{std::move(mtx)}
+    {
+        const auto exec = mtx_->get_executor();
+        auto level_factory =
+            gko::share(pgm_type::build().with_deterministic(true).on(exec));
+        level_factory_ = level_factory;
+        multigrid_factory_ =
+            gko::solver::Multigrid::build()
+                .with_mg_level(level_factory)
+                .with_criteria(
+                    gko::stop::Iteration::build().with_max_iters(1u))
+                .on(exec);
+    }
+
+    std::vector<std::string> get_phases() const override
+    {
+        return {"coarsen", "hierarchy"};
+    }
+
+    void run(const std::string& phase) override
+    {
+        if (phase == "coarsen") {
+            level_ = level_factory_->generate(mtx_);
+        } else if (phase == "hierarchy") {
+            multigrid_ = multigrid_factory_->generate(mtx_);
+        }
+    }
+
+    void write_stats(json& object) override
+    {
+        const auto& levels =
+            gko::as<gko::solver::Multigrid>(multigrid_.get())
+                ->get_mg_level_list();
+        object["num_levels"] = levels.size() + 1;
+        object["level_rows"] = json::array();
+        object["level_rows"].push_back(mtx_->get_size()[0]);
+        for (const auto& level : levels) {
+            object["level_rows"].push_back(
+                level->get_coarse_op()->get_size()[0]);
+        }
+    }
+
+private:
+    std::shared_ptr<const Mtx> mtx_;
+    std::shared_ptr<const gko::LinOpFactory> level_factory_;
+    std::shared_ptr<const gko::LinOpFactory> multigrid_factory_;
+    std::unique_ptr<gko::LinOp> level_;
+    std::unique_ptr<gko::LinOp> multigrid_;
+};
+
+
+struct setup_benchmark_state {
+    std::shared_ptr<const Mtx> mtx;
+    // the system matrix with the same sparsity pattern and different values
+    std::shared_ptr<const Mtx> updated_mtx;
+};
+
+
+const std::map<std::string, std::function<std::unique_ptr<SetupOperation>(
+                                const setup_benchmark_state&)>>
+    operation_map{
+        {"lu",
+         [](const setup_benchmark_state& state) {
+             return std::make_unique<FactorizationOperation<
+                 gko::experimental::factorization::Lu<etype, itype>>>(
+                 state.mtx, state.updated_mtx,
+                 [](const Mtx* mtx, std::unique_ptr<Mtx>& factors) {
+                     gko::factorization::symbolic_lu(mtx, factors);
+                 });
+         }},
+        {"cholesky",
+         [](const setup_benchmark_state& state) {
+             return std::make_unique<FactorizationOperation<
+                 gko::experimental::factorization::Cholesky<etype, itype>>>(
+                 state.mtx, state.updated_mtx,
+                 [](const Mtx* mtx, std::unique_ptr<Mtx>& factors) {
+                     std::unique_ptr<
+                         gko::factorization::elimination_forest<itype>>
+                         forest;
+                     gko::factorization::symbolic_cholesky(mtx, true, factors,
+                                                           forest);
+                 });
+         }},
+        {"reorder_amd",
+         [](const setup_benchmark_state& state) {
+             return std::make_unique<ReorderOperation>(
+                 state.mtx, gko::experimental::reorder::Amd<itype>::build().on(
+                                state.mtx->get_executor()));
+         }},
+        {"reorder_rcm",
+         [](const setup_benchmark_state& state) {
+             return std::make_unique<ReorderOperation>(
+                 state.mtx, gko::experimental::reorder::Rcm<itype>::build().on(
+                                state.mtx->get_executor()));
+         }},
+        {"reorder_mc64",
+         [](const setup_benchmark_state& state) {
+             return std::make_unique<ReorderOperation>(
+                 state.mtx,
+                 gko::experimental::reorder::Mc64<etype, itype>::build().on(
+                     state.mtx->get_executor()));
+         }},
+        {"reorder_nd",
+         [](const setup_benchmark_state& state)
+             -> std::unique_ptr<SetupOperation> {
+#if GKO_HAVE_METIS
+             return std::make_unique<ReorderOperation>(
+                 state.mtx,
+                 gko::experimental::reorder::NestedDissection<etype,
+                                                              itype>::build()
+                     .on(state.mtx->get_executor()));
+#else
+             GKO_NOT_COMPILED(METIS);
+#endif
+         }},
+        {"pgm", [](const setup_benchmark_state& state) {
+             return std::make_unique<PgmOperation>(state.mtx);
+         }}};
+
+
+using Generator = DefaultSystemGenerator<>;
+
+
+struct SetupBenchmark : Benchmark<setup_benchmark_state> {
+    std::string name;
+    std::vector<std::string> operations;
+
+    SetupBenchmark() : name{"setup"}, operations{split(FLAGS_operations)}
+    {
+        for (const auto& operation : operations) {
+            if (operation_map.find(operation) == operation_map.end()) {
+                throw std::invalid_argument("Unknown operation " + operation);
+            }
+        }
+    }
+
+    const std::string& get_name() const override { return name; }
+
+    const std::vector<std::string>& get_operations() const override
+    {
+        return operations;
+    }
+
+    bool should_print() const override { return true; }
+
+    bool validate_config(const json& value) const override
+    {
+        return Generator::validate_config(value);
+    }
+
+    std::string get_example_config() const override
+    {
+        return Generator::get_example_config();
+    }
+
+    std::string describe_config(const json& test_case) const override
+    {
+        return Generator::describe_config(test_case);
+    }
+
+    setup_benchmark_state setup(std::shared_ptr<gko::Executor> exec,
+                                json& test_case) const override
+    {
+        auto data = Generator::generate_matrix_data(test_case);
+        reorder(data, test_case);
+        std::clog << "Matrix is of size (" << data.size[0] << ", "
+                  << data.size[1] << "), " << data.nonzeros.size() << std::endl;
+        test_case["rows"] = data.size[0];
+        test_case["cols"] = data.size[1];
+        test_case["nonzeros"] = data.nonzeros.size();
+
+        setup_benchmark_state state;
+        auto mtx = Mtx::create(exec, data.size, data.nonzeros.size());
+        mtx->read(data);
+        state.mtx = std::move(mtx);
+        // scaling by a positive factor preserves the definiteness required
+        // by the Cholesky factorization
+        for (auto& entry : data.nonzeros) {
+            entry.value *= static_cast<etype>(2.0);
+        }
+        auto updated_mtx = Mtx::create(exec, data.size, data.nonzeros.size());
+        updated_mtx->read(data);
+        state.updated_mtx = std::move(updated_mtx);
+        return state;
+    }
+
+
+    void run(std::shared_ptr<gko::Executor> exec, std::shared_ptr<Timer> timer,
+             annotate_functor annotate, setup_benchmark_state& state,
+             const std::string& operation_name,
+             json& operation_case) const override
+    {
+        auto op = operation_map.at(operation_name)(state);
+
+        double total_time = 0.0;
+        for (const auto& phase : op->get_phases()) {
+            auto phase_range = annotate(phase.c_str());
+            auto& phase_case = operation_case[phase];
+            IterationControl ic(timer);
+
+            // warm run
+            {
+                auto range = annotate("warmup", FLAGS_warmup > 0);
+                for (auto _ : ic.warmup_run()) {
+                    op->run(phase);
+                }
+            }
+
+            // timed run
+            for (auto _ : ic.run()) {
+                auto range = annotate("repetition");
+                op->run(phase);
+            }
+            const auto runtime = ic.compute_time(FLAGS_timer_method);
+            const auto repetitions = ic.get_num_repetitions();
+            phase_case["time"] = runtime;
+            phase_case["repetitions"] = repetitions;
+            total_time += runtime;
+
+            // memory run, only allocations made by the phase itself are
+            // visible to the logger
+            if (FLAGS_memory) {
+                auto tracker = gko::share(gko::log::MemoryTracker::create());
+                exec->add_logger(tracker);
+                op->run(phase);
+                exec->synchronize();
+                exec->remove_logger(tracker);
+                gko::size_type peak_bytes{};
+                for (const auto& summary : tracker->get_executor_summaries()) {
+                    if (summary.exec == exec.get()) {
+                        peak_bytes = summary.peak_bytes;
+                    }
+                }
+                phase_case["memory_peak"] = peak_bytes;
+            }
+
+            if (FLAGS_detailed) {
+                phase_case["components"] = json::object();
+                auto gen_logger = create_operations_logger(
+                    FLAGS_gpu_timer, FLAGS_nested_names, exec,
+                    phase_case["components"], repetitions);
+                exec->add_logger(gen_logger);
+                for (unsigned i = 0; i < repetitions; i++) {
+                    op->run(phase);
+                }
+                exec->remove_logger(gen_logger);
+            }
+        }
+        operation_case["time"] = total_time;
+        op->write_stats(operation_case);
+    }
+};
+
+
+int main(int argc, char* argv[])
+{
+    std::string header =
+        "A benchmark for measuring the setup phases of Ginkgo's sparse direct "
+        "factorizations, reorderings and multigrid hierarchies.\n";
+    std::string format = Generator::get_example_config();
+    initialize_argument_parsing_matrix(&argc, &argv, header, format);
+
+    auto exec = executor_factory.at(FLAGS_executor)(FLAGS_gpu_timer);
+
+    auto test_cases = json::parse(get_input_stream());
+
+    std::string extra_information = "The operations are " + FLAGS_operations;
+    print_general_information(extra_information);
+
+    run_test_cases(SetupBenchmark{}, exec, get_timer(exec, FLAGS_gpu_timer),
+                   test_cases);
+
+    std::cout << std::setw(4) << test_cases << std::endl;
+}
@@ -81,6 +81,25 @@ DEFINE_string(
 DEFINE_bool(overhead, false,
             "If set, uses dummy data to benchmark Ginkgo overhead");
 
+DEFINE_uint32(repeated_solves, 0,
+              "If > 0, additionally measures this many consecutive solves "
+              "with the same solver instance, as it happens when a system is "
+              "solved for a sequence of right hand sides. The results are "
+              "stored in the \"repeated_apply\" stage.");
+
+DEFINE_uint32(refactorizations, 0,
+              "If > 0, additionally measures this many regenerations of the "
+              "solver from the same solver factory, alternating between the "
+              "system matrix and a copy with the same sparsity pattern and "
+              "updated values, as it happens in nonlinear or time-dependent "
+              "simulations. The results are stored in the \"refactorize\" "
+              "stage.");
+
+DEFINE_bool(time_samples, false,
+            "If set, stores the individual runtimes of all repetitions of "
+            "every stage in \"time_samples\", to allow statistical "
+            "comparisons like benchmark/tools/regression.py");
+
 
 std::string solver_example_config = R"(
   [
@@ -348,10 +367,22 @@ struct SolverGenerator : DefaultSystemGenerator<> {
 };
 
 
+void write_stage_time(const Timer* timer, json& stage)
+{
+    stage["time"] = timer->compute_time(FLAGS_timer_method);
+    stage["repetitions"] = timer->get_num_repetitions();
+    if (FLAGS_time_samples) {
+        stage["time_samples"] = timer->get_time_detail();
+    }
+}
+
+
 template <typename Generator>
 struct solver_benchmark_state {
     using Vec = typename Generator::Vec;
     std::shared_ptr<gko::LinOp> system_matrix;
+    // the system matrix with updated values, used for refactorizations
+    std::shared_ptr<gko::LinOp> updated_matrix;
     std::unique_ptr<Vec> b;
     std::unique_ptr<Vec> x;
 };
@@ -419,6 +450,16 @@ struct SolverBenchmark : Benchmark<solver_benchmark_state<Generator>> {
 
             state.system_matrix = generator.generate_matrix_with_format(
                 exec, test_case["optimal"]["spmv"].get<std::string>(), data);
+            if (FLAGS_refactorizations > 0) {
+                // doubling all values keeps the sparsity pattern as well as
+                // the symmetry and definiteness of the matrix
+                for (auto& entry : data.nonzeros) {
+                    entry.value += entry.value;
+                }
+                state.updated_matrix = generator.generate_matrix_with_format(
+                    exec, test_case["optimal"]["spmv"].get<std::string>(),
+                    data);
+            }
             state.b = generator.generate_rhs(exec, state.system_matrix.get(),
                                              test_case);
             if (permutation) {
@@ -437,6 +478,12 @@ struct SolverBenchmark : Benchmark<solver_benchmark_state<Generator>> {
     }
 
 
+    double get_runtime(const json& solver_case) const override
+    {
+        return solver_case.at("apply").at("time").get<double>();
+    }
+
+
     void run(std::shared_ptr<gko::Executor> exec, std::shared_ptr<Timer> timer,
              annotate_functor annotate,
              solver_benchmark_state<Generator>& state,
@@ -591,6 +638,46 @@ struct SolverBenchmark : Benchmark<solver_benchmark_state<Generator>> {
         solver_case["apply"]["time"] =
             apply_timer->compute_time(FLAGS_timer_method);
         solver_case["repetitions"] = apply_timer->get_num_repetitions();
+        if (FLAGS_time_samples) {
+            solver_case["generate"]["time_samples"] =
+                generate_timer->get_time_detail();
+            solver_case["apply"]["time_samples"] =
+                apply_timer->get_time_detail();
+        }
+
+        // repeated solves with the same solver
+        if (FLAGS_repeated_solves > 0) {
+            auto range = annotate("repeated_apply");
+            auto repeated_timer = get_timer(exec, FLAGS_gpu_timer);
+            for (gko::uint32 i = 0; i < FLAGS_repeated_solves; i++) {
+                x_clone->copy_from(state.x.get());
+                exec->synchronize();
+                repeated_timer->tic();
+                solver->apply(state.b, x_clone);
+                repeated_timer->toc();
+            }
+            write_stage_time(repeated_timer.get(),
+                             solver_case["repeated_apply"]);
+        }
+
+        // regenerations after value updates of the system matrix
+        if (FLAGS_refactorizations > 0 && state.updated_matrix) {
+            auto range = annotate("refactorize");
+            auto refactorize_timer = get_timer(exec, FLAGS_gpu_timer);
+            auto precond = precond_factory.at(precond_name)(exec);
+            auto factory = generate_solver(exec, give(precond), solver_name,
+                                           FLAGS_max_iters);
+            for (gko::uint32 i = 0; i < FLAGS_refactorizations; i++) {
+                const auto& matrix =
+                    i % 2 == 0 ? state.updated_matrix : state.system_matrix;
+                exec->synchronize();
+                refactorize_timer->tic();
+                solver = factory->generate(matrix);
+                refactorize_timer->toc();
+            }
+            write_stage_time(refactorize_timer.get(),
+                             solver_case["refactorize"]);
+        }
     }
 };
 
@@ -176,6 +176,16 @@ struct SpmvBenchmark : Benchmark<spmv_benchmark_state<Generator>> {
         format_case["repetitions"] = ic.get_num_repetitions();
     }
 
+    double get_memory(const spmv_benchmark_state<Generator>& state,
+                      const json& format_case) const override
+    {
+        // read the matrix and b, write x
+        const auto vectors = (state.data.size[0] + state.data.size[1]) *
+                             FLAGS_nrhs * sizeof(etype);
+        const auto storage = format_case.value("storage", gko::size_type{});
+        return static_cast<double>(storage + vectors);
+    }
+
     void postprocess(json& test_case) const override
     {
         if (!test_case.contains("optimal")) {
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+# SPDX-License-Identifier: BSD-3-Clause
+import sys
+import json
+import argparse
+import math
+import statistics
+
+
+keys = {"stencil", "size", "filename", "n", "r", "k", "m"}
+samples_key = "time_samples"
+# the minimal number of samples for the normal approximation of the U statistic
+min_samples = 5
+
+
+def parse_json_matrix(filename: str) -> dict:
+    """Parse a JSON file into a key -> test_case dict"""
+    with open(filename) as file:
+        parsed = json.load(file)
+    result = {}
+    assert isinstance(parsed, list)
+    for case in parsed:
+        assert isinstance(case, dict)
+        assert not keys.isdisjoint(case.keys())
+        case_key = json.dumps(
+            {key: case[key] for key in sorted(keys.intersection(case.keys()))}
+        )
+        if case_key in result.keys():
+            print(f"WARNING: Duplicate key {case_key}", file=sys.stderr)
+        result[case_key] = case
+    return result
+
+
+def extract_measurements(case: dict) -> dict:
+    """Collects all timed stages of a test case into a path -> stage dict"""
+    result = {}
+
+    def recurse(value: dict, context: str):
+        for key, sub_value in value.items():
+            # component breakdowns are not stored repetition-wise
+            if key == "components" or not isinstance(sub_value, dict):
+                continue
+            path = key if context is None else f"{context}/{key}"
+            if isinstance(sub_value.get("time"), (int, float)):
+                result[path] = sub_value
+            recurse(sub_value, path)
+
+    recurse(case, None)
+    return result
+
+
+def mann_whitney_u(baseline: list, comparison: list) -> float:
+    """
+    Returns the p-value of a one-sided Mann-Whitney U test for the comparison
+    samples being stochastically larger than the baseline samples, using the
+    normal approximation with tie and continuity correction.
+    """
+    n1 = len(baseline)
+    n2 = len(comparison)
+    combined = sorted(
+        [(value, 0) for value in baseline] + [(value, 1) for value in comparison]
+    )
+    # assign average ranks to ties
+    rank_sum = 0.0
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j < len(combined) and combined[j][0] == combined[i][0]:
+            j += 1
+        average_rank = (i + j + 1) / 2
+        rank_sum += average_rank * sum(1 for _, group in combined[i:j] if group)
+        tie_term += (j - i) ** 3 - (j - i)
+        i = j
+    u = rank_sum - n2 * (n2 + 1) / 2
+    mean = n1 * n2 / 2
+    variance = n1 * n2 / 12 * ((n1 + n2 + 1) - tie_term / ((n1 + n2) * (n1 + n2 - 1)))
+    if variance <= 0:
+        # all samples are equal
+        return 1.0
+    z = (u - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2))
+
+
+def compare_stage(baseline: dict, comparison: dict, args) -> dict:
+    """Compares the runtime of a single stage, testing for a slowdown"""
+    baseline_samples = baseline.get(samples_key, [])
+    comparison_samples = comparison.get(samples_key, [])
+    result = {}
+    if min(len(baseline_samples), len(comparison_samples)) >= min_samples:
+        ratio = statistics.median(comparison_samples) / statistics.median(
+            baseline_samples
+        )
+        p_value = mann_whitney_u(baseline_samples, comparison_samples)
+        result["p_value"] = p_value
+        significant = p_value < args.alpha
+    else:
+        ratio = comparison["time"] / baseline["time"]
+        significant = None
+    result["slowdown"] = ratio
+    slower = ratio > 1.0 + args.threshold / 100
+    if not slower:
+        result["status"] = "ok"
+    elif significant is None:
+        result["status"] = "untested"
+    elif significant:
+        result["status"] = "regression"
+    else:
+        result["status"] = "noise"
+    return result
+
+
+def regression_main(args: list) -> int:
+    """Runs the regression script, returns the number of regressions"""
+    parser = argparse.ArgumentParser(
+        description="Report statistically significant slowdowns between two "
+        "Ginkgo benchmark outputs. Stages with at least "
+        f"{min_samples} entries in {samples_key} are tested with a one-sided "
+        "Mann-Whitney U test, all other stages are only compared by their "
+        "time and reported as untested."
+    )
+    parser.add_argument(
+        "--alpha",
+        type=float,
+        default=0.01,
+        help="Significance level of the test for a slowdown",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5,
+        help="Minimal slowdown in percent of the median runtime to be reported",
+    )
+    parser.add_argument("--output", choices=["json", "markdown"], default="markdown")
+    parser.add_argument("baseline")
+    parser.add_argument("comparison")
+    args = parser.parse_args(args)
+    baseline_json = parse_json_matrix(args.baseline)
+    comparison_json = parse_json_matrix(args.comparison)
+
+    results = []
+    for case_key in sorted(set(baseline_json.keys()) | set(comparison_json.keys())):
+        if case_key not in comparison_json or case_key not in baseline_json:
+            where = "baseline" if case_key in baseline_json else "comparison"
+            print(f"WARNING: Key {case_key} found in {where} only", file=sys.stderr)
+            continue
+        baseline = extract_measurements(baseline_json[case_key])
+        comparison = extract_measurements(comparison_json[case_key])
+        for path in sorted(set(baseline.keys()).intersection(comparison.keys())):
+            results.append(
+                {
+                    "testcase": json.loads(case_key),
+                    "benchmark": path,
+                    **compare_stage(baseline[path], comparison[path], args),
+                }
+            )
+    regressions = [result for result in results if result["status"] == "regression"]
+    untested = [result for result in results if result["status"] == "untested"]
+
+    if args.output == "json":
+        print(json.dumps({"results": results, "regressions": regressions}, indent=4))
+    else:
+        print(
+            f"{len(regressions)} significant regressions, {len(untested)} untested "
+            f"slowdowns in {len(results)} measurements "
+            f"(threshold {args.threshold}%, alpha {args.alpha})\n"
+        )
+        reported = [result for result in results if result["status"] != "ok"]
+        if len(reported) > 0:
+            print("| benchmark | testcase | slowdown | p-value | status |")
+            print("|-----------|----------|---------:|--------:|--------|")
+            for result in sorted(reported, key=lambda x: x["slowdown"], reverse=True):
+                p_value = f"{result['p_value']:.2g}" if "p_value" in result else "-"
+                print(
+                    f"| {result['benchmark']} | {json.dumps(result['testcase'])} "
+                    f"| {result['slowdown']:.3f} | {p_value} | {result['status']} |"
+                )
+    return len(regressions)
+
+
+if __name__ == "__main__":
+    sys.exit(1 if regression_main(sys.argv[1:]) > 0 else 0)
@@ -0,0 +1,78 @@
+import json
+import regression
+import os
+
+dir_path = os.path.dirname(os.path.realpath(__file__))
+
+
+def test_mann_whitney_u():
+    baseline = [1.0, 1.1, 1.2, 1.3, 1.4]
+    comparison = [2.0, 2.1, 2.2, 2.3, 2.4]
+
+    assert regression.mann_whitney_u(baseline, comparison) < 0.01
+    assert regression.mann_whitney_u(comparison, baseline) > 0.99
+    assert regression.mann_whitney_u(baseline, baseline) > 0.5
+    assert regression.mann_whitney_u([1.0] * 5, [1.0] * 5) == 1.0
+
+
+def test_no_regression(capsys):
+    num_regressions = regression.regression_main(
+        [
+            "--output",
+            "json",
+            dir_path + "/regression_test_input1.json",
+            dir_path + "/regression_test_input1.json",
+        ]
+    )
+    captured = capsys.readouterr()
+    result = json.loads(captured.out)
+
+    assert num_regressions == 0
+    assert result["regressions"] == []
+    assert [x["status"] for x in result["results"]] == ["ok"] * 5
+    assert captured.err == ""
+
+
+def test_regression(capsys):
+    num_regressions = regression.regression_main(
+        [
+            "--output",
+            "json",
+            dir_path + "/regression_test_input1.json",
+            dir_path + "/regression_test_input2.json",
+        ]
+    )
+    captured = capsys.readouterr()
+    result = json.loads(captured.out)
+    status = {x["benchmark"]: x["status"] for x in result["results"]}
+    ref_err = """WARNING: Key {"size": 100, "stencil": "5pt"} found in baseline only
+WARNING: Key {"size": 100, "stencil": "9pt"} found in comparison only
+"""
+
+    assert num_regressions == 1
+    assert status == {
+        "solver/cg/apply": "regression",
+        "solver/cg/generate": "ok",
+        "solver/cg/refactorize": "untested",
+        "solver/cg/repeated_apply": "noise",
+    }
+    assert result["regressions"][0]["slowdown"] == 1.2
+    assert result["regressions"][0]["testcase"] == {"size": 100, "stencil": "7pt"}
+    assert captured.err == ref_err
+
+
+def test_threshold(capsys):
+    num_regressions = regression.regression_main(
+        [
+            "--threshold",
+            "50",
+            dir_path + "/regression_test_input1.json",
+            dir_path + "/regression_test_input2.json",
+        ]
+    )
+    captured = capsys.readouterr()
+
+    assert num_regressions == 0
+    assert captured.out.startswith(
+        "0 significant regressions, 0 untested slowdowns in 4 measurements"
+    )
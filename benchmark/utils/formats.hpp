@@ -25,8 +25,8 @@ namespace formats {
 
 
 std::string available_format =
-    "coo, csr, ell, ell_mixed, sellp, hybrid, hybrid0, hybrid25, hybrid33, "
-    "hybrid40, "
+    "coo, csr, csr_mixed, csrc_mixed, ell, ell_mixed, sellp, hybrid, hybrid0, "
+    "hybrid25, hybrid33, hybrid40, "
     "hybrid60, hybrid80, hybridlimit0, hybridlimit25, hybridlimit33, "
     "hybridminstorage"
 #ifdef HAS_CUDA
@@ -54,6 +54,10 @@ std::string format_description =
     "csri: Ginkgo's CSR implementation with imbalance strategy.\n"
     "csrm: Ginkgo's CSR implementation with merge_path strategy.\n"
     "csrs: Ginkgo's CSR implementation with sparselib strategy.\n"
+    "csr_mixed: Ginkgo's CSR implementation with automatic strategy, storing\n"
+    "           the matrix values in the next lower precision while the\n"
+    "           vectors keep the benchmark precision.\n"
+    "csrc_mixed: Like csr_mixed, but with classical strategy.\n"
     "ell: Ellpack format according to Bell and Garland: Efficient Sparse\n"
     "     Matrix-Vector Multiplication on CUDA.\n"
     "ell_mixed: Mixed Precision Ellpack format according to Bell and Garland:\n"
@@ -133,6 +137,7 @@ using csr = gko::matrix::Csr<etype, itype>;
 using coo = gko::matrix::Coo<etype, itype>;
 using ell = gko::matrix::Ell<etype, itype>;
 using ell_mixed = gko::matrix::Ell<gko::next_precision<etype>, itype>;
+using csr_mixed = gko::matrix::Csr<gko::next_precision<etype>, itype>;
 
 
 /**
@@ -140,9 +145,10 @@ using ell_mixed = gko::matrix::Ell<gko::next_precision<etype>, itype>;
  * falls back to csr::classical for executors without support for this strategy.
  *
  * @tparam Strategy  one of csr::automatical or csr::load_balance
+ * @tparam CsrType  the Csr matrix type the strategy is used for
  */
-template <typename Strategy>
-std::shared_ptr<csr::strategy_type> create_gpu_strategy(
+template <typename Strategy, typename CsrType = csr>
+std::shared_ptr<typename CsrType::strategy_type> create_gpu_strategy(
     std::shared_ptr<const gko::Executor> exec)
 {
     if (auto cuda = dynamic_cast<const gko::CudaExecutor*>(exec.get())) {
@@ -153,11 +159,24 @@ std::shared_ptr<csr::strategy_type> create_gpu_strategy(
                    dynamic_cast<const gko::DpcppExecutor*>(exec.get())) {
         return std::make_shared<Strategy>(dpcpp->shared_from_this());
     } else {
-        return std::make_shared<csr::classical>();
+        return std::make_shared<typename CsrType::classical>();
     }
 }
 
 
+/**
+ * Returns true if the format stores its values in the next lower precision,
+ * i.e. its name ends with `_mixed`.
+ */
+bool is_mixed_format(const std::string& format)
+{
+    const std::string suffix = "_mixed";
+    return format.size() > suffix.size() &&
+           format.compare(format.size() - suffix.size(), suffix.size(),
+                          suffix) == 0;
+}
+
+
 /**
  * Checks whether the given matrix data exceeds the ELL imbalance limit set by
  * the --ell_imbalance_limit flag
@@ -197,7 +216,8 @@ auto create_matrix_type_with_gpu_strategy()
 {
     return [&](std::shared_ptr<const gko::Executor> exec)
                -> std::unique_ptr<MatrixType> {
-        return MatrixType::create(exec, create_gpu_strategy<Strategy>(exec));
+        return MatrixType::create(
+            exec, create_gpu_strategy<Strategy, MatrixType>(exec));
     };
 }
 
@@ -211,6 +231,8 @@ const std::map<std::string, std::function<std::unique_ptr<gko::LinOp>(
         {"csrm", create_matrix_type<csr>(std::make_shared<csr::merge_path>())},
         {"csrc", create_matrix_type<csr>(std::make_shared<csr::classical>())},
         {"csrs", create_matrix_type<csr>(std::make_shared<csr::sparselib>())},
+        {"csr_mixed", create_matrix_type_with_gpu_strategy<csr_mixed, csr_mixed::automatical>()},
+        {"csrc_mixed", create_matrix_type<csr_mixed>(std::make_shared<csr_mixed::classical>())},
         {"coo", create_matrix_type<coo>()},
         {"ell", create_matrix_type<ell>()},
         {"ell_mixed", create_matrix_type<ell_mixed>()},
@@ -276,7 +298,7 @@ std::unique_ptr<gko::LinOp> matrix_factory(
     if (format == "ell" || format == "ell_mixed") {
         check_ell_admissibility(data);
     }
-    if (format == "ell_mixed") {
+    if (is_mixed_format(format)) {
         gko::matrix_data<gko::next_precision<etype>, itype> conv_data;
         conv_data.size = data.size;
         conv_data.nonzeros.resize(data.nonzeros.size());
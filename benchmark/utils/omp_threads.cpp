@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <omp.h>
+
+
+#include "benchmark/utils/omp_threads.hpp"
+
+
+int get_omp_max_threads() { return omp_get_max_threads(); }
+
+
+void set_omp_num_threads(int num_threads) { omp_set_num_threads(num_threads); }
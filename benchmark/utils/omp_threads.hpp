@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_BENCHMARK_UTILS_OMP_THREADS_HPP_
+#define GKO_BENCHMARK_UTILS_OMP_THREADS_HPP_
+
+
+#ifdef HAS_OMP_THREADS
+
+
+/**
+ * Returns the number of OpenMP threads used for the next parallel region, i.e.
+ * omp_get_max_threads().
+ */
+int get_omp_max_threads();
+
+
+/**
+ * Sets the number of OpenMP threads used for the following parallel regions
+ * started from the calling thread, i.e. omp_set_num_threads().
+ *
+ * @param num_threads  the number of threads
+ */
+void set_omp_num_threads(int num_threads);
+
+
+#endif  // HAS_OMP_THREADS
+
+
+#endif  // GKO_BENCHMARK_UTILS_OMP_THREADS_HPP_
@@ -15,6 +15,7 @@
 
 
 #include "benchmark/utils/general.hpp"
+#include "benchmark/utils/thread_scaling.hpp"
 
 
 std::shared_ptr<gko::log::ProfilerHook> create_profiler_hook(
@@ -80,9 +81,80 @@ struct Benchmark {
 
     /** Post-process test case info. */
     virtual void postprocess(json& test_case) const {}
+
+    /** The runtime in seconds stored in the results of an operation. */
+    virtual double get_runtime(const json& operation_case) const
+    {
+        return operation_case.at("time").get<double>();
+    }
+
+    /**
+     * The number of bytes an operation needs to read and write at least, or 0
+     * if it is unknown. Used to compute the achieved bandwidth.
+     */
+    virtual double get_memory(const State& state,
+                              const json& operation_case) const
+    {
+        return 0.0;
+    }
 };
 
 
+/**
+ * Reruns an operation for all thread counts and binding policies of the
+ * scaling mode, and stores the results in the "scaling" array of the
+ * operation. The speedup and the parallel efficiency are relative to the
+ * smallest thread count with the same binding policy.
+ */
+template <typename State>
+void run_scaling(const Benchmark<State>& benchmark,
+                 std::shared_ptr<gko::Executor> exec,
+                 std::shared_ptr<Timer> timer, annotate_functor annotate,
+                 State& state, const std::string& operation_name,
+                 json& operation_case)
+{
+    auto& scaling = operation_case["scaling"];
+    scaling = json::array();
+    const auto memory = benchmark.get_memory(state, operation_case);
+    double base_time{};
+    int base_threads{};
+    std::string base_binding;
+    for (const auto& config : get_scaling_configs()) {
+        json config_case = json::object();
+        const auto name =
+            std::to_string(config.num_threads) + " threads " + config.binding;
+        auto range = annotate(name.c_str());
+        const auto cores = apply_scaling_config(config);
+        try {
+            benchmark.run(exec, timer, annotate, state, operation_name,
+                          config_case);
+        } catch (...) {
+            reset_scaling_config(cores);
+            throw;
+        }
+        reset_scaling_config(cores);
+        const auto time = benchmark.get_runtime(config_case);
+        if (config.binding != base_binding) {
+            base_time = time;
+            base_threads = config.num_threads;
+            base_binding = config.binding;
+        }
+        json result = json::object();
+        result["threads"] = config.num_threads;
+        result["binding"] = config.binding;
+        result["cores"] = cores;
+        result["time"] = time;
+        result["speedup"] = base_time / time;
+        result["efficiency"] =
+            base_time * base_threads / (time * config.num_threads);
+        if (memory > 0.0) {
+            result["bandwidth"] = memory / time;
+        }
+        scaling.push_back(result);
+    }
+}
+
+
 template <typename State>
 void run_test_cases(const Benchmark<State>& benchmark,
                     std::shared_ptr<gko::Executor> exec,
@@ -107,6 +179,24 @@ void run_test_cases(const Benchmark<State>& benchmark,
         }
     }
 
+    if (!get_scaling_configs().empty()) {
+#ifdef HAS_OMP_THREADS
+        const bool supported =
+            std::dynamic_pointer_cast<const gko::OmpExecutor>(exec) &&
+            !std::dynamic_pointer_cast<const gko::ReferenceExecutor>(exec);
+#else
+        const bool supported = false;
+#endif  // HAS_OMP_THREADS
+        if (!supported) {
+            if (benchmark.should_print()) {
+                std::cerr << "Thread scaling is only supported by the omp "
+                             "executor"
+                          << std::endl;
+            }
+            std::exit(1);
+        }
+    }
+
     auto profiler_hook = create_profiler_hook(exec, benchmark.should_print());
     if (profiler_hook) {
         exec->add_logger(profiler_hook);
@@ -142,6 +232,11 @@ void run_test_cases(const Benchmark<State>& benchmark,
                     auto operation_range = annotate(operation_name.c_str());
                     benchmark.run(exec, timer, annotate, test_case_state,
                                   operation_name, operation_case);
+                    if (!FLAGS_scaling_threads.empty()) {
+                        run_scaling(benchmark, exec, timer, annotate,
+                                    test_case_state, operation_name,
+                                    operation_case);
+                    }
                     operation_case["completed"] = true;
                 } catch (const std::exception& e) {
                     operation_case["completed"] = false;
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_BENCHMARK_UTILS_THREAD_SCALING_HPP_
+#define GKO_BENCHMARK_UTILS_THREAD_SCALING_HPP_
+
+
+#include <ginkgo/ginkgo.hpp>
+
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+#include <gflags/gflags.h>
+
+
+#include "benchmark/utils/general.hpp"
+#include "benchmark/utils/omp_threads.hpp"
+
+
+// Command-line arguments
+DEFINE_string(
+    scaling_threads, "",
+    "If set, additionally runs every operation with each of the given "
+    "comma-separated numbers of OpenMP threads, and stores the runtime, "
+    "speedup, parallel efficiency and achieved bandwidth of each "
+    "configuration in \"scaling\". `max` stands for the number of threads "
+    "the benchmark was started with. Only supported by the omp executor.");
+
+DEFINE_string(
+    scaling_binding, "none",
+    "A comma-separated list of thread binding policies to run every thread "
+    "count of --scaling_threads with. Supported values are: `none` leaves the "
+    "placement of the threads to the operating system, `compact` binds the "
+    "threads to the first cores, filling up one NUMA node after the other, "
+    "and `spread` binds them to cores distributed round-robin over all NUMA "
+    "nodes. Binding requires Ginkgo to be built with HWLOC support.");
+
+
+// Returns the number of OpenMP threads the benchmark was started with
+int get_default_num_threads()
+{
+#ifdef HAS_OMP_THREADS
+    static const int num_threads = get_omp_max_threads();
+    return num_threads;
+#else
+    return 1;
+#endif  // HAS_OMP_THREADS
+}
+
+
+struct scaling_config {
+    int num_threads;
+    std::string binding;
+};
+
+
+/**
+ * Returns the thread counts and binding policies of the scaling mode, or an
+ * empty vector if it is disabled.
+ */
+std::vector<scaling_config> get_scaling_configs()
+{
+    std::vector<scaling_config> result;
+    if (FLAGS_scaling_threads.empty()) {
+        return result;
+    }
+    const auto max_threads = get_default_num_threads();
+    std::vector<int> thread_counts;
+    for (const auto& count : split(FLAGS_scaling_threads, ',')) {
+        thread_counts.push_back(count == "max" ? max_threads
+                                               : std::stoi(count));
+        if (thread_counts.back() <= 0) {
+            throw std::invalid_argument("Invalid thread count " + count);
+        }
+    }
+    std::sort(thread_counts.begin(), thread_counts.end());
+    thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()),
+                        thread_counts.end());
+    for (const auto& binding : split(FLAGS_scaling_binding, ',')) {
+        if (binding != "none" && binding != "compact" && binding != "spread") {
+            throw std::invalid_argument("Unknown thread binding " + binding);
+        }
+        for (auto num_threads : thread_counts) {
+            result.push_back({num_threads, binding});
+        }
+    }
+    return result;
+}
+
+
+/**
+ * Returns the logical ids of the cores a binding policy places the given
+ * number of threads on. If there are more threads than cores, every core is
+ * used. The result is empty for the `none` policy, or if no topology
+ * information is available.
+ */
+std::vector<int> get_binding_cores(const std::string& binding, int num_threads)
+{
+    const auto topology = gko::machine_topology::get_instance();
+    const auto num_cores = static_cast<int>(topology->get_num_cores());
+    std::vector<int> result;
+    if (binding == "none" || num_cores == 0) {
+        return result;
+    }
+    const auto num_used = std::min(num_threads, num_cores);
+    if (binding == "compact") {
+        // logical ids are ordered by proximity, so consecutive cores fill up
+        // the NUMA nodes one after the other
+        for (int core = 0; core < num_used; core++) {
+            result.push_back(core);
+        }
+    } else {
+        std::vector<std::vector<int>> numa_cores;
+        for (int core = 0; core < num_cores; core++) {
+            const auto numa = std::max(topology->get_core(core)->numa, 0);
+            if (numa >= static_cast<int>(numa_cores.size())) {
+                numa_cores.resize(numa + 1);
+            }
+            numa_cores[numa].push_back(core);
+        }
+        numa_cores.erase(std::remove_if(numa_cores.begin(), numa_cores.end(),
+                                        [](const std::vector<int>& cores) {
+                                            return cores.empty();
+                                        }),
+                         numa_cores.end());
+        for (std::size_t i = 0; static_cast<int>(result.size()) < num_used;
+             i++) {
+            auto& cores = numa_cores[i % numa_cores.size()];
+            const auto index = i / numa_cores.size();
+            if (index < cores.size()) {
+                result.push_back(cores[index]);
+            }
+        }
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+
+/**
+ * Sets the number of OpenMP threads and binds the process to the cores of a
+ * scaling configuration.
+ *
+ * @return the logical ids of the cores the process was bound to
+ */
+std::vector<int> apply_scaling_config(const scaling_config& config)
+{
+#ifdef HAS_OMP_THREADS
+    set_omp_num_threads(config.num_threads);
+#endif  // HAS_OMP_THREADS
+    auto cores = get_binding_cores(config.binding, config.num_threads);
+    if (!cores.empty()) {
+        gko::machine_topology::get_instance()->bind_to_cores(cores, false);
+    }
+    return cores;
+}
+
+
+/**
+ * Restores the number of OpenMP threads the benchmark was started with, and
+ * allows the process to run on all processing units again if it was bound.
+ *
+ * @param cores  the cores returned by apply_scaling_config
+ */
+void reset_scaling_config(const std::vector<int>& cores)
+{
+#ifdef HAS_OMP_THREADS
+    set_omp_num_threads(get_default_num_threads());
+#endif  // HAS_OMP_THREADS
+    if (!cores.empty()) {
+        const auto topology = gko::machine_topology::get_instance();
+        std::vector<int> pus(topology->get_num_pus());
+        std::iota(pus.begin(), pus.end(), 0);
+        topology->bind_to_pus(pus, false);
+    }
+}
+
+
+#endif  // GKO_BENCHMARK_UTILS_THREAD_SCALING_HPP_
@@ -8,6 +8,7 @@
 #include <ginkgo/core/base/math.hpp>
 
 
+#include "common/unified/base/kernel_launch_reduction.hpp"
 #include "common/unified/base/kernel_launch_solver.hpp"
 
 
@@ -111,6 +112,39 @@ void step_2(std::shared_ptr<const DefaultExecutor> exec,
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_KERNEL);
 
 
+template <typename ValueType>
+void step_2_norm(std::shared_ptr<const DefaultExecutor> exec,
+                 matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                 const matrix::Dense<ValueType>* p,
+                 const matrix::Dense<ValueType>* q,
+                 const matrix::Dense<ValueType>* beta,
+                 const matrix::Dense<ValueType>* rho,
+                 matrix::Dense<remove_complex<ValueType>>* residual_norm,
+                 array<char>& tmp, const array<stopping_status>* stop_status)
+{
+    // every entry is visited exactly once, so the update can be done inside
+    // the reduction
+    run_kernel_col_reduction_cached(
+        exec,
+        [] GKO_KERNEL(auto row, auto col, auto x, auto r, auto p, auto q,
+                      auto beta, auto rho, auto stop) {
+            if (!stop[col].has_stopped()) {
+                auto alpha = safe_divide(rho[col], beta[col]);
+                x(row, col) += alpha * p(row, col);
+                r(row, col) -= alpha * q(row, col);
+            }
+            return squared_norm(r(row, col));
+        },
+        [] GKO_KERNEL(auto a, auto b) { return a + b; },
+        [] GKO_KERNEL(auto a) { return sqrt(a); },
+        remove_complex<ValueType>{}, residual_norm->get_values(),
+        x->get_size(), tmp, x, r, p, q, row_vector(beta), row_vector(rho),
+        *stop_status);
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_NORM_KERNEL);
+
+
 }  // namespace cg
 }  // namespace GKO_DEVICE_NAMESPACE
 }  // namespace kernels
@@ -44,6 +44,28 @@ auto create_vector_blocks(LinOpType* vector,
 }
 
 
+/**
+ * Calls fn(row) for all block rows. The block rows write to disjoint parts of
+ * the output, so on an OmpExecutor they run as concurrent tasks.
+ */
+template <typename Fn>
+void for_each_block_row(std::shared_ptr<const Executor> exec,
+                        size_type num_rows, Fn fn)
+{
+    auto omp_exec = std::dynamic_pointer_cast<const OmpExecutor>(exec);
+    if (!omp_exec || num_rows < 2) {
+        for (size_type row = 0; row < num_rows; ++row) {
+            fn(row);
+        }
+        return;
+    }
+    for (size_type row = 0; row < num_rows; ++row) {
+        omp_exec->enqueue([&fn, row] { fn(row); });
+    }
+    omp_exec->synchronize();
+}
+
+
 const LinOp* find_non_zero_in_row(
     const std::vector<std::vector<std::shared_ptr<const LinOp>>>& blocks,
     size_type row)
@@ -197,8 +219,9 @@ void BlockOperator::apply_impl(const LinOp* b, LinOp* x) const
     auto block_b = create_vector_blocks(b, col_spans_);
     auto block_x = create_vector_blocks(x, row_spans_);
 
-    init_one_cache(this->get_executor(), one_);
-    for (size_type row = 0; row < block_size_[0]; ++row) {
+    auto exec = this->get_executor();
+    init_one_cache(exec, one_);
+    for_each_block_row(exec, block_size_[0], [&](size_type row) {
         bool first_in_row = true;
         for (size_type col = 0; col < block_size_[1]; ++col) {
             if (!block_at(row, col)) {
@@ -212,7 +235,7 @@ void BlockOperator::apply_impl(const LinOp* b, LinOp* x) const
                                           block_x(row));
             }
         }
-    }
+    });
 }
 
 
@@ -222,8 +245,9 @@ void BlockOperator::apply_impl(const LinOp* alpha, const LinOp* b,
     auto block_b = create_vector_blocks(b, col_spans_);
     auto block_x = create_vector_blocks(x, row_spans_);
 
-    init_one_cache(this->get_executor(), one_);
-    for (size_type row = 0; row < block_size_[0]; ++row) {
+    auto exec = this->get_executor();
+    init_one_cache(exec, one_);
+    for_each_block_row(exec, block_size_[0], [&](size_type row) {
         bool first_in_row = true;
         for (size_type col = 0; col < block_size_[1]; ++col) {
             if (!block_at(row, col)) {
@@ -238,7 +262,7 @@ void BlockOperator::apply_impl(const LinOp* alpha, const LinOp* b,
                                           block_x(row));
             }
         }
-    }
+    });
 }
 
 
@@ -25,7 +25,7 @@ namespace fixedblock {
  */
 using compiled_kernels = syn::value_list<int, GKO_FIXED_BLOCK_CUSTOM_SIZES>;
 #else
-using compiled_kernels = syn::value_list<int, 2, 3, 4, 7>;
+using compiled_kernels = syn::value_list<int, 2, 3, 4, 5, 6, 7, 8>;
 #endif
 
 
@@ -154,15 +154,26 @@ template <typename ValueType>
 void Combination<ValueType>::apply_impl(const LinOp* alpha, const LinOp* b,
                                         const LinOp* beta, LinOp* x) const
 {
+    initialize_scalars<ValueType>(this->get_executor(), cache_.zero,
+                                  cache_.one);
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
-            if (cache_.intermediate_x == nullptr ||
-                cache_.intermediate_x->get_size() != dense_x->get_size()) {
-                cache_.intermediate_x = dense_x->clone();
+            // fold alpha into the coefficients, so every operator accumulates
+            // directly into x instead of going through an intermediate vector
+            auto exec = this->get_executor();
+            cache_.scaled_coefficients.resize(coefficients_.size());
+            for (size_type i = 0; i < coefficients_.size(); ++i) {
+                auto& coef = cache_.scaled_coefficients[i];
+                coef.init(exec, dim<2>{1, 1});
+                coef->copy_from(coefficients_[i]);
+                coef->scale(dense_alpha);
+            }
+            operators_[0]->apply(cache_.scaled_coefficients[0].get(), dense_b,
+                                 dense_beta, dense_x);
+            for (size_type i = 1; i < operators_.size(); ++i) {
+                operators_[i]->apply(cache_.scaled_coefficients[i].get(),
+                                     dense_b, cache_.one, dense_x);
             }
-            this->apply_impl(dense_b, cache_.intermediate_x.get());
-            dense_x->scale(dense_beta);
-            dense_x->add_scaled(dense_alpha, cache_.intermediate_x);
         },
         alpha, b, beta, x);
 }
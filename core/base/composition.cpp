@@ -10,10 +10,10 @@
 
 
 #include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
-
-
-#include "core/components/fill_array_kernels.hpp"
+#include <ginkgo/core/matrix/diagonal.hpp>
+#include <ginkgo/core/matrix/permutation.hpp>
 
 
 namespace gko {
@@ -21,7 +21,111 @@ namespace composition {
 namespace {
 
 
-GKO_REGISTER_OPERATION(fill_array, components::fill_array);
+template <typename IndexType>
+std::shared_ptr<const LinOp> fuse_permutations(
+    const std::shared_ptr<const LinOp>& left,
+    const std::shared_ptr<const LinOp>& right)
+{
+    using Permutation = matrix::Permutation<IndexType>;
+    auto left_perm = dynamic_cast<const Permutation*>(left.get());
+    auto right_perm = dynamic_cast<const Permutation*>(right.get());
+    if (left_perm && right_perm) {
+        // P_l * P_r first permutes by P_r and then by P_l
+        return right_perm->compose(left_perm);
+    }
+    return nullptr;
+}
+
+
+template <typename ValueType, typename IndexType>
+std::shared_ptr<const LinOp> fuse_with_csr(
+    const std::shared_ptr<const LinOp>& left,
+    const std::shared_ptr<const LinOp>& right)
+{
+    using Csr = matrix::Csr<ValueType, IndexType>;
+    using Diagonal = matrix::Diagonal<ValueType>;
+    using Permutation = matrix::Permutation<IndexType>;
+    if (auto csr = std::dynamic_pointer_cast<const Csr>(right)) {
+        if (auto diag = dynamic_cast<const Diagonal*>(left.get())) {
+            // D * A scales the rows of A
+            auto result = gko::clone(csr);
+            diag->apply(csr, result);
+            return std::move(result);
+        }
+        if (auto perm = dynamic_cast<const Permutation*>(left.get())) {
+            // P * A permutes the rows of A
+            return csr->permute(perm, matrix::permute_mode::rows);
+        }
+    }
+    if (auto csr = std::dynamic_pointer_cast<const Csr>(left)) {
+        if (auto diag = dynamic_cast<const Diagonal*>(right.get())) {
+            // A * D scales the columns of A
+            auto result = gko::clone(csr);
+            diag->rapply(csr, result);
+            return std::move(result);
+        }
+        if (auto perm = dynamic_cast<const Permutation*>(right.get())) {
+            // A * P = A * P^-T permutes the columns of A
+            return csr->permute(perm, matrix::permute_mode::inverse_columns);
+        }
+    }
+    return nullptr;
+}
+
+
+template <typename ValueType>
+std::shared_ptr<const LinOp> fuse_diagonals(
+    const std::shared_ptr<const LinOp>& left,
+    const std::shared_ptr<const LinOp>& right)
+{
+    using Dense = matrix::Dense<ValueType>;
+    using Diagonal = matrix::Diagonal<ValueType>;
+    auto left_diag = dynamic_cast<const Diagonal*>(left.get());
+    auto right_diag = dynamic_cast<const Diagonal*>(right.get());
+    if (left_diag && right_diag) {
+        // D_l * D_r is the diagonal of the elementwise products
+        auto exec = right_diag->get_executor();
+        const auto size = right_diag->get_size()[0];
+        auto result = Diagonal::create(exec, size);
+        auto right_values = Dense::create_const(
+            exec, dim<2>{size, 1},
+            make_const_array_view(exec, size, right_diag->get_const_values()),
+            1);
+        auto result_values =
+            Dense::create(exec, dim<2>{size, 1},
+                          make_array_view(exec, size, result->get_values()), 1);
+        left_diag->apply(right_values, result_values);
+        return std::move(result);
+    }
+    return nullptr;
+}
+
+
+/**
+ * Returns a single operator representing left * right if both operators can
+ * be combined without increasing their storage requirements significantly,
+ * nullptr otherwise.
+ */
+template <typename ValueType>
+std::shared_ptr<const LinOp> fuse_operators(
+    const std::shared_ptr<const LinOp>& left,
+    const std::shared_ptr<const LinOp>& right)
+{
+    auto result = fuse_diagonals<ValueType>(left, right);
+    if (!result) {
+        result = fuse_permutations<int32>(left, right);
+    }
+    if (!result) {
+        result = fuse_permutations<int64>(left, right);
+    }
+    if (!result) {
+        result = fuse_with_csr<ValueType, int32>(left, right);
+    }
+    if (!result) {
+        result = fuse_with_csr<ValueType, int64>(left, right);
+    }
+    return result;
+}
 
 
 }  // anonymous namespace
@@ -29,77 +133,63 @@ GKO_REGISTER_OPERATION(fill_array, components::fill_array);
 
 
 template <typename ValueType>
-std::unique_ptr<LinOp> apply_inner_operators(
+const matrix::Dense<ValueType>* apply_inner_operators(
     const std::vector<std::shared_ptr<const LinOp>>& operators,
-    array<ValueType>& storage, const LinOp* rhs)
+    std::vector<detail::DenseCache<ValueType>>& intermediates,
+    const matrix::Dense<ValueType>* rhs)
 {
-    using Dense = matrix::Dense<ValueType>;
-    // determine amount of necessary storage:
-    // maximum sum of two subsequent intermediate vectors
-    // (and the out dimension of the last op if we only have one operator)
-    auto num_rhs = rhs->get_size()[1];
-    auto max_intermediate_size = std::accumulate(
-        begin(operators) + 1, end(operators) - 1,
-        operators.back()->get_size()[0],
-        [](size_type acc, std::shared_ptr<const LinOp> op) {
-            return std::max(acc, op->get_size()[0] + op->get_size()[1]);
-        });
-    auto storage_size = max_intermediate_size * num_rhs;
-    storage.resize_and_reset(storage_size);
-
-    // apply inner vectors
+    // every intermediate vector has its own buffer, so they only need to be
+    // reallocated if the number of right-hand sides changes
     auto exec = rhs->get_executor();
-    auto data = storage.get_data();
-    // apply last operator
-    auto op_size = operators.back()->get_size();
-    auto out_dim = gko::dim<2>{op_size[0], num_rhs};
-    auto out_size = out_dim[0] * num_rhs;
-    auto out = Dense::create(exec, out_dim,
-                             make_array_view(exec, out_size, data), num_rhs);
-    // for operators with initial guess: set initial guess
-    if (operators.back()->apply_uses_initial_guess()) {
-        if (op_size[0] == op_size[1]) {
-            // square matrix: we can use the previous output
-            exec->copy(out_size, as<Dense>(rhs)->get_const_values(),
-                       out->get_values());
-        } else {
-            // rectangular matrix: we can't do better than zeros
-            exec->run(composition::make_fill_array(out->get_values(), out_size,
-                                                   zero<ValueType>()));
-        }
-    }
-    operators.back()->apply(rhs, out);
-    // apply following operators
-    // alternate intermediate vectors between beginning/end of storage
-    auto reversed_storage = true;
-    for (auto i = operators.size() - 2; i > 0; --i) {
-        // swap in and out
-        auto in = std::move(out);
-        // build new intermediate vector
-        op_size = operators[i]->get_size();
-        out_dim[0] = op_size[0];
-        out_size = out_dim[0] * num_rhs;
-        auto out_data =
-            data + (reversed_storage ? storage_size - out_size : size_type{});
-        reversed_storage = !reversed_storage;
-        out = Dense::create(exec, out_dim,
-                            make_array_view(exec, out_size, out_data), num_rhs);
+    auto num_rhs = rhs->get_size()[1];
+    intermediates.resize(operators.size() - 1);
+    auto in = rhs;
+    for (auto i = operators.size() - 1; i > 0; --i) {
+        const auto& op = operators[i];
+        auto op_size = op->get_size();
+        auto& out = intermediates[i - 1];
+        out.init(exec, dim<2>{op_size[0], num_rhs});
         // for operators with initial guess: set initial guess
-        if (operators[i]->apply_uses_initial_guess()) {
+        if (op->apply_uses_initial_guess()) {
             if (op_size[0] == op_size[1]) {
                 // square matrix: we can use the previous output
-                exec->copy(out_size, in->get_const_values(), out->get_values());
+                out->copy_from(in);
             } else {
                 // rectangular matrix: we can't do better than zeros
-                exec->run(composition::make_fill_array(
-                    out->get_values(), out_size, zero<ValueType>()));
+                out->fill(zero<ValueType>());
             }
         }
-        // apply operator
-        operators[i]->apply(in, out);
+        op->apply(in, out.get());
+        in = out.get();
     }
 
-    return std::move(out);
+    return in;
+}
+
+
+template <typename ValueType>
+const std::vector<std::shared_ptr<const LinOp>>&
+Composition<ValueType>::get_fused_operators() const
+{
+    if (fused_operators_.empty() && !operators_.empty()) {
+        fused_operators_ = operators_;
+        size_type i = 0;
+        while (i + 1 < fused_operators_.size()) {
+            auto fused = composition::fuse_operators<ValueType>(
+                fused_operators_[i], fused_operators_[i + 1]);
+            if (fused) {
+                fused_operators_[i] = std::move(fused);
+                fused_operators_.erase(fused_operators_.begin() + i + 1);
+                // the fused operator may be fusable with its left neighbor
+                if (i > 0) {
+                    --i;
+                }
+            } else {
+                ++i;
+            }
+        }
+    }
+    return fused_operators_;
 }
 
 
@@ -111,6 +201,7 @@ Composition<ValueType>& Composition<ValueType>::operator=(
         EnableLinOp<Composition>::operator=(other);
         auto exec = this->get_executor();
         operators_ = other.operators_;
+        fused_operators_.clear();
         // if the operators are on the wrong executor, copy them over
         if (other.get_executor() != exec) {
             for (auto& op : operators_) {
@@ -129,6 +220,8 @@ Composition<ValueType>& Composition<ValueType>::operator=(Composition&& other)
         EnableLinOp<Composition>::operator=(std::move(other));
         auto exec = this->get_executor();
         operators_ = std::move(other.operators_);
+        fused_operators_.clear();
+        other.fused_operators_.clear();
         // if the operators are on the wrong executor, copy them over
         if (other.get_executor() != exec) {
             for (auto& op : operators_) {
@@ -193,12 +286,13 @@ void Composition<ValueType>::apply_impl(const LinOp* b, LinOp* x) const
 {
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_b, auto dense_x) {
-            if (operators_.size() > 1) {
-                operators_[0]->apply(
-                    apply_inner_operators(operators_, storage_, dense_b),
+            const auto& operators = this->get_fused_operators();
+            if (operators.size() > 1) {
+                operators[0]->apply(
+                    apply_inner_operators(operators, intermediates_, dense_b),
                     dense_x);
             } else {
-                operators_[0]->apply(dense_b, dense_x);
+                operators[0]->apply(dense_b, dense_x);
             }
         },
         b, x);
@@ -211,13 +305,14 @@ void Composition<ValueType>::apply_impl(const LinOp* alpha, const LinOp* b,
 {
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
-            if (operators_.size() > 1) {
-                operators_[0]->apply(
+            const auto& operators = this->get_fused_operators();
+            if (operators.size() > 1) {
+                operators[0]->apply(
                     dense_alpha,
-                    apply_inner_operators(operators_, storage_, dense_b),
+                    apply_inner_operators(operators, intermediates_, dense_b),
                     dense_beta, dense_x);
             } else {
-                operators_[0]->apply(dense_alpha, dense_b, dense_beta, dense_x);
+                operators[0]->apply(dense_alpha, dense_b, dense_beta, dense_x);
             }
         },
         alpha, b, beta, x);
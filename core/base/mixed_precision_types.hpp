@@ -75,6 +75,33 @@
     GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE(_macro, int64)
 
 
+/**
+ * Instantiates a kernel with the signature
+ * `_macro(MatrixValueType, InputValueType, OutputValueType, ...)` for the
+ * reduced-storage combinations, where the matrix values are stored in single
+ * precision and the vectors in double precision. These combinations are
+ * always available, so lower-precision matrices can be applied to vectors
+ * without converting the vectors. With GINKGO_MIXED_PRECISION, they are
+ * already part of GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE.
+ */
+#ifdef GINKGO_MIXED_PRECISION
+#define GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_TYPE(_macro, ...) \
+    static_assert(true,                                                  \
+                  "This assert is used to counter the false positive "   \
+                  "extra semi-colon warnings")
+#else
+#define GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_TYPE(_macro, ...) \
+    template _macro(float, double, double, __VA_ARGS__);                 \
+    template _macro(std::complex<float>, std::complex<double>,           \
+                    std::complex<double>, __VA_ARGS__)
+#endif
+
+
+#define GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_AND_INDEX_TYPE(_macro) \
+    GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_TYPE(_macro, int32);       \
+    GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_TYPE(_macro, int64)
+
+
 #ifdef GINKGO_MIXED_PRECISION
 #define GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE_2(_macro, ...)             \
     template _macro(float, float, __VA_ARGS__);                              \
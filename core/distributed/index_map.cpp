@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/distributed/index_map.hpp>
+
+
+#include <numeric>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+
+
+template <typename LocalIndexType, typename GlobalIndexType>
+IndexMap<LocalIndexType, GlobalIndexType>::IndexMap(
+    std::shared_ptr<const Executor> exec, comm_index_type num_parts,
+    size_type global_size, size_type local_size)
+    : EnablePolymorphicObject<IndexMap>{exec},
+      global_size_{global_size},
+      local_size_{local_size},
+      send_offsets_(num_parts + 1),
+      send_sizes_(num_parts),
+      recv_offsets_(num_parts + 1),
+      recv_sizes_(num_parts),
+      gather_idxs_{exec},
+      non_local_to_global_{exec}
+{}
+
+
+template <typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<IndexMap<LocalIndexType, GlobalIndexType>>
+IndexMap<LocalIndexType, GlobalIndexType>::create(
+    std::shared_ptr<const Executor> exec, comm_index_type num_parts,
+    size_type global_size, size_type local_size)
+{
+    return std::unique_ptr<IndexMap>{
+        new IndexMap{exec, num_parts, global_size, local_size}};
+}
+
+
+template <typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<IndexMap<LocalIndexType, GlobalIndexType>>
+IndexMap<LocalIndexType, GlobalIndexType>::build_from_non_local_columns(
+    std::shared_ptr<const Executor> exec, mpi::communicator comm,
+    size_type global_size, size_type local_size,
+    const array<comm_index_type>& recv_sizes,
+    const array<local_index_type>& recv_gather_idxs,
+    array<global_index_type> non_local_to_global)
+{
+    const auto num_parts = comm.size();
+    GKO_ASSERT_EQ(recv_sizes.get_size(), num_parts);
+    GKO_ASSERT_EQ(recv_gather_idxs.get_size(), non_local_to_global.get_size());
+    auto result = create(exec, num_parts, global_size, local_size);
+    result->non_local_to_global_ = std::move(non_local_to_global);
+
+    // exchange step 1: determine recv_sizes, send_sizes, send_offsets
+    exec->get_master()->copy_from(recv_sizes.get_executor(), num_parts,
+                                  recv_sizes.get_const_data(),
+                                  result->recv_sizes_.data());
+    std::partial_sum(result->recv_sizes_.begin(), result->recv_sizes_.end(),
+                     result->recv_offsets_.begin() + 1);
+    comm.all_to_all(exec, result->recv_sizes_.data(), 1,
+                    result->send_sizes_.data(), 1);
+    std::partial_sum(result->send_sizes_.begin(), result->send_sizes_.end(),
+                     result->send_offsets_.begin() + 1);
+    result->send_offsets_[0] = 0;
+    result->recv_offsets_[0] = 0;
+
+    // exchange step 2: exchange gather_idxs from receivers to senders
+    auto use_host_buffer = mpi::requires_host_buffer(exec, comm);
+    auto comm_exec = use_host_buffer ? exec->get_master() : exec;
+    auto send_gather_idxs = make_temporary_clone(comm_exec, &recv_gather_idxs);
+    array<local_index_type> gather_idxs{comm_exec,
+                                        static_cast<size_type>(
+                                            result->send_offsets_.back())};
+    comm.all_to_all_v(comm_exec, send_gather_idxs->get_const_data(),
+                      result->recv_sizes_.data(),
+                      result->recv_offsets_.data(), gather_idxs.get_data(),
+                      result->send_sizes_.data(),
+                      result->send_offsets_.data());
+    result->gather_idxs_ = std::move(gather_idxs);
+    return result;
+}
+
+
+#define GKO_DECLARE_INDEX_MAP(_local, _global) class IndexMap<_local, _global>
+GKO_INSTANTIATE_FOR_EACH_LOCAL_GLOBAL_INDEX_TYPE(GKO_DECLARE_INDEX_MAP);
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
@@ -5,6 +5,10 @@
 #include <ginkgo/core/distributed/matrix.hpp>
 
 
+#include <algorithm>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/distributed/vector.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
@@ -28,6 +32,28 @@ GKO_REGISTER_OPERATION(build_local_nonlocal,
 }  // namespace matrix
 
 
+namespace {
+
+
+/**
+ * Returns the index map itself if it is stored on exec, otherwise a copy of it
+ * on exec.
+ */
+template <typename IndexMapType>
+std::shared_ptr<const IndexMapType> share_index_map(
+    std::shared_ptr<const Executor> exec,
+    std::shared_ptr<const IndexMapType> index_map)
+{
+    if (index_map->get_executor() == exec) {
+        return index_map;
+    }
+    return gko::clone(exec, index_map);
+}
+
+
+}  // namespace
+
+
 template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
 Matrix<ValueType, LocalIndexType, GlobalIndexType>::Matrix(
     std::shared_ptr<const Executor> exec, mpi::communicator comm)
@@ -45,12 +71,7 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::Matrix(
     : EnableDistributedLinOp<
           Matrix<value_type, local_index_type, global_index_type>>{exec},
       DistributedBase{comm},
-      send_offsets_(comm.size() + 1),
-      send_sizes_(comm.size()),
-      recv_offsets_(comm.size() + 1),
-      recv_sizes_(comm.size()),
-      gather_idxs_{exec},
-      non_local_to_global_{exec},
+      index_map_{index_map_type::create(exec, comm.size())},
       one_scalar_{},
       local_mtx_{local_matrix_template->clone(exec)},
       non_local_mtx_{non_local_matrix_template->clone(exec)}
@@ -106,12 +127,8 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::convert_to(
                result->get_communicator().size());
     result->local_mtx_->copy_from(this->local_mtx_);
     result->non_local_mtx_->copy_from(this->non_local_mtx_);
-    result->gather_idxs_ = this->gather_idxs_;
-    result->send_offsets_ = this->send_offsets_;
-    result->recv_offsets_ = this->recv_offsets_;
-    result->recv_sizes_ = this->recv_sizes_;
-    result->send_sizes_ = this->send_sizes_;
-    result->non_local_to_global_ = this->non_local_to_global_;
+    result->index_map_ =
+        share_index_map(result->get_executor(), this->index_map_);
     result->set_size(this->get_size());
 }
 
@@ -125,12 +142,8 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::move_to(
                result->get_communicator().size());
     result->local_mtx_->move_from(this->local_mtx_);
     result->non_local_mtx_->move_from(this->non_local_mtx_);
-    result->gather_idxs_ = std::move(this->gather_idxs_);
-    result->send_offsets_ = std::move(this->send_offsets_);
-    result->recv_offsets_ = std::move(this->recv_offsets_);
-    result->recv_sizes_ = std::move(this->recv_sizes_);
-    result->send_sizes_ = std::move(this->send_sizes_);
-    result->non_local_to_global_ = std::move(this->non_local_to_global_);
+    result->index_map_ =
+        share_index_map(result->get_executor(), this->index_map_);
     result->set_size(this->get_size());
     this->set_size({});
 }
@@ -143,6 +156,77 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
         row_partition,
     ptr_param<const Partition<local_index_type, global_index_type>>
         col_partition)
+{
+    this->read_distributed_impl(data, row_partition.get(), col_partition.get(),
+                                nullptr);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
+    const device_matrix_data<value_type, global_index_type>& data,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        row_partition,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        col_partition,
+    std::shared_ptr<const index_map_type> index_map)
+{
+    GKO_ASSERT(index_map);
+    this->read_distributed_impl(data, row_partition.get(), col_partition.get(),
+                                std::move(index_map));
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
+    const matrix_data<value_type, global_index_type>& data,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        row_partition,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        col_partition,
+    std::shared_ptr<const index_map_type> index_map)
+{
+    this->read_distributed(
+        device_matrix_data<value_type, global_index_type>::create_from_host(
+            this->get_executor(), data),
+        row_partition, col_partition, std::move(index_map));
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::update_values(
+    const device_matrix_data<value_type, global_index_type>& data,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        row_partition,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        col_partition)
+{
+    this->read_distributed_impl(data, row_partition.get(), col_partition.get(),
+                                index_map_);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::update_values(
+    const matrix_data<value_type, global_index_type>& data,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        row_partition,
+    ptr_param<const Partition<local_index_type, global_index_type>>
+        col_partition)
+{
+    this->update_values(
+        device_matrix_data<value_type, global_index_type>::create_from_host(
+            this->get_executor(), data),
+        row_partition, col_partition);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed_impl(
+    const device_matrix_data<value_type, global_index_type>& data,
+    const Partition<local_index_type, global_index_type>* row_partition,
+    const Partition<local_index_type, global_index_type>* col_partition,
+    std::shared_ptr<const index_map_type> index_map)
 {
     const auto comm = this->get_communicator();
     GKO_ASSERT_EQ(data.get_size()[0], row_partition->get_size());
@@ -168,6 +252,7 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
     array<value_type> non_local_values{exec};
     array<local_index_type> recv_gather_idxs{exec};
     array<comm_index_type> recv_sizes_array{exec, num_parts};
+    array<global_index_type> non_local_to_global{exec};
 
     // build local, non-local matrix data and communication structures
     exec->run(matrix::make_build_local_nonlocal(
@@ -175,14 +260,36 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
         make_temporary_clone(exec, col_partition).get(), local_part,
         local_row_idxs, local_col_idxs, local_values, non_local_row_idxs,
         non_local_col_idxs, non_local_values, recv_gather_idxs,
-        recv_sizes_array, non_local_to_global_));
-
-    // read the local matrix data
+        recv_sizes_array, non_local_to_global));
     const auto num_local_rows =
         static_cast<size_type>(row_partition->get_part_size(local_part));
     const auto num_local_cols =
         static_cast<size_type>(col_partition->get_part_size(local_part));
-    const auto num_non_local_cols = non_local_to_global_.get_size();
+    if (index_map) {
+        // the non-local columns determine the whole communication pattern
+        GKO_ASSERT_EQ(index_map->get_global_size(), global_num_cols);
+        GKO_ASSERT_EQ(index_map->get_local_size(), num_local_cols);
+        const auto host_exec = exec->get_master();
+        const array<global_index_type> old_cols{
+            host_exec, index_map->get_non_local_to_global()};
+        const array<global_index_type> new_cols{host_exec,
+                                                non_local_to_global};
+        if (old_cols.get_size() != new_cols.get_size() ||
+            !std::equal(old_cols.get_const_data(),
+                        old_cols.get_const_data() + old_cols.get_size(),
+                        new_cols.get_const_data())) {
+            GKO_INVALID_STATE(
+                "The non-local columns differ from the index map");
+        }
+        index_map_ = share_index_map(exec, std::move(index_map));
+    } else {
+        index_map_ = index_map_type::build_from_non_local_columns(
+            exec, comm, global_num_cols, num_local_cols, recv_sizes_array,
+            recv_gather_idxs, std::move(non_local_to_global));
+    }
+
+    // read the local matrix data
+    const auto num_non_local_cols = index_map_->get_non_local_size();
     device_matrix_data<value_type, local_index_type> local_data{
         exec, dim<2>{num_local_rows, num_local_cols}, std::move(local_row_idxs),
         std::move(local_col_idxs), std::move(local_values)};
@@ -194,33 +301,6 @@ void Matrix<ValueType, LocalIndexType, GlobalIndexType>::read_distributed(
         ->read(std::move(local_data));
     as<ReadableFromMatrixData<ValueType, LocalIndexType>>(this->non_local_mtx_)
         ->read(std::move(non_local_data));
-
-    // exchange step 1: determine recv_sizes, send_sizes, send_offsets
-    exec->get_master()->copy_from(
-        exec, num_parts, recv_sizes_array.get_const_data(), recv_sizes_.data());
-    std::partial_sum(recv_sizes_.begin(), recv_sizes_.end(),
-                     recv_offsets_.begin() + 1);
-    comm.all_to_all(exec, recv_sizes_.data(), 1, send_sizes_.data(), 1);
-    std::partial_sum(send_sizes_.begin(), send_sizes_.end(),
-                     send_offsets_.begin() + 1);
-    send_offsets_[0] = 0;
-    recv_offsets_[0] = 0;
-
-    // exchange step 2: exchange gather_idxs from receivers to senders
-    auto use_host_buffer = mpi::requires_host_buffer(exec, comm);
-    if (use_host_buffer) {
-        recv_gather_idxs.set_executor(exec->get_master());
-        gather_idxs_.clear();
-        gather_idxs_.set_executor(exec->get_master());
-    }
-    gather_idxs_.resize_and_reset(send_offsets_.back());
-    comm.all_to_all_v(use_host_buffer ? exec->get_master() : exec,
-                      recv_gather_idxs.get_const_data(), recv_sizes_.data(),
-                      recv_offsets_.data(), gather_idxs_.get_data(),
-                      send_sizes_.data(), send_offsets_.data());
-    if (use_host_buffer) {
-        gather_idxs_.set_executor(exec);
-    }
 }
 
 
@@ -267,14 +347,18 @@ mpi::request Matrix<ValueType, LocalIndexType, GlobalIndexType>::communicate(
     auto exec = this->get_executor();
     const auto comm = this->get_communicator();
     auto num_cols = local_b->get_size()[1];
-    auto send_size = send_offsets_.back();
-    auto recv_size = recv_offsets_.back();
+    const auto& send_sizes = index_map_->get_send_sizes();
+    const auto& send_offsets = index_map_->get_send_offsets();
+    const auto& recv_sizes = index_map_->get_recv_sizes();
+    const auto& recv_offsets = index_map_->get_recv_offsets();
+    auto send_size = send_offsets.back();
+    auto recv_size = recv_offsets.back();
     auto send_dim = dim<2>{static_cast<size_type>(send_size), num_cols};
     auto recv_dim = dim<2>{static_cast<size_type>(recv_size), num_cols};
     recv_buffer_.init(exec, recv_dim);
     send_buffer_.init(exec, send_dim);
 
-    local_b->row_gather(&gather_idxs_, send_buffer_.get());
+    local_b->row_gather(&index_map_->get_gather_idxs(), send_buffer_.get());
 
     auto use_host_buffer = mpi::requires_host_buffer(exec, comm);
     if (use_host_buffer) {
@@ -291,15 +375,15 @@ mpi::request Matrix<ValueType, LocalIndexType, GlobalIndexType>::communicate(
     exec->synchronize();
 #ifdef GINKGO_FORCE_SPMV_BLOCKING_COMM
     comm.all_to_all_v(use_host_buffer ? exec->get_master() : exec, send_ptr,
-                      send_sizes_.data(), send_offsets_.data(), type.get(),
-                      recv_ptr, recv_sizes_.data(), recv_offsets_.data(),
+                      send_sizes.data(), send_offsets.data(), type.get(),
+                      recv_ptr, recv_sizes.data(), recv_offsets.data(),
                       type.get());
     return {};
 #else
     return comm.i_all_to_all_v(
         use_host_buffer ? exec->get_master() : exec, send_ptr,
-        send_sizes_.data(), send_offsets_.data(), type.get(), recv_ptr,
-        recv_sizes_.data(), recv_offsets_.data(), type.get());
+        send_sizes.data(), send_offsets.data(), type.get(), recv_ptr,
+        recv_sizes.data(), recv_offsets.data(), type.get());
 #endif
 }
 
@@ -402,12 +486,7 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::operator=(
         this->set_size(other.get_size());
         local_mtx_->copy_from(other.local_mtx_);
         non_local_mtx_->copy_from(other.non_local_mtx_);
-        gather_idxs_ = other.gather_idxs_;
-        send_offsets_ = other.send_offsets_;
-        recv_offsets_ = other.recv_offsets_;
-        send_sizes_ = other.send_sizes_;
-        recv_sizes_ = other.recv_sizes_;
-        non_local_to_global_ = other.non_local_to_global_;
+        index_map_ = share_index_map(this->get_executor(), other.index_map_);
         one_scalar_.init(this->get_executor(), dim<2>{1, 1});
         one_scalar_->fill(one<value_type>());
     }
@@ -426,12 +505,7 @@ Matrix<ValueType, LocalIndexType, GlobalIndexType>::operator=(Matrix&& other)
         other.set_size({});
         local_mtx_->move_from(other.local_mtx_);
         non_local_mtx_->move_from(other.non_local_mtx_);
-        gather_idxs_ = std::move(other.gather_idxs_);
-        send_offsets_ = std::move(other.send_offsets_);
-        recv_offsets_ = std::move(other.recv_offsets_);
-        send_sizes_ = std::move(other.send_sizes_);
-        recv_sizes_ = std::move(other.recv_sizes_);
-        non_local_to_global_ = std::move(other.non_local_to_global_);
+        index_map_ = share_index_map(this->get_executor(), other.index_map_);
         one_scalar_.init(this->get_executor(), dim<2>{1, 1});
         one_scalar_->fill(one<value_type>());
     }
@@ -5,10 +5,23 @@
 #include <ginkgo/core/distributed/partition_helpers.hpp>
 
 
+#include <algorithm>
+#include <array>
 #include <numeric>
+#include <string>
+#include <vector>
 
 
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/temporary_clone.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
 #include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+
+
+#if GKO_HAVE_METIS
+#include GKO_METIS_HEADER
+#endif
 
 
 #include "core/components/fill_array_kernels.hpp"
@@ -44,6 +57,191 @@ GKO_REGISTER_OPERATION(compress_ranges, partition_helpers::compress_ranges);
 }  // namespace partition_helpers
 
 
+namespace {
+
+
+#if GKO_HAVE_METIS
+
+
+/**
+ * Computes a k-way partition of the symmetrized graph of a matrix without its
+ * diagonal using METIS.
+ */
+template <typename ValueType, typename GlobalIndexType>
+std::vector<comm_index_type> metis_partition(
+    const matrix_data<ValueType, GlobalIndexType>& graph,
+    comm_index_type num_parts, const std::unordered_map<int, int>& options)
+{
+    const auto num_rows = graph.size[0];
+    std::vector<std::pair<idx_t, idx_t>> edges;
+    for (const auto& entry : graph.nonzeros) {
+        if (entry.row != entry.column) {
+            edges.emplace_back(entry.row, entry.column);
+            edges.emplace_back(entry.column, entry.row);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    std::vector<idx_t> row_ptrs(num_rows + 1);
+    std::vector<idx_t> col_idxs(edges.size());
+    for (size_type i = 0; i < edges.size(); i++) {
+        row_ptrs[edges[i].first + 1]++;
+        col_idxs[i] = edges[i].second;
+    }
+    std::partial_sum(row_ptrs.begin(), row_ptrs.end(), row_ptrs.begin());
+    std::array<idx_t, METIS_NOPTIONS> metis_options{};
+    METIS_SetDefaultOptions(metis_options.data());
+    for (auto pair : options) {
+        if (pair.first < 0 || pair.first >= METIS_NOPTIONS) {
+            throw MetisError(__FILE__, __LINE__, "metis_partition",
+                             "Invalid option ID " + std::to_string(pair.first));
+        }
+        metis_options[pair.first] = pair.second;
+    }
+    metis_options[METIS_OPTION_NUMBERING] = 0;
+    std::vector<comm_index_type> mapping(num_rows, 0);
+    if (num_parts == 1 || num_rows == 0) {
+        return mapping;
+    }
+    auto nvtxs = static_cast<idx_t>(num_rows);
+    idx_t ncon = 1;
+    auto nparts = static_cast<idx_t>(num_parts);
+    idx_t edge_cut{};
+    std::vector<idx_t> part(num_rows);
+    auto result = METIS_PartGraphKway(
+        &nvtxs, &ncon, row_ptrs.data(), col_idxs.data(), nullptr, nullptr,
+        nullptr, &nparts, nullptr, nullptr, metis_options.data(), &edge_cut,
+        part.data());
+    if (result != METIS_OK) {
+        throw MetisError(__FILE__, __LINE__, "METIS_PartGraphKway",
+                         "<" + std::to_string(result) + ">");
+    }
+    std::copy(part.begin(), part.end(), mapping.begin());
+    return mapping;
+}
+
+
+#endif
+
+
+/**
+ * Returns the global indices of the local indices of a part.
+ */
+template <typename LocalIndexType, typename GlobalIndexType>
+std::vector<GlobalIndexType> compute_local_to_global(
+    const Partition<LocalIndexType, GlobalIndexType>* partition,
+    comm_index_type part)
+{
+    auto host_partition = make_temporary_clone(
+        partition->get_executor()->get_master(), partition);
+    const auto range_bounds = host_partition->get_range_bounds();
+    const auto part_ids = host_partition->get_part_ids();
+    const auto starting_indices = host_partition->get_range_starting_indices();
+    std::vector<GlobalIndexType> result(host_partition->get_part_size(part));
+    for (size_type range = 0; range < host_partition->get_num_ranges();
+         range++) {
+        if (part_ids[range] == part) {
+            auto begin = result.begin() + starting_indices[range];
+            std::iota(begin,
+                      begin + (range_bounds[range + 1] - range_bounds[range]),
+                      range_bounds[range]);
+        }
+    }
+    return result;
+}
+
+
+/**
+ * Returns the part owning the row of each entry.
+ */
+template <typename ValueType, typename LocalIndexType,
+          typename GlobalIndexType>
+std::vector<comm_index_type> find_row_parts(
+    const Partition<LocalIndexType, GlobalIndexType>* partition,
+    const matrix_data<ValueType, GlobalIndexType>& data)
+{
+    auto host_partition = make_temporary_clone(
+        partition->get_executor()->get_master(), partition);
+    const auto range_bounds = host_partition->get_range_bounds();
+    const auto part_ids = host_partition->get_part_ids();
+    const auto num_ranges = host_partition->get_num_ranges();
+    std::vector<comm_index_type> result;
+    result.reserve(data.nonzeros.size());
+    for (const auto& entry : data.nonzeros) {
+        auto range = std::upper_bound(range_bounds + 1,
+                                      range_bounds + num_ranges + 1,
+                                      entry.row) -
+                     (range_bounds + 1);
+        result.push_back(part_ids[range]);
+    }
+    return result;
+}
+
+
+/**
+ * Sends each entry to its target process and returns the entries received
+ * from all processes. This needs to be called collectively.
+ */
+template <typename ValueType, typename GlobalIndexType>
+matrix_data<ValueType, GlobalIndexType> exchange_entries(
+    std::shared_ptr<const Executor> host_exec, mpi::communicator comm,
+    const matrix_data<ValueType, GlobalIndexType>& data,
+    const std::vector<comm_index_type>& targets)
+{
+    const auto num_parts = comm.size();
+    const auto nnz = data.nonzeros.size();
+    std::vector<size_type> order(nnz);
+    std::iota(order.begin(), order.end(), size_type{});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_type a, size_type b) {
+                         return targets[a] < targets[b];
+                     });
+    std::vector<comm_index_type> send_sizes(num_parts);
+    std::vector<comm_index_type> send_offsets(num_parts + 1);
+    std::vector<comm_index_type> recv_sizes(num_parts);
+    std::vector<comm_index_type> recv_offsets(num_parts + 1);
+    std::vector<GlobalIndexType> send_rows(nnz);
+    std::vector<GlobalIndexType> send_cols(nnz);
+    std::vector<ValueType> send_vals(nnz);
+    for (size_type i = 0; i < nnz; i++) {
+        const auto& entry = data.nonzeros[order[i]];
+        send_sizes[targets[order[i]]]++;
+        send_rows[i] = entry.row;
+        send_cols[i] = entry.column;
+        send_vals[i] = entry.value;
+    }
+    comm.all_to_all(host_exec, send_sizes.data(), 1, recv_sizes.data(), 1);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     send_offsets.begin() + 1);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     recv_offsets.begin() + 1);
+    const auto recv_nnz = static_cast<size_type>(recv_offsets.back());
+    std::vector<GlobalIndexType> recv_rows(recv_nnz);
+    std::vector<GlobalIndexType> recv_cols(recv_nnz);
+    std::vector<ValueType> recv_vals(recv_nnz);
+    comm.all_to_all_v(host_exec, send_rows.data(), send_sizes.data(),
+                      send_offsets.data(), recv_rows.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    comm.all_to_all_v(host_exec, send_cols.data(), send_sizes.data(),
+                      send_offsets.data(), recv_cols.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    comm.all_to_all_v(host_exec, send_vals.data(), send_sizes.data(),
+                      send_offsets.data(), recv_vals.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    matrix_data<ValueType, GlobalIndexType> result{data.size};
+    result.nonzeros.reserve(recv_nnz);
+    for (size_type i = 0; i < recv_nnz; i++) {
+        result.nonzeros.emplace_back(recv_rows[i], recv_cols[i], recv_vals[i]);
+    }
+    // the distributed read expects the entries in row-major order
+    result.sort_row_major();
+    return result;
+}
+
+
+}  // namespace
+
+
 template <typename LocalIndexType, typename GlobalIndexType>
 std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
 build_partition_from_local_range(std::shared_ptr<const Executor> exec,
@@ -122,6 +320,155 @@ GKO_INSTANTIATE_FOR_EACH_LOCAL_GLOBAL_INDEX_TYPE(
     GKO_DECLARE_BUILD_PARTITION_FROM_LOCAL_SIZE);
 
 
+#if GKO_HAVE_METIS
+
+
+template <typename LocalIndexType, typename GlobalIndexType, typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(std::shared_ptr<const Executor> exec,
+                           mpi::communicator comm,
+                           const matrix_data<ValueType, GlobalIndexType>& graph,
+                           const std::unordered_map<int, int>& options)
+{
+    // compute the partition on a single process to make it consistent
+    auto host_exec = exec->get_master();
+    auto global_size = static_cast<int64>(graph.size[0]);
+    comm.broadcast(host_exec, &global_size, 1, 0);
+    array<comm_index_type> mapping{host_exec,
+                                   static_cast<size_type>(global_size)};
+    if (comm.rank() == 0) {
+        auto parts = metis_partition(graph, comm.size(), options);
+        std::copy(parts.begin(), parts.end(), mapping.get_data());
+    }
+    comm.broadcast(host_exec, mapping.get_data(),
+                   static_cast<int>(global_size), 0);
+    mapping.set_executor(exec);
+    return Partition<LocalIndexType, GlobalIndexType>::build_from_mapping(
+        exec, mapping, comm.size());
+}
+
+
+#else
+
+
+template <typename LocalIndexType, typename GlobalIndexType, typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(std::shared_ptr<const Executor> exec,
+                           mpi::communicator comm,
+                           const matrix_data<ValueType, GlobalIndexType>& graph,
+                           const std::unordered_map<int, int>& options)
+    GKO_NOT_COMPILED(metis);
+
+
+#endif
+
+
+#define GKO_DECLARE_BUILD_PARTITION_FROM_GRAPH(_value_type, _local_type, \
+                                               _global_type)             \
+    std::unique_ptr<Partition<_local_type, _global_type>>                \
+    build_partition_from_graph(                                          \
+        std::shared_ptr<const Executor> exec, mpi::communicator comm,    \
+        const matrix_data<_value_type, _global_type>& graph,             \
+        const std::unordered_map<int, int>& options)
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_BUILD_PARTITION_FROM_GRAPH);
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<Matrix<ValueType, LocalIndexType, GlobalIndexType>>
+redistribute(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx,
+    const Partition<LocalIndexType, GlobalIndexType>* row_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* col_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_row_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_col_partition)
+{
+    using local_data_type = matrix_data<ValueType, LocalIndexType>;
+    using writable_type = WritableToMatrixData<ValueType, LocalIndexType>;
+    auto exec = mtx->get_executor();
+    auto host_exec = exec->get_master();
+    auto comm = mtx->get_communicator();
+    const auto row_map = compute_local_to_global(row_partition, comm.rank());
+    const auto col_map = compute_local_to_global(col_partition, comm.rank());
+    const array<GlobalIndexType> non_local_map{
+        host_exec, mtx->get_index_map()->get_non_local_to_global()};
+    local_data_type local_data;
+    local_data_type non_local_data;
+    as<writable_type>(mtx->get_local_matrix())->write(local_data);
+    as<writable_type>(mtx->get_non_local_matrix())->write(non_local_data);
+
+    // collect the local entries in global numbering
+    matrix_data<ValueType, GlobalIndexType> data{mtx->get_size()};
+    for (const auto& entry : local_data.nonzeros) {
+        data.nonzeros.emplace_back(row_map[entry.row], col_map[entry.column],
+                                   entry.value);
+    }
+    for (const auto& entry : non_local_data.nonzeros) {
+        data.nonzeros.emplace_back(
+            row_map[entry.row], non_local_map.get_const_data()[entry.column],
+            entry.value);
+    }
+    auto new_data = exchange_entries(host_exec, comm, data,
+                                     find_row_parts(new_row_partition, data));
+
+    auto result = Matrix<ValueType, LocalIndexType, GlobalIndexType>::create(
+        exec, comm, mtx->get_local_matrix(), mtx->get_non_local_matrix());
+    result->read_distributed(new_data, new_row_partition, new_col_partition);
+    return result;
+}
+
+#define GKO_DECLARE_REDISTRIBUTE_MATRIX(_value_type, _local_type,      \
+                                        _global_type)                  \
+    std::unique_ptr<Matrix<_value_type, _local_type, _global_type>>    \
+    redistribute(                                                      \
+        const Matrix<_value_type, _local_type, _global_type>* mtx,     \
+        const Partition<_local_type, _global_type>* row_partition,     \
+        const Partition<_local_type, _global_type>* col_partition,     \
+        const Partition<_local_type, _global_type>* new_row_partition, \
+        const Partition<_local_type, _global_type>* new_col_partition)
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_REDISTRIBUTE_MATRIX);
+
+
+template <typename LocalIndexType, typename GlobalIndexType, typename ValueType>
+std::unique_ptr<Vector<ValueType>> redistribute(
+    const Vector<ValueType>* vec,
+    const Partition<LocalIndexType, GlobalIndexType>* partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_partition)
+{
+    auto exec = vec->get_executor();
+    auto host_exec = exec->get_master();
+    auto comm = vec->get_communicator();
+    const auto row_map = compute_local_to_global(partition, comm.rank());
+    auto local_vec = make_temporary_clone(host_exec, vec->get_local_vector());
+    const auto local_size = local_vec->get_size();
+
+    // collect the local entries in global numbering
+    matrix_data<ValueType, GlobalIndexType> data{vec->get_size()};
+    for (size_type row = 0; row < local_size[0]; row++) {
+        for (size_type col = 0; col < local_size[1]; col++) {
+            data.nonzeros.emplace_back(row_map[row], col,
+                                       local_vec->at(row, col));
+        }
+    }
+    auto new_data = exchange_entries(host_exec, comm, data,
+                                     find_row_parts(new_partition, data));
+
+    auto result = Vector<ValueType>::create(exec, comm);
+    result->read_distributed(new_data, new_partition);
+    return result;
+}
+
+#define GKO_DECLARE_REDISTRIBUTE_VECTOR(_value_type, _local_type, \
+                                        _global_type)             \
+    std::unique_ptr<Vector<_value_type>> redistribute(            \
+        const Vector<_value_type>* vec,                           \
+        const Partition<_local_type, _global_type>* partition,    \
+        const Partition<_local_type, _global_type>* new_partition)
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_LOCAL_GLOBAL_INDEX_TYPE(
+    GKO_DECLARE_REDISTRIBUTE_VECTOR);
+
+
 }  // namespace distributed
 }  // namespace experimental
 }  // namespace gko
@@ -5,12 +5,17 @@
 #include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
 
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <vector>
 
 
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/executor.hpp>
 #include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/base/mpi.hpp>
 #include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/base/temporary_conversion.hpp>
 #include <ginkgo/core/base/utils.hpp>
@@ -27,6 +32,106 @@ namespace gko {
 namespace experimental {
 namespace distributed {
 namespace preconditioner {
+namespace {
+
+
+/**
+ * Returns the process owning the global row idx, given the row offsets of all
+ * processes.
+ */
+template <typename GlobalIndexType>
+comm_index_type find_owner(const std::vector<GlobalIndexType>& offsets,
+                           GlobalIndexType idx)
+{
+    return static_cast<comm_index_type>(
+        std::upper_bound(offsets.begin() + 1, offsets.end(), idx) -
+        (offsets.begin() + 1));
+}
+
+
+/**
+ * Fetches the rows with the given sorted global indices from their owners.
+ * The rows of this process are given by own_data with the row pointers
+ * own_row_ptrs. This needs to be called collectively.
+ *
+ * @return  the entries of the requested rows in global numbering.
+ */
+template <typename ValueType, typename GlobalIndexType>
+std::vector<matrix_data_entry<ValueType, GlobalIndexType>> fetch_rows(
+    std::shared_ptr<const Executor> host_exec, mpi::communicator comm,
+    const std::vector<GlobalIndexType>& offsets,
+    const matrix_data<ValueType, GlobalIndexType>& own_data,
+    const std::vector<size_type>& own_row_ptrs,
+    const std::vector<GlobalIndexType>& rows)
+{
+    const auto num_parts = comm.size();
+    const auto offset = offsets[comm.rank()];
+    // exchange the requested row indices
+    std::vector<comm_index_type> request_sizes(num_parts);
+    std::vector<comm_index_type> request_offsets(num_parts + 1);
+    std::vector<comm_index_type> serve_sizes(num_parts);
+    std::vector<comm_index_type> serve_offsets(num_parts + 1);
+    for (auto row : rows) {
+        request_sizes[find_owner(offsets, row)]++;
+    }
+    comm.all_to_all(host_exec, request_sizes.data(), 1, serve_sizes.data(),
+                    1);
+    std::partial_sum(request_sizes.begin(), request_sizes.end(),
+                     request_offsets.begin() + 1);
+    std::partial_sum(serve_sizes.begin(), serve_sizes.end(),
+                     serve_offsets.begin() + 1);
+    std::vector<GlobalIndexType> serve_rows(serve_offsets.back());
+    comm.all_to_all_v(host_exec, rows.data(), request_sizes.data(),
+                      request_offsets.data(), serve_rows.data(),
+                      serve_sizes.data(), serve_offsets.data());
+    // send the entries of the requested rows back
+    std::vector<comm_index_type> send_sizes(num_parts);
+    std::vector<comm_index_type> send_offsets(num_parts + 1);
+    std::vector<comm_index_type> recv_sizes(num_parts);
+    std::vector<comm_index_type> recv_offsets(num_parts + 1);
+    std::vector<GlobalIndexType> send_rows;
+    std::vector<GlobalIndexType> send_cols;
+    std::vector<ValueType> send_vals;
+    for (comm_index_type part = 0; part < num_parts; part++) {
+        for (auto i = serve_offsets[part]; i < serve_offsets[part + 1]; i++) {
+            const auto local_row = serve_rows[i] - offset;
+            for (auto nz = own_row_ptrs[local_row];
+                 nz < own_row_ptrs[local_row + 1]; nz++) {
+                const auto& entry = own_data.nonzeros[nz];
+                send_rows.push_back(entry.row);
+                send_cols.push_back(entry.column);
+                send_vals.push_back(entry.value);
+            }
+        }
+        send_offsets[part + 1] = static_cast<comm_index_type>(send_rows.size());
+        send_sizes[part] = send_offsets[part + 1] - send_offsets[part];
+    }
+    comm.all_to_all(host_exec, send_sizes.data(), 1, recv_sizes.data(), 1);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     recv_offsets.begin() + 1);
+    const auto recv_nnz = static_cast<size_type>(recv_offsets.back());
+    std::vector<GlobalIndexType> recv_rows(recv_nnz);
+    std::vector<GlobalIndexType> recv_cols(recv_nnz);
+    std::vector<ValueType> recv_vals(recv_nnz);
+    comm.all_to_all_v(host_exec, send_rows.data(), send_sizes.data(),
+                      send_offsets.data(), recv_rows.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    comm.all_to_all_v(host_exec, send_cols.data(), send_sizes.data(),
+                      send_offsets.data(), recv_cols.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    comm.all_to_all_v(host_exec, send_vals.data(), send_sizes.data(),
+                      send_offsets.data(), recv_vals.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    std::vector<matrix_data_entry<ValueType, GlobalIndexType>> result;
+    result.reserve(recv_nnz);
+    for (size_type i = 0; i < recv_nnz; i++) {
+        result.emplace_back(recv_rows[i], recv_cols[i], recv_vals[i]);
+    }
+    return result;
+}
+
+
+}  // namespace
 
 
 template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
@@ -47,11 +152,111 @@ void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::apply_dense_impl(
     const VectorType* dense_b, VectorType* dense_x) const
 {
     using Vector = matrix::Dense<ValueType>;
+    using dist_vec_type = distributed::Vector<ValueType>;
+    using dist_mtx_type = Matrix<ValueType, LocalIndexType, GlobalIndexType>;
+    if (this->coarse_level_ == nullptr) {
+        this->apply_local_impl(dense_b, dense_x);
+        return;
+    }
     auto exec = this->get_executor();
-    if (this->local_solver_ != nullptr) {
+    const auto comm = as<DistributedBase>(dense_b)->get_communicator();
+    const auto num_cols = dense_b->get_size()[1];
+    auto coarse_op = this->coarse_level_->get_coarse_op();
+    auto coarse_dim = dim<2>{coarse_op->get_size()[0], num_cols};
+    auto coarse_local_dim = dim<2>{
+        as<dist_mtx_type>(coarse_op)->get_local_matrix()->get_size()[0],
+        num_cols};
+    auto coarse_b =
+        dist_vec_type::create(exec, comm, coarse_dim, coarse_local_dim);
+    auto coarse_x =
+        dist_vec_type::create(exec, comm, coarse_dim, coarse_local_dim);
+    auto coarse_correction = gko::detail::create_with_config_of(dense_x);
+    auto one = initialize<Vector>({gko::one<ValueType>()}, exec);
+    auto neg_one = initialize<Vector>({-gko::one<ValueType>()}, exec);
+
+    this->coarse_level_->get_restrict_op()->apply(dense_b, coarse_b);
+    coarse_x->fill(zero<ValueType>());
+    this->coarse_solver_->apply(coarse_b, coarse_x);
+    this->coarse_level_->get_prolong_op()->apply(coarse_x, coarse_correction);
+    if (parameters_.coarse_correction ==
+        coarse_correction_type::multiplicative) {
+        auto residual = dense_b->clone();
+        this->system_matrix_->apply(neg_one, coarse_correction, one, residual);
+        this->apply_local_impl(residual.get(), dense_x);
+    } else {
+        this->apply_local_impl(dense_b, dense_x);
+    }
+    dense_x->add_scaled(one, coarse_correction);
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+template <typename VectorType>
+void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::apply_local_impl(
+    const VectorType* dense_b, VectorType* dense_x) const
+{
+    auto exec = this->get_executor();
+    if (this->local_solver_ == nullptr) {
+        return;
+    }
+    if (this->overlap_map_ == nullptr) {
         this->local_solver_->apply(gko::detail::get_local(dense_b),
                                    gko::detail::get_local(dense_x));
+        return;
+    }
+    const auto local_b = gko::detail::get_local(dense_b);
+    auto local_x = gko::detail::get_local(dense_x);
+    const auto comm = as<DistributedBase>(dense_b)->get_communicator();
+    const auto num_cols = local_b->get_size()[1];
+    const auto local_size = local_b->get_size()[0];
+    const auto overlap_size =
+        local_size + this->overlap_map_->get_non_local_size();
+    const auto& send_offsets = this->overlap_map_->get_send_offsets();
+    const auto& recv_offsets = this->overlap_map_->get_recv_offsets();
+    auto send_dim =
+        dim<2>{static_cast<size_type>(send_offsets.back()), num_cols};
+    auto recv_dim =
+        dim<2>{static_cast<size_type>(recv_offsets.back()), num_cols};
+    send_buffer_.init(exec, send_dim);
+    recv_buffer_.init(exec, recv_dim);
+
+    // fetch the right-hand side on the overlapping rows
+    local_b->row_gather(&this->overlap_map_->get_gather_idxs(),
+                        send_buffer_.get());
+    auto use_host_buffer = mpi::requires_host_buffer(exec, comm);
+    if (use_host_buffer) {
+        host_send_buffer_.init(exec->get_master(), send_dim);
+        host_recv_buffer_.init(exec->get_master(), recv_dim);
+        host_send_buffer_->copy_from(send_buffer_.get());
+    }
+    mpi::contiguous_type type(num_cols, mpi::type_impl<ValueType>::get_type());
+    exec->synchronize();
+    comm.all_to_all_v(
+        use_host_buffer ? exec->get_master() : exec,
+        use_host_buffer ? host_send_buffer_->get_const_values()
+                        : send_buffer_->get_const_values(),
+        this->overlap_map_->get_send_sizes().data(), send_offsets.data(),
+        type.get(),
+        use_host_buffer ? host_recv_buffer_->get_values()
+                        : recv_buffer_->get_values(),
+        this->overlap_map_->get_recv_sizes().data(), recv_offsets.data(),
+        type.get());
+    if (use_host_buffer) {
+        recv_buffer_->copy_from(host_recv_buffer_.get());
     }
+    overlap_b_.init(exec, dim<2>{overlap_size, num_cols});
+    overlap_x_.init(exec, dim<2>{overlap_size, num_cols});
+    overlap_b_->create_submatrix(span{0, local_size}, span{0, num_cols})
+        ->copy_from(local_b);
+    overlap_b_
+        ->create_submatrix(span{local_size, overlap_size}, span{0, num_cols})
+        ->copy_from(recv_buffer_.get());
+
+    // solve on the overlapping subdomain and keep only the owned rows
+    overlap_x_->fill(zero<ValueType>());
+    this->local_solver_->apply(overlap_b_.get(), overlap_x_.get());
+    local_x->copy_from(
+        overlap_x_->create_submatrix(span{0, local_size}, span{0, num_cols}));
 }
 
 
@@ -98,15 +303,183 @@ void Schwarz<ValueType, LocalIndexType, GlobalIndexType>::generate(
             "Requires either a generated solver or an solver factory");
     }
 
+    if (parameters_.overlap > 0 && !parameters_.local_solver) {
+        GKO_INVALID_STATE("Overlap requires a solver factory");
+    }
+
     if (parameters_.local_solver) {
-        this->set_solver(gko::share(parameters_.local_solver->generate(
-            as<experimental::distributed::Matrix<
-                ValueType, LocalIndexType, GlobalIndexType>>(system_matrix)
-                ->get_local_matrix())));
+        auto dist_mtx = as<experimental::distributed::Matrix<
+            ValueType, LocalIndexType, GlobalIndexType>>(system_matrix);
+        auto local_mtx = parameters_.overlap > 0
+                             ? this->generate_overlap(dist_mtx.get())
+                             : dist_mtx->get_local_matrix();
+        this->set_solver(
+            gko::share(parameters_.local_solver->generate(local_mtx)));
 
     } else {
         this->set_solver(parameters_.generated_local_solver);
     }
+
+    if (static_cast<bool>(parameters_.coarse_level) !=
+        static_cast<bool>(parameters_.coarse_solver)) {
+        GKO_INVALID_STATE(
+            "Requires both a coarse level and a coarse solver factory");
+    }
+
+    if (parameters_.coarse_level) {
+        this->system_matrix_ = system_matrix;
+        this->coarse_level_ = as<gko::multigrid::MultigridLevel>(
+            share(parameters_.coarse_level->generate(system_matrix)));
+        this->coarse_solver_ = share(parameters_.coarse_solver->generate(
+            this->coarse_level_->get_coarse_op()));
+    }
+}
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::shared_ptr<const LinOp>
+Schwarz<ValueType, LocalIndexType, GlobalIndexType>::generate_overlap(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* system_matrix)
+{
+    using csr_type = matrix::Csr<ValueType, LocalIndexType>;
+    using index_map_type = IndexMap<LocalIndexType, GlobalIndexType>;
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    auto comm = system_matrix->get_communicator();
+    const auto rank = comm.rank();
+    const auto num_parts = comm.size();
+    const auto global_size = system_matrix->get_size()[0];
+    auto local_mtx = convert_to_with_sorting<csr_type>(
+        host_exec, system_matrix->get_local_matrix(), true);
+    auto non_local_mtx = convert_to_with_sorting<csr_type>(
+        host_exec, system_matrix->get_non_local_matrix(), true);
+    const auto local_size = local_mtx->get_size()[0];
+
+    // number the rows consecutively by their owning process
+    std::vector<GlobalIndexType> offsets(num_parts + 1);
+    const auto local_size_global = static_cast<GlobalIndexType>(local_size);
+    comm.all_gather(host_exec, &local_size_global, 1, offsets.data() + 1, 1);
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    const auto offset = offsets[rank];
+    auto index_map = system_matrix->get_index_map();
+    const array<LocalIndexType> gather_idxs{host_exec,
+                                            index_map->get_gather_idxs()};
+    std::vector<GlobalIndexType> send_cols(gather_idxs.get_size());
+    for (size_type i = 0; i < send_cols.size(); i++) {
+        send_cols[i] = gather_idxs.get_const_data()[i] + offset;
+    }
+    std::vector<GlobalIndexType> non_local_cols(
+        index_map->get_non_local_size());
+    comm.all_to_all_v(host_exec, send_cols.data(),
+                      index_map->get_send_sizes().data(),
+                      index_map->get_send_offsets().data(),
+                      non_local_cols.data(),
+                      index_map->get_recv_sizes().data(),
+                      index_map->get_recv_offsets().data());
+
+    // the owned rows in this numbering
+    matrix_data<ValueType, GlobalIndexType> own_data{
+        dim<2>{global_size, global_size}};
+    std::vector<size_type> own_row_ptrs(local_size + 1);
+    for (size_type row = 0; row < local_size; row++) {
+        const auto global_row = static_cast<GlobalIndexType>(row) + offset;
+        for (auto nz = local_mtx->get_const_row_ptrs()[row];
+             nz < local_mtx->get_const_row_ptrs()[row + 1]; nz++) {
+            own_data.nonzeros.emplace_back(
+                global_row, local_mtx->get_const_col_idxs()[nz] + offset,
+                local_mtx->get_const_values()[nz]);
+        }
+        for (auto nz = non_local_mtx->get_const_row_ptrs()[row];
+             nz < non_local_mtx->get_const_row_ptrs()[row + 1]; nz++) {
+            own_data.nonzeros.emplace_back(
+                global_row,
+                non_local_cols[non_local_mtx->get_const_col_idxs()[nz]],
+                non_local_mtx->get_const_values()[nz]);
+        }
+        own_row_ptrs[row + 1] = own_data.nonzeros.size();
+    }
+
+    // add the rows of the neighboring subdomains layer by layer, where each
+    // layer consists of the new columns of the previous layer
+    auto is_owned = [&](GlobalIndexType idx) {
+        return idx >= offset &&
+               idx < offset + static_cast<GlobalIndexType>(local_size);
+    };
+    std::vector<GlobalIndexType> overlap_rows;
+    std::vector<matrix_data_entry<ValueType, GlobalIndexType>> overlap_entries;
+    std::vector<GlobalIndexType> layer = non_local_cols;
+    std::sort(layer.begin(), layer.end());
+    for (size_type level = 0; level < parameters_.overlap; level++) {
+        auto layer_entries = fetch_rows(host_exec, comm, offsets, own_data,
+                                        own_row_ptrs, layer);
+        std::vector<GlobalIndexType> merged(overlap_rows.size() +
+                                            layer.size());
+        std::merge(overlap_rows.begin(), overlap_rows.end(), layer.begin(),
+                   layer.end(), merged.begin());
+        overlap_rows = std::move(merged);
+        layer.clear();
+        for (const auto& entry : layer_entries) {
+            if (!is_owned(entry.column) &&
+                !std::binary_search(overlap_rows.begin(), overlap_rows.end(),
+                                    entry.column)) {
+                layer.push_back(entry.column);
+            }
+        }
+        std::sort(layer.begin(), layer.end());
+        layer.erase(std::unique(layer.begin(), layer.end()), layer.end());
+        overlap_entries.insert(overlap_entries.end(), layer_entries.begin(),
+                               layer_entries.end());
+    }
+
+    // local numbering: the owned rows, followed by the overlapping rows
+    const auto num_overlap_rows = overlap_rows.size();
+    auto map_to_local = [&](GlobalIndexType idx) -> LocalIndexType {
+        if (is_owned(idx)) {
+            return static_cast<LocalIndexType>(idx - offset);
+        }
+        auto it =
+            std::lower_bound(overlap_rows.begin(), overlap_rows.end(), idx);
+        if (it == overlap_rows.end() || *it != idx) {
+            return invalid_index<LocalIndexType>();
+        }
+        return static_cast<LocalIndexType>(local_size +
+                                           (it - overlap_rows.begin()));
+    };
+    matrix_data<ValueType, LocalIndexType> overlap_data{
+        dim<2>{local_size + num_overlap_rows, local_size + num_overlap_rows}};
+    // couplings to rows outside of the overlapping subdomain are dropped
+    auto add_entry = [&](const matrix_data_entry<ValueType, GlobalIndexType>&
+                             entry) {
+        const auto col = map_to_local(entry.column);
+        if (col != invalid_index<LocalIndexType>()) {
+            overlap_data.nonzeros.emplace_back(map_to_local(entry.row), col,
+                                               entry.value);
+        }
+    };
+    std::for_each(own_data.nonzeros.begin(), own_data.nonzeros.end(),
+                  add_entry);
+    std::for_each(overlap_entries.begin(), overlap_entries.end(), add_entry);
+    overlap_data.sort_row_major();
+    auto overlap_mtx = share(csr_type::create(exec));
+    overlap_mtx->read(overlap_data);
+
+    // the overlapping rows are received from their owners on application
+    array<comm_index_type> recv_sizes{host_exec,
+                                      static_cast<size_type>(num_parts)};
+    array<LocalIndexType> recv_gather_idxs{host_exec, num_overlap_rows};
+    array<GlobalIndexType> non_local_to_global{host_exec, num_overlap_rows};
+    recv_sizes.fill(0);
+    for (size_type i = 0; i < num_overlap_rows; i++) {
+        const auto owner = find_owner(offsets, overlap_rows[i]);
+        recv_sizes.get_data()[owner]++;
+        recv_gather_idxs.get_data()[i] =
+            static_cast<LocalIndexType>(overlap_rows[i] - offsets[owner]);
+        non_local_to_global.get_data()[i] = overlap_rows[i];
+    }
+    this->overlap_map_ = index_map_type::build_from_non_local_columns(
+        exec, comm, global_size, local_size, recv_sizes, recv_gather_idxs,
+        array<GlobalIndexType>{exec, std::move(non_local_to_global)});
+    return overlap_mtx;
 }
 
 
@@ -0,0 +1,299 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/log/memory_tracker.hpp>
+
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/name_demangling.hpp>
+
+
+namespace gko {
+namespace log {
+namespace {
+
+
+std::string format_bytes(size_type bytes)
+{
+    std::stringstream ss;
+    if (bytes < 1024) {
+        ss << bytes << " B";
+        return ss.str();
+    }
+    const char* units[] = {"KiB", "MiB", "GiB", "TiB"};
+    auto value = bytes / 1024.0;
+    int unit = 0;
+    while (value >= 1024.0 && unit < 3) {
+        value /= 1024.0;
+        unit++;
+    }
+    ss << std::setprecision(1) << std::fixed << value << ' ' << units[unit];
+    return ss.str();
+}
+
+
+void print_table(std::ostream& output, const std::vector<std::string>& headers,
+                 const std::vector<std::vector<std::string>>& table)
+{
+    std::vector<std::size_t> widths(headers.size());
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        widths[i] = headers[i].size();
+        for (const auto& row : table) {
+            widths[i] = std::max(widths[i], row[i].size());
+        }
+    }
+    output << '|';
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        output << ' ' << std::setw(widths[i]) << std::left << headers[i]
+               << " |";
+    }
+    output << "\n|";
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        output << std::string(widths[i] + 1, '-') << (i == 0 ? "-|" : ":|");
+    }
+    output << '\n';
+    for (const auto& row : table) {
+        output << '|';
+        for (std::size_t i = 0; i < row.size(); i++) {
+            output << ' ' << std::setw(widths[i])
+                   << (i == 0 ? std::left : std::right) << row[i] << " |";
+        }
+        output << '\n';
+    }
+    output << std::right;
+}
+
+
+}  // namespace
+
+
+MemoryTracker::MemoryTracker() : Logger(mask_) {}
+
+
+void MemoryTracker::begin(std::string name) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    auto it = operation_map_.find(name);
+    if (it == operation_map_.end()) {
+        const auto new_id = static_cast<int64>(operations_.size());
+        it = operation_map_.emplace_hint(it, name, new_id);
+        operations_.emplace_back();
+        operations_.back().name = std::move(name);
+    }
+    operations_[it->second].count++;
+    stack_.push_back(it->second);
+}
+
+
+void MemoryTracker::end() const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    // the logger may have been added during an operation
+    if (!stack_.empty()) {
+        stack_.pop_back();
+    }
+}
+
+
+void MemoryTracker::on_allocation_completed(const Executor* exec,
+                                            const size_type& num_bytes,
+                                            const uintptr& location) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    auto it = executor_map_.find(exec);
+    if (it == executor_map_.end()) {
+        const auto new_id = static_cast<int64>(executors_.size());
+        it = executor_map_.emplace_hint(it, exec, new_id);
+        executors_.emplace_back();
+        executors_.back().exec = exec;
+        executors_.back().name = name_demangling::get_dynamic_type(*exec);
+    }
+    auto& e = executors_[it->second];
+    e.current_bytes += num_bytes;
+    e.peak_bytes = std::max(e.peak_bytes, e.current_bytes);
+    e.num_allocations++;
+    e.total_bytes += num_bytes;
+    const auto owner = stack_.empty() ? int64{-1} : stack_.back();
+    if (owner >= 0) {
+        auto& op = operations_[owner];
+        op.num_allocations++;
+        op.total_bytes += num_bytes;
+        op.live_bytes += num_bytes;
+    }
+    for (const auto id : stack_) {
+        operations_[id].peak_bytes =
+            std::max(operations_[id].peak_bytes, e.current_bytes);
+    }
+    allocations_[location] = allocation_info{it->second, num_bytes, owner};
+}
+
+
+void MemoryTracker::on_free_completed(const Executor* exec,
+                                      const uintptr& location) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    const auto it = allocations_.find(location);
+    if (it == allocations_.end()) {
+        return;
+    }
+    const auto info = it->second;
+    allocations_.erase(it);
+    executors_[info.executor_id].current_bytes -= info.num_bytes;
+    if (info.operation_id >= 0) {
+        operations_[info.operation_id].live_bytes -= info.num_bytes;
+    }
+}
+
+
+void MemoryTracker::on_operation_launched(const Executor* exec,
+                                          const Operation* operation) const
+{
+    begin(operation->get_name());
+}
+
+
+void MemoryTracker::on_operation_completed(const Executor* exec,
+                                           const Operation* operation) const
+{
+    end();
+}
+
+
+void MemoryTracker::on_linop_apply_started(const LinOp* A, const LinOp* b,
+                                           const LinOp* x) const
+{
+    begin(name_demangling::get_dynamic_type(*A) + "::apply");
+}
+
+
+void MemoryTracker::on_linop_apply_completed(const LinOp* A, const LinOp* b,
+                                             const LinOp* x) const
+{
+    end();
+}
+
+
+void MemoryTracker::on_linop_advanced_apply_started(const LinOp* A,
+                                                    const LinOp* alpha,
+                                                    const LinOp* b,
+                                                    const LinOp* beta,
+                                                    const LinOp* x) const
+{
+    begin(name_demangling::get_dynamic_type(*A) + "::advanced_apply");
+}
+
+
+void MemoryTracker::on_linop_advanced_apply_completed(const LinOp* A,
+                                                      const LinOp* alpha,
+                                                      const LinOp* b,
+                                                      const LinOp* beta,
+                                                      const LinOp* x) const
+{
+    end();
+}
+
+
+void MemoryTracker::on_linop_factory_generate_started(
+    const LinOpFactory* factory, const LinOp* input) const
+{
+    begin(name_demangling::get_dynamic_type(*factory) + "::generate");
+}
+
+
+void MemoryTracker::on_linop_factory_generate_completed(
+    const LinOpFactory* factory, const LinOp* input, const LinOp* output) const
+{
+    end();
+}
+
+
+bool MemoryTracker::needs_propagation() const { return true; }
+
+
+std::vector<MemoryTracker::executor_summary>
+MemoryTracker::get_executor_summaries() const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    return executors_;
+}
+
+
+std::vector<MemoryTracker::operation_summary>
+MemoryTracker::get_operation_summaries() const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    return operations_;
+}
+
+
+std::vector<MemoryTracker::allocation> MemoryTracker::get_live_allocations()
+    const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    std::vector<allocation> result;
+    for (const auto& pair : allocations_) {
+        const auto& info = pair.second;
+        result.push_back(allocation{
+            executors_[info.executor_id].exec, pair.first, info.num_bytes,
+            info.operation_id >= 0 ? operations_[info.operation_id].name
+                                   : "unattributed"});
+    }
+    std::sort(result.begin(), result.end(),
+              [](const allocation& a, const allocation& b) {
+                  return a.num_bytes > b.num_bytes;
+              });
+    return result;
+}
+
+
+void MemoryTracker::write(std::ostream& output) const
+{
+    const auto executors = get_executor_summaries();
+    auto operations = get_operation_summaries();
+    operations.erase(std::remove_if(operations.begin(), operations.end(),
+                                    [](const operation_summary& op) {
+                                        return op.num_allocations == 0;
+                                    }),
+                     operations.end());
+    std::stable_sort(operations.begin(), operations.end(),
+                     [](const operation_summary& a,
+                        const operation_summary& b) {
+                         return a.peak_bytes > b.peak_bytes;
+                     });
+    std::vector<std::vector<std::string>> executor_table;
+    for (const auto& e : executors) {
+        executor_table.push_back({e.name, format_bytes(e.current_bytes),
+                                  format_bytes(e.peak_bytes),
+                                  std::to_string(e.num_allocations),
+                                  format_bytes(e.total_bytes)});
+    }
+    std::vector<std::vector<std::string>> operation_table;
+    for (const auto& op : operations) {
+        operation_table.push_back(
+            {op.name, std::to_string(op.count),
+             std::to_string(op.num_allocations), format_bytes(op.total_bytes),
+             format_bytes(op.live_bytes), format_bytes(op.peak_bytes)});
+    }
+    output << "Memory usage per executor\n";
+    print_table(output, {"executor", "current", "peak", "allocations",
+                         "allocated"},
+                executor_table);
+    output << "\nMemory usage per operation, by peak\n";
+    print_table(output, {"operation", "count", "allocations", "allocated",
+                         "live", "peak"},
+                operation_table);
+}
+
+
+constexpr Logger::mask_type MemoryTracker::mask_;
+
+
+}  // namespace log
+}  // namespace gko
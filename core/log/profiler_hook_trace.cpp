@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+#include "core/log/profiler_hook.hpp"
+
+
+namespace gko {
+namespace log {
+namespace {
+
+
+struct trace_record {
+    int32 name_id;
+    profile_event_category category;
+    bool begin;
+};
+
+
+/**
+ * The events of a single thread, stored in a ring buffer. It is only ever
+ * written to by its own thread, so no synchronization is necessary.
+ */
+struct thread_trace {
+    std::vector<trace_record> records;
+    std::vector<time_point> times;
+    std::unordered_map<std::string, int32> name_map;
+    std::vector<std::string> names;
+    // reused for name lookups to avoid allocations
+    std::string key;
+    size_type capacity;
+    size_type num_events{};
+
+    thread_trace(size_type capacity) : capacity{capacity}
+    {
+        records.reserve(capacity);
+        times.reserve(capacity);
+    }
+
+    void log(Timer& timer, const char* name, profile_event_category category,
+             bool begin)
+    {
+        key.assign(name);
+        auto it = name_map.find(key);
+        if (it == name_map.end()) {
+            const auto new_id = static_cast<int32>(names.size());
+            it = name_map.emplace_hint(it, key, new_id);
+            names.push_back(key);
+        }
+        const trace_record record{it->second, category, begin};
+        if (records.size() < capacity) {
+            records.push_back(record);
+            times.push_back(timer.create_time_point());
+            timer.record(times.back());
+        } else {
+            const auto idx = num_events % capacity;
+            records[idx] = record;
+            timer.record(times[idx]);
+        }
+        num_events++;
+    }
+};
+
+
+struct trace {
+    std::shared_ptr<Timer> timer;
+    size_type capacity;
+    uint64 id;
+    time_point origin;
+    // only used to register the buffer of a new thread
+    std::mutex mutex;
+    std::vector<std::shared_ptr<thread_trace>> threads;
+
+    trace(std::shared_ptr<Timer> timer, size_type capacity)
+        : timer{std::move(timer)},
+          capacity{std::max<size_type>(capacity, 1)},
+          id{next_id()},
+          origin{this->timer->create_time_point()}
+    {
+        this->timer->record(origin);
+    }
+
+    static uint64 next_id()
+    {
+        static std::atomic<uint64> counter{};
+        return counter++;
+    }
+
+    thread_trace& get_thread_trace()
+    {
+        struct cache_entry {
+            uint64 id;
+            std::weak_ptr<thread_trace> owner;
+            thread_trace* ptr;
+        };
+        // the buffers of this thread for all active trace loggers
+        thread_local std::vector<cache_entry> cache;
+        for (const auto& entry : cache) {
+            if (entry.id == id) {
+                return *entry.ptr;
+            }
+        }
+        cache.erase(std::remove_if(cache.begin(), cache.end(),
+                                   [](const cache_entry& entry) {
+                                       return entry.owner.expired();
+                                   }),
+                    cache.end());
+        auto buffer = std::make_shared<thread_trace>(capacity);
+        {
+            std::lock_guard<std::mutex> guard{mutex};
+            threads.push_back(buffer);
+        }
+        cache.push_back(cache_entry{id, buffer, buffer.get()});
+        return *buffer;
+    }
+
+    void log(const char* name, profile_event_category category, bool begin)
+    {
+        get_thread_trace().log(*timer, name, category, begin);
+    }
+
+    void write(ProfilerHook::TraceWriter& writer)
+    {
+        std::vector<ProfilerHook::trace_event> events;
+        int64 num_dropped{};
+        for (int thread_id = 0; thread_id < static_cast<int>(threads.size());
+             thread_id++) {
+            auto& thread = *threads[thread_id];
+            const auto begin = thread.num_events - thread.records.size();
+            num_dropped += static_cast<int64>(begin);
+            // skip range ends whose beginning was overwritten
+            int64 depth{};
+            for (auto i = begin; i < thread.num_events; i++) {
+                const auto idx = i % capacity;
+                const auto& record = thread.records[idx];
+                if (!record.begin && depth == 0) {
+                    continue;
+                }
+                depth += record.begin ? 1 : -1;
+                timer->wait(thread.times[idx]);
+                events.push_back(ProfilerHook::trace_event{
+                    thread.names[record.name_id], record.category,
+                    record.begin, thread_id,
+                    timer->difference_async(origin, thread.times[idx])});
+            }
+        }
+        writer.write_trace(events, num_dropped);
+    }
+};
+
+
+const char* category_name(profile_event_category category)
+{
+    switch (category) {
+    case profile_event_category::memory:
+        return "memory";
+    case profile_event_category::operation:
+        return "operation";
+    case profile_event_category::object:
+        return "object";
+    case profile_event_category::linop:
+        return "linop";
+    case profile_event_category::factory:
+        return "factory";
+    case profile_event_category::solver:
+        return "solver";
+    case profile_event_category::criterion:
+        return "criterion";
+    case profile_event_category::user:
+        return "user";
+    case profile_event_category::internal:
+    default:
+        return "internal";
+    }
+}
+
+
+void write_json_string(std::ostream& output, const std::string& str)
+{
+    output << '"';
+    for (const auto c : str) {
+        if (c == '"' || c == '\\') {
+            output << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            output << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+            output << c;
+        }
+    }
+    output << '"';
+}
+
+
+}  // namespace
+
+
+ProfilerHook::ChromeTraceWriter::ChromeTraceWriter(std::ostream& output)
+    : output_{&output}
+{}
+
+
+void ProfilerHook::ChromeTraceWriter::write_trace(
+    const std::vector<trace_event>& events, int64 num_dropped)
+{
+    auto& output = *output_;
+    output << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        output << (first ? "\n" : ",\n");
+        first = false;
+        // timestamps are given in microseconds
+        const auto time_ns = event.timestamp.count();
+        output << "{\"name\":";
+        write_json_string(output, event.name);
+        output << ",\"cat\":\"" << category_name(event.category)
+               << "\",\"ph\":\"" << (event.begin ? 'B' : 'E')
+               << "\",\"ts\":" << time_ns / 1000 << '.' << std::setw(3)
+               << std::setfill('0') << time_ns % 1000 << std::setfill(' ')
+               << ",\"pid\":0,\"tid\":" << event.thread_id << '}';
+    }
+    output << "\n],\"displayTimeUnit\":\"ns\","
+           << "\"otherData\":{\"dropped_events\":" << num_dropped << "}}\n";
+}
+
+
+std::shared_ptr<ProfilerHook> ProfilerHook::create_trace(
+    std::shared_ptr<Timer> timer, std::unique_ptr<TraceWriter> writer,
+    size_type buffer_capacity)
+{
+    // we need to wrap the deleter in a shared_ptr to deal with a GCC 5.5 bug
+    // related to move-only functors
+    std::shared_ptr<trace> data{
+        new trace{std::move(timer), buffer_capacity},
+        [writer = std::shared_ptr<TraceWriter>{std::move(writer)}](
+            trace* ptr) {
+            ptr->write(*writer);
+            delete ptr;
+        }};
+    return std::shared_ptr<ProfilerHook>{new ProfilerHook{
+        [data](const char* name, profile_event_category category) {
+            data->log(name, category, true);
+        },
+        [data](const char* name, profile_event_category category) {
+            data->log(name, category, false);
+        }}};
+}
+
+
+}  // namespace log
+}  // namespace gko
@@ -0,0 +1,590 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/log/roofline.hpp>
+
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <iomanip>
+#include <sstream>
+
+
+#if GKO_HAVE_PAPI_SDE
+#include <papi.h>
+#endif
+
+
+#include <ginkgo/core/base/composition.hpp>
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/name_demangling.hpp>
+#include <ginkgo/core/matrix/coo.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/ell.hpp>
+#include <ginkgo/core/matrix/fbcsr.hpp>
+#include <ginkgo/core/matrix/hybrid.hpp>
+#include <ginkgo/core/matrix/sellp.hpp>
+#include <ginkgo/core/solver/triangular.hpp>
+#include <ginkgo/core/synthesizer/containers.hpp>
+
+
+namespace gko {
+namespace log {
+namespace {
+
+
+using value_types = syn::type_list<float, double, std::complex<float>,
+                                   std::complex<double>>;
+
+
+template <template <typename...> class Op, typename... IndexTypes,
+          typename Func>
+bool dispatch_value_type(const LinOp*, Func&&, syn::type_list<>)
+{
+    return false;
+}
+
+
+/**
+ * Calls fn with a pointer to the template <ValueType> or
+ * template <ValueType, IndexType> type the LinOp has.
+ */
+template <template <typename...> class Op, typename... IndexTypes,
+          typename Func, typename ValueType, typename... ValueTypes>
+bool dispatch_value_type(const LinOp* op, Func&& fn,
+                         syn::type_list<ValueType, ValueTypes...>)
+{
+    if (auto cast = dynamic_cast<const Op<ValueType, IndexTypes...>*>(op)) {
+        fn(cast);
+        return true;
+    }
+    return dispatch_value_type<Op, IndexTypes...>(
+        op, std::forward<Func>(fn), syn::type_list<ValueTypes...>{});
+}
+
+
+template <template <typename...> class Op, typename Func>
+bool dispatch(const LinOp* op, Func&& fn)
+{
+    return dispatch_value_type<Op>(op, fn, value_types{});
+}
+
+
+template <template <typename, typename> class Op, typename Func>
+bool dispatch_indexed(const LinOp* op, Func&& fn)
+{
+    return dispatch_value_type<Op, int32>(op, fn, value_types{}) ||
+           dispatch_value_type<Op, int64>(op, fn, value_types{});
+}
+
+
+template <typename Mtx>
+constexpr double value_bytes(const Mtx*)
+{
+    return sizeof(typename Mtx::value_type);
+}
+
+
+template <typename Mtx>
+constexpr double index_bytes(const Mtx*)
+{
+    return sizeof(typename Mtx::index_type);
+}
+
+
+/**
+ * Returns the memory traffic for reading the stored data of a matrix, or a
+ * negative value if the type is unknown.
+ */
+double matrix_bytes(const LinOp* op)
+{
+    double bytes = -1.0;
+    const auto found =
+        dispatch<matrix::Dense>(
+            op,
+            [&](auto mtx) {
+                bytes = value_bytes(mtx) * mtx->get_size()[0] *
+                        mtx->get_size()[1];
+            }) ||
+        dispatch_indexed<matrix::Csr>(
+            op,
+            [&](auto mtx) {
+                bytes = (value_bytes(mtx) + index_bytes(mtx)) *
+                            mtx->get_num_stored_elements() +
+                        index_bytes(mtx) * (mtx->get_size()[0] + 1);
+            }) ||
+        dispatch_indexed<matrix::Coo>(
+            op,
+            [&](auto mtx) {
+                bytes = (value_bytes(mtx) + 2 * index_bytes(mtx)) *
+                        mtx->get_num_stored_elements();
+            }) ||
+        dispatch_indexed<matrix::Ell>(
+            op,
+            [&](auto mtx) {
+                bytes = (value_bytes(mtx) + index_bytes(mtx)) *
+                        mtx->get_num_stored_elements();
+            }) ||
+        dispatch_indexed<matrix::Sellp>(
+            op,
+            [&](auto mtx) {
+                bytes = (value_bytes(mtx) + index_bytes(mtx)) *
+                        mtx->get_num_stored_elements();
+            }) ||
+        dispatch_indexed<matrix::Hybrid>(
+            op,
+            [&](auto mtx) {
+                bytes = (value_bytes(mtx) + index_bytes(mtx)) *
+                            mtx->get_ell_num_stored_elements() +
+                        (value_bytes(mtx) + 2 * index_bytes(mtx)) *
+                            mtx->get_coo_num_stored_elements();
+            }) ||
+        dispatch_indexed<matrix::Fbcsr>(
+            op,
+            [&](auto mtx) {
+                bytes = value_bytes(mtx) * mtx->get_num_stored_elements() +
+                        index_bytes(mtx) * (mtx->get_num_stored_blocks() +
+                                            mtx->get_num_block_rows() + 1);
+            }) ||
+        dispatch<Composition>(op, [&](auto composition) {
+            bytes = 0.0;
+            for (const auto& factor : composition->get_operators()) {
+                const auto factor_bytes = matrix_bytes(factor.get());
+                if (factor_bytes < 0.0) {
+                    bytes = -1.0;
+                    return;
+                }
+                bytes += factor_bytes;
+            }
+        });
+    return found ? bytes : -1.0;
+}
+
+
+/**
+ * Returns the number of stored entries a matrix-vector product with the
+ * matrix processes, or a negative value if the type is unknown.
+ */
+double matrix_entries(const LinOp* op)
+{
+    double entries = -1.0;
+    dispatch<matrix::Dense>(op,
+                            [&](auto mtx) {
+                                entries = static_cast<double>(
+                                    mtx->get_size()[0] * mtx->get_size()[1]);
+                            }) ||
+        dispatch_indexed<matrix::Csr>(
+            op,
+            [&](auto mtx) { entries = mtx->get_num_stored_elements(); }) ||
+        dispatch_indexed<matrix::Coo>(
+            op,
+            [&](auto mtx) { entries = mtx->get_num_stored_elements(); }) ||
+        dispatch_indexed<matrix::Ell>(
+            op,
+            [&](auto mtx) { entries = mtx->get_num_stored_elements(); }) ||
+        dispatch_indexed<matrix::Sellp>(
+            op,
+            [&](auto mtx) { entries = mtx->get_num_stored_elements(); }) ||
+        dispatch_indexed<matrix::Hybrid>(
+            op,
+            [&](auto mtx) {
+                entries = mtx->get_ell_num_stored_elements() +
+                          mtx->get_coo_num_stored_elements();
+            }) ||
+        dispatch_indexed<matrix::Fbcsr>(
+            op, [&](auto mtx) { entries = mtx->get_num_stored_elements(); });
+    return entries;
+}
+
+
+/**
+ * Returns the size of a single value of a Dense vector, or a negative value
+ * if it is not a Dense vector.
+ */
+double vector_value_bytes(const LinOp* op)
+{
+    double bytes = -1.0;
+    dispatch<matrix::Dense>(op,
+                            [&](auto vec) { bytes = value_bytes(vec); });
+    return bytes;
+}
+
+
+/**
+ * Models a (sparse) matrix-vector product or triangular solve: every stored
+ * entry of the matrix is read once and causes one multiply-add per
+ * right-hand side, b is read once and x is written (and for the advanced
+ * apply read) once.
+ */
+bool matvec_cost(const LinOp* mtx, const LinOp* b, const LinOp* x,
+                 bool advanced, Roofline::cost& result)
+{
+    const auto mtx_bytes = matrix_bytes(mtx);
+    const auto entries = matrix_entries(mtx);
+    const auto b_value_bytes = vector_value_bytes(b);
+    const auto x_value_bytes = vector_value_bytes(x);
+    if (mtx_bytes < 0.0 || entries < 0.0 || b_value_bytes < 0.0 ||
+        x_value_bytes < 0.0) {
+        return false;
+    }
+    const double nrhs = b->get_size()[1];
+    const double b_size = b->get_size()[0] * nrhs;
+    const double x_size = x->get_size()[0] * nrhs;
+    result.bytes = mtx_bytes + b_value_bytes * b_size +
+                   x_value_bytes * x_size * (advanced ? 2 : 1);
+    result.flops = 2 * entries * nrhs + (advanced ? 3 * x_size : 0.0);
+    return true;
+}
+
+
+template <template <typename, typename> class Solver>
+bool triangular_system_matrix(const LinOp* op, const LinOp*& system_matrix)
+{
+    return dispatch_indexed<Solver>(op, [&](auto solver) {
+        system_matrix = solver->get_system_matrix().get();
+    });
+}
+
+
+std::string format_number(double value, const char* unit = nullptr)
+{
+    std::stringstream ss;
+    ss << std::setprecision(1) << std::fixed << value;
+    if (unit) {
+        ss << ' ' << unit;
+    }
+    return ss.str();
+}
+
+
+std::string format_time(std::chrono::nanoseconds time)
+{
+    const auto time_ns = static_cast<double>(time.count());
+    if (time_ns < 1e3) {
+        return format_number(time_ns, "ns");
+    } else if (time_ns < 1e6) {
+        return format_number(time_ns / 1e3, "us");
+    } else if (time_ns < 1e9) {
+        return format_number(time_ns / 1e6, "ms");
+    }
+    return format_number(time_ns / 1e9, "s ");
+}
+
+
+}  // namespace
+
+
+Roofline::Roofline(std::shared_ptr<Timer> timer, double peak_bandwidth,
+                   double peak_gflops, std::string papi_flops_event)
+    : Logger(mask_),
+      timer_{std::move(timer)},
+      peak_bandwidth_{peak_bandwidth},
+      peak_gflops_{peak_gflops},
+      papi_flops_event_{std::move(papi_flops_event)},
+      papi_event_set_{-1}
+{
+    if (!papi_flops_event_.empty()) {
+#if GKO_HAVE_PAPI_SDE
+        if (!PAPI_is_initialized()) {
+            PAPI_library_init(PAPI_VER_CURRENT);
+        }
+        if (PAPI_create_eventset(&papi_event_set_) != PAPI_OK ||
+            PAPI_add_named_event(papi_event_set_,
+                                 papi_flops_event_.c_str()) != PAPI_OK ||
+            PAPI_start(papi_event_set_) != PAPI_OK) {
+            GKO_INVALID_STATE("Unable to start PAPI event " +
+                              papi_flops_event_);
+        }
+#else
+        GKO_NOT_COMPILED(papi);
+#endif
+    }
+}
+
+
+Roofline::~Roofline()
+{
+#if GKO_HAVE_PAPI_SDE
+    if (papi_event_set_ >= 0) {
+        long long value{};
+        PAPI_stop(papi_event_set_, &value);
+        PAPI_cleanup_eventset(papi_event_set_);
+        PAPI_destroy_eventset(&papi_event_set_);
+    }
+#endif
+}
+
+
+long long Roofline::read_counter() const
+{
+    long long value{};
+#if GKO_HAVE_PAPI_SDE
+    if (papi_event_set_ >= 0) {
+        PAPI_read(papi_event_set_, &value);
+    }
+#endif
+    return value;
+}
+
+
+void Roofline::add_apply_model(std::type_index type, apply_model model)
+{
+    apply_models_[type] = std::move(model);
+}
+
+
+void Roofline::add_generate_model(std::type_index type, generate_model model)
+{
+    generate_models_[type] = std::move(model);
+}
+
+
+Roofline::cost Roofline::apply_cost(const LinOp* A, const LinOp* b,
+                                    const LinOp* x, bool advanced,
+                                    bool& has_model) const
+{
+    const auto it = apply_models_.find(typeid(*A));
+    if (it != apply_models_.end()) {
+        has_model = true;
+        return it->second(A, b, x, advanced);
+    }
+    cost result{};
+    // triangular solvers have the same cost as a product with their matrix
+    const LinOp* mtx = A;
+    triangular_system_matrix<solver::LowerTrs>(A, mtx) ||
+        triangular_system_matrix<solver::UpperTrs>(A, mtx);
+    has_model = matvec_cost(mtx, b, x, advanced, result);
+    return result;
+}
+
+
+Roofline::cost Roofline::generate_cost(const LinOpFactory* factory,
+                                       const LinOp* input,
+                                       const LinOp* output,
+                                       bool& has_model) const
+{
+    const auto it = generate_models_.find(typeid(*factory));
+    if (it != generate_models_.end()) {
+        has_model = true;
+        return it->second(factory, input, output);
+    }
+    // reading the input and writing the output, e.g. factors
+    cost result{};
+    const auto input_bytes = matrix_bytes(input);
+    const auto output_bytes = output ? matrix_bytes(output) : -1.0;
+    has_model = input_bytes >= 0.0 && output_bytes >= 0.0;
+    result.bytes = input_bytes + output_bytes;
+    return result;
+}
+
+
+void Roofline::start(std::string name, cost model_cost, bool has_model) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    auto it = name_map_.find(name);
+    if (it == name_map_.end()) {
+        const auto new_id = static_cast<int64>(entries_.size());
+        it = name_map_.emplace_hint(it, name, new_id);
+        entries_.emplace_back();
+        entries_.back().name = std::move(name);
+    }
+    auto time = timer_->create_time_point();
+    timer_->record(time);
+    stack_.push_back(pending{it->second, model_cost, has_model,
+                             std::move(time), read_counter()});
+}
+
+
+void Roofline::stop() const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (stack_.empty()) {
+        // the logger was added during an operation
+        return;
+    }
+    auto time = timer_->create_time_point();
+    timer_->record(time);
+    timer_->wait(time);
+    const auto counter = read_counter();
+    auto& top = stack_.back();
+    auto& e = entries_[top.entry_id];
+    e.count++;
+    e.time += timer_->difference_async(top.start, time);
+    e.bytes += top.model_cost.bytes;
+    e.flops += top.model_cost.flops;
+    e.has_model = top.has_model;
+    if (papi_event_set_ >= 0) {
+        e.measured_flops = std::max<int64>(e.measured_flops, 0) +
+                           static_cast<int64>(counter - top.counter_start);
+    }
+    stack_.pop_back();
+}
+
+
+void Roofline::on_linop_apply_started(const LinOp* A, const LinOp* b,
+                                      const LinOp* x) const
+{
+    bool has_model{};
+    const auto model_cost = apply_cost(A, b, x, false, has_model);
+    start(name_demangling::get_dynamic_type(*A) + "::apply", model_cost,
+          has_model);
+}
+
+
+void Roofline::on_linop_apply_completed(const LinOp* A, const LinOp* b,
+                                        const LinOp* x) const
+{
+    stop();
+}
+
+
+void Roofline::on_linop_advanced_apply_started(const LinOp* A,
+                                               const LinOp* alpha,
+                                               const LinOp* b,
+                                               const LinOp* beta,
+                                               const LinOp* x) const
+{
+    bool has_model{};
+    const auto model_cost = apply_cost(A, b, x, true, has_model);
+    start(name_demangling::get_dynamic_type(*A) + "::advanced_apply",
+          model_cost, has_model);
+}
+
+
+void Roofline::on_linop_advanced_apply_completed(const LinOp* A,
+                                                 const LinOp* alpha,
+                                                 const LinOp* b,
+                                                 const LinOp* beta,
+                                                 const LinOp* x) const
+{
+    stop();
+}
+
+
+void Roofline::on_linop_factory_generate_started(const LinOpFactory* factory,
+                                                 const LinOp* input) const
+{
+    // the cost depends on the output, so it is added on completion
+    start(name_demangling::get_dynamic_type(*factory) + "::generate", {},
+          false);
+}
+
+
+void Roofline::on_linop_factory_generate_completed(const LinOpFactory* factory,
+                                                   const LinOp* input,
+                                                   const LinOp* output) const
+{
+    bool has_model{};
+    const auto model_cost = generate_cost(factory, input, output, has_model);
+    {
+        std::lock_guard<std::mutex> guard{mutex_};
+        if (!stack_.empty()) {
+            stack_.back().model_cost = model_cost;
+            stack_.back().has_model = has_model;
+        }
+    }
+    stop();
+}
+
+
+bool Roofline::needs_propagation() const { return true; }
+
+
+std::vector<Roofline::entry> Roofline::get_entries() const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    return entries_;
+}
+
+
+double Roofline::get_roofline_fraction(const entry& e) const
+{
+    const auto seconds = e.time.count() * 1e-9;
+    if (!e.has_model || seconds <= 0.0 || peak_bandwidth_ <= 0.0) {
+        return -1.0;
+    }
+    const auto bandwidth = e.bytes / seconds * 1e-9;
+    if (e.flops <= 0.0) {
+        return bandwidth / peak_bandwidth_;
+    }
+    if (peak_gflops_ <= 0.0 || e.bytes <= 0.0) {
+        return -1.0;
+    }
+    const auto gflops = e.flops / seconds * 1e-9;
+    const auto bound =
+        std::min(peak_gflops_, e.flops / e.bytes * peak_bandwidth_);
+    return gflops / bound;
+}
+
+
+void Roofline::write(std::ostream& output) const
+{
+    const auto entries = get_entries();
+    const bool papi = papi_event_set_ >= 0;
+    std::vector<std::string> headers{"name",     "count",     "time",
+                                     "GB/s",     "GFLOP/s",   "flop/byte",
+                                     "roofline"};
+    if (papi) {
+        headers.push_back("measured/model flops");
+    }
+    std::vector<std::vector<std::string>> table;
+    for (const auto& e : entries) {
+        const auto seconds = e.time.count() * 1e-9;
+        std::vector<std::string> row{e.name, std::to_string(e.count),
+                                     format_time(e.time)};
+        if (e.has_model && seconds > 0.0) {
+            row.push_back(format_number(e.bytes / seconds * 1e-9));
+            row.push_back(format_number(e.flops / seconds * 1e-9));
+            row.push_back(
+                e.bytes > 0.0 ? format_number(e.flops / e.bytes) : "-");
+        } else {
+            row.insert(row.end(), 3, "-");
+        }
+        const auto fraction = get_roofline_fraction(e);
+        row.push_back(fraction >= 0.0 ? format_number(fraction * 100.0, "%")
+                                      : "-");
+        if (papi) {
+            row.push_back(e.has_model && e.flops > 0.0
+                              ? format_number(e.measured_flops / e.flops)
+                              : "-");
+        }
+        table.push_back(std::move(row));
+    }
+    std::vector<std::size_t> widths(headers.size());
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        widths[i] = headers[i].size();
+        for (const auto& row : table) {
+            widths[i] = std::max(widths[i], row[i].size());
+        }
+    }
+    output << "Roofline summary (peak " << peak_bandwidth_ << " GB/s, "
+           << peak_gflops_ << " GFLOP/s)\n|";
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        output << ' ' << std::setw(widths[i]) << std::left << headers[i]
+               << " |";
+    }
+    output << "\n|";
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        output << std::string(widths[i] + 1, '-') << (i == 0 ? "-|" : ":|");
+    }
+    output << '\n';
+    for (const auto& row : table) {
+        output << '|';
+        for (std::size_t i = 0; i < row.size(); i++) {
+            output << ' ' << std::setw(widths[i])
+                   << (i == 0 ? std::left : std::right) << row[i] << " |";
+        }
+        output << '\n';
+    }
+    output << std::right;
+}
+
+
+constexpr Logger::mask_type Roofline::mask_;
+
+
+}  // namespace log
+}  // namespace gko
@@ -0,0 +1,377 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/log/solver_profiler.hpp>
+
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+
+#include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/base/name_demangling.hpp>
+#include <ginkgo/core/solver/solver_base.hpp>
+
+
+namespace gko {
+namespace log {
+namespace {
+
+
+std::string format_number(double value, const char* unit)
+{
+    std::stringstream ss;
+    ss << std::setprecision(1) << std::fixed << value << ' ' << unit;
+    return ss.str();
+}
+
+
+std::string format_time(std::chrono::nanoseconds time)
+{
+    const auto time_ns = static_cast<double>(time.count());
+    if (time_ns < 1e3) {
+        return format_number(time_ns, "ns");
+    } else if (time_ns < 1e6) {
+        return format_number(time_ns / 1e3, "us");
+    } else if (time_ns < 1e9) {
+        return format_number(time_ns / 1e6, "ms");
+    }
+    return format_number(time_ns / 1e9, "s ");
+}
+
+
+SolverProfiler::phase classify_operation(const Operation* operation)
+{
+    const auto name = operation->get_name();
+    if (std::strstr(name, "dot") || std::strstr(name, "norm")) {
+        return SolverProfiler::phase::reduction;
+    }
+    return SolverProfiler::phase::vector_update;
+}
+
+
+}  // namespace
+
+
+const char* SolverProfiler::get_phase_name(phase p)
+{
+    switch (p) {
+    case phase::spmv:
+        return "spmv";
+    case phase::preconditioner:
+        return "preconditioner";
+    case phase::reduction:
+        return "reduction";
+    case phase::vector_update:
+        return "vector update";
+    case phase::criterion:
+        return "criterion";
+    case phase::other:
+    default:
+        return "other";
+    }
+}
+
+
+SolverProfiler::SolverProfiler(std::shared_ptr<Timer> timer)
+    : Logger(mask_), timer_{std::move(timer)}
+{}
+
+
+time_point SolverProfiler::get_time_point() const
+{
+    if (free_time_points_.empty()) {
+        return timer_->create_time_point();
+    }
+    auto time = std::move(free_time_points_.back());
+    free_time_points_.pop_back();
+    return time;
+}
+
+
+void SolverProfiler::begin_solver(const LinOp* solver) const
+{
+    auto name = name_demangling::get_dynamic_type(*solver);
+    auto it = name_map_.find(name);
+    if (it == name_map_.end()) {
+        const auto new_id = static_cast<int64>(summaries_.size());
+        it = name_map_.emplace_hint(it, name, new_id);
+        summaries_.emplace_back();
+        summaries_.back().name = std::move(name);
+    }
+    const LinOp* system_matrix{};
+    const LinOp* preconditioner{};
+    if (auto base = dynamic_cast<const solver::detail::SolverBaseLinOp*>(
+            solver)) {
+        system_matrix = base->get_system_matrix().get();
+    }
+    if (auto precond = dynamic_cast<const Preconditionable*>(solver)) {
+        preconditioner = precond->get_preconditioner().get();
+    }
+    auto start = get_time_point();
+    timer_->record(start);
+    stack_.push_back(frame{solver, system_matrix, preconditioner, it->second,
+                           std::move(start), 0, false, 0, {}});
+}
+
+
+void SolverProfiler::end_solver() const
+{
+    auto current = std::move(stack_.back());
+    stack_.pop_back();
+    auto stop = get_time_point();
+    if (current.in_phase) {
+        timer_->record(current.intervals.back().stop);
+    }
+    timer_->record(stop);
+    timer_->wait(stop);
+    auto& s = summaries_[current.summary_id];
+    const auto total = timer_->difference_async(current.start, stop);
+    std::chrono::nanoseconds covered{};
+    for (auto& i : current.intervals) {
+        const auto time = timer_->difference_async(i.start, i.stop);
+        s.phase_time[static_cast<int>(i.p)] += time;
+        s.phase_count[static_cast<int>(i.p)]++;
+        covered += time;
+        free_time_points_.push_back(std::move(i.start));
+        free_time_points_.push_back(std::move(i.stop));
+    }
+    const auto other = static_cast<int>(phase::other);
+    s.phase_time[other] += std::max(total - covered, decltype(total){});
+    s.phase_count[other]++;
+    s.count++;
+    s.iterations += current.iterations;
+    s.time += total;
+    free_time_points_.push_back(std::move(current.start));
+    free_time_points_.push_back(std::move(stop));
+}
+
+
+void SolverProfiler::begin(bool classified, phase p) const
+{
+    if (stack_.empty()) {
+        return;
+    }
+    auto& top = stack_.back();
+    if (top.depth++ == 0 && classified) {
+        auto start = get_time_point();
+        timer_->record(start);
+        top.intervals.push_back(
+            interval{p, std::move(start), get_time_point()});
+        top.in_phase = true;
+    }
+}
+
+
+void SolverProfiler::end() const
+{
+    if (stack_.empty()) {
+        return;
+    }
+    auto& top = stack_.back();
+    // the logger may have been added during an operation
+    if (top.depth == 0) {
+        return;
+    }
+    if (--top.depth == 0 && top.in_phase) {
+        timer_->record(top.intervals.back().stop);
+        top.in_phase = false;
+    }
+}
+
+
+void SolverProfiler::begin_linop(const LinOp* op) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (!stack_.empty()) {
+        const auto& top = stack_.back();
+        if (op == top.system_matrix) {
+            begin(true, phase::spmv);
+        } else if (op == top.preconditioner) {
+            begin(true, phase::preconditioner);
+        } else {
+            begin(false, phase::other);
+        }
+    }
+    if (dynamic_cast<const solver::IterativeBase*>(op)) {
+        begin_solver(op);
+    }
+}
+
+
+void SolverProfiler::end_linop(const LinOp* op) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (!stack_.empty() && stack_.back().solver == op &&
+        stack_.back().depth == 0) {
+        end_solver();
+    }
+    end();
+}
+
+
+void SolverProfiler::on_operation_launched(const Executor* exec,
+                                           const Operation* operation) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (!stack_.empty()) {
+        begin(true, classify_operation(operation));
+    }
+}
+
+
+void SolverProfiler::on_operation_completed(const Executor* exec,
+                                            const Operation* operation) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    end();
+}
+
+
+void SolverProfiler::on_linop_apply_started(const LinOp* A, const LinOp* b,
+                                            const LinOp* x) const
+{
+    begin_linop(A);
+}
+
+
+void SolverProfiler::on_linop_apply_completed(const LinOp* A, const LinOp* b,
+                                              const LinOp* x) const
+{
+    end_linop(A);
+}
+
+
+void SolverProfiler::on_linop_advanced_apply_started(const LinOp* A,
+                                                     const LinOp* alpha,
+                                                     const LinOp* b,
+                                                     const LinOp* beta,
+                                                     const LinOp* x) const
+{
+    begin_linop(A);
+}
+
+
+void SolverProfiler::on_linop_advanced_apply_completed(const LinOp* A,
+                                                       const LinOp* alpha,
+                                                       const LinOp* b,
+                                                       const LinOp* beta,
+                                                       const LinOp* x) const
+{
+    end_linop(A);
+}
+
+
+void SolverProfiler::on_criterion_check_started(
+    const stop::Criterion* criterion, const size_type& num_iterations,
+    const LinOp* residual, const LinOp* residual_norm, const LinOp* solution,
+    const uint8& stopping_id, const bool& set_finalized) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    begin(true, phase::criterion);
+}
+
+
+void SolverProfiler::on_criterion_check_completed(
+    const stop::Criterion* criterion, const size_type& num_iterations,
+    const LinOp* residual, const LinOp* residual_norm,
+    const LinOp* implicit_sq_residual_norm, const LinOp* solution,
+    const uint8& stopping_id, const bool& set_finalized,
+    const array<stopping_status>* status, const bool& one_changed,
+    const bool& all_converged) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    end();
+}
+
+
+void SolverProfiler::on_iteration_complete(
+    const LinOp* solver, const LinOp* b, const LinOp* x,
+    const size_type& num_iterations, const LinOp* residual,
+    const LinOp* residual_norm, const LinOp* implicit_resnorm_sq,
+    const array<stopping_status>* status, bool stopped) const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    for (auto it = stack_.rbegin(); it != stack_.rend(); ++it) {
+        if (it->solver == solver) {
+            it->iterations = std::max(it->iterations,
+                                      static_cast<int64>(num_iterations));
+            break;
+        }
+    }
+}
+
+
+bool SolverProfiler::needs_propagation() const { return true; }
+
+
+std::vector<SolverProfiler::summary> SolverProfiler::get_summaries() const
+{
+    std::lock_guard<std::mutex> guard{mutex_};
+    return summaries_;
+}
+
+
+void SolverProfiler::write(std::ostream& output) const
+{
+    const auto summaries = get_summaries();
+    std::vector<std::string> headers{"solver", "applies", "iterations",
+                                     "time", "time/iteration"};
+    for (int p = 0; p < num_phases; p++) {
+        headers.push_back(get_phase_name(static_cast<phase>(p)));
+    }
+    std::vector<std::vector<std::string>> table;
+    for (const auto& s : summaries) {
+        std::vector<std::string> row{s.name, std::to_string(s.count),
+                                     std::to_string(s.iterations),
+                                     format_time(s.time)};
+        row.push_back(s.iterations > 0 ? format_time(s.time / s.iterations)
+                                       : "-");
+        for (int p = 0; p < num_phases; p++) {
+            row.push_back(
+                s.time.count() > 0
+                    ? format_number(100.0 * s.phase_time[p].count() /
+                                        s.time.count(),
+                                    "%")
+                    : "-");
+        }
+        table.push_back(std::move(row));
+    }
+    std::vector<std::size_t> widths(headers.size());
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        widths[i] = headers[i].size();
+        for (const auto& row : table) {
+            widths[i] = std::max(widths[i], row[i].size());
+        }
+    }
+    output << "Solver phase breakdown\n|";
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        output << ' ' << std::setw(widths[i]) << std::left << headers[i]
+               << " |";
+    }
+    output << "\n|";
+    for (std::size_t i = 0; i < headers.size(); i++) {
+        output << std::string(widths[i] + 1, '-') << (i == 0 ? "-|" : ":|");
+    }
+    output << '\n';
+    for (const auto& row : table) {
+        output << '|';
+        for (std::size_t i = 0; i < row.size(); i++) {
+            output << ' ' << std::setw(widths[i])
+                   << (i == 0 ? std::left : std::right) << row[i] << " |";
+        }
+        output << '\n';
+    }
+    output << std::right;
+}
+
+
+constexpr int SolverProfiler::num_phases;
+constexpr Logger::mask_type SolverProfiler::mask_;
+
+
+}  // namespace log
+}  // namespace gko
@@ -5,6 +5,10 @@
 #include <ginkgo/core/matrix/csr.hpp>
 
 
+#include <algorithm>
+#include <numeric>
+
+
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/executor.hpp>
@@ -13,6 +17,7 @@
 #include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/base/utils.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
+#include <ginkgo/core/matrix/delta_csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/matrix/ell.hpp>
 #include <ginkgo/core/matrix/fbcsr.hpp>
@@ -30,6 +35,7 @@
 #include "core/components/format_conversion_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
 #include "core/matrix/csr_kernels.hpp"
+#include "core/matrix/delta_csr_kernels.hpp"
 #include "core/matrix/ell_kernels.hpp"
 #include "core/matrix/hybrid_kernels.hpp"
 #include "core/matrix/permutation.hpp"
@@ -52,6 +58,8 @@ GKO_REGISTER_OPERATION(convert_ptrs_to_idxs, components::convert_ptrs_to_idxs);
 GKO_REGISTER_OPERATION(fill_in_dense, csr::fill_in_dense);
 GKO_REGISTER_OPERATION(compute_slice_sets, sellp::compute_slice_sets);
 GKO_REGISTER_OPERATION(convert_to_sellp, csr::convert_to_sellp);
+GKO_REGISTER_OPERATION(compute_delta_sizes, delta_csr::compute_delta_sizes);
+GKO_REGISTER_OPERATION(fill_in_deltas, delta_csr::fill_in_deltas);
 GKO_REGISTER_OPERATION(compute_max_row_nnz, ell::compute_max_row_nnz);
 GKO_REGISTER_OPERATION(convert_to_ell, csr::convert_to_ell);
 GKO_REGISTER_OPERATION(convert_to_fbcsr, csr::convert_to_fbcsr);
@@ -99,6 +107,76 @@ GKO_REGISTER_OPERATION(check_diagonal_entries,
 GKO_REGISTER_OPERATION(aos_to_soa, components::aos_to_soa);
 
 
+/**
+ * Computes the SELL-C-sigma row permutation, which orders the rows within each
+ * window of `sorting_window` consecutive rows by decreasing number of nonzeros.
+ */
+template <typename IndexType>
+array<IndexType> compute_sorting_window_permutation(
+    const array<IndexType>& row_ptrs, size_type sorting_window)
+{
+    const auto host_exec = row_ptrs.get_executor()->get_master();
+    const auto host_row_ptrs = make_temporary_clone(host_exec, &row_ptrs);
+    const auto ptrs = host_row_ptrs->get_const_data();
+    const auto num_rows = static_cast<IndexType>(row_ptrs.get_size() - 1);
+    array<IndexType> permutation{host_exec, row_ptrs.get_size() - 1};
+    const auto perm = permutation.get_data();
+    std::iota(perm, perm + num_rows, IndexType{});
+    const auto window = static_cast<IndexType>(sorting_window);
+    for (IndexType begin = 0; begin < num_rows; begin += window) {
+        const auto end = std::min(begin + window, num_rows);
+        std::stable_sort(perm + begin, perm + end, [&](auto a, auto b) {
+            return ptrs[a + 1] - ptrs[a] > ptrs[b + 1] - ptrs[b];
+        });
+    }
+    return permutation;
+}
+
+
+template <typename ValueType, typename Function>
+bool reduced_storage_dispatch(Function, const LinOp*, LinOp*, std::false_type)
+{
+    return false;
+}
+
+
+template <typename ValueType, typename Function>
+bool reduced_storage_dispatch(Function fn, const LinOp* in, LinOp* out,
+                              std::true_type)
+{
+    using Vec = Dense<next_precision<ValueType>>;
+    auto dense_in = dynamic_cast<const Vec*>(in);
+    auto dense_out = dynamic_cast<Vec*>(out);
+    if (dense_in && dense_out) {
+        fn(dense_in, dense_out);
+        return true;
+    }
+    return false;
+}
+
+
+/**
+ * Calls `fn` with `in` and `out` if both are Dense vectors in the next higher
+ * precision than the matrix values. The SpMV kernels for these combinations
+ * are always instantiated, so a matrix storing its values in reduced
+ * precision is applied without converting the vectors, independent of
+ * GINKGO_MIXED_PRECISION.
+ *
+ * @return true if `fn` was called, false otherwise
+ */
+template <typename ValueType, typename Function>
+bool reduced_storage_dispatch(Function fn, const LinOp* in, LinOp* out)
+{
+    using is_reduced_storage =
+        std::integral_constant<bool,
+                               (sizeof(remove_complex<ValueType>) <
+                                sizeof(remove_complex<next_precision<
+                                           ValueType>>))>;
+    return reduced_storage_dispatch<ValueType>(fn, in, out,
+                                               is_reduced_storage{});
+}
+
+
 }  // anonymous namespace
 }  // namespace csr
 
@@ -257,12 +335,12 @@ void Csr<ValueType, IndexType>::apply_impl(const LinOp* b, LinOp* x) const
         auto x_csr = as<TCsr>(x);
         this->get_executor()->run(csr::make_spgemm(this, b_csr, x_csr));
     } else {
-        mixed_precision_dispatch_real_complex<ValueType>(
-            [this](auto dense_b, auto dense_x) {
-                this->get_executor()->run(
-                    csr::make_spmv(this, dense_b, dense_x));
-            },
-            b, x);
+        auto spmv = [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(csr::make_spmv(this, dense_b, dense_x));
+        };
+        if (!csr::reduced_storage_dispatch<ValueType>(spmv, b, x)) {
+            mixed_precision_dispatch_real_complex<ValueType>(spmv, b, x);
+        }
     }
 }
 
@@ -289,17 +367,18 @@ void Csr<ValueType, IndexType>::apply_impl(const LinOp* alpha, const LinOp* b,
             csr::make_spgeam(as<Dense<ValueType>>(alpha), this,
                              as<Dense<ValueType>>(beta), x_copy.get(), x_csr));
     } else {
-        mixed_precision_dispatch_real_complex<ValueType>(
-            [this, alpha, beta](auto dense_b, auto dense_x) {
-                auto dense_alpha = make_temporary_conversion<ValueType>(alpha);
-                auto dense_beta = make_temporary_conversion<
-                    typename std::decay_t<decltype(*dense_x)>::value_type>(
-                    beta);
-                this->get_executor()->run(
-                    csr::make_advanced_spmv(dense_alpha.get(), this, dense_b,
-                                            dense_beta.get(), dense_x));
-            },
-            b, x);
+        auto advanced_spmv = [this, alpha, beta](auto dense_b, auto dense_x) {
+            auto dense_alpha = make_temporary_conversion<ValueType>(alpha);
+            auto dense_beta = make_temporary_conversion<
+                typename std::decay_t<decltype(*dense_x)>::value_type>(beta);
+            this->get_executor()->run(
+                csr::make_advanced_spmv(dense_alpha.get(), this, dense_b,
+                                        dense_beta.get(), dense_x));
+        };
+        if (!csr::reduced_storage_dispatch<ValueType>(advanced_spmv, b, x)) {
+            mixed_precision_dispatch_real_complex<ValueType>(advanced_spmv, b,
+                                                             x);
+        }
     }
 }
 
@@ -406,22 +485,38 @@ void Csr<ValueType, IndexType>::convert_to(
     auto exec = this->get_executor();
     const auto stride_factor = result->get_stride_factor();
     const auto slice_size = result->get_slice_size();
+    const auto sorting_window = result->get_sorting_window();
     const auto num_rows = this->get_size()[0];
     const auto num_slices = ceildiv(num_rows, slice_size);
     auto tmp = make_temporary_clone(exec, result);
+    auto source = this;
+    std::unique_ptr<Csr> sorted;
+    if (sorting_window > 1) {
+        tmp->permutation_ = array<IndexType>{
+            exec, csr::compute_sorting_window_permutation(this->row_ptrs_,
+                                                          sorting_window)};
+        sorted = this->permute(
+            Permutation<IndexType>::create_const(
+                exec, make_const_array_view(
+                          exec, num_rows, tmp->permutation_.get_const_data())),
+            permute_mode::rows);
+        source = sorted.get();
+    } else {
+        tmp->permutation_.resize_and_reset(0);
+    }
     tmp->slice_sets_.resize_and_reset(num_slices + 1);
     tmp->slice_lengths_.resize_and_reset(num_slices);
     tmp->stride_factor_ = stride_factor;
     tmp->slice_size_ = slice_size;
-    exec->run(csr::make_compute_slice_sets(this->row_ptrs_, slice_size,
-                                           stride_factor, tmp->get_slice_sets(),
-                                           tmp->get_slice_lengths()));
+    exec->run(csr::make_compute_slice_sets(
+        source->row_ptrs_, slice_size, stride_factor, tmp->get_slice_sets(),
+        tmp->get_slice_lengths()));
     auto total_cols =
         exec->copy_val_to_host(tmp->get_slice_sets() + num_slices);
     tmp->col_idxs_.resize_and_reset(total_cols * slice_size);
     tmp->values_.resize_and_reset(total_cols * slice_size);
     tmp->set_size(this->get_size());
-    exec->run(csr::make_convert_to_sellp(this, tmp.get()));
+    exec->run(csr::make_convert_to_sellp(source, tmp.get()));
 }
 
 
@@ -454,6 +549,36 @@ void Csr<ValueType, IndexType>::move_to(
 }
 
 
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::convert_to(
+    DeltaCsr<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    const auto num_rows = this->get_size()[0];
+    auto tmp = make_temporary_clone(exec, result);
+    tmp->values_ = this->values_;
+    tmp->row_ptrs_ = this->row_ptrs_;
+    tmp->row_bases_.resize_and_reset(num_rows);
+    tmp->delta_ptrs_.resize_and_reset(num_rows + 1);
+    exec->run(csr::make_compute_delta_sizes(
+        this, tmp->get_row_bases(), tmp->get_delta_ptrs()));
+    exec->run(csr::make_prefix_sum_nonnegative(tmp->get_delta_ptrs(),
+                                               num_rows + 1));
+    const auto num_bytes =
+        static_cast<size_type>(get_element(tmp->delta_ptrs_, num_rows));
+    tmp->deltas_.resize_and_reset(num_bytes);
+    tmp->set_size(this->get_size());
+    exec->run(csr::make_fill_in_deltas(this, tmp.get()));
+}
+
+
+template <typename ValueType, typename IndexType>
+void Csr<ValueType, IndexType>::move_to(DeltaCsr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
 template <typename ValueType, typename IndexType>
 void Csr<ValueType, IndexType>::convert_to(
     Ell<ValueType, IndexType>* result) const
@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/matrix/delta_csr.hpp>
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/precision_dispatch.hpp>
+#include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/delta_csr_kernels.hpp"
+
+
+namespace gko {
+namespace matrix {
+namespace delta_csr {
+namespace {
+
+
+GKO_REGISTER_OPERATION(spmv, delta_csr::spmv);
+GKO_REGISTER_OPERATION(advanced_spmv, delta_csr::advanced_spmv);
+GKO_REGISTER_OPERATION(convert_to_csr, delta_csr::convert_to_csr);
+
+
+}  // anonymous namespace
+}  // namespace delta_csr
+
+
+template <typename ValueType, typename IndexType>
+DeltaCsr<ValueType, IndexType>& DeltaCsr<ValueType, IndexType>::operator=(
+    const DeltaCsr& other)
+{
+    if (&other != this) {
+        EnableLinOp<DeltaCsr>::operator=(other);
+        values_ = other.values_;
+        row_ptrs_ = other.row_ptrs_;
+        row_bases_ = other.row_bases_;
+        delta_ptrs_ = other.delta_ptrs_;
+        deltas_ = other.deltas_;
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+DeltaCsr<ValueType, IndexType>& DeltaCsr<ValueType, IndexType>::operator=(
+    DeltaCsr&& other)
+{
+    if (&other != this) {
+        EnableLinOp<DeltaCsr>::operator=(std::move(other));
+        values_ = std::move(other.values_);
+        row_ptrs_ = std::move(other.row_ptrs_);
+        row_bases_ = std::move(other.row_bases_);
+        delta_ptrs_ = std::move(other.delta_ptrs_);
+        deltas_ = std::move(other.deltas_);
+        // restore other invariant
+        other.row_ptrs_.resize_and_reset(1);
+        other.row_ptrs_.fill(0);
+        other.delta_ptrs_.resize_and_reset(1);
+        other.delta_ptrs_.fill(0);
+    }
+    return *this;
+}
+
+
+template <typename ValueType, typename IndexType>
+DeltaCsr<ValueType, IndexType>::DeltaCsr(const DeltaCsr& other)
+    : DeltaCsr{other.get_executor()}
+{
+    *this = other;
+}
+
+
+template <typename ValueType, typename IndexType>
+DeltaCsr<ValueType, IndexType>::DeltaCsr(DeltaCsr&& other)
+    : DeltaCsr{other.get_executor()}
+{
+    *this = std::move(other);
+}
+
+
+template <typename ValueType, typename IndexType>
+DeltaCsr<ValueType, IndexType>::DeltaCsr(std::shared_ptr<const Executor> exec,
+                                         const dim<2>& size)
+    : EnableLinOp<DeltaCsr>(exec, size),
+      values_(exec),
+      row_ptrs_(exec, size[0] + 1),
+      row_bases_(exec, size[0]),
+      delta_ptrs_(exec, size[0] + 1),
+      deltas_(exec)
+{
+    row_ptrs_.fill(0);
+    row_bases_.fill(0);
+    delta_ptrs_.fill(0);
+}
+
+
+template <typename ValueType, typename IndexType>
+std::unique_ptr<DeltaCsr<ValueType, IndexType>>
+DeltaCsr<ValueType, IndexType>::create(std::shared_ptr<const Executor> exec,
+                                       const dim<2>& size)
+{
+    return std::unique_ptr<DeltaCsr>{new DeltaCsr{exec, size}};
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::apply_impl(const LinOp* b, LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_b, auto dense_x) {
+            this->get_executor()->run(
+                delta_csr::make_spmv(this, dense_b, dense_x));
+        },
+        b, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::apply_impl(const LinOp* alpha,
+                                                const LinOp* b,
+                                                const LinOp* beta,
+                                                LinOp* x) const
+{
+    precision_dispatch_real_complex<ValueType>(
+        [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
+            this->get_executor()->run(delta_csr::make_advanced_spmv(
+                dense_alpha, this, dense_b, dense_beta, dense_x));
+        },
+        alpha, b, beta, x);
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::convert_to(
+    Csr<ValueType, IndexType>* result) const
+{
+    auto exec = this->get_executor();
+    {
+        auto tmp = make_temporary_clone(exec, result);
+        tmp->row_ptrs_ = row_ptrs_;
+        tmp->values_ = values_;
+        tmp->col_idxs_.resize_and_reset(values_.get_size());
+        tmp->set_size(this->get_size());
+        exec->run(delta_csr::make_convert_to_csr(this, tmp.get()));
+    }
+    result->make_srow();
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::move_to(Csr<ValueType, IndexType>* result)
+{
+    this->convert_to(result);
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::read(const device_mat_data& data)
+{
+    // the row bases and delta widths are computed in the conversion from Csr
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    tmp->read(data);
+    tmp->convert_to(this);
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::read(device_mat_data&& data)
+{
+    this->read(data);
+    data.empty_out();
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::read(const mat_data& data)
+{
+    this->read(device_mat_data::create_from_host(this->get_executor(), data));
+}
+
+
+template <typename ValueType, typename IndexType>
+void DeltaCsr<ValueType, IndexType>::write(mat_data& data) const
+{
+    auto tmp = Csr<ValueType, IndexType>::create(this->get_executor());
+    this->convert_to(tmp.get());
+    tmp->write(data);
+}
+
+
+#define GKO_DECLARE_DELTA_CSR_MATRIX(ValueType, IndexType) \
+    class DeltaCsr<ValueType, IndexType>
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_DELTA_CSR_MATRIX);
+
+
+}  // namespace matrix
+}  // namespace gko
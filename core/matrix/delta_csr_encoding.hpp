@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_CORE_MATRIX_DELTA_CSR_ENCODING_HPP_
+#define GKO_CORE_MATRIX_DELTA_CSR_ENCODING_HPP_
+
+
+#include <cstring>
+
+
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace matrix {
+namespace delta_csr {
+
+
+/**
+ * Returns the number of bytes needed to store the column deltas of a row
+ * whose column indices lie in the range [base, base + span].
+ */
+template <typename IndexType>
+inline int delta_width(IndexType span)
+{
+    const auto wide_span = static_cast<uint64>(span);
+    if (wide_span <= 0xffu) {
+        return 1;
+    }
+    if (wide_span <= 0xffffu) {
+        return 2;
+    }
+    if (wide_span <= 0xffffffffu) {
+        return 4;
+    }
+    return 8;
+}
+
+
+/**
+ * Returns the width in bytes of the deltas of a row with `nnz` nonzeros whose
+ * deltas occupy the bytes [row_begin, row_end) of the delta array.
+ */
+template <typename IndexType>
+inline int row_delta_width(int64 row_begin, int64 row_end, IndexType nnz)
+{
+    return nnz == 0 ? 1 : static_cast<int>((row_end - row_begin) / nnz);
+}
+
+
+/**
+ * Loads the `i`-th delta of a row that stores its deltas as DeltaType.
+ * The deltas are not necessarily aligned, so they are read bytewise.
+ */
+template <typename DeltaType>
+inline DeltaType load_delta(const uint8* deltas, size_type i)
+{
+    DeltaType delta;
+    std::memcpy(&delta, deltas + i * sizeof(DeltaType), sizeof(DeltaType));
+    return delta;
+}
+
+
+/**
+ * Stores the `i`-th delta of a row that stores its deltas as DeltaType.
+ */
+template <typename DeltaType>
+inline void store_delta(uint8* deltas, size_type i, DeltaType delta)
+{
+    std::memcpy(deltas + i * sizeof(DeltaType), &delta, sizeof(DeltaType));
+}
+
+
+/**
+ * Calls `fn` with a value of the unsigned integer type of the given width in
+ * bytes, so the delta decoding loops can be instantiated for each width.
+ */
+template <typename Fn>
+inline void dispatch_delta_width(int width, Fn&& fn)
+{
+    switch (width) {
+    case 1:
+        fn(uint8{});
+        break;
+    case 2:
+        fn(uint16{});
+        break;
+    case 4:
+        fn(uint32{});
+        break;
+    default:
+        fn(uint64{});
+    }
+}
+
+
+}  // namespace delta_csr
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_CORE_MATRIX_DELTA_CSR_ENCODING_HPP_
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_CORE_MATRIX_DELTA_CSR_KERNELS_HPP_
+#define GKO_CORE_MATRIX_DELTA_CSR_KERNELS_HPP_
+
+
+#include <ginkgo/core/matrix/delta_csr.hpp>
+
+
+#include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/base/kernel_declaration.hpp"
+
+
+namespace gko {
+namespace kernels {
+
+
+#define GKO_DECLARE_DELTA_CSR_SPMV_KERNEL(ValueType, IndexType) \
+    void spmv(std::shared_ptr<const DefaultExecutor> exec,      \
+              const matrix::DeltaCsr<ValueType, IndexType>* a,  \
+              const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+
+#define GKO_DECLARE_DELTA_CSR_ADVANCED_SPMV_KERNEL(ValueType, IndexType) \
+    void advanced_spmv(std::shared_ptr<const DefaultExecutor> exec,      \
+                       const matrix::Dense<ValueType>* alpha,            \
+                       const matrix::DeltaCsr<ValueType, IndexType>* a,  \
+                       const matrix::Dense<ValueType>* b,                \
+                       const matrix::Dense<ValueType>* beta,             \
+                       matrix::Dense<ValueType>* c)
+
+#define GKO_DECLARE_DELTA_CSR_COMPUTE_DELTA_SIZES_KERNEL(ValueType, IndexType) \
+    void compute_delta_sizes(std::shared_ptr<const DefaultExecutor> exec,      \
+                             const matrix::Csr<ValueType, IndexType>* source,  \
+                             IndexType* row_bases, int64* delta_sizes)
+
+#define GKO_DECLARE_DELTA_CSR_FILL_IN_DELTAS_KERNEL(ValueType, IndexType) \
+    void fill_in_deltas(std::shared_ptr<const DefaultExecutor> exec,      \
+                        const matrix::Csr<ValueType, IndexType>* source,  \
+                        matrix::DeltaCsr<ValueType, IndexType>* result)
+
+#define GKO_DECLARE_DELTA_CSR_CONVERT_TO_CSR_KERNEL(ValueType, IndexType) \
+    void convert_to_csr(                                                  \
+        std::shared_ptr<const DefaultExecutor> exec,                      \
+        const matrix::DeltaCsr<ValueType, IndexType>* source,             \
+        matrix::Csr<ValueType, IndexType>* result)
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                                        \
+    template <typename ValueType, typename IndexType>                       \
+    GKO_DECLARE_DELTA_CSR_SPMV_KERNEL(ValueType, IndexType);                \
+    template <typename ValueType, typename IndexType>                       \
+    GKO_DECLARE_DELTA_CSR_ADVANCED_SPMV_KERNEL(ValueType, IndexType);       \
+    template <typename ValueType, typename IndexType>                       \
+    GKO_DECLARE_DELTA_CSR_COMPUTE_DELTA_SIZES_KERNEL(ValueType, IndexType); \
+    template <typename ValueType, typename IndexType>                       \
+    GKO_DECLARE_DELTA_CSR_FILL_IN_DELTAS_KERNEL(ValueType, IndexType);      \
+    template <typename ValueType, typename IndexType>                       \
+    GKO_DECLARE_DELTA_CSR_CONVERT_TO_CSR_KERNEL(ValueType, IndexType)
+
+
+GKO_DECLARE_FOR_ALL_EXECUTOR_NAMESPACES(delta_csr,
+                                        GKO_DECLARE_ALL_AS_TEMPLATES);
+
+
+#undef GKO_DECLARE_ALL_AS_TEMPLATES
+
+
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_CORE_MATRIX_DELTA_CSR_KERNELS_HPP_
@@ -859,6 +859,13 @@ template <typename IndexType>
 void Dense<ValueType>::convert_impl(Sellp<ValueType, IndexType>* result) const
 {
     auto exec = this->get_executor();
+    if (result->get_sorting_window() > 1) {
+        // the row sorting is computed as part of the conversion from Csr
+        auto tmp = Csr<ValueType, IndexType>::create(exec);
+        this->convert_to(tmp.get());
+        tmp->convert_to(result);
+        return;
+    }
     const auto num_rows = this->get_size()[0];
     const auto stride_factor = result->get_stride_factor();
     const auto slice_size = result->get_slice_size();
@@ -868,6 +875,7 @@ void Dense<ValueType>::convert_impl(Sellp<ValueType, IndexType>* result) const
     tmp->slice_size_ = slice_size;
     tmp->slice_sets_.resize_and_reset(num_slices + 1);
     tmp->slice_lengths_.resize_and_reset(num_slices);
+    tmp->permutation_.resize_and_reset(0);
     exec->run(dense::make_compute_slice_sets(this, slice_size, stride_factor,
                                              tmp->get_slice_sets(),
                                              tmp->get_slice_lengths()));
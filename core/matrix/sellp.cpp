@@ -12,6 +12,7 @@
 #include <ginkgo/core/base/utils.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/permutation.hpp>
 
 
 #include "core/base/allocator.hpp"
@@ -48,6 +49,16 @@ GKO_REGISTER_OPERATION(outplace_absolute_array,
                        components::outplace_absolute_array);
 
 
+template <typename IndexType>
+std::unique_ptr<const Permutation<IndexType>> make_row_permutation(
+    std::shared_ptr<const Executor> exec, const array<IndexType>& permutation)
+{
+    return Permutation<IndexType>::create_const(
+        exec, make_const_array_view(exec, permutation.get_size(),
+                                    permutation.get_const_data()));
+}
+
+
 }  // anonymous namespace
 }  // namespace sellp
 
@@ -64,6 +75,8 @@ Sellp<ValueType, IndexType>& Sellp<ValueType, IndexType>::operator=(
         slice_sets_ = other.slice_sets_;
         slice_size_ = other.slice_size_;
         stride_factor_ = other.stride_factor_;
+        sorting_window_ = other.sorting_window_;
+        permutation_ = other.permutation_;
     }
     return *this;
 }
@@ -82,6 +95,8 @@ Sellp<ValueType, IndexType>& Sellp<ValueType, IndexType>::operator=(
         // slice_size and stride_factor are immutable
         slice_size_ = other.slice_size_;
         stride_factor_ = other.stride_factor_;
+        sorting_window_ = other.sorting_window_;
+        permutation_ = std::move(other.permutation_);
         // restore other invariant
         other.slice_sets_.resize_and_reset(1);
         other.slice_sets_.fill(0);
@@ -118,13 +133,26 @@ Sellp<ValueType, IndexType>::Sellp(std::shared_ptr<const Executor> exec,
                                    const dim<2>& size, size_type slice_size,
                                    size_type stride_factor,
                                    size_type total_cols)
+    : Sellp(std::move(exec), size, slice_size, stride_factor,
+            default_sorting_window, total_cols)
+{}
+
+
+template <typename ValueType, typename IndexType>
+Sellp<ValueType, IndexType>::Sellp(std::shared_ptr<const Executor> exec,
+                                   const dim<2>& size, size_type slice_size,
+                                   size_type stride_factor,
+                                   size_type sorting_window,
+                                   size_type total_cols)
     : EnableLinOp<Sellp>(exec, size),
       values_(exec, slice_size * total_cols),
       col_idxs_(exec, slice_size * total_cols),
       slice_lengths_(exec, ceildiv(size[0], slice_size)),
       slice_sets_(exec, ceildiv(size[0], slice_size) + 1),
       slice_size_(slice_size),
-      stride_factor_(stride_factor)
+      stride_factor_(stride_factor),
+      sorting_window_(std::max<size_type>(sorting_window, 1)),
+      permutation_(exec)
 {
     slice_sets_.fill(0);
     slice_lengths_.fill(0);
@@ -152,12 +180,35 @@ Sellp<ValueType, IndexType>::create(std::shared_ptr<const Executor> exec,
 }
 
 
+template <typename ValueType, typename IndexType>
+std::unique_ptr<Sellp<ValueType, IndexType>>
+Sellp<ValueType, IndexType>::create(std::shared_ptr<const Executor> exec,
+                                    const dim<2>& size, size_type slice_size,
+                                    size_type stride_factor,
+                                    size_type sorting_window,
+                                    size_type total_cols)
+{
+    return std::unique_ptr<Sellp>{new Sellp{exec, size, slice_size,
+                                            stride_factor, sorting_window,
+                                            total_cols}};
+}
+
+
 template <typename ValueType, typename IndexType>
 void Sellp<ValueType, IndexType>::apply_impl(const LinOp* b, LinOp* x) const
 {
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_b, auto dense_x) {
-            this->get_executor()->run(sellp::make_spmv(this, dense_b, dense_x));
+            auto exec = this->get_executor();
+            if (permutation_.get_size() == 0) {
+                exec->run(sellp::make_spmv(this, dense_b, dense_x));
+                return;
+            }
+            // compute the result in storage order and scatter it back
+            auto sorted_x = dense_x->create_with_same_config();
+            exec->run(sellp::make_spmv(this, dense_b, sorted_x.get()));
+            sorted_x->permute(sellp::make_row_permutation(exec, permutation_),
+                              dense_x, permute_mode::inverse_rows);
         },
         b, x);
 }
@@ -169,8 +220,18 @@ void Sellp<ValueType, IndexType>::apply_impl(const LinOp* alpha, const LinOp* b,
 {
     precision_dispatch_real_complex<ValueType>(
         [this](auto dense_alpha, auto dense_b, auto dense_beta, auto dense_x) {
-            this->get_executor()->run(sellp::make_advanced_spmv(
-                dense_alpha, this, dense_b, dense_beta, dense_x));
+            auto exec = this->get_executor();
+            if (permutation_.get_size() == 0) {
+                exec->run(sellp::make_advanced_spmv(dense_alpha, this, dense_b,
+                                                    dense_beta, dense_x));
+                return;
+            }
+            // gather x into storage order, update it and scatter it back
+            auto perm = sellp::make_row_permutation(exec, permutation_);
+            auto sorted_x = dense_x->permute(perm, permute_mode::rows);
+            exec->run(sellp::make_advanced_spmv(dense_alpha, this, dense_b,
+                                                dense_beta, sorted_x.get()));
+            sorted_x->permute(perm, dense_x, permute_mode::inverse_rows);
         },
         alpha, b, beta, x);
 }
@@ -186,6 +247,8 @@ void Sellp<ValueType, IndexType>::convert_to(
     result->slice_sets_ = this->slice_sets_;
     result->slice_size_ = this->slice_size_;
     result->stride_factor_ = this->stride_factor_;
+    result->sorting_window_ = this->sorting_window_;
+    result->permutation_ = this->permutation_;
     result->set_size(this->get_size());
 }
 
@@ -204,8 +267,16 @@ void Sellp<ValueType, IndexType>::convert_to(Dense<ValueType>* result) const
     auto exec = this->get_executor();
     auto tmp_result = make_temporary_output_clone(exec, result);
     tmp_result->resize(this->get_size());
-    tmp_result->fill(zero<ValueType>());
-    exec->run(sellp::make_fill_in_dense(this, tmp_result.get()));
+    if (permutation_.get_size() == 0) {
+        tmp_result->fill(zero<ValueType>());
+        exec->run(sellp::make_fill_in_dense(this, tmp_result.get()));
+        return;
+    }
+    auto sorted = Dense<ValueType>::create(exec, this->get_size());
+    sorted->fill(zero<ValueType>());
+    exec->run(sellp::make_fill_in_dense(this, sorted.get()));
+    sorted->permute(sellp::make_row_permutation(exec, permutation_),
+                    tmp_result.get(), permute_mode::inverse_rows);
 }
 
 
@@ -222,8 +293,8 @@ void Sellp<ValueType, IndexType>::convert_to(
 {
     auto exec = this->get_executor();
     const auto num_rows = this->get_size()[0];
-    {
-        auto tmp = make_temporary_clone(exec, result);
+    auto convert = [&](Csr<ValueType, IndexType>* output) {
+        auto tmp = make_temporary_clone(exec, output);
         tmp->row_ptrs_.resize_and_reset(num_rows + 1);
         exec->run(sellp::make_count_nonzeros_per_row(
             this, tmp->row_ptrs_.get_data()));
@@ -235,6 +306,16 @@ void Sellp<ValueType, IndexType>::convert_to(
         tmp->values_.resize_and_reset(nnz);
         tmp->set_size(this->get_size());
         exec->run(sellp::make_convert_to_csr(this, tmp.get()));
+    };
+    if (permutation_.get_size() == 0) {
+        convert(result);
+    } else {
+        auto sorted = Csr<ValueType, IndexType>::create(exec);
+        convert(sorted.get());
+        sorted
+            ->permute(sellp::make_row_permutation(exec, permutation_),
+                      permute_mode::inverse_rows)
+            ->move_to(result);
     }
     result->make_srow();
 }
@@ -251,6 +332,14 @@ template <typename ValueType, typename IndexType>
 void Sellp<ValueType, IndexType>::read(const device_mat_data& data)
 {
     auto exec = this->get_executor();
+    if (sorting_window_ > 1) {
+        // the row sorting is computed as part of the conversion from Csr
+        auto tmp = Csr<ValueType, IndexType>::create(exec);
+        tmp->read(data);
+        tmp->convert_to(this);
+        return;
+    }
+    permutation_.resize_and_reset(0);
     const auto size = data.get_size();
     slice_lengths_.resize_and_reset(ceildiv(size[0], slice_size_));
     slice_sets_.resize_and_reset(ceildiv(size[0], slice_size_) + 1);
@@ -295,6 +384,7 @@ void Sellp<ValueType, IndexType>::write(mat_data& data) const
     data = {tmp->get_size(), {}};
 
     auto slice_size = tmp->get_slice_size();
+    auto permutation = tmp->get_const_permutation();
     size_type slice_num = static_cast<index_type>(
         (tmp->get_size()[0] + slice_size - 1) / slice_size);
     for (size_type slice = 0; slice < slice_num; slice++) {
@@ -308,12 +398,16 @@ void Sellp<ValueType, IndexType>::write(mat_data& data) const
                     const auto col = tmp->col_at(row_in_slice, slice_offset, i);
                     const auto val = tmp->val_at(row_in_slice, slice_offset, i);
                     if (col != invalid_index<IndexType>()) {
-                        data.nonzeros.emplace_back(row, col, val);
+                        data.nonzeros.emplace_back(
+                            permutation ? permutation[row] : row, col, val);
                     }
                 }
             }
         }
     }
+    if (permutation) {
+        data.sort_row_major();
+    }
 }
 
 
@@ -322,6 +416,11 @@ std::unique_ptr<Diagonal<ValueType>>
 Sellp<ValueType, IndexType>::extract_diagonal() const
 {
     auto exec = this->get_executor();
+    if (permutation_.get_size() > 0) {
+        auto csr = Csr<ValueType, IndexType>::create(exec);
+        this->convert_to(csr.get());
+        return csr->extract_diagonal();
+    }
 
     const auto diag_size = std::min(this->get_size()[0], this->get_size()[1]);
     auto diag = Diagonal<ValueType>::create(exec, diag_size);
@@ -350,9 +449,11 @@ Sellp<ValueType, IndexType>::compute_absolute() const
 
     auto abs_sellp = absolute_type::create(
         exec, this->get_size(), this->get_slice_size(),
-        this->get_stride_factor(), this->get_total_cols());
+        this->get_stride_factor(), this->get_sorting_window(),
+        this->get_total_cols());
 
     abs_sellp->col_idxs_ = col_idxs_;
+    abs_sellp->permutation_ = permutation_;
     abs_sellp->slice_lengths_ = slice_lengths_;
     abs_sellp->slice_sets_ = slice_sets_;
     exec->run(sellp::make_outplace_absolute_array(
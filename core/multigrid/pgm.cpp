@@ -5,12 +5,20 @@
 #include <ginkgo/core/multigrid/pgm.hpp>
 
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/executor.hpp>
 #include <ginkgo/core/base/polymorphic_object.hpp>
 #include <ginkgo/core/base/types.hpp>
 #include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/distributed/partition_helpers.hpp>
 #include <ginkgo/core/matrix/coo.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
@@ -19,9 +27,11 @@
 #include <ginkgo/core/matrix/sparsity_csr.hpp>
 
 
+#include "core/base/dispatch_helper.hpp"
 #include "core/base/utils.hpp"
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/format_conversion_kernels.hpp"
+#include "core/distributed/helpers.hpp"
 #include "core/matrix/csr_builder.hpp"
 #include "core/multigrid/pgm_kernels.hpp"
 
@@ -112,34 +122,23 @@ std::shared_ptr<matrix::Csr<ValueType, IndexType>> generate_coarse(
 }
 
 
-}  // namespace
-
-
-template <typename ValueType, typename IndexType>
-void Pgm<ValueType, IndexType>::generate()
+/**
+ * Computes the aggregates of the rows of pgm_op by repeated parallel graph
+ * matching and returns the number of aggregates.
+ */
+template <typename ValueType, typename IndexType, typename ParametersType>
+IndexType aggregate(std::shared_ptr<const Executor> exec,
+                    const matrix::Csr<ValueType, IndexType>* pgm_op,
+                    const ParametersType& parameters, array<IndexType>& agg)
 {
-    using csr_type = matrix::Csr<ValueType, IndexType>;
     using real_type = remove_complex<ValueType>;
-    using weight_csr_type = remove_complex<csr_type>;
-    auto exec = this->get_executor();
-    const auto num_rows = this->system_matrix_->get_size()[0];
-    array<IndexType> strongest_neighbor(this->get_executor(), num_rows);
-    array<IndexType> intermediate_agg(this->get_executor(),
-                                      parameters_.deterministic * num_rows);
-    // Only support csr matrix currently.
-    const csr_type* pgm_op =
-        dynamic_cast<const csr_type*>(system_matrix_.get());
-    std::shared_ptr<const csr_type> pgm_op_shared_ptr{};
-    // If system matrix is not csr or need sorting, generate the csr.
-    if (!parameters_.skip_sorting || !pgm_op) {
-        pgm_op_shared_ptr = convert_to_with_sorting<csr_type>(
-            exec, system_matrix_, parameters_.skip_sorting);
-        pgm_op = pgm_op_shared_ptr.get();
-        // keep the same precision data in fine_op
-        this->set_fine_op(pgm_op_shared_ptr);
-    }
+    using weight_csr_type = remove_complex<matrix::Csr<ValueType, IndexType>>;
+    const auto num_rows = pgm_op->get_size()[0];
+    array<IndexType> strongest_neighbor(exec, num_rows);
+    array<IndexType> intermediate_agg(exec,
+                                      parameters.deterministic * num_rows);
     // Initial agg = -1
-    exec->run(pgm::make_fill_array(agg_.get_data(), agg_.get_size(),
+    exec->run(pgm::make_fill_array(agg.get_data(), agg.get_size(),
                                    -one<IndexType>()));
     IndexType num_unagg = num_rows;
     IndexType num_unagg_prev = num_rows;
@@ -154,35 +153,162 @@ void Pgm<ValueType, IndexType>::generate()
     abs_mtx->apply(half_scalar, identity, half_scalar, weight_mtx);
     // Extract the diagonal value of matrix
     auto diag = weight_mtx->extract_diagonal();
-    for (int i = 0; i < parameters_.max_iterations; i++) {
+    for (int i = 0; i < parameters.max_iterations; i++) {
         // Find the strongest neighbor of each row
         exec->run(pgm::make_find_strongest_neighbor(
-            weight_mtx.get(), diag.get(), agg_, strongest_neighbor));
+            weight_mtx.get(), diag.get(), agg, strongest_neighbor));
         // Match edges
-        exec->run(pgm::make_match_edge(strongest_neighbor, agg_));
+        exec->run(pgm::make_match_edge(strongest_neighbor, agg));
         // Get the num_unagg
-        exec->run(pgm::make_count_unagg(agg_, &num_unagg));
+        exec->run(pgm::make_count_unagg(agg, &num_unagg));
         // no new match, all match, or the ratio of num_unagg/num is lower
         // than parameter.max_unassigned_ratio
         if (num_unagg == 0 || num_unagg == num_unagg_prev ||
-            num_unagg < parameters_.max_unassigned_ratio * num_rows) {
+            num_unagg < parameters.max_unassigned_ratio * num_rows) {
             break;
         }
         num_unagg_prev = num_unagg;
     }
     // Handle the left unassign points
-    if (num_unagg != 0 && parameters_.deterministic) {
+    if (num_unagg != 0 && parameters.deterministic) {
         // copy the agg to intermediate_agg
-        intermediate_agg = agg_;
+        intermediate_agg = agg;
     }
     if (num_unagg != 0) {
         // Assign all left points
         exec->run(pgm::make_assign_to_exist_agg(weight_mtx.get(), diag.get(),
-                                                agg_, intermediate_agg));
+                                                agg, intermediate_agg));
     }
     IndexType num_agg = 0;
     // Renumber the index
-    exec->run(pgm::make_renumber(agg_, &num_agg));
+    exec->run(pgm::make_renumber(agg, &num_agg));
+    return num_agg;
+}
+
+
+#if GINKGO_BUILD_MPI
+
+
+/**
+ * Sends all entries of data to the process target and returns the entries
+ * received from all processes. This needs to be called collectively.
+ */
+template <typename ValueType, typename IndexType>
+matrix_data<ValueType, IndexType> send_to_process(
+    std::shared_ptr<const Executor> host_exec,
+    experimental::mpi::communicator comm,
+    const matrix_data<ValueType, IndexType>& data,
+    experimental::distributed::comm_index_type target)
+{
+    using experimental::distributed::comm_index_type;
+    const auto num_parts = comm.size();
+    const auto nnz = data.nonzeros.size();
+    std::vector<comm_index_type> send_sizes(num_parts);
+    std::vector<comm_index_type> send_offsets(num_parts + 1);
+    std::vector<comm_index_type> recv_sizes(num_parts);
+    std::vector<comm_index_type> recv_offsets(num_parts + 1);
+    send_sizes[target] = static_cast<comm_index_type>(nnz);
+    comm.all_to_all(host_exec, send_sizes.data(), 1, recv_sizes.data(), 1);
+    std::partial_sum(send_sizes.begin(), send_sizes.end(),
+                     send_offsets.begin() + 1);
+    std::partial_sum(recv_sizes.begin(), recv_sizes.end(),
+                     recv_offsets.begin() + 1);
+    std::vector<IndexType> send_rows(nnz);
+    std::vector<IndexType> send_cols(nnz);
+    std::vector<ValueType> send_vals(nnz);
+    for (size_type i = 0; i < nnz; i++) {
+        send_rows[i] = data.nonzeros[i].row;
+        send_cols[i] = data.nonzeros[i].column;
+        send_vals[i] = data.nonzeros[i].value;
+    }
+    const auto recv_nnz = static_cast<size_type>(recv_offsets.back());
+    std::vector<IndexType> recv_rows(recv_nnz);
+    std::vector<IndexType> recv_cols(recv_nnz);
+    std::vector<ValueType> recv_vals(recv_nnz);
+    comm.all_to_all_v(host_exec, send_rows.data(), send_sizes.data(),
+                      send_offsets.data(), recv_rows.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    comm.all_to_all_v(host_exec, send_cols.data(), send_sizes.data(),
+                      send_offsets.data(), recv_cols.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    comm.all_to_all_v(host_exec, send_vals.data(), send_sizes.data(),
+                      send_offsets.data(), recv_vals.data(), recv_sizes.data(),
+                      recv_offsets.data());
+    matrix_data<ValueType, IndexType> result{data.size};
+    result.nonzeros.reserve(recv_nnz);
+    for (size_type i = 0; i < recv_nnz; i++) {
+        result.nonzeros.emplace_back(recv_rows[i], recv_cols[i], recv_vals[i]);
+    }
+    result.sort_row_major();
+    return result;
+}
+
+
+/**
+ * Returns the global coarse index of each non-local column of a distributed
+ * matrix, i.e. the aggregate its owner assigned it to, using the
+ * communication pattern of the matrix.
+ */
+template <typename LocalIndexType, typename GlobalIndexType>
+std::vector<GlobalIndexType> communicate_non_local_agg(
+    std::shared_ptr<const Executor> host_exec,
+    experimental::mpi::communicator comm,
+    const experimental::distributed::IndexMap<LocalIndexType, GlobalIndexType>*
+        index_map,
+    const array<LocalIndexType>& host_agg, GlobalIndexType coarse_offset)
+{
+    const array<LocalIndexType> gather_idxs{host_exec,
+                                            index_map->get_gather_idxs()};
+    std::vector<GlobalIndexType> send_buffer(gather_idxs.get_size());
+    for (size_type i = 0; i < send_buffer.size(); i++) {
+        send_buffer[i] =
+            host_agg.get_const_data()[gather_idxs.get_const_data()[i]] +
+            coarse_offset;
+    }
+    std::vector<GlobalIndexType> recv_buffer(index_map->get_non_local_size());
+    comm.all_to_all_v(host_exec, send_buffer.data(),
+                      index_map->get_send_sizes().data(),
+                      index_map->get_send_offsets().data(), recv_buffer.data(),
+                      index_map->get_recv_sizes().data(),
+                      index_map->get_recv_offsets().data());
+    return recv_buffer;
+}
+
+
+#endif
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+void Pgm<ValueType, IndexType>::generate()
+{
+    using csr_type = matrix::Csr<ValueType, IndexType>;
+    auto exec = this->get_executor();
+#if GINKGO_BUILD_MPI
+    if (gko::detail::is_distributed(system_matrix_.get())) {
+        using experimental::distributed::Matrix;
+        run<const Matrix<ValueType, IndexType, IndexType>*,
+            const Matrix<ValueType, IndexType, int64>*>(
+            system_matrix_.get(),
+            [this](auto fine_mtx) { this->generate_distributed(fine_mtx); });
+        return;
+    }
+#endif
+    // Only support csr matrix currently.
+    const csr_type* pgm_op =
+        dynamic_cast<const csr_type*>(system_matrix_.get());
+    std::shared_ptr<const csr_type> pgm_op_shared_ptr{};
+    // If system matrix is not csr or need sorting, generate the csr.
+    if (!parameters_.skip_sorting || !pgm_op) {
+        pgm_op_shared_ptr = convert_to_with_sorting<csr_type>(
+            exec, system_matrix_, parameters_.skip_sorting);
+        pgm_op = pgm_op_shared_ptr.get();
+        // keep the same precision data in fine_op
+        this->set_fine_op(pgm_op_shared_ptr);
+    }
+    const auto num_agg = aggregate(exec, pgm_op, parameters_, agg_);
 
     gko::dim<2>::dimension_type coarse_dim = num_agg;
     auto fine_dim = system_matrix_->get_size()[0];
@@ -206,6 +332,142 @@ void Pgm<ValueType, IndexType>::generate()
 }
 
 
+#if GINKGO_BUILD_MPI
+
+
+template <typename ValueType, typename IndexType>
+template <typename GlobalIndexType>
+void Pgm<ValueType, IndexType>::generate_distributed(
+    const experimental::distributed::Matrix<ValueType, IndexType,
+                                            GlobalIndexType>* fine_mtx)
+{
+    using csr_type = matrix::Csr<ValueType, IndexType>;
+    using dist_mtx_type =
+        experimental::distributed::Matrix<ValueType, IndexType,
+                                          GlobalIndexType>;
+    using partition_type =
+        experimental::distributed::Partition<IndexType, GlobalIndexType>;
+    using experimental::distributed::comm_index_type;
+    auto exec = this->get_executor();
+    auto host_exec = exec->get_master();
+    auto comm = fine_mtx->get_communicator();
+    const auto rank = comm.rank();
+    const auto num_parts = comm.size();
+    // aggregate the rows of the local matrix, ignoring non-local couplings
+    auto local_op = convert_to_with_sorting<csr_type>(
+        exec, fine_mtx->get_local_matrix(), parameters_.skip_sorting);
+    const auto num_local_rows = local_op->get_size()[0];
+    agg_.resize_and_reset(num_local_rows);
+    const auto num_agg = aggregate(exec, local_op.get(), parameters_, agg_);
+    const array<IndexType> host_agg{host_exec, agg_};
+
+    // the aggregates of each process form a contiguous coarse range
+    std::vector<GlobalIndexType> coarse_sizes(num_parts);
+    const GlobalIndexType local_coarse_size = num_agg;
+    comm.all_gather(host_exec, &local_coarse_size, 1, coarse_sizes.data(), 1);
+    array<GlobalIndexType> coarse_ranges{host_exec,
+                                         static_cast<size_type>(num_parts + 1)};
+    coarse_ranges.get_data()[0] = 0;
+    std::partial_sum(coarse_sizes.begin(), coarse_sizes.end(),
+                     coarse_ranges.get_data() + 1);
+    const auto coarse_offset = coarse_ranges.get_const_data()[rank];
+    const auto global_coarse_size =
+        static_cast<size_type>(coarse_ranges.get_const_data()[num_parts]);
+    // agglomerate the ranges of neighboring processes onto fewer processes
+    const auto threshold = parameters_.agglomeration_threshold;
+    auto num_active_parts = static_cast<size_type>(num_parts);
+    if (threshold > 0 && global_coarse_size < threshold * num_parts) {
+        num_active_parts =
+            std::max(global_coarse_size / threshold, size_type{1});
+    }
+    const bool agglomerate =
+        num_active_parts < static_cast<size_type>(num_parts);
+    array<comm_index_type> coarse_part_ids{host_exec,
+                                           static_cast<size_type>(num_parts)};
+    for (comm_index_type part = 0; part < num_parts; part++) {
+        coarse_part_ids.get_data()[part] = static_cast<comm_index_type>(
+            part * num_active_parts / num_parts);
+    }
+    const auto target = coarse_part_ids.get_const_data()[rank];
+    auto coarse_partition = share(partition_type::build_from_contiguous(
+        exec, coarse_ranges, coarse_part_ids));
+    auto fine_partition = share(
+        experimental::distributed::build_partition_from_local_size<
+            IndexType, GlobalIndexType>(exec, comm, num_local_rows));
+    const auto fine_offset =
+        make_temporary_clone(host_exec, fine_partition.get())
+            ->get_range_bounds()[rank];
+
+    // Galerkin product of the local block, the non-local columns are mapped
+    // to the aggregates of their owners
+    auto non_local_agg = communicate_non_local_agg(
+        host_exec, comm, fine_mtx->get_index_map().get(), host_agg,
+        coarse_offset);
+    matrix_data<ValueType, GlobalIndexType> coarse_data{
+        dim<2>{global_coarse_size, global_coarse_size}};
+    std::shared_ptr<const csr_type> local_coarse_op =
+        generate_coarse(exec, local_op.get(), num_agg, agg_);
+    auto local_coarse = make_temporary_clone(host_exec, local_coarse_op);
+    for (IndexType row = 0; row < num_agg; row++) {
+        for (auto nz = local_coarse->get_const_row_ptrs()[row];
+             nz < local_coarse->get_const_row_ptrs()[row + 1]; nz++) {
+            coarse_data.nonzeros.emplace_back(
+                row + coarse_offset,
+                local_coarse->get_const_col_idxs()[nz] + coarse_offset,
+                local_coarse->get_const_values()[nz]);
+        }
+    }
+    auto non_local_op = convert_to_with_sorting<csr_type>(
+        host_exec, fine_mtx->get_non_local_matrix(), true);
+    const auto host_agg_data = host_agg.get_const_data();
+    for (size_type row = 0; row < num_local_rows; row++) {
+        for (auto nz = non_local_op->get_const_row_ptrs()[row];
+             nz < non_local_op->get_const_row_ptrs()[row + 1]; nz++) {
+            coarse_data.nonzeros.emplace_back(
+                host_agg_data[row] + coarse_offset,
+                non_local_agg[non_local_op->get_const_col_idxs()[nz]],
+                non_local_op->get_const_values()[nz]);
+        }
+    }
+    coarse_data.sum_duplicates();
+
+    // prolongation and restriction are the aggregation and its transpose
+    const auto fine_size = fine_mtx->get_size()[0];
+    matrix_data<ValueType, GlobalIndexType> prolong_data{
+        dim<2>{fine_size, global_coarse_size}};
+    matrix_data<ValueType, GlobalIndexType> restrict_data{
+        dim<2>{global_coarse_size, fine_size}};
+    for (size_type row = 0; row < num_local_rows; row++) {
+        const auto fine_row = static_cast<GlobalIndexType>(row) + fine_offset;
+        const auto coarse_row = host_agg_data[row] + coarse_offset;
+        prolong_data.nonzeros.emplace_back(fine_row, coarse_row,
+                                           one<ValueType>());
+        restrict_data.nonzeros.emplace_back(coarse_row, fine_row,
+                                            one<ValueType>());
+    }
+    restrict_data.sort_row_major();
+    if (agglomerate) {
+        // the coarse rows are owned by the target process now
+        coarse_data = send_to_process(host_exec, comm, coarse_data, target);
+        restrict_data =
+            send_to_process(host_exec, comm, restrict_data, target);
+    }
+
+    auto coarse_mtx = share(dist_mtx_type::create(exec, comm));
+    coarse_mtx->read_distributed(coarse_data, coarse_partition);
+    auto prolong = share(dist_mtx_type::create(exec, comm));
+    prolong->read_distributed(prolong_data, fine_partition, coarse_partition);
+    auto restrict_op = share(dist_mtx_type::create(exec, comm));
+    restrict_op->read_distributed(restrict_data, coarse_partition,
+                                  fine_partition);
+
+    this->set_multigrid_level(prolong, coarse_mtx, restrict_op);
+}
+
+
+#endif
+
+
 #define GKO_DECLARE_PGM(_vtype, _itype) class Pgm<_vtype, _itype>
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_PGM);
 
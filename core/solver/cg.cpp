@@ -5,6 +5,12 @@
 #include <ginkgo/core/solver/cg.hpp>
 
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+
 #include <ginkgo/core/base/exception.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/executor.hpp>
@@ -12,6 +18,9 @@
 #include <ginkgo/core/base/name_demangling.hpp>
 #include <ginkgo/core/base/precision_dispatch.hpp>
 #include <ginkgo/core/base/utils.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
 
 
 #include "core/distributed/helpers.hpp"
@@ -28,6 +37,53 @@ namespace {
 GKO_REGISTER_OPERATION(initialize, cg::initialize);
 GKO_REGISTER_OPERATION(step_1, cg::step_1);
 GKO_REGISTER_OPERATION(step_2, cg::step_2);
+GKO_REGISTER_OPERATION(step_2_norm, cg::step_2_norm);
+GKO_REGISTER_OPERATION(persistent_solve, cg::persistent_solve);
+
+
+/**
+ * Collects the stopping criteria evaluated by the persistent CG kernel, i.e.
+ * the smallest iteration limit and the reduction factors and baselines of all
+ * residual norm criteria. Returns false if the factory contains any other
+ * criterion.
+ */
+template <typename ValueType>
+bool collect_persistent_criteria(
+    const stop::CriterionFactory* factory, size_type& max_iters,
+    std::vector<std::pair<remove_complex<ValueType>, stop::mode>>&
+        residual_criteria)
+{
+    if (auto combined = dynamic_cast<const stop::Combined::Factory*>(factory)) {
+        for (const auto& criterion : combined->get_parameters().criteria) {
+            if (!collect_persistent_criteria<ValueType>(
+                    criterion.get(), max_iters, residual_criteria)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (auto iteration =
+            dynamic_cast<const stop::Iteration::Factory*>(factory)) {
+        max_iters = std::min(max_iters, iteration->get_parameters().max_iters);
+        return true;
+    }
+    if (auto residual = dynamic_cast<
+            const typename stop::ResidualNorm<ValueType>::Factory*>(factory)) {
+        residual_criteria.emplace_back(
+            residual->get_parameters().reduction_factor,
+            residual->get_parameters().baseline);
+        return true;
+    }
+    if (auto residual = dynamic_cast<
+            const typename stop::ImplicitResidualNorm<ValueType>::Factory*>(
+            factory)) {
+        residual_criteria.emplace_back(
+            residual->get_parameters().reduction_factor,
+            residual->get_parameters().baseline);
+        return true;
+    }
+    return false;
+}
 
 
 }  // anonymous namespace
@@ -41,6 +97,7 @@ std::unique_ptr<LinOp> Cg<ValueType>::transpose() const
         .with_generated_preconditioner(
             share(as<Transposable>(this->get_preconditioner())->transpose()))
         .with_criteria(this->get_stop_criterion_factory())
+        .with_persistent_region(this->get_parameters().persistent_region)
         .on(this->get_executor())
         ->generate(
             share(as<Transposable>(this->get_system_matrix())->transpose()));
@@ -54,6 +111,7 @@ std::unique_ptr<LinOp> Cg<ValueType>::conj_transpose() const
         .with_generated_preconditioner(share(
             as<Transposable>(this->get_preconditioner())->conj_transpose()))
         .with_criteria(this->get_stop_criterion_factory())
+        .with_persistent_region(this->get_parameters().persistent_region)
         .on(this->get_executor())
         ->generate(share(
             as<Transposable>(this->get_system_matrix())->conj_transpose()));
@@ -81,9 +139,16 @@ void Cg<ValueType>::apply_dense_impl(const VectorType* dense_b,
 {
     using std::swap;
     using LocalVector = matrix::Dense<ValueType>;
+    using NormVector = matrix::Dense<remove_complex<ValueType>>;
+    using ws = workspace_traits<Cg>;
 
     constexpr uint8 RelativeStoppingId{1};
 
+    if (this->get_parameters().persistent_region &&
+        this->apply_persistent_impl(dense_b, dense_x)) {
+        return;
+    }
+
     auto exec = this->get_executor();
     this->setup_workspace();
 
@@ -96,6 +161,8 @@ void Cg<ValueType>::apply_dense_impl(const VectorType* dense_b,
     GKO_SOLVER_SCALAR(beta, dense_b);
     GKO_SOLVER_SCALAR(prev_rho, dense_b);
     GKO_SOLVER_SCALAR(rho, dense_b);
+    auto residual_norm = this->template create_workspace_op<NormVector>(
+        ws::residual_norm, dim<2>{1, dense_b->get_size()[1]});
 
     GKO_SOLVER_ONE_MINUS_ONE();
 
@@ -115,16 +182,24 @@ void Cg<ValueType>::apply_dense_impl(const VectorType* dense_b,
     auto stop_criterion = this->get_stop_criterion_factory()->generate(
         this->get_system_matrix(),
         std::shared_ptr<const LinOp>(dense_b, [](const LinOp*) {}), dense_x, r);
+    // for non-distributed vectors, the residual norm is computed as part of
+    // the residual update, so the stopping criterion doesn't need to launch
+    // a separate norm kernel
+    const bool fused_norm = !gko::detail::is_distributed(dense_b);
+    const NormVector* criterion_norm = nullptr;
+    if (fused_norm) {
+        r->compute_norm2(residual_norm, reduction_tmp);
+        criterion_norm = residual_norm;
+    }
 
     int iter = -1;
     /* Memory movement summary:
-     * 18n * values + matrix/preconditioner storage
+     * 17n * values + matrix/preconditioner storage
      * 1x SpMV:           2n * values + storage
      * 1x Preconditioner: 2n * values + storage
      * 2x dot             4n
      * 1x step 1 (axpy)   3n
-     * 1x step 2 (axpys)  6n
-     * 1x norm2 residual   n
+     * 1x step 2 (axpys)  6n (includes the norm2 of the residual)
      */
     while (true) {
         // z = preconditioner * r
@@ -137,11 +212,12 @@ void Cg<ValueType>::apply_dense_impl(const VectorType* dense_b,
             stop_criterion->update()
                 .num_iterations(iter)
                 .residual(r)
+                .residual_norm(criterion_norm)
                 .implicit_sq_residual_norm(rho)
                 .solution(dense_x)
                 .check(RelativeStoppingId, true, &stop_status, &one_changed);
         this->template log<log::Logger::iteration_complete>(
-            this, dense_b, dense_x, iter, r, nullptr, rho, &stop_status,
+            this, dense_b, dense_x, iter, r, criterion_norm, rho, &stop_status,
             all_stopped);
         if (all_stopped) {
             break;
@@ -159,15 +235,122 @@ void Cg<ValueType>::apply_dense_impl(const VectorType* dense_b,
         // tmp = rho / beta
         // x = x + tmp * p
         // r = r - tmp * q
-        exec->run(cg::make_step_2(
-            gko::detail::get_local(dense_x), gko::detail::get_local(r),
-            gko::detail::get_local(p), gko::detail::get_local(q), beta, rho,
-            &stop_status));
+        if (fused_norm) {
+            // residual_norm = norm(r)
+            exec->run(cg::make_step_2_norm(
+                gko::detail::get_local(dense_x), gko::detail::get_local(r),
+                gko::detail::get_local(p), gko::detail::get_local(q), beta,
+                rho, residual_norm, reduction_tmp, &stop_status));
+        } else {
+            exec->run(cg::make_step_2(
+                gko::detail::get_local(dense_x), gko::detail::get_local(r),
+                gko::detail::get_local(p), gko::detail::get_local(q), beta,
+                rho, &stop_status));
+        }
         swap(prev_rho, rho);
     }
 }
 
 
+template <typename ValueType>
+template <typename VectorType>
+bool Cg<ValueType>::apply_persistent_impl(const VectorType*, VectorType*) const
+{
+    // distributed vectors always use the default implementation
+    return false;
+}
+
+
+template <typename ValueType>
+bool Cg<ValueType>::apply_persistent_impl(
+    const matrix::Dense<ValueType>* dense_b,
+    matrix::Dense<ValueType>* dense_x) const
+{
+    using absolute_type = remove_complex<ValueType>;
+    using NormVector = matrix::Dense<absolute_type>;
+
+    constexpr uint8 RelativeStoppingId{1};
+
+    auto exec = this->get_executor();
+    if (!std::dynamic_pointer_cast<const OmpExecutor>(exec) ||
+        !dynamic_cast<const matrix::Identity<ValueType>*>(
+            this->get_preconditioner().get()) ||
+        !this->get_stop_criterion_factory()) {
+        return false;
+    }
+    auto max_iters = std::numeric_limits<size_type>::max();
+    std::vector<std::pair<absolute_type, stop::mode>> residual_criteria;
+    if (!cg::collect_persistent_criteria<ValueType>(
+            this->get_stop_criterion_factory().get(), max_iters,
+            residual_criteria)) {
+        return false;
+    }
+    auto solve = [&](auto csr) {
+        this->setup_workspace();
+
+        GKO_SOLVER_VECTOR(r, dense_b);
+        GKO_SOLVER_VECTOR(z, dense_b);
+        GKO_SOLVER_VECTOR(p, dense_b);
+        GKO_SOLVER_VECTOR(q, dense_b);
+
+        GKO_SOLVER_SCALAR(prev_rho, dense_b);
+        GKO_SOLVER_SCALAR(rho, dense_b);
+
+        GKO_SOLVER_ONE_MINUS_ONE();
+
+        auto& stop_status =
+            this->template create_workspace_array<stopping_status>(
+                GKO_SOLVER_TRAITS::stop, dense_b->get_size()[1]);
+
+        exec->run(cg::make_initialize(dense_b, r, z, p, q, prev_rho, rho,
+                                      &stop_status));
+        csr->apply(neg_one_op, dense_x, one_op, r);
+
+        // the kernel converges a column once its residual norm drops below
+        // the largest threshold of all residual norm criteria
+        const auto num_rhs = dense_b->get_size()[1];
+        auto thresholds = NormVector::create(exec, dim<2>{1, num_rhs});
+        auto norm = NormVector::create(exec, dim<2>{1, num_rhs});
+        thresholds->fill(-one<absolute_type>());
+        for (const auto& criterion : residual_criteria) {
+            switch (criterion.second) {
+            case stop::mode::rhs_norm:
+                dense_b->compute_norm2(norm);
+                break;
+            case stop::mode::initial_resnorm:
+                r->compute_norm2(norm);
+                break;
+            default:
+                norm->fill(one<absolute_type>());
+            }
+            for (size_type j = 0; j < num_rhs; ++j) {
+                thresholds->at(0, j) = std::max(
+                    thresholds->at(0, j), criterion.first * norm->at(0, j));
+            }
+        }
+
+        size_type num_iterations{};
+        exec->run(cg::make_persistent_solve(
+            csr, dense_x, r, p, q, thresholds.get(), max_iters,
+            RelativeStoppingId, &stop_status, &num_iterations));
+        this->template log<log::Logger::iteration_complete>(
+            this, dense_b, dense_x, num_iterations, r, nullptr, nullptr,
+            &stop_status, true);
+    };
+    auto system_matrix = this->get_system_matrix().get();
+    if (auto csr =
+            dynamic_cast<const matrix::Csr<ValueType, int32>*>(system_matrix)) {
+        solve(csr);
+    } else if (auto csr = dynamic_cast<const matrix::Csr<ValueType, int64>*>(
+                   system_matrix)) {
+        solve(csr);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+
 template <typename ValueType>
 void Cg<ValueType>::apply_impl(const LinOp* alpha, const LinOp* b,
                                const LinOp* beta, LinOp* x) const
@@ -196,7 +379,7 @@ int workspace_traits<Cg<ValueType>>::num_arrays(const Solver&)
 template <typename ValueType>
 int workspace_traits<Cg<ValueType>>::num_vectors(const Solver&)
 {
-    return 10;
+    return 11;
 }
 
 
@@ -207,6 +390,7 @@ std::vector<std::string> workspace_traits<Cg<ValueType>>::op_names(
     return {
         "r",    "z",        "p",   "q",   "alpha",
         "beta", "prev_rho", "rho", "one", "minus_one",
+        "residual_norm",
     };
 }
 
@@ -222,7 +406,7 @@ std::vector<std::string> workspace_traits<Cg<ValueType>>::array_names(
 template <typename ValueType>
 std::vector<int> workspace_traits<Cg<ValueType>>::scalars(const Solver&)
 {
-    return {alpha, beta, prev_rho, rho};
+    return {alpha, beta, prev_rho, rho, residual_norm};
 }
 
 
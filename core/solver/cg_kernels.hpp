@@ -12,6 +12,7 @@
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/base/types.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/stop/stopping_status.hpp>
 
@@ -50,13 +51,55 @@ namespace cg {
                 const array<stopping_status>* stop_status)
 
 
-#define GKO_DECLARE_ALL_AS_TEMPLATES             \
-    template <typename ValueType>                \
-    GKO_DECLARE_CG_INITIALIZE_KERNEL(ValueType); \
-    template <typename ValueType>                \
-    GKO_DECLARE_CG_STEP_1_KERNEL(ValueType);     \
-    template <typename ValueType>                \
-    GKO_DECLARE_CG_STEP_2_KERNEL(ValueType)
+/**
+ * Performs the same update as step_2 and computes the 2-norm of each column
+ * of the updated residual in the same pass, so no separate norm kernel is
+ * necessary for the stopping criterion.
+ */
+#define GKO_DECLARE_CG_STEP_2_NORM_KERNEL(_type)                          \
+    void step_2_norm(std::shared_ptr<const DefaultExecutor> exec,         \
+                     matrix::Dense<_type>* x, matrix::Dense<_type>* r,    \
+                     const matrix::Dense<_type>* p,                       \
+                     const matrix::Dense<_type>* q,                       \
+                     const matrix::Dense<_type>* beta,                    \
+                     const matrix::Dense<_type>* rho,                     \
+                     matrix::Dense<remove_complex<_type>>* residual_norm, \
+                     array<char>& tmp,                                    \
+                     const array<stopping_status>* stop_status)
+
+
+/**
+ * Runs the complete unpreconditioned CG iteration on a Csr matrix, starting
+ * from the residual r = b - A * x.
+ *
+ * A column stops as converged once its residual norm is at most
+ * thresholds[j] (a negative threshold disables this check), and all columns
+ * stop once max_iters iterations have been completed. num_iterations
+ * returns the index of the last iteration, as it would be passed to the
+ * stopping criterion.
+ */
+#define GKO_DECLARE_CG_PERSISTENT_SOLVE_KERNEL(_type, _itype)         \
+    void persistent_solve(                                            \
+        std::shared_ptr<const DefaultExecutor> exec,                  \
+        const matrix::Csr<_type, _itype>* a, matrix::Dense<_type>* x, \
+        matrix::Dense<_type>* r, matrix::Dense<_type>* p,             \
+        matrix::Dense<_type>* q,                                      \
+        const matrix::Dense<remove_complex<_type>>* thresholds,       \
+        size_type max_iters, uint8 stopping_id,                       \
+        array<stopping_status>* stop_status, size_type* num_iterations)
+
+
+#define GKO_DECLARE_ALL_AS_TEMPLATES                  \
+    template <typename ValueType>                     \
+    GKO_DECLARE_CG_INITIALIZE_KERNEL(ValueType);      \
+    template <typename ValueType>                     \
+    GKO_DECLARE_CG_STEP_1_KERNEL(ValueType);          \
+    template <typename ValueType>                     \
+    GKO_DECLARE_CG_STEP_2_KERNEL(ValueType);          \
+    template <typename ValueType>                     \
+    GKO_DECLARE_CG_STEP_2_NORM_KERNEL(ValueType);     \
+    template <typename ValueType, typename IndexType> \
+    GKO_DECLARE_CG_PERSISTENT_SOLVE_KERNEL(ValueType, IndexType)
 
 
 }  // namespace cg
@@ -15,6 +15,9 @@
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/base/utils.hpp>
 #include <ginkgo/core/base/utils_helper.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
 #include <ginkgo/core/factorization/lu.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/preconditioner/jacobi.hpp>
@@ -27,6 +30,7 @@
 
 #include "core/base/dispatch_helper.hpp"
 #include "core/components/fill_array_kernels.hpp"
+#include "core/distributed/helpers.hpp"
 #include "core/solver/ir_kernels.hpp"
 #include "core/solver/multigrid_kernels.hpp"
 #include "core/solver/solver_base.hpp"
@@ -81,23 +85,69 @@ casting(const T& x)
 }
 
 /**
- * as_vec gives a shortcut for casting pointer to dense.
+ * as_real_vec gives a shortcut for casting pointer to dense with real type.
  */
 template <typename ValueType>
-auto as_vec(std::shared_ptr<LinOp> x)
+auto as_real_vec(std::shared_ptr<LinOp> x)
 {
-    return std::static_pointer_cast<matrix::Dense<ValueType>>(x);
+    return std::static_pointer_cast<matrix::Dense<remove_complex<ValueType>>>(
+        x);
 }
 
 
 /**
- * as_real_vec gives a shortcut for casting pointer to dense with real type.
+ * create_vector creates a vector with nrhs columns, which is distributed like
+ * the rows of op if op is a distributed matrix, and dense otherwise.
  */
 template <typename ValueType>
-auto as_real_vec(std::shared_ptr<LinOp> x)
+std::shared_ptr<LinOp> create_vector(std::shared_ptr<const Executor> exec,
+                                     const LinOp* op, size_type nrhs)
 {
-    return std::static_pointer_cast<matrix::Dense<remove_complex<ValueType>>>(
-        x);
+#if GINKGO_BUILD_MPI
+    if (gko::detail::is_distributed(op)) {
+        using experimental::distributed::Matrix;
+        return run<const Matrix<ValueType, int32, int32>*,
+                   const Matrix<ValueType, int32, int64>*,
+                   const Matrix<ValueType, int64, int64>*>(
+            op, [&](auto dist_op) -> std::shared_ptr<LinOp> {
+                return experimental::distributed::Vector<ValueType>::create(
+                    exec, dist_op->get_communicator(),
+                    dim<2>{dist_op->get_size()[0], nrhs},
+                    dim<2>{dist_op->get_local_matrix()->get_size()[0], nrhs});
+            });
+    }
+#endif
+    return matrix::Dense<ValueType>::create(exec,
+                                            dim<2>{op->get_size()[0], nrhs});
+}
+
+
+/**
+ * build_local_preconditioner wraps the factory of a preconditioner for the
+ * local blocks into a Schwarz preconditioner if matrix is distributed.
+ */
+template <typename ValueType>
+std::shared_ptr<const LinOpFactory> build_local_preconditioner(
+    const LinOp* matrix, std::shared_ptr<const LinOpFactory> local_factory)
+{
+#if GINKGO_BUILD_MPI
+    if (gko::detail::is_distributed(matrix)) {
+        using experimental::distributed::Matrix;
+        return run<const Matrix<ValueType, int32, int32>*,
+                   const Matrix<ValueType, int32, int64>*,
+                   const Matrix<ValueType, int64, int64>*>(
+            matrix,
+            [&](auto dist_op) -> std::shared_ptr<const LinOpFactory> {
+                using dist_type = std::decay_t<decltype(*dist_op)>;
+                return experimental::distributed::preconditioner::Schwarz<
+                           ValueType, typename dist_type::local_index_type,
+                           typename dist_type::global_index_type>::build()
+                    .with_local_solver(local_factory)
+                    .on(local_factory->get_executor());
+            });
+    }
+#endif
+    return local_factory;
 }
 
 
@@ -116,12 +166,14 @@ void handle_list(
     auto list_size = smoother_list.size();
     auto gen_default_smoother = [&] {
         auto exec = matrix->get_executor();
-        return share(build_smoother(preconditioner::Jacobi<ValueType>::build()
-                                        .with_max_block_size(1u)
-                                        .on(exec),
-                                    iteration,
-                                    casting<ValueType>(relaxation_factor))
-                         ->generate(matrix));
+        return share(
+            build_smoother(
+                build_local_preconditioner<ValueType>(
+                    matrix.get(), preconditioner::Jacobi<ValueType>::build()
+                                      .with_max_block_size(1u)
+                                      .on(exec)),
+                iteration, casting<ValueType>(relaxation_factor))
+                ->generate(matrix));
     };
     if (list_size != 0) {
         auto temp_index = list_size == 1 ? 0 : index;
@@ -216,12 +268,15 @@ struct MultigridState {
      *
      * @param level  the current level index
      * @param cycle  the multigrid cycle
-     * @param current_nrows  the number of rows of current fine matrix
-     * @param next_nrows  the number of rows of next coarse matrix
+     * @param current_op  the current fine matrix
+     * @param next_op  the next coarse matrix
+     *
+     * @note the vectors are distributed like the rows of the matrices if
+     *       they are distributed.
      */
     template <typename ValueType>
     void allocate_memory(int level, multigrid::cycle cycle,
-                         size_type current_nrows, size_type next_nrows);
+                         const LinOp* current_op, const LinOp* next_op);
 
     /**
      * run the cycle of the level
@@ -271,7 +326,7 @@ void MultigridState::generate(const LinOp* system_matrix_in,
     system_matrix = system_matrix_in;
     multigrid = multigrid_in;
     nrhs = nrhs_in;
-    auto current_nrows = system_matrix->get_size()[0];
+    auto current_op = system_matrix;
     auto mg_level_list = multigrid->get_mg_level_list();
     auto list_size = mg_level_list.size();
     auto cycle = multigrid->get_cycle();
@@ -283,50 +338,47 @@ void MultigridState::generate(const LinOp* system_matrix_in,
     clear_and_reserve(neg_one_list, list_size);
     // Allocate memory first such that reusing allocation in each iter.
     for (int i = 0; i < mg_level_list.size(); i++) {
-        auto next_nrows = mg_level_list.at(i)->get_coarse_op()->get_size()[0];
+        auto next_op = mg_level_list.at(i)->get_coarse_op().get();
         auto mg_level = mg_level_list.at(i);
 
         run<gko::multigrid::EnableMultigridLevel, float, double,
             std::complex<float>, std::complex<double>>(
             mg_level,
-            [&, this](auto mg_level, auto i, auto cycle, auto current_nrows,
-                      auto next_nrows) {
+            [&, this](auto mg_level, auto i, auto cycle, auto current_op,
+                      auto next_op) {
                 using value_type =
                     typename std::decay_t<decltype(*mg_level)>::value_type;
-                using vec = matrix::Dense<value_type>;
-                this->allocate_memory<value_type>(i, cycle, current_nrows,
-                                                  next_nrows);
-                auto exec = as<LinOp>(multigrid->get_mg_level_list().at(i))
-                                ->get_executor();
+                this->allocate_memory<value_type>(i, cycle, current_op,
+                                                  next_op);
             },
-            i, cycle, current_nrows, next_nrows);
+            i, cycle, current_op, next_op);
 
-        current_nrows = next_nrows;
+        current_op = next_op;
     }
 }
 
 
 template <typename ValueType>
 void MultigridState::allocate_memory(int level, multigrid::cycle cycle,
-                                     size_type current_nrows,
-                                     size_type next_nrows)
+                                     const LinOp* current_op,
+                                     const LinOp* next_op)
 {
     using vec = matrix::Dense<ValueType>;
     using norm_vec = matrix::Dense<remove_complex<ValueType>>;
 
     auto exec =
         as<LinOp>(multigrid->get_mg_level_list().at(level))->get_executor();
-    r_list.emplace_back(vec::create(exec, dim<2>{current_nrows, nrhs}));
+    r_list.emplace_back(create_vector<ValueType>(exec, current_op, nrhs));
     if (level != 0) {
         // allocate the previous level
-        g_list.emplace_back(vec::create(exec, dim<2>{current_nrows, nrhs}));
-        e_list.emplace_back(vec::create(exec, dim<2>{current_nrows, nrhs}));
+        g_list.emplace_back(create_vector<ValueType>(exec, current_op, nrhs));
+        e_list.emplace_back(create_vector<ValueType>(exec, current_op, nrhs));
         next_one_list.emplace_back(initialize<vec>({one<ValueType>()}, exec));
     }
     if (level + 1 == multigrid->get_mg_level_list().size()) {
         // the last level allocate the g, e for coarsest solver
-        g_list.emplace_back(vec::create(exec, dim<2>{next_nrows, nrhs}));
-        e_list.emplace_back(vec::create(exec, dim<2>{next_nrows, nrhs}));
+        g_list.emplace_back(create_vector<ValueType>(exec, next_op, nrhs));
+        e_list.emplace_back(create_vector<ValueType>(exec, next_op, nrhs));
         next_one_list.emplace_back(initialize<vec>({one<ValueType>()}, exec));
     }
     one_list.emplace_back(initialize<vec>({one<ValueType>()}, exec));
@@ -392,8 +444,9 @@ void MultigridState::run_cycle(multigrid::cycle cycle, size_type level,
             } else {
                 // x in first level is already filled by zero outside.
                 if (level != 0) {
-                    dynamic_cast<matrix::Dense<ValueType>*>(x)->fill(
-                        zero<ValueType>());
+                    gko::detail::vector_dispatch<ValueType>(x, [](auto vec) {
+                        vec->fill(zero<ValueType>());
+                    });
                 }
                 pre_smoother->apply(b, x);
             }
@@ -414,7 +467,8 @@ void MultigridState::run_cycle(multigrid::cycle cycle, size_type level,
     // next level
     if (level + 1 == total_level) {
         // the coarsest solver use the last level valuetype
-        as_vec<ValueType>(e)->fill(zero<ValueType>());
+        gko::detail::vector_dispatch<ValueType>(
+            e.get(), [](auto vec) { vec->fill(zero<ValueType>()); });
     }
     auto next_level_matrix =
         (level + 1 < total_level)
@@ -537,7 +591,9 @@ void Multigrid::generate()
             // TODO: maybe remove fixed index type
             auto gen_default_solver = [&]() -> std::unique_ptr<LinOp> {
                 // TODO: unify when dpcpp supports direct solver
-                if (dynamic_cast<const DpcppExecutor*>(exec.get())) {
+                // the direct solver only works on non-distributed matrices
+                if (dynamic_cast<const DpcppExecutor*>(exec.get()) ||
+                    gko::detail::is_distributed(matrix.get())) {
                     using absolute_value_type = remove_complex<value_type>;
                     return solver::Gmres<value_type>::build()
                         .with_criteria(
@@ -551,8 +607,11 @@ void Multigrid::generate()
                         .with_krylov_dim(
                             std::min(size_type(100), matrix->get_size()[0]))
                         .with_preconditioner(
-                            preconditioner::Jacobi<value_type>::build()
-                                .with_max_block_size(1u))
+                            build_local_preconditioner<value_type>(
+                                matrix.get(),
+                                preconditioner::Jacobi<value_type>::build()
+                                    .with_max_block_size(1u)
+                                    .on(exec)))
                         .on(exec)
                         ->generate(matrix);
                 } else {
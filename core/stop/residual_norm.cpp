@@ -92,16 +92,21 @@ void norm_dispatch(Function&& fn, LinOps*... linops)
 template <typename ValueType>
 ResidualNormBase<ValueType>::ResidualNormBase(
     std::shared_ptr<const gko::Executor> exec, const CriterionArgs& args,
-    remove_complex<ValueType> reduction_factor, mode baseline)
+    remove_complex<ValueType> reduction_factor, mode baseline,
+    size_type check_interval)
     : EnablePolymorphicObject<ResidualNormBase, Criterion>(exec),
       device_storage_{exec, 2},
       reduction_factor_{reduction_factor},
+      check_interval_{check_interval},
       baseline_{baseline},
       system_matrix_{args.system_matrix},
       b_{args.b},
       one_{gko::initialize<Vector>({1}, exec)},
       neg_one_{gko::initialize<Vector>({-1}, exec)}
 {
+    if (check_interval_ == 0) {
+        GKO_INVALID_STATE("The check interval must be at least 1");
+    }
     switch (baseline_) {
     case mode::initial_resnorm: {
         if (args.initial_residual == nullptr) {
@@ -162,6 +167,10 @@ bool ResidualNormBase<ValueType>::check_impl(
     uint8 stopping_id, bool set_finalized, array<stopping_status>* stop_status,
     bool* one_changed, const Criterion::Updater& updater)
 {
+    if (this->skip_check(updater)) {
+        *one_changed = false;
+        return false;
+    }
     const NormVector* dense_tau;
     if (updater.residual_norm_ != nullptr) {
         dense_tau = as<NormVector>(updater.residual_norm_);
@@ -204,6 +213,10 @@ bool ImplicitResidualNorm<ValueType>::check_impl(
     uint8 stopping_id, bool set_finalized, array<stopping_status>* stop_status,
     bool* one_changed, const Criterion::Updater& updater)
 {
+    if (this->skip_check(updater)) {
+        *one_changed = false;
+        return false;
+    }
     const Vector* dense_tau;
     if (updater.implicit_sq_residual_norm_ != nullptr) {
         dense_tau = as<Vector>(updater.implicit_sq_residual_norm_);
@@ -5,8 +5,10 @@
 #include <ginkgo/core/base/executor.hpp>
 
 
+#include <stdexcept>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 
 #if defined(__unix__) || defined(__APPLE__)
@@ -81,6 +83,51 @@ TEST(OmpExecutor, IsItsOwnMaster)
 }
 
 
+TEST(OmpExecutor, RunsEnqueuedTasksOnSynchronize)
+{
+    auto omp = gko::OmpExecutor::create();
+    std::vector<int> values(10);
+
+    for (int i = 0; i < 10; i++) {
+        omp->enqueue([&values, i] { values[i] = i + 1; });
+    }
+    omp->synchronize();
+
+    ASSERT_EQ(values, std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
+}
+
+
+TEST(OmpExecutor, RunsNestedEnqueuedTasks)
+{
+    auto omp = gko::OmpExecutor::create();
+    std::vector<int> values(4);
+
+    for (int i = 0; i < 2; i++) {
+        omp->enqueue([&, i] {
+            omp->enqueue([&, i] { values[2 * i] = 1; });
+            omp->enqueue([&, i] { values[2 * i + 1] = 2; });
+            omp->synchronize();
+        });
+    }
+    omp->synchronize();
+
+    ASSERT_EQ(values, std::vector<int>({1, 2, 1, 2}));
+}
+
+
+TEST(OmpExecutor, RethrowsExceptionFromEnqueuedTask)
+{
+    auto omp = gko::OmpExecutor::create();
+    int value = 0;
+
+    omp->enqueue([] { throw std::runtime_error("task failed"); });
+    omp->enqueue([&value] { value = 1; });
+
+    ASSERT_THROW(omp->synchronize(), std::runtime_error);
+    ASSERT_EQ(value, 1);
+}
+
+
 #if GKO_HAVE_HWLOC
 
 
@@ -129,6 +176,17 @@ TEST(ReferenceExecutor, AllocatesAndFreesMemory)
 }
 
 
+TEST(ReferenceExecutor, RunsEnqueuedTasksImmediately)
+{
+    auto ref = gko::ReferenceExecutor::create();
+    int value = 0;
+
+    ref->enqueue([&value] { value = 1; });
+
+    ASSERT_EQ(value, 1);
+}
+
+
 TEST(ReferenceExecutor, FreeAcceptsNullptr)
 {
     exec_ptr omp = gko::ReferenceExecutor::create();
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/log/memory_tracker.hpp>
+
+
+#include <sstream>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/preconditioner/jacobi.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class MemoryTracker : public ::testing::Test {
+protected:
+    using Csr = gko::matrix::Csr<double, gko::int32>;
+    using Jacobi = gko::preconditioner::Jacobi<double, gko::int32>;
+
+    MemoryTracker()
+        : exec{gko::ReferenceExecutor::create()},
+          logger{gko::log::MemoryTracker::create()}
+    {}
+
+    std::shared_ptr<gko::ReferenceExecutor> exec;
+    std::shared_ptr<gko::log::MemoryTracker> logger;
+};
+
+
+TEST_F(MemoryTracker, TracksCurrentAndPeakBytes)
+{
+    exec->add_logger(logger);
+    {
+        gko::array<double> a{exec, 100};
+        gko::array<double> b{exec, 50};
+    }
+    gko::array<double> c{exec, 10};
+
+    exec->remove_logger(logger);
+    auto executors = logger->get_executor_summaries();
+    ASSERT_EQ(executors.size(), 1);
+    ASSERT_EQ(executors[0].exec, exec.get());
+    ASSERT_EQ(executors[0].name, "gko::ReferenceExecutor");
+    ASSERT_EQ(executors[0].current_bytes, 80);
+    ASSERT_EQ(executors[0].peak_bytes, 1200);
+    ASSERT_EQ(executors[0].num_allocations, 3);
+    ASSERT_EQ(executors[0].total_bytes, 1280);
+}
+
+
+TEST_F(MemoryTracker, IgnoresUntrackedFrees)
+{
+    auto a = std::make_unique<gko::array<double>>(exec, 100);
+    exec->add_logger(logger);
+    gko::array<double> b{exec, 10};
+
+    a.reset();
+
+    exec->remove_logger(logger);
+    auto executors = logger->get_executor_summaries();
+    ASSERT_EQ(executors[0].current_bytes, 80);
+}
+
+
+TEST_F(MemoryTracker, AttributesAllocationsToInnermostOperation)
+{
+    auto mtx = gko::initialize<Csr>({{1.0, 0.0}, {0.0, 1.0}}, exec);
+    auto factory = Jacobi::build().on(exec);
+    exec->add_logger(logger);
+    gko::array<double> unattributed{exec, 1};
+
+    logger->on_linop_factory_generate_started(factory.get(), mtx.get());
+    gko::array<double> owned{exec, 16};
+    {
+        logger->on_linop_apply_started(mtx.get(), nullptr, nullptr);
+        gko::array<double> temporary{exec, 64};
+        logger->on_linop_apply_completed(mtx.get(), nullptr, nullptr);
+    }
+    logger->on_linop_factory_generate_completed(factory.get(), mtx.get(),
+                                                nullptr);
+
+    exec->remove_logger(logger);
+    auto operations = logger->get_operation_summaries();
+    ASSERT_EQ(operations.size(), 2);
+    ASSERT_EQ(operations[0].name,
+              gko::name_demangling::get_type_name(typeid(Jacobi::Factory)) +
+                  "::generate");
+    ASSERT_EQ(operations[0].count, 1);
+    ASSERT_EQ(operations[0].num_allocations, 1);
+    ASSERT_EQ(operations[0].total_bytes, 128);
+    ASSERT_EQ(operations[0].live_bytes, 128);
+    ASSERT_EQ(operations[0].peak_bytes, 8 + 128 + 512);
+    ASSERT_EQ(operations[1].name,
+              gko::name_demangling::get_type_name(typeid(Csr)) + "::apply");
+    ASSERT_EQ(operations[1].num_allocations, 1);
+    ASSERT_EQ(operations[1].live_bytes, 0);
+    ASSERT_EQ(operations[1].peak_bytes, 8 + 128 + 512);
+    auto live = logger->get_live_allocations();
+    ASSERT_EQ(live.size(), 2);
+    ASSERT_EQ(live[0].location,
+              reinterpret_cast<gko::uintptr>(owned.get_data()));
+    ASSERT_EQ(live[0].num_bytes, 128);
+    ASSERT_EQ(live[0].owner, operations[0].name);
+    ASSERT_EQ(live[1].owner, "unattributed");
+}
+
+
+TEST_F(MemoryTracker, TracksGenerate)
+{
+    auto mtx = gko::share(gko::initialize<Csr>({{2.0, 1.0}, {1.0, 2.0}}, exec));
+    exec->add_logger(logger);
+
+    auto jacobi = Jacobi::build().with_max_block_size(1u).on(exec)->generate(
+        mtx);
+
+    exec->remove_logger(logger);
+    auto operations = logger->get_operation_summaries();
+    ASSERT_FALSE(operations.empty());
+    ASSERT_EQ(operations[0].name,
+              gko::name_demangling::get_type_name(typeid(Jacobi::Factory)) +
+                  "::generate");
+    ASSERT_GT(operations[0].live_bytes, 0);
+    ASSERT_EQ(operations[0].peak_bytes,
+              logger->get_executor_summaries()[0].peak_bytes);
+}
+
+
+TEST_F(MemoryTracker, WritesReport)
+{
+    auto mtx = gko::share(gko::initialize<Csr>({{2.0, 1.0}, {1.0, 2.0}}, exec));
+    exec->add_logger(logger);
+    auto jacobi = Jacobi::build().on(exec)->generate(mtx);
+    exec->remove_logger(logger);
+    std::stringstream ss;
+
+    logger->write(ss);
+
+    const auto output = ss.str();
+    ASSERT_NE(output.find("Memory usage per executor"), std::string::npos);
+    ASSERT_NE(output.find("gko::ReferenceExecutor"), std::string::npos);
+    ASSERT_NE(output.find("Memory usage per operation, by peak"),
+              std::string::npos);
+    ASSERT_NE(output.find("::generate"), std::string::npos);
+}
+
+
+}  // namespace
@@ -7,6 +7,7 @@
 
 #include <chrono>
 #include <string>
+#include <thread>
 
 
 #include <gtest/gtest.h>
@@ -439,3 +440,129 @@ Overhead estimate 1.0 ns
 
     ASSERT_EQ(ss.str(), expected);
 }
+
+
+struct TestTraceWriter : gko::log::ProfilerHook::TraceWriter {
+    TestTraceWriter(std::vector<gko::log::ProfilerHook::trace_event>& events,
+                    gko::int64& num_dropped)
+        : events{&events}, num_dropped{&num_dropped}
+    {}
+
+    void write_trace(
+        const std::vector<gko::log::ProfilerHook::trace_event>& events,
+        gko::int64 num_dropped) override
+    {
+        *this->events = events;
+        *this->num_dropped = num_dropped;
+    }
+
+    std::vector<gko::log::ProfilerHook::trace_event>* events;
+    gko::int64* num_dropped;
+};
+
+
+TEST(ProfilerHook, TraceWorks)
+{
+    std::vector<gko::log::ProfilerHook::trace_event> events;
+    gko::int64 num_dropped{-1};
+    std::vector<std::string> expected{
+        "begin:foo", "begin:foo", "end:foo",  "begin:foo",  "end:foo",
+        "begin:bar", "begin:baz", "end:baz",  "begin:bazz", "end:bazz",
+        "end:bar",   "begin:baz", "end:baz",  "end:foo"};
+    {
+        auto logger = gko::log::ProfilerHook::create_trace(
+            std::make_shared<gko::CpuTimer>(),
+            std::make_unique<TestTraceWriter>(events, num_dropped));
+
+        call_ranges(logger);
+    }
+
+    std::vector<std::string> output;
+    for (const auto& event : events) {
+        output.push_back((event.begin ? "begin:" : "end:") + event.name);
+        ASSERT_EQ(event.category, gko::log::profile_event_category::user);
+        ASSERT_EQ(event.thread_id, 0);
+    }
+    ASSERT_EQ(output, expected);
+    ASSERT_EQ(num_dropped, 0);
+    for (std::size_t i = 1; i < events.size(); i++) {
+        ASSERT_LE(events[i - 1].timestamp, events[i].timestamp);
+    }
+}
+
+
+TEST(ProfilerHook, TraceOverwritesOldestEvents)
+{
+    std::vector<gko::log::ProfilerHook::trace_event> events;
+    gko::int64 num_dropped{-1};
+    {
+        auto logger = gko::log::ProfilerHook::create_trace(
+            std::make_shared<gko::CpuTimer>(),
+            std::make_unique<TestTraceWriter>(events, num_dropped), 3);
+
+        call_ranges(logger);
+    }
+
+    // only the last three events remain, the unmatched end:foo is skipped
+    ASSERT_EQ(num_dropped, 11);
+    ASSERT_EQ(events.size(), 2);
+    ASSERT_EQ(events[0].name, "baz");
+    ASSERT_TRUE(events[0].begin);
+    ASSERT_EQ(events[1].name, "baz");
+    ASSERT_FALSE(events[1].begin);
+}
+
+
+TEST(ProfilerHook, TraceSeparatesThreads)
+{
+    std::vector<gko::log::ProfilerHook::trace_event> events;
+    gko::int64 num_dropped{-1};
+    {
+        auto logger = gko::log::ProfilerHook::create_trace(
+            std::make_shared<gko::CpuTimer>(),
+            std::make_unique<TestTraceWriter>(events, num_dropped));
+
+        auto range = logger->user_range("main");
+        std::thread thread{[&] { auto range = logger->user_range("worker"); }};
+        thread.join();
+    }
+
+    ASSERT_EQ(events.size(), 4);
+    ASSERT_EQ(events[0].name, "main");
+    ASSERT_EQ(events[1].name, "main");
+    ASSERT_EQ(events[2].name, "worker");
+    ASSERT_EQ(events[3].name, "worker");
+    ASSERT_EQ(events[0].thread_id, events[1].thread_id);
+    ASSERT_EQ(events[2].thread_id, events[3].thread_id);
+    ASSERT_NE(events[0].thread_id, events[2].thread_id);
+}
+
+
+TEST(ProfilerHookChromeTraceWriter, TraceWorks)
+{
+    using gko::log::ProfilerHook;
+    using gko::log::profile_event_category;
+    using namespace std::chrono_literals;
+    std::stringstream ss;
+    ProfilerHook::ChromeTraceWriter writer(ss);
+    std::vector<ProfilerHook::trace_event> events;
+    events.push_back({"apply", profile_event_category::linop, true, 0, 5ns});
+    events.push_back(
+        {"a\"b", profile_event_category::operation, true, 0, 1200ns});
+    events.push_back(
+        {"a\"b", profile_event_category::operation, false, 0, 3us});
+    events.push_back({"apply", profile_event_category::linop, false, 0, 1ms});
+    events.push_back({"free", profile_event_category::memory, true, 1, 2ms});
+    const auto expected = R"({"traceEvents":[
+{"name":"apply","cat":"linop","ph":"B","ts":0.005,"pid":0,"tid":0},
+{"name":"a\"b","cat":"operation","ph":"B","ts":1.200,"pid":0,"tid":0},
+{"name":"a\"b","cat":"operation","ph":"E","ts":3.000,"pid":0,"tid":0},
+{"name":"apply","cat":"linop","ph":"E","ts":1000.000,"pid":0,"tid":0},
+{"name":"free","cat":"memory","ph":"B","ts":2000.000,"pid":0,"tid":1}
+],"displayTimeUnit":"ns","otherData":{"dropped_events":4}}
+)";
+
+    writer.write_trace(events, 4);
+
+    ASSERT_EQ(ss.str(), expected);
+}
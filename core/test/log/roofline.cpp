@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/log/roofline.hpp>
+
+
+#include <sstream>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/factorization/ilu.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/identity.hpp>
+#include <ginkgo/core/solver/triangular.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class Roofline : public ::testing::Test {
+protected:
+    using Csr = gko::matrix::Csr<double, gko::int32>;
+    using Vec = gko::matrix::Dense<double>;
+
+    Roofline()
+        : exec{gko::ReferenceExecutor::create()},
+          mtx{gko::initialize<Csr>(
+              {{2.0, 0.0, 0.0}, {1.0, 3.0, 0.0}, {0.0, 1.0, 4.0}}, exec)},
+          b{Vec::create(exec, gko::dim<2>{3, 2})},
+          x{Vec::create(exec, gko::dim<2>{3, 2})}
+    {}
+
+    std::shared_ptr<gko::ReferenceExecutor> exec;
+    std::shared_ptr<Csr> mtx;
+    std::unique_ptr<Vec> b;
+    std::unique_ptr<Vec> x;
+};
+
+
+TEST_F(Roofline, ModelsCsrApply)
+{
+    auto logger = gko::log::Roofline::create();
+
+    logger->on_linop_apply_started(mtx.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(mtx.get(), b.get(), x.get());
+    logger->on_linop_apply_started(mtx.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(mtx.get(), b.get(), x.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].name,
+              gko::name_demangling::get_type_name(typeid(Csr)) + "::apply");
+    ASSERT_EQ(entries[0].count, 2);
+    ASSERT_TRUE(entries[0].has_model);
+    // 5 entries with value and column index, 4 row pointers, 6 + 6 values
+    const double bytes = 5 * 12 + 4 * 4 + 12 * 8;
+    ASSERT_EQ(entries[0].bytes, 2 * bytes);
+    ASSERT_EQ(entries[0].flops, 2 * (2 * 5 * 2));
+    ASSERT_EQ(entries[0].measured_flops, -1);
+}
+
+
+TEST_F(Roofline, LogsOperationsOnExecutor)
+{
+    std::shared_ptr<gko::log::Roofline> logger = gko::log::Roofline::create();
+    exec->add_logger(logger);
+
+    mtx->apply(b, x);
+
+    exec->remove_logger(logger);
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].count, 1);
+    ASSERT_TRUE(entries[0].has_model);
+}
+
+
+TEST_F(Roofline, ModelsAdvancedApply)
+{
+    auto logger = gko::log::Roofline::create();
+
+    logger->on_linop_advanced_apply_started(mtx.get(), nullptr, b.get(),
+                                            nullptr, x.get());
+    logger->on_linop_advanced_apply_completed(mtx.get(), nullptr, b.get(),
+                                              nullptr, x.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].name,
+              gko::name_demangling::get_type_name(typeid(Csr)) +
+                  "::advanced_apply");
+    ASSERT_EQ(entries[0].bytes, 5 * 12 + 4 * 4 + 18 * 8);
+    ASSERT_EQ(entries[0].flops, 2 * 5 * 2 + 3 * 6);
+}
+
+
+TEST_F(Roofline, ModelsTriangularSolveByItsMatrix)
+{
+    auto logger = gko::log::Roofline::create();
+    auto solver = gko::solver::LowerTrs<double, gko::int32>::build()
+                      .on(exec)
+                      ->generate(mtx);
+
+    logger->on_linop_apply_started(solver.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(solver.get(), b.get(), x.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_TRUE(entries[0].has_model);
+    ASSERT_EQ(entries[0].bytes, 5 * 12 + 4 * 4 + 12 * 8);
+    ASSERT_EQ(entries[0].flops, 2 * 5 * 2);
+}
+
+
+TEST_F(Roofline, ModelsGenerateMemoryTraffic)
+{
+    auto logger = gko::log::Roofline::create();
+    auto factory = gko::factorization::Ilu<double, gko::int32>::build()
+                       .with_skip_sorting(true)
+                       .on(exec);
+    auto factors = factory->generate(mtx);
+
+    logger->on_linop_factory_generate_started(factory.get(), mtx.get());
+    logger->on_linop_factory_generate_completed(factory.get(), mtx.get(),
+                                                factors.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_TRUE(entries[0].has_model);
+    // the input, the factor L with 5 and the factor U with 3 entries
+    ASSERT_EQ(entries[0].bytes, 2 * (5 * 12 + 4 * 4) + 3 * 12 + 4 * 4);
+    ASSERT_EQ(entries[0].flops, 0.0);
+}
+
+
+TEST_F(Roofline, TimesOperationsWithoutModel)
+{
+    auto logger = gko::log::Roofline::create();
+    auto id = gko::matrix::Identity<double>::create(exec, 3);
+
+    logger->on_linop_apply_started(id.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(id.get(), b.get(), x.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].count, 1);
+    ASSERT_FALSE(entries[0].has_model);
+    ASSERT_EQ(logger->get_roofline_fraction(entries[0]), -1.0);
+}
+
+
+TEST_F(Roofline, UsesCustomModel)
+{
+    auto logger = gko::log::Roofline::create();
+    auto id = gko::matrix::Identity<double>::create(exec, 3);
+    logger->add_apply_model(
+        typeid(*id), [](const gko::LinOp*, const gko::LinOp* b,
+                        const gko::LinOp*, bool) {
+            return gko::log::Roofline::cost{b->get_size()[0] * 16.0, 0.0};
+        });
+
+    logger->on_linop_apply_started(id.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(id.get(), b.get(), x.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_TRUE(entries[0].has_model);
+    ASSERT_EQ(entries[0].bytes, 48.0);
+}
+
+
+TEST_F(Roofline, AttributesNestedOperations)
+{
+    auto logger = gko::log::Roofline::create();
+    auto id = gko::matrix::Identity<double>::create(exec, 3);
+
+    logger->on_linop_apply_started(id.get(), b.get(), x.get());
+    logger->on_linop_apply_started(mtx.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(mtx.get(), b.get(), x.get());
+    logger->on_linop_apply_completed(id.get(), b.get(), x.get());
+
+    auto entries = logger->get_entries();
+    ASSERT_EQ(entries.size(), 2);
+    ASSERT_FALSE(entries[0].has_model);
+    ASSERT_TRUE(entries[1].has_model);
+    ASSERT_EQ(entries[0].count, 1);
+    ASSERT_EQ(entries[1].count, 1);
+    ASSERT_GE(entries[0].time, entries[1].time);
+}
+
+
+TEST(RooflineFraction, ComputesFractionOfRoofline)
+{
+    using namespace std::chrono_literals;
+    auto logger =
+        gko::log::Roofline::create(std::make_shared<gko::CpuTimer>(), 100.0,
+                                   1000.0);
+    gko::log::Roofline::entry compute_bound{"a", 1, 1s, 1e9, 1e12, true};
+    gko::log::Roofline::entry memory_bound{"b", 1, 1s, 1e9, 1e9, true};
+    gko::log::Roofline::entry bandwidth_only{"c", 1, 1s, 5e10, 0.0, true};
+
+    ASSERT_DOUBLE_EQ(logger->get_roofline_fraction(compute_bound), 1.0);
+    ASSERT_DOUBLE_EQ(logger->get_roofline_fraction(memory_bound), 0.01);
+    ASSERT_DOUBLE_EQ(logger->get_roofline_fraction(bandwidth_only), 0.5);
+}
+
+
+TEST(RooflineWriter, WritesTable)
+{
+    using namespace std::chrono_literals;
+    auto exec = gko::ReferenceExecutor::create();
+    auto mtx = gko::initialize<gko::matrix::Dense<double>>(
+        {{1.0, 0.0}, {0.0, 1.0}}, exec);
+    auto vec = gko::matrix::Dense<double>::create(exec, gko::dim<2>{2, 1});
+    auto logger =
+        gko::log::Roofline::create(std::make_shared<gko::CpuTimer>(), 100.0,
+                                   1000.0);
+    logger->on_linop_apply_started(mtx.get(), vec.get(), vec.get());
+    logger->on_linop_apply_completed(mtx.get(), vec.get(), vec.get());
+    std::stringstream ss;
+
+    logger->write(ss);
+
+    const auto output = ss.str();
+    ASSERT_NE(output.find("Roofline summary (peak 100 GB/s, 1000 GFLOP/s)"),
+              std::string::npos);
+    ASSERT_NE(output.find("| name"), std::string::npos);
+    ASSERT_NE(output.find("roofline"), std::string::npos);
+    ASSERT_NE(output.find("gko::matrix::Dense<double>::apply"),
+              std::string::npos);
+}
+
+
+#if !GKO_HAVE_PAPI_SDE
+
+
+TEST_F(Roofline, ThrowsOnPapiEventWithoutPapi)
+{
+    ASSERT_THROW(gko::log::Roofline::create(std::make_shared<gko::CpuTimer>(),
+                                            0.0, 0.0, "PAPI_DP_OPS"),
+                 gko::NotCompiled);
+}
+
+
+#endif
+
+
+}  // namespace
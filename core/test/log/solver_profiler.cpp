@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/log/solver_profiler.hpp>
+
+
+#include <numeric>
+#include <sstream>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/solver/cg.hpp>
+#include <ginkgo/core/solver/fcg.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class SolverProfiler : public ::testing::Test {
+protected:
+    using Csr = gko::matrix::Csr<double, gko::int32>;
+    using Vec = gko::matrix::Dense<double>;
+    using Cg = gko::solver::Cg<double>;
+    using phase = gko::log::SolverProfiler::phase;
+
+    SolverProfiler()
+        : exec{gko::ReferenceExecutor::create()},
+          mtx{gko::initialize<Csr>({{4.0, -1.0, 0.0, 0.0},
+                                    {-1.0, 4.0, -1.0, 0.0},
+                                    {0.0, -1.0, 4.0, -1.0},
+                                    {0.0, 0.0, -1.0, 4.0}},
+                                   exec)},
+          b{gko::initialize<Vec>({1.0, 2.0, 3.0, 4.0}, exec)},
+          x{gko::initialize<Vec>({0.0, 0.0, 0.0, 0.0}, exec)},
+          logger{gko::log::SolverProfiler::create()}
+    {}
+
+    std::unique_ptr<Cg::Factory> cg_factory(gko::size_type max_iters)
+    {
+        return Cg::build()
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(max_iters),
+                gko::stop::ResidualNorm<double>::build().with_reduction_factor(
+                    1e-14))
+            .on(exec);
+    }
+
+    static int64_t get_phase_count(
+        const gko::log::SolverProfiler::summary& summary, phase p)
+    {
+        return summary.phase_count[static_cast<int>(p)];
+    }
+
+    std::shared_ptr<gko::ReferenceExecutor> exec;
+    std::shared_ptr<Csr> mtx;
+    std::unique_ptr<Vec> b;
+    std::unique_ptr<Vec> x;
+    std::shared_ptr<gko::log::SolverProfiler> logger;
+};
+
+
+TEST_F(SolverProfiler, BreaksDownSolverPhases)
+{
+    auto solver = cg_factory(100u)->generate(mtx);
+    exec->add_logger(logger);
+
+    solver->apply(b, x);
+
+    exec->remove_logger(logger);
+    auto summaries = logger->get_summaries();
+    ASSERT_EQ(summaries.size(), 1);
+    const auto& s = summaries[0];
+    ASSERT_EQ(s.name, gko::name_demangling::get_type_name(typeid(Cg)));
+    ASSERT_EQ(s.count, 1);
+    ASSERT_GT(s.iterations, 0);
+    // the initial residual requires an additional SpMV
+    ASSERT_EQ(get_phase_count(s, phase::spmv), s.iterations + 1);
+    ASSERT_GE(get_phase_count(s, phase::preconditioner), s.iterations);
+    ASSERT_GE(get_phase_count(s, phase::reduction), s.iterations);
+    ASSERT_GE(get_phase_count(s, phase::vector_update), s.iterations);
+    ASSERT_GE(get_phase_count(s, phase::criterion), s.iterations);
+    ASSERT_EQ(get_phase_count(s, phase::other), 1);
+    ASSERT_EQ(std::accumulate(s.phase_time.begin(), s.phase_time.end(),
+                              std::chrono::nanoseconds{}),
+              s.time);
+}
+
+
+TEST_F(SolverProfiler, AggregatesApplications)
+{
+    auto solver = cg_factory(2u)->generate(mtx);
+    solver->add_logger(logger);
+    mtx->add_logger(logger);
+
+    solver->apply(b, x);
+    solver->apply(b, x);
+
+    auto summaries = logger->get_summaries();
+    ASSERT_EQ(summaries.size(), 1);
+    ASSERT_EQ(summaries[0].count, 2);
+    ASSERT_EQ(summaries[0].iterations, 4);
+    ASSERT_EQ(get_phase_count(summaries[0], phase::spmv), 6);
+}
+
+
+TEST_F(SolverProfiler, AttributesNestedSolverToPreconditioner)
+{
+    auto solver = gko::solver::Fcg<double>::build()
+                      .with_criteria(gko::stop::Iteration::build()
+                                         .with_max_iters(3u))
+                      .with_preconditioner(cg_factory(2u))
+                      .on(exec)
+                      ->generate(mtx);
+    exec->add_logger(logger);
+
+    solver->apply(b, x);
+
+    exec->remove_logger(logger);
+    auto summaries = logger->get_summaries();
+    ASSERT_EQ(summaries.size(), 2);
+    const auto& outer = summaries[0];
+    const auto& inner = summaries[1];
+    ASSERT_EQ(outer.count, 1);
+    ASSERT_EQ(outer.iterations, 3);
+    ASSERT_EQ(inner.count, get_phase_count(outer, phase::preconditioner));
+    ASSERT_EQ(inner.iterations, 2 * inner.count);
+    ASSERT_GE(
+        outer.phase_time[static_cast<int>(phase::preconditioner)].count(),
+        inner.time.count());
+}
+
+
+TEST_F(SolverProfiler, IgnoresOperationsOutsideOfSolvers)
+{
+    exec->add_logger(logger);
+
+    mtx->apply(b, x);
+
+    exec->remove_logger(logger);
+    ASSERT_TRUE(logger->get_summaries().empty());
+}
+
+
+TEST_F(SolverProfiler, WritesTable)
+{
+    auto solver = cg_factory(100u)->generate(mtx);
+    exec->add_logger(logger);
+    solver->apply(b, x);
+    exec->remove_logger(logger);
+    std::stringstream ss;
+
+    logger->write(ss);
+
+    const auto output = ss.str();
+    ASSERT_NE(output.find("Solver phase breakdown"), std::string::npos);
+    ASSERT_NE(output.find("time/iteration"), std::string::npos);
+    ASSERT_NE(output.find("preconditioner"), std::string::npos);
+    ASSERT_NE(output.find("gko::solver::Cg<double>"), std::string::npos);
+}
+
+
+}  // namespace
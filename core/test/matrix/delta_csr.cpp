@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/matrix/delta_csr.hpp>
+
+
+#include <memory>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/dim.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class DeltaCsr : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Mtx = gko::matrix::DeltaCsr<value_type, index_type>;
+    using mat_data = gko::matrix_data<value_type, index_type>;
+
+    DeltaCsr()
+        : exec(gko::ReferenceExecutor::create()), mtx(Mtx::create(exec))
+    {
+        // clang-format off
+        mtx->read(mat_data{{2, 400}, {{0, 1, 1.0},
+                                      {0, 2, 3.0},
+                                      {0, 3, 2.0},
+                                      {1, 1, 5.0},
+                                      {1, 301, 4.0}}});
+        // clang-format on
+    }
+
+    std::shared_ptr<const gko::Executor> exec;
+    std::unique_ptr<Mtx> mtx;
+
+    void assert_equal_to_original_mtx(const Mtx* m)
+    {
+        auto v = m->get_const_values();
+        auto r = m->get_const_row_ptrs();
+        auto b = m->get_const_row_bases();
+        auto d = m->get_const_delta_ptrs();
+        auto deltas = m->get_const_deltas();
+        ASSERT_EQ(m->get_size(), gko::dim<2>(2, 400));
+        ASSERT_EQ(m->get_num_stored_elements(), 5);
+        ASSERT_EQ(m->get_num_delta_bytes(), 7);
+        EXPECT_EQ(r[0], 0);
+        EXPECT_EQ(r[1], 3);
+        EXPECT_EQ(r[2], 5);
+        EXPECT_EQ(b[0], 1);
+        EXPECT_EQ(b[1], 1);
+        EXPECT_EQ(d[0], 0);
+        EXPECT_EQ(d[1], 3);
+        EXPECT_EQ(d[2], 7);
+        EXPECT_EQ(deltas[0], 0);
+        EXPECT_EQ(deltas[1], 1);
+        EXPECT_EQ(deltas[2], 2);
+        EXPECT_EQ(v[0], value_type{1.0});
+        EXPECT_EQ(v[1], value_type{3.0});
+        EXPECT_EQ(v[2], value_type{2.0});
+        EXPECT_EQ(v[3], value_type{5.0});
+        EXPECT_EQ(v[4], value_type{4.0});
+    }
+
+    void assert_empty(const Mtx* m)
+    {
+        ASSERT_EQ(m->get_size(), gko::dim<2>(0, 0));
+        ASSERT_EQ(m->get_num_stored_elements(), 0);
+        ASSERT_EQ(m->get_num_delta_bytes(), 0);
+        ASSERT_EQ(m->get_const_values(), nullptr);
+        ASSERT_EQ(m->get_const_deltas(), nullptr);
+        ASSERT_NE(m->get_const_row_ptrs(), nullptr);
+        ASSERT_NE(m->get_const_delta_ptrs(), nullptr);
+    }
+};
+
+TYPED_TEST_SUITE(DeltaCsr, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(DeltaCsr, KnowsItsSize)
+{
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(2, 400));
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 5);
+}
+
+
+TYPED_TEST(DeltaCsr, ContainsCorrectData)
+{
+    this->assert_equal_to_original_mtx(this->mtx.get());
+}
+
+
+TYPED_TEST(DeltaCsr, CanBeEmpty)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto mtx = Mtx::create(this->exec);
+
+    this->assert_empty(mtx.get());
+}
+
+
+TYPED_TEST(DeltaCsr, CanBeCreatedWithSize)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto mtx = Mtx::create(this->exec, gko::dim<2>{3, 2});
+
+    ASSERT_EQ(mtx->get_size(), gko::dim<2>(3, 2));
+    ASSERT_EQ(mtx->get_num_stored_elements(), 0);
+    EXPECT_EQ(mtx->get_const_row_ptrs()[3], 0);
+    EXPECT_EQ(mtx->get_const_delta_ptrs()[3], 0);
+}
+
+
+TYPED_TEST(DeltaCsr, StoresWideDeltasOnlyForRowsWithLargeSpan)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using mat_data = typename TestFixture::mat_data;
+    auto mtx = Mtx::create(this->exec);
+
+    mtx->read(mat_data{{3, 100000},
+                       {{0, 5, 1.0}, {1, 7, 2.0}, {1, 99999, 3.0}}});
+
+    auto d = mtx->get_const_delta_ptrs();
+    EXPECT_EQ(d[0], 0);
+    EXPECT_EQ(d[1], 1);
+    EXPECT_EQ(d[2], 9);
+    EXPECT_EQ(d[3], 9);
+    EXPECT_EQ(mtx->get_const_row_bases()[1], 7);
+}
+
+
+TYPED_TEST(DeltaCsr, CanBeCopied)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->copy_from(this->mtx);
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(DeltaCsr, CanBeMoved)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto copy = Mtx::create(this->exec);
+
+    copy->move_from(this->mtx);
+
+    this->assert_equal_to_original_mtx(copy.get());
+}
+
+
+TYPED_TEST(DeltaCsr, CanBeCloned)
+{
+    auto clone = this->mtx->clone();
+
+    this->assert_equal_to_original_mtx(this->mtx.get());
+    this->assert_equal_to_original_mtx(clone.get());
+}
+
+
+TYPED_TEST(DeltaCsr, CanBeCleared)
+{
+    this->mtx->clear();
+
+    this->assert_empty(this->mtx.get());
+}
+
+
+TYPED_TEST(DeltaCsr, GeneratesCorrectMatrixData)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    using tpl = typename gko::matrix_data<value_type, index_type>::nonzero_type;
+    gko::matrix_data<value_type, index_type> data;
+
+    this->mtx->write(data);
+
+    ASSERT_EQ(data.size, gko::dim<2>(2, 400));
+    ASSERT_EQ(data.nonzeros.size(), 5);
+    EXPECT_EQ(data.nonzeros[0], tpl(0, 1, value_type{1.0}));
+    EXPECT_EQ(data.nonzeros[1], tpl(0, 2, value_type{3.0}));
+    EXPECT_EQ(data.nonzeros[2], tpl(0, 3, value_type{2.0}));
+    EXPECT_EQ(data.nonzeros[3], tpl(1, 1, value_type{5.0}));
+    EXPECT_EQ(data.nonzeros[4], tpl(1, 301, value_type{4.0}));
+}
+
+
+}  // namespace
@@ -151,6 +151,21 @@ TYPED_TEST(Sellp, CanBeConstructedWithSliceSizeAndStrideFactor)
 }
 
 
+TYPED_TEST(Sellp, CanBeConstructedWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto mtx = Mtx::create(this->exec, gko::dim<2>{2, 3}, 2, 2, 4, 3);
+
+    ASSERT_EQ(mtx->get_size(), gko::dim<2>(2, 3));
+    ASSERT_EQ(mtx->get_num_stored_elements(), 6);
+    ASSERT_EQ(mtx->get_slice_size(), 2);
+    ASSERT_EQ(mtx->get_stride_factor(), 2);
+    ASSERT_EQ(mtx->get_sorting_window(), 4);
+    ASSERT_EQ(mtx->get_total_cols(), 3);
+    ASSERT_EQ(mtx->get_const_permutation(), nullptr);
+}
+
+
 TYPED_TEST(Sellp, CanBeCopied)
 {
     using Mtx = typename TestFixture::Mtx;
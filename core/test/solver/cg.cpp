@@ -273,4 +273,26 @@ TYPED_TEST(Cg, PassExplicitFactory)
 }
 
 
+TYPED_TEST(Cg, PersistentRegionIsDisabledByDefault)
+{
+    ASSERT_FALSE(this->cg_factory->get_parameters().persistent_region);
+}
+
+
+TYPED_TEST(Cg, TransposeKeepsPersistentRegion)
+{
+    using Solver = typename TestFixture::Solver;
+    auto solver = Solver::build()
+                      .with_criteria(
+                          gko::stop::Iteration::build().with_max_iters(3u))
+                      .with_persistent_region(true)
+                      .on(this->exec)
+                      ->generate(this->mtx);
+
+    auto transposed = gko::as<Solver>(solver->transpose());
+
+    ASSERT_TRUE(transposed->get_parameters().persistent_region);
+}
+
+
 }  // namespace
@@ -60,13 +60,6 @@ void OmpExecutor::raw_copy_to(const OmpExecutor*, size_type num_bytes,
 }
 
 
-void OmpExecutor::synchronize() const
-{
-    // This is a no-op for single-threaded OMP
-    // TODO: change when adding support for multi-threaded OMP execution
-}
-
-
 scoped_device_id_guard OmpExecutor::get_scoped_device_id_guard() const
 {
     return {this, 0};
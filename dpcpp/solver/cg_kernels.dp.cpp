@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "core/solver/cg_kernels.hpp"
+
+
+#include <ginkgo/core/base/exception_helpers.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace dpcpp {
+/**
+ * @brief The CG solver namespace.
+ *
+ * @ingroup cg
+ */
+namespace cg {
+
+
+template <typename ValueType, typename IndexType>
+void persistent_solve(
+    std::shared_ptr<const DefaultExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* a, matrix::Dense<ValueType>* x,
+    matrix::Dense<ValueType>* r, matrix::Dense<ValueType>* p,
+    matrix::Dense<ValueType>* q,
+    const matrix::Dense<remove_complex<ValueType>>* thresholds,
+    size_type max_iters, uint8 stopping_id, array<stopping_status>* stop_status,
+    size_type* num_iterations) GKO_NOT_IMPLEMENTED;
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CG_PERSISTENT_SOLVE_KERNEL);
+
+
+}  // namespace cg
+}  // namespace dpcpp
+}  // namespace kernels
+}  // namespace gko
@@ -45,6 +45,9 @@ GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE_SPLIT3(GKO_DECLARE_CSR_SPMV_KERNEL,
 // split
 GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE_SPLIT4(GKO_DECLARE_CSR_SPMV_KERNEL,
                                                  int64);
+// split
+GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_SPMV_KERNEL);
 
 
 // split
@@ -71,6 +74,9 @@ GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE_SPLIT3(
 // split
 GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_TYPE_SPLIT4(
     GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL, int64);
+// split
+GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
 
 
 // split
@@ -9,7 +9,9 @@
 #include <vector>
 
 
+#include <ginkgo/core/base/dense_cache.hpp>
 #include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
 
 
 namespace gko {
@@ -201,7 +203,7 @@ private:
 
         std::unique_ptr<LinOp> zero;
         std::unique_ptr<LinOp> one;
-        std::unique_ptr<LinOp> intermediate_x;
+        std::vector<detail::DenseCache<ValueType>> scaled_coefficients;
     } cache_;
 };
 
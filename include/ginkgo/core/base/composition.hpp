@@ -9,8 +9,10 @@
 #include <vector>
 
 
+#include <ginkgo/core/base/dense_cache.hpp>
 #include <ginkgo/core/base/executor.hpp>
 #include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
 
 
 namespace gko {
@@ -31,6 +33,16 @@ namespace gko {
  * executor, and if not, copies the operators to the executor of the first
  * operator.
  *
+ * On the first apply, neighboring operators that can be combined cheaply are
+ * fused into a single operator: products of Diagonal or Permutation matrices,
+ * and Diagonal or Permutation matrices next to a Csr matrix of the same value
+ * and index type. This saves a full sweep over the intermediate vectors per
+ * fused operator. The fused operators are only used internally,
+ * get_operators() still returns the original operators, which must not be
+ * modified after the first apply. The intermediate vectors are kept between
+ * applications and only reallocated when the number of right-hand sides
+ * changes.
+ *
  * @tparam ValueType  precision of input and result vectors
  *
  * @ingroup LinOp
@@ -113,7 +125,7 @@ protected:
      * @param exec  Executor associated to the composition
      */
     explicit Composition(std::shared_ptr<const Executor> exec)
-        : EnableLinOp<Composition>(exec), storage_{exec}
+        : EnableLinOp<Composition>(exec)
     {}
 
     /**
@@ -134,8 +146,7 @@ protected:
                   throw OutOfBoundsError(__FILE__, __LINE__, 1, 0);
               }
               return (*begin)->get_executor();
-          }()),
-          storage_{this->get_executor()}
+          }())
     {
         for (auto it = begin; it != end; ++it) {
             add_operators(*it);
@@ -163,8 +174,17 @@ protected:
                     LinOp* x) const override;
 
 private:
+    /**
+     * Returns the operators used for the application, where neighboring
+     * operators that can be combined have been fused. They are computed on
+     * first use.
+     */
+    const std::vector<std::shared_ptr<const LinOp>>& get_fused_operators()
+        const;
+
     std::vector<std::shared_ptr<const LinOp>> operators_;
-    mutable array<ValueType> storage_;
+    mutable std::vector<std::shared_ptr<const LinOp>> fused_operators_;
+    mutable std::vector<detail::DenseCache<ValueType>> intermediates_;
 };
 
 
@@ -8,6 +8,7 @@
 
 #include <array>
 #include <atomic>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
@@ -1353,8 +1354,35 @@ public:
 
     std::shared_ptr<const Executor> get_master() const noexcept override;
 
+    /**
+     * Runs all tasks enqueued by the calling thread and waits for their
+     * completion.
+     *
+     * If a task throws an exception, the remaining tasks still run, and the
+     * first exception is rethrown afterwards.
+     */
     void synchronize() const override;
 
+    /**
+     * Enqueues a task on the task queue of the calling thread, which behaves
+     * like a stream: the task may run at any point before the next call to
+     * synchronize() from the same thread returns.
+     *
+     * All tasks enqueued between two synchronization points run concurrently,
+     * each on a share of the OpenMP threads, within a single parallel region.
+     * This allows independent operations, such as the applications of
+     * different blocks of an operator, to overlap, and amortizes the fork/join
+     * overhead for small operations. The tasks thus need to be independent of
+     * each other. Loggers attached to objects used inside the tasks need to
+     * be thread-safe.
+     *
+     * On a ReferenceExecutor, or if Ginkgo was built without OpenMP, the task
+     * runs immediately.
+     *
+     * @param task  the task to run
+     */
+    void enqueue(std::function<void()> task) const;
+
     int get_num_cores() const
     {
         return this->get_exec_info().num_computing_units;
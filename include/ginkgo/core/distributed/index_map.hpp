@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_PUBLIC_CORE_DISTRIBUTED_INDEX_MAP_HPP_
+#define GKO_PUBLIC_CORE_DISTRIBUTED_INDEX_MAP_HPP_
+
+
+#include <ginkgo/config.hpp>
+
+
+#if GINKGO_BUILD_MPI
+
+
+#include <vector>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/mpi.hpp>
+#include <ginkgo/core/base/polymorphic_object.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace experimental {
+namespace distributed {
+
+
+/**
+ * An IndexMap describes the halo of a distributed column space, i.e. which
+ * non-local (ghost) columns a process needs, how they are numbered locally,
+ * and which of its own entries it has to send to the other processes.
+ *
+ * The non-local columns are numbered consecutively by their owning process
+ * and their global index. The communication pattern consists of the number
+ * of entries sent to and received from each process, together with the local
+ * indices (gather indices) of the entries that are sent.
+ *
+ * An IndexMap is immutable after its construction and can be shared between
+ * distributed matrices with the same column partition and non-local
+ * sparsity pattern, e.g. a Jacobian and a mass matrix. Distributed vectors
+ * matching its column space can be created from it, see Vector::create.
+ *
+ * @tparam LocalIndexType  type for local indices
+ * @tparam GlobalIndexType  type for global indices
+ */
+template <typename LocalIndexType = int32, typename GlobalIndexType = int64>
+class IndexMap
+    : public EnablePolymorphicObject<IndexMap<LocalIndexType, GlobalIndexType>>,
+      public EnablePolymorphicAssignment<
+          IndexMap<LocalIndexType, GlobalIndexType>> {
+    friend class EnablePolymorphicObject<IndexMap>;
+
+public:
+    using EnablePolymorphicAssignment<IndexMap>::convert_to;
+    using EnablePolymorphicAssignment<IndexMap>::move_to;
+    using local_index_type = LocalIndexType;
+    using global_index_type = GlobalIndexType;
+
+    /**
+     * Returns the global size of the column space.
+     *
+     * @return  the global number of columns.
+     */
+    size_type get_global_size() const noexcept { return global_size_; }
+
+    /**
+     * Returns the number of columns owned by this process.
+     *
+     * @return  the local number of columns.
+     */
+    size_type get_local_size() const noexcept { return local_size_; }
+
+    /**
+     * Returns the number of non-local columns of this process.
+     *
+     * @return  the number of non-local columns.
+     */
+    size_type get_non_local_size() const noexcept
+    {
+        return non_local_to_global_.get_size();
+    }
+
+    /**
+     * Returns the global indices of the non-local columns, in the order of
+     * their local numbering.
+     *
+     * @return  the non-local to global index map.
+     */
+    const array<global_index_type>& get_non_local_to_global() const noexcept
+    {
+        return non_local_to_global_;
+    }
+
+    /**
+     * Returns the local indices of the entries that are sent to the other
+     * processes, ordered by the receiving process.
+     *
+     * @return  the gather indices.
+     */
+    const array<local_index_type>& get_gather_idxs() const noexcept
+    {
+        return gather_idxs_;
+    }
+
+    /** Returns the number of entries sent to each process. */
+    const std::vector<comm_index_type>& get_send_sizes() const noexcept
+    {
+        return send_sizes_;
+    }
+
+    /**
+     * Returns the offsets of the entries sent to each process, with the
+     * total number of sent entries as last element.
+     */
+    const std::vector<comm_index_type>& get_send_offsets() const noexcept
+    {
+        return send_offsets_;
+    }
+
+    /** Returns the number of entries received from each process. */
+    const std::vector<comm_index_type>& get_recv_sizes() const noexcept
+    {
+        return recv_sizes_;
+    }
+
+    /**
+     * Returns the offsets of the entries received from each process, with the
+     * total number of received entries as last element.
+     */
+    const std::vector<comm_index_type>& get_recv_offsets() const noexcept
+    {
+        return recv_offsets_;
+    }
+
+    /**
+     * Creates an index map without any non-local columns.
+     *
+     * @param exec  the Executor on which the index map should be stored
+     * @param num_parts  the number of processes
+     * @param global_size  the global number of columns
+     * @param local_size  the number of columns owned by this process
+     *
+     * @return  an index map with an empty communication pattern.
+     */
+    static std::unique_ptr<IndexMap> create(
+        std::shared_ptr<const Executor> exec, comm_index_type num_parts = 0,
+        size_type global_size = 0, size_type local_size = 0);
+
+    /**
+     * Builds an index map from the non-local columns of this process. This
+     * exchanges the communication pattern between all processes of the
+     * communicator, so it needs to be called collectively.
+     *
+     * @param exec  the Executor on which the index map should be stored
+     * @param comm  the communicator of the column partition
+     * @param global_size  the global number of columns
+     * @param local_size  the number of columns owned by this process
+     * @param recv_sizes  the number of non-local columns owned by each
+     *                    process
+     * @param recv_gather_idxs  the local index of each non-local column on
+     *                          its owning process
+     * @param non_local_to_global  the global index of each non-local column
+     *
+     * @return  the index map of this process.
+     */
+    static std::unique_ptr<IndexMap> build_from_non_local_columns(
+        std::shared_ptr<const Executor> exec, mpi::communicator comm,
+        size_type global_size, size_type local_size,
+        const array<comm_index_type>& recv_sizes,
+        const array<local_index_type>& recv_gather_idxs,
+        array<global_index_type> non_local_to_global);
+
+private:
+    IndexMap(std::shared_ptr<const Executor> exec,
+             comm_index_type num_parts = 0, size_type global_size = 0,
+             size_type local_size = 0);
+
+    size_type global_size_;
+    size_type local_size_;
+    std::vector<comm_index_type> send_offsets_;
+    std::vector<comm_index_type> send_sizes_;
+    std::vector<comm_index_type> recv_offsets_;
+    std::vector<comm_index_type> recv_sizes_;
+    array<local_index_type> gather_idxs_;
+    array<global_index_type> non_local_to_global_;
+};
+
+
+}  // namespace distributed
+}  // namespace experimental
+}  // namespace gko
+
+
+#endif
+
+
+#endif  // GKO_PUBLIC_CORE_DISTRIBUTED_INDEX_MAP_HPP_
@@ -15,6 +15,7 @@
 #include <ginkgo/core/base/dense_cache.hpp>
 #include <ginkgo/core/base/mpi.hpp>
 #include <ginkgo/core/distributed/base.hpp>
+#include <ginkgo/core/distributed/index_map.hpp>
 #include <ginkgo/core/distributed/lin_op.hpp>
 
 
@@ -251,6 +252,7 @@ public:
     using global_vector_type =
         gko::experimental::distributed::Vector<ValueType>;
     using local_vector_type = typename global_vector_type::local_vector_type;
+    using index_map_type = IndexMap<local_index_type, global_index_type>;
 
     using EnableDistributedLinOp<Matrix>::convert_to;
     using EnableDistributedLinOp<Matrix>::move_to;
@@ -336,6 +338,105 @@ public:
         ptr_param<const Partition<local_index_type, global_index_type>>
             col_partition);
 
+    /**
+     * Replaces the values of the matrix by the entries of the
+     * device_matrix_data structure, reusing the index map set up by the
+     * previous read_distributed call.
+     *
+     * In contrast to read_distributed, this does not exchange the
+     * communication pattern between the processes, so it is purely local.
+     * This is intended for repeated assembly with the same sparsity pattern,
+     * where only the values change.
+     *
+     * @note The data has to contain entries in exactly the same non-local
+     *       columns as the data the matrix was read from, otherwise an
+     *       InvalidStateError is thrown. The local part may change freely.
+     *
+     * @param data  The device_matrix_data structure.
+     * @param row_partition  The global row partition.
+     * @param col_partition  The global col partition.
+     */
+    void update_values(
+        const device_matrix_data<value_type, global_index_type>& data,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            row_partition,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            col_partition);
+
+    /**
+     * Replaces the values of the matrix by the entries of the matrix_data
+     * structure, reusing the existing communication pattern.
+     *
+     * @see update_values
+     *
+     * @note For efficiency it is advised to use the device_matrix_data
+     * overload.
+     */
+    void update_values(
+        const matrix_data<value_type, global_index_type>& data,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            row_partition,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            col_partition);
+
+    /**
+     * Reads a matrix from the device_matrix_data structure, a global row
+     * partition, and a global column partition, sharing the given index map
+     * instead of setting up a new one.
+     *
+     * This allows matrices with the same column partition and non-local
+     * sparsity pattern, e.g. a Jacobian and a mass matrix, to share a single
+     * communication pattern. Since no communication pattern has to be
+     * exchanged, this is purely local.
+     *
+     * @note The data has to contain entries in exactly the non-local columns
+     *       described by the index map, otherwise an InvalidStateError is
+     *       thrown.
+     *
+     * @param data  The device_matrix_data structure.
+     * @param row_partition  The global row partition.
+     * @param col_partition  The global col partition.
+     * @param index_map  The index map of the column space, usually obtained
+     *                   from get_index_map of another matrix.
+     */
+    void read_distributed(
+        const device_matrix_data<value_type, global_index_type>& data,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            row_partition,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            col_partition,
+        std::shared_ptr<const index_map_type> index_map);
+
+    /**
+     * Reads a matrix from the matrix_data structure, a global row partition,
+     * and a global column partition, sharing the given index map.
+     *
+     * @see read_distributed
+     *
+     * @note For efficiency it is advised to use the device_matrix_data
+     * overload.
+     */
+    void read_distributed(
+        const matrix_data<value_type, global_index_type>& data,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            row_partition,
+        ptr_param<const Partition<local_index_type, global_index_type>>
+            col_partition,
+        std::shared_ptr<const index_map_type> index_map);
+
+    /**
+     * Get read access to the index map, which describes the non-local
+     * columns and the communication pattern of this matrix. It can be shared
+     * with other matrices, see read_distributed, and used to create vectors
+     * matching the column space, see Vector::create.
+     *
+     * @return  Shared pointer to the index map
+     */
+    std::shared_ptr<const index_map_type> get_index_map() const
+    {
+        return index_map_;
+    }
+
     /**
      * Get read access to the stored local matrix.
      *
@@ -541,12 +642,18 @@ protected:
                     LinOp* x) const override;
 
 private:
-    std::vector<comm_index_type> send_offsets_;
-    std::vector<comm_index_type> send_sizes_;
-    std::vector<comm_index_type> recv_offsets_;
-    std::vector<comm_index_type> recv_sizes_;
-    array<local_index_type> gather_idxs_;
-    array<global_index_type> non_local_to_global_;
+    /**
+     * Reads the local and non-local matrices from data. If index_map is
+     * non-null, the non-local columns need to match it, and it is shared
+     * as-is. Otherwise, a new index map is set up from the data.
+     */
+    void read_distributed_impl(
+        const device_matrix_data<value_type, global_index_type>& data,
+        const Partition<local_index_type, global_index_type>* row_partition,
+        const Partition<local_index_type, global_index_type>* col_partition,
+        std::shared_ptr<const index_map_type> index_map);
+
+    std::shared_ptr<const index_map_type> index_map_;
     gko::detail::DenseCache<value_type> one_scalar_;
     gko::detail::DenseCache<value_type> host_send_buffer_;
     gko::detail::DenseCache<value_type> host_recv_buffer_;
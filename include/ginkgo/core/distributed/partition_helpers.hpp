@@ -12,6 +12,10 @@
 #if GINKGO_BUILD_MPI
 
 
+#include <unordered_map>
+
+
+#include <ginkgo/core/base/matrix_data.hpp>
 #include <ginkgo/core/base/mpi.hpp>
 #include <ginkgo/core/base/range.hpp>
 
@@ -24,6 +28,14 @@ template <typename LocalIndexType, typename GlobalIndexType>
 class Partition;
 
 
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+class Matrix;
+
+
+template <typename ValueType>
+class Vector;
+
+
 /**
  * Builds a partition from a local range.
  *
@@ -64,6 +76,76 @@ build_partition_from_local_size(std::shared_ptr<const Executor> exec,
                                 mpi::communicator comm, size_type local_size);
 
 
+/**
+ * Builds a partition from the graph of a matrix using METIS. The partition
+ * balances the number of rows per part and minimizes the edge cut, i.e. the
+ * number of couplings between rows in different parts, which determines the
+ * communication volume of a distributed matrix. The graph is symmetrized and
+ * its diagonal is ignored.
+ *
+ * The partition is computed on process 0 and broadcast to all other
+ * processes, so the graph only needs to be available on process 0.
+ *
+ * @param exec  the Executor on which the partition should be built.
+ * @param comm  the communicator used to determine the number of parts.
+ * @param graph  the matrix whose sparsity pattern is partitioned, only used
+ *               on process 0.
+ * @param options  the METIS options to use, indexed by METIS_OPTION_*
+ *                 constants.
+ *
+ * @return a Partition with one part per process.
+ *
+ * @throws NotCompiled  if Ginkgo was built without METIS.
+ */
+template <typename LocalIndexType, typename GlobalIndexType, typename ValueType>
+std::unique_ptr<Partition<LocalIndexType, GlobalIndexType>>
+build_partition_from_graph(std::shared_ptr<const Executor> exec,
+                           mpi::communicator comm,
+                           const matrix_data<ValueType, GlobalIndexType>& graph,
+                           const std::unordered_map<int, int>& options = {});
+
+
+/**
+ * Redistributes a matrix to new row and column partitions. The entries of
+ * each local row are sent to the process owning the row in the new row
+ * partition. The local matrix formats are preserved. This needs to be called
+ * collectively.
+ *
+ * @param mtx  the matrix to redistribute.
+ * @param row_partition  the current row partition of mtx.
+ * @param col_partition  the current column partition of mtx.
+ * @param new_row_partition  the new row partition.
+ * @param new_col_partition  the new column partition.
+ *
+ * @return the redistributed matrix.
+ */
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+std::unique_ptr<Matrix<ValueType, LocalIndexType, GlobalIndexType>>
+redistribute(
+    const Matrix<ValueType, LocalIndexType, GlobalIndexType>* mtx,
+    const Partition<LocalIndexType, GlobalIndexType>* row_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* col_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_row_partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_col_partition);
+
+
+/**
+ * Redistributes a vector to a new row partition. This needs to be called
+ * collectively.
+ *
+ * @param vec  the vector to redistribute.
+ * @param partition  the current row partition of vec.
+ * @param new_partition  the new row partition.
+ *
+ * @return the redistributed vector.
+ */
+template <typename LocalIndexType, typename GlobalIndexType, typename ValueType>
+std::unique_ptr<Vector<ValueType>> redistribute(
+    const Vector<ValueType>* vec,
+    const Partition<LocalIndexType, GlobalIndexType>* partition,
+    const Partition<LocalIndexType, GlobalIndexType>* new_partition);
+
+
 }  // namespace distributed
 }  // namespace experimental
 }  // namespace gko
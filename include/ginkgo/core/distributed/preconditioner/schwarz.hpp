@@ -13,9 +13,12 @@
 
 
 #include <ginkgo/core/base/abstract_factory.hpp>
+#include <ginkgo/core/base/dense_cache.hpp>
 #include <ginkgo/core/base/lin_op.hpp>
+#include <ginkgo/core/distributed/index_map.hpp>
 #include <ginkgo/core/distributed/matrix.hpp>
 #include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/multigrid/multigrid_level.hpp>
 
 
 namespace gko {
@@ -29,6 +32,17 @@ namespace distributed {
 namespace preconditioner {
 
 
+/**
+ * coarse_correction_type defines how the coarse level correction of a
+ * two-level Schwarz preconditioner is combined with the local corrections.
+ * - additive: the local and coarse corrections are both computed from the
+ *   right-hand side and added up.
+ * - multiplicative: the coarse correction is computed first, and the local
+ *   corrections are computed from the remaining residual.
+ */
+enum class coarse_correction_type { additive, multiplicative };
+
+
 /**
  * A Schwarz preconditioner is a simple domain decomposition preconditioner that
  * generalizes the Block Jacobi preconditioner, incorporating options for
@@ -37,7 +51,17 @@ namespace preconditioner {
  * See Iterative Methods for Sparse Linear Systems (Y. Saad) for a general
  * treatment and variations of the method.
  *
- * @note Currently overlap and coarse grid correction are not supported (TODO).
+ * Without overlap, the local solver is applied to the diagonal block of each
+ * process. With a non-zero overlap, each subdomain is extended by layers of
+ * rows of the neighboring subdomains, and the preconditioner is applied as
+ * restricted additive Schwarz (RAS), i.e. only the solution of the owned rows
+ * is kept.
+ *
+ * Optionally, a coarse level correction can be added to make the number of
+ * iterations independent of the number of subdomains. The coarse level is
+ * generated by a multigrid level factory, e.g. multigrid::Pgm, and solved by
+ * the coarse solver. It is combined with the one-level preconditioner as
+ * specified by coarse_correction_type.
  *
  * @tparam ValueType  precision of matrix elements
  * @tparam IndexType  integral type of the preconditioner
@@ -74,6 +98,40 @@ public:
          */
         std::shared_ptr<const LinOp> GKO_FACTORY_PARAMETER_SCALAR(
             generated_local_solver, nullptr);
+
+        /**
+         * The number of layers of rows of the neighboring subdomains that are
+         * added to the local subdomain. The additional rows are fetched once
+         * during the generation, and the local solver is generated from the
+         * overlapping subdomain matrix, so this requires the local_solver
+         * factory. Each application then needs a single halo exchange of the
+         * right-hand side.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(overlap, 0);
+
+        /**
+         * Factory generating the coarse level from the system matrix. It has
+         * to generate a multigrid::MultigridLevel whose operators are
+         * distributed matrices with the same value and index types, e.g.
+         * multigrid::Pgm. Using its agglomeration_threshold, the coarse
+         * problem can be moved to a subset of the processes. If no coarse
+         * level is given, the preconditioner is a one-level method.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_DEFERRED_FACTORY_PARAMETER(
+            coarse_level);
+
+        /**
+         * Solver factory for the coarse matrix. Required together with
+         * coarse_level.
+         */
+        std::shared_ptr<const LinOpFactory> GKO_DEFERRED_FACTORY_PARAMETER(
+            coarse_solver);
+
+        /**
+         * How the coarse correction is combined with the local corrections.
+         */
+        coarse_correction_type GKO_FACTORY_PARAMETER_SCALAR(
+            coarse_correction, coarse_correction_type::additive);
     };
     GKO_ENABLE_LIN_OP_FACTORY(Schwarz, parameters, Factory);
     GKO_ENABLE_BUILD_METHOD(Factory);
@@ -114,6 +172,9 @@ protected:
     template <typename VectorType>
     void apply_dense_impl(const VectorType* b, VectorType* x) const;
 
+    template <typename VectorType>
+    void apply_local_impl(const VectorType* b, VectorType* x) const;
+
     void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
                     LinOp* x) const override;
 
@@ -125,7 +186,32 @@ private:
      */
     void set_solver(std::shared_ptr<const LinOp> new_solver);
 
+    /**
+     * Builds the local matrix of the subdomain extended by
+     * parameters_.overlap layers of rows, and the communication pattern
+     * fetching the right-hand side on the additional rows.
+     *
+     * @param system_matrix  the distributed system matrix
+     *
+     * @return  the overlapping subdomain matrix.
+     */
+    std::shared_ptr<const LinOp> generate_overlap(
+        const Matrix<ValueType, LocalIndexType, GlobalIndexType>*
+            system_matrix);
+
     std::shared_ptr<const LinOp> local_solver_;
+    std::shared_ptr<const LinOp> system_matrix_;
+    std::shared_ptr<const gko::multigrid::MultigridLevel> coarse_level_;
+    std::shared_ptr<const LinOp> coarse_solver_;
+    std::shared_ptr<const IndexMap<LocalIndexType, GlobalIndexType>>
+        overlap_map_;
+
+    gko::detail::DenseCache<ValueType> overlap_b_;
+    gko::detail::DenseCache<ValueType> overlap_x_;
+    gko::detail::DenseCache<ValueType> send_buffer_;
+    gko::detail::DenseCache<ValueType> recv_buffer_;
+    gko::detail::DenseCache<ValueType> host_send_buffer_;
+    gko::detail::DenseCache<ValueType> host_recv_buffer_;
 };
 
 
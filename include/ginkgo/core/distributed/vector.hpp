@@ -28,6 +28,10 @@ template <typename LocalIndexType, typename GlobalIndexType>
 class Partition;
 
 
+template <typename LocalIndexType, typename GlobalIndexType>
+class IndexMap;
+
+
 /**
  * Vector is a format which explicitly stores (multiple) distributed column
  * vectors in a dense storage format.
@@ -506,6 +510,29 @@ public:
                                           dim<2> global_size = {},
                                           dim<2> local_size = {});
 
+    /**
+     * Creates an empty distributed vector matching the column space described
+     * by an index map, e.g. a vector that can be multiplied by a distributed
+     * matrix sharing this index map.
+     *
+     * @param exec  Executor associated with vector
+     * @param comm  Communicator associated with vector
+     * @param index_map  the index map describing the column space
+     * @param num_cols  the number of columns of the vector
+     *
+     * @return A smart pointer to the newly created vector.
+     */
+    template <typename LocalIndexType, typename GlobalIndexType>
+    static std::unique_ptr<Vector> create(
+        std::shared_ptr<const Executor> exec, mpi::communicator comm,
+        const IndexMap<LocalIndexType, GlobalIndexType>* index_map,
+        size_type num_cols = 1)
+    {
+        return create(exec, comm,
+                      dim<2>{index_map->get_global_size(), num_cols},
+                      dim<2>{index_map->get_local_size(), num_cols});
+    }
+
     /**
      * Creates a distributed vector from local vectors with a specified size.
      *
@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_PUBLIC_CORE_LOG_MEMORY_TRACKER_HPP_
+#define GKO_PUBLIC_CORE_LOG_MEMORY_TRACKER_HPP_
+
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+#include <ginkgo/config.hpp>
+#include <ginkgo/core/log/logger.hpp>
+
+
+namespace gko {
+namespace log {
+
+
+/**
+ * MemoryTracker is a Logger which tracks the current and peak memory usage of
+ * every executor, and attributes every allocation to the innermost enclosing
+ * operation, i.e. LinOp application, LinOpFactory generate call or kernel
+ * launch. For every operation, it records the number and size of its
+ * allocations, the bytes allocated by it that are still alive, and the
+ * high-water mark of the allocating executor while it was running. The latter
+ * shows which setup or solver phase determines the peak memory usage, e.g.
+ * during the generation of a Multigrid hierarchy or a ParIlut factorization.
+ *
+ * Allocations made before the logger was added are not tracked, and neither
+ * are their deallocations.
+ *
+ * The logger can be attached to an Executor to track all allocations and
+ * operations on it, or to individual LinOps and LinOpFactories, in which case
+ * the executor also needs the logger to track the allocations.
+ *
+ * @ingroup log
+ */
+class MemoryTracker : public Logger {
+public:
+    /** The memory usage of an executor. */
+    struct executor_summary {
+        /** The executor. */
+        const Executor* exec;
+        /** The name of the executor type. */
+        std::string name;
+        /** The number of bytes currently allocated. */
+        size_type current_bytes{};
+        /** The maximum number of bytes allocated at any time. */
+        size_type peak_bytes{};
+        /** The number of allocations. */
+        int64 num_allocations{};
+        /** The total number of bytes allocated. */
+        size_type total_bytes{};
+    };
+
+    /** The allocations of one kind of operation. */
+    struct operation_summary {
+        /** The name of the operation. */
+        std::string name;
+        /** The number of invocations. */
+        int64 count{};
+        /** The number of allocations made within the operation. */
+        int64 num_allocations{};
+        /** The total number of bytes allocated within the operation. */
+        size_type total_bytes{};
+        /** The number of bytes allocated within the operation still alive. */
+        size_type live_bytes{};
+        /**
+         * The maximum number of bytes allocated on an executor while the
+         * operation was running and allocated memory on that executor.
+         */
+        size_type peak_bytes{};
+    };
+
+    /** A currently alive allocation. */
+    struct allocation {
+        /** The executor the memory was allocated on. */
+        const Executor* exec;
+        /** The address of the allocation. */
+        uintptr location;
+        /** The size of the allocation. */
+        size_type num_bytes;
+        /**
+         * The name of the innermost operation during which the allocation was
+         * made, or "unattributed" if there was none.
+         */
+        std::string owner;
+    };
+
+    void on_allocation_completed(const Executor* exec,
+                                 const size_type& num_bytes,
+                                 const uintptr& location) const override;
+
+    void on_free_completed(const Executor* exec,
+                           const uintptr& location) const override;
+
+    void on_operation_launched(const Executor* exec,
+                               const Operation* operation) const override;
+
+    void on_operation_completed(const Executor* exec,
+                                const Operation* operation) const override;
+
+    void on_linop_apply_started(const LinOp* A, const LinOp* b,
+                                const LinOp* x) const override;
+
+    void on_linop_apply_completed(const LinOp* A, const LinOp* b,
+                                  const LinOp* x) const override;
+
+    void on_linop_advanced_apply_started(const LinOp* A, const LinOp* alpha,
+                                         const LinOp* b, const LinOp* beta,
+                                         const LinOp* x) const override;
+
+    void on_linop_advanced_apply_completed(const LinOp* A, const LinOp* alpha,
+                                           const LinOp* b, const LinOp* beta,
+                                           const LinOp* x) const override;
+
+    void on_linop_factory_generate_started(const LinOpFactory* factory,
+                                           const LinOp* input) const override;
+
+    void on_linop_factory_generate_completed(
+        const LinOpFactory* factory, const LinOp* input,
+        const LinOp* output) const override;
+
+    bool needs_propagation() const override;
+
+    /**
+     * Returns the memory usage of all executors, in the order of their first
+     * allocation.
+     */
+    std::vector<executor_summary> get_executor_summaries() const;
+
+    /**
+     * Returns the allocations of all operations, in the order of their first
+     * invocation.
+     */
+    std::vector<operation_summary> get_operation_summaries() const;
+
+    /** Returns all allocations that are currently alive. */
+    std::vector<allocation> get_live_allocations() const;
+
+    /**
+     * Writes a peak memory report to an ASCII table in Markdown format. It
+     * contains the memory usage of every executor, and the operations that
+     * allocated memory, sorted by their peak memory usage.
+     *
+     * @param output  the output stream to write the report to.
+     */
+    void write(std::ostream& output = std::cerr) const;
+
+    /**
+     * Creates a MemoryTracker logger.
+     *
+     * @return an std::unique_ptr to the the constructed object
+     */
+    static std::unique_ptr<MemoryTracker> create()
+    {
+        return std::unique_ptr<MemoryTracker>(new MemoryTracker());
+    }
+
+protected:
+    MemoryTracker();
+
+private:
+    struct allocation_info {
+        int64 executor_id;
+        size_type num_bytes;
+        // the operation the allocation is attributed to, or -1
+        int64 operation_id;
+    };
+
+    void begin(std::string name) const;
+
+    void end() const;
+
+    mutable std::mutex mutex_;
+    mutable std::vector<int64> stack_;
+    mutable std::unordered_map<const Executor*, int64> executor_map_;
+    mutable std::vector<executor_summary> executors_;
+    mutable std::unordered_map<std::string, int64> operation_map_;
+    mutable std::vector<operation_summary> operations_;
+    mutable std::unordered_map<uintptr, allocation_info> allocations_;
+    static constexpr Logger::mask_type mask_ =
+        Logger::allocation_completed_mask | Logger::free_completed_mask |
+        Logger::operation_events_mask | Logger::linop_apply_started_mask |
+        Logger::linop_apply_completed_mask |
+        Logger::linop_advanced_apply_started_mask |
+        Logger::linop_advanced_apply_completed_mask |
+        Logger::linop_factory_events_mask;
+};
+
+
+}  // namespace log
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_LOG_MEMORY_TRACKER_HPP_
@@ -329,6 +329,57 @@ public:
         std::string header_;
     };
 
+    struct trace_event {
+        /** The name of the range. */
+        std::string name;
+        /** The category of the range. */
+        profile_event_category category;
+        /** Whether the event begins (true) or ends (false) the range. */
+        bool begin;
+        /** The index of the thread that logged the event. */
+        int thread_id;
+        /** The time of the event relative to the creation of the logger. */
+        std::chrono::nanoseconds timestamp;
+    };
+
+    /** Receives the results from ProfilerHook::create_trace(). */
+    class TraceWriter {
+    public:
+        virtual ~TraceWriter() = default;
+
+        /**
+         * Callback to write out the recorded events.
+         *
+         * @param events  the events grouped by thread, in chronological order
+         *                within each thread.
+         * @param num_dropped  the number of events that were overwritten
+         *                     because the buffer of their thread was full.
+         */
+        virtual void write_trace(const std::vector<trace_event>& events,
+                                 int64 num_dropped) = 0;
+    };
+
+    /**
+     * Writes the results from ProfilerHook::create_trace() in the Chrome
+     * trace event JSON format, which can be viewed in Perfetto
+     * (ui.perfetto.dev) or chrome://tracing.
+     */
+    class ChromeTraceWriter : public TraceWriter {
+    public:
+        /**
+         * Constructs a writer on an output stream.
+         *
+         * @param output  the output stream to write the JSON trace to.
+         */
+        ChromeTraceWriter(std::ostream& output);
+
+        void write_trace(const std::vector<trace_event>& events,
+                         int64 num_dropped) override;
+
+    private:
+        std::ostream* output_;
+    };
+
     /**
      * Creates a logger measuring the runtime of Ginkgo events and printing a
      * summary when it is destroyed.
@@ -374,6 +425,27 @@ public:
             std::make_unique<TableSummaryWriter>(),
         bool debug_check_nesting = false);
 
+    /**
+     * Creates a logger recording a timeline of all Ginkgo events and writing
+     * it out when it is destroyed.
+     *
+     * Every thread records its events into a separate ring buffer without
+     * any synchronization, so the logger can be left enabled in production
+     * runs. Only the first event logged by a thread registers its buffer
+     * under a lock. If a buffer is full, its oldest events are overwritten.
+     *
+     * @param timer  The timer used to record time points.
+     * @param writer  The TraceWriter to receive the recorded events.
+     * @param buffer_capacity  The maximum number of events stored per thread.
+     *
+     * @note For this logger to provide reliable GPU timings, either use
+     *       Timer::create_for_executor or enable synchronization via
+     *       `set_synchronization(true)`.
+     */
+    static std::shared_ptr<ProfilerHook> create_trace(
+        std::shared_ptr<Timer> timer, std::unique_ptr<TraceWriter> writer,
+        size_type buffer_capacity = 65536);
+
     /**
      * Creates a logger annotating Ginkgo events with a custom set of functions
      * for range begin and end.
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_PUBLIC_CORE_LOG_ROOFLINE_HPP_
+#define GKO_PUBLIC_CORE_LOG_ROOFLINE_HPP_
+
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+
+#include <ginkgo/config.hpp>
+#include <ginkgo/core/base/timer.hpp>
+#include <ginkgo/core/log/logger.hpp>
+
+
+namespace gko {
+namespace log {
+
+
+/**
+ * Roofline is a Logger which measures the runtime of LinOp applications and
+ * LinOpFactory generate calls and relates it to a model of the memory traffic
+ * and floating point operations they cause. From this, it computes the
+ * achieved bandwidth and floating point throughput of every operation and
+ * its fraction of the roofline bound given by the peak bandwidth and peak
+ * throughput of the machine.
+ *
+ * The logger contains models for the application of all sparse matrix
+ * formats (SpMV), dense matrices (GEMV/GEMM), and triangular solvers, and for
+ * the memory traffic of generating factorizations and other operators from a
+ * matrix. Vector operations like dot products and axpy updates are part of
+ * the solvers using them. Operations without a model are still timed, but
+ * their throughput is not reported. Models for custom LinOps can be added
+ * via add_apply_model and add_generate_model.
+ *
+ * The models assume that every matrix entry is read exactly once and the
+ * input and output vectors are read and written once, i.e. they describe the
+ * minimal memory traffic.
+ *
+ * If Ginkgo was built with PAPI support, the floating point operations can
+ * additionally be measured with a PAPI counter to cross-check the models on
+ * CPU executors.
+ *
+ * The logger can be attached to an Executor to measure all operations on
+ * it, or to individual LinOps and LinOpFactories.
+ *
+ * @note For this logger to provide reliable GPU timings, use
+ *       Timer::create_for_executor.
+ *
+ * @ingroup log
+ */
+class Roofline : public Logger {
+public:
+    /** The modeled cost of a single operation. */
+    struct cost {
+        /** The number of bytes read from and written to memory. */
+        double bytes{};
+        /** The number of floating point operations. */
+        double flops{};
+    };
+
+    /** The accumulated measurements for one kind of operation. */
+    struct entry {
+        /** The name of the operation, i.e. its type and event. */
+        std::string name;
+        /** The number of invocations. */
+        int64 count{};
+        /** The total runtime of all invocations. */
+        std::chrono::nanoseconds time{};
+        /** The total modeled number of bytes of all invocations. */
+        double bytes{};
+        /** The total modeled number of flops of all invocations. */
+        double flops{};
+        /** Whether a model was available for the operation. */
+        bool has_model{};
+        /** The total number of flops measured by PAPI, or -1. */
+        int64 measured_flops{-1};
+    };
+
+    /**
+     * Computes the cost of x = op(b), or x = alpha * op(b) + beta * x if
+     * advanced is true.
+     */
+    using apply_model = std::function<cost(const LinOp* op, const LinOp* b,
+                                           const LinOp* x, bool advanced)>;
+
+    /** Computes the cost of generating output from input. */
+    using generate_model = std::function<cost(const LinOpFactory* factory,
+                                              const LinOp* input,
+                                              const LinOp* output)>;
+
+    void on_linop_apply_started(const LinOp* A, const LinOp* b,
+                                const LinOp* x) const override;
+
+    void on_linop_apply_completed(const LinOp* A, const LinOp* b,
+                                  const LinOp* x) const override;
+
+    void on_linop_advanced_apply_started(const LinOp* A, const LinOp* alpha,
+                                         const LinOp* b, const LinOp* beta,
+                                         const LinOp* x) const override;
+
+    void on_linop_advanced_apply_completed(const LinOp* A, const LinOp* alpha,
+                                           const LinOp* b, const LinOp* beta,
+                                           const LinOp* x) const override;
+
+    void on_linop_factory_generate_started(const LinOpFactory* factory,
+                                           const LinOp* input) const override;
+
+    void on_linop_factory_generate_completed(
+        const LinOpFactory* factory, const LinOp* input,
+        const LinOp* output) const override;
+
+    bool needs_propagation() const override;
+
+    /**
+     * Adds a model for the application of a LinOp type, which takes
+     * precedence over the built-in models.
+     *
+     * @param type  the dynamic type of the LinOp, e.g. typeid(MyLinOp)
+     * @param model  the cost model
+     */
+    void add_apply_model(std::type_index type, apply_model model);
+
+    /**
+     * Adds a model for the generation from a LinOpFactory type, which takes
+     * precedence over the built-in models.
+     *
+     * @param type  the dynamic type of the factory, e.g.
+     *              typeid(MyLinOp::Factory)
+     * @param model  the cost model
+     */
+    void add_generate_model(std::type_index type, generate_model model);
+
+    /**
+     * Returns the accumulated measurements of all operations, in the order
+     * of their first invocation.
+     */
+    std::vector<entry> get_entries() const;
+
+    /**
+     * Writes the measurements to an ASCII table in Markdown format.
+     *
+     * @param output  the output stream to write the table to.
+     */
+    void write(std::ostream& output = std::cerr) const;
+
+    /**
+     * Computes the fraction of the roofline bound achieved by an entry, i.e.
+     * its floating point throughput relative to
+     * min(peak_gflops, intensity * peak_bandwidth), or its bandwidth relative
+     * to the peak bandwidth if it does no floating point operations.
+     *
+     * @return  the fraction, or -1 if the entry or peak values are unknown.
+     */
+    double get_roofline_fraction(const entry& e) const;
+
+    /**
+     * Creates a Roofline logger.
+     *
+     * @param timer  the timer used to record time points.
+     * @param peak_bandwidth  the peak memory bandwidth in GB/s, or 0 if
+     *                        unknown.
+     * @param peak_gflops  the peak floating point throughput in GFLOP/s, or 0
+     *                     if unknown.
+     * @param papi_flops_event  the name of a PAPI event counting floating
+     *                          point operations, e.g. "PAPI_DP_OPS", or an
+     *                          empty string to disable the cross-check.
+     *                          This requires Ginkgo to be built with PAPI.
+     *
+     * @return an std::unique_ptr to the the constructed object
+     */
+    static std::unique_ptr<Roofline> create(
+        std::shared_ptr<Timer> timer = std::make_shared<CpuTimer>(),
+        double peak_bandwidth = 0.0, double peak_gflops = 0.0,
+        std::string papi_flops_event = "")
+    {
+        return std::unique_ptr<Roofline>(
+            new Roofline(std::move(timer), peak_bandwidth, peak_gflops,
+                         std::move(papi_flops_event)));
+    }
+
+    ~Roofline() override;
+
+protected:
+    explicit Roofline(std::shared_ptr<Timer> timer, double peak_bandwidth,
+                      double peak_gflops, std::string papi_flops_event);
+
+private:
+    struct pending {
+        int64 entry_id;
+        cost model_cost;
+        bool has_model;
+        time_point start;
+        long long counter_start;
+    };
+
+    void start(std::string name, cost model_cost, bool has_model) const;
+
+    void stop() const;
+
+    cost apply_cost(const LinOp* A, const LinOp* b, const LinOp* x,
+                    bool advanced, bool& has_model) const;
+
+    cost generate_cost(const LinOpFactory* factory, const LinOp* input,
+                       const LinOp* output, bool& has_model) const;
+
+    long long read_counter() const;
+
+    std::shared_ptr<Timer> timer_;
+    double peak_bandwidth_;
+    double peak_gflops_;
+    std::string papi_flops_event_;
+    int papi_event_set_;
+    std::unordered_map<std::type_index, apply_model> apply_models_;
+    std::unordered_map<std::type_index, generate_model> generate_models_;
+    mutable std::mutex mutex_;
+    mutable std::vector<pending> stack_;
+    mutable std::unordered_map<std::string, int64> name_map_;
+    mutable std::vector<entry> entries_;
+    static constexpr Logger::mask_type mask_ =
+        Logger::linop_events_mask | Logger::linop_factory_events_mask;
+};
+
+
+}  // namespace log
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_LOG_ROOFLINE_HPP_
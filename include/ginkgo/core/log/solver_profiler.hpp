@@ -0,0 +1,227 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_PUBLIC_CORE_LOG_SOLVER_PROFILER_HPP_
+#define GKO_PUBLIC_CORE_LOG_SOLVER_PROFILER_HPP_
+
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+#include <ginkgo/config.hpp>
+#include <ginkgo/core/base/timer.hpp>
+#include <ginkgo/core/log/logger.hpp>
+
+
+namespace gko {
+namespace log {
+
+
+/**
+ * SolverProfiler is a Logger which breaks down the runtime of iterative
+ * solvers into the phases of their iterations: the application of the system
+ * matrix, the application of the preconditioner, reductions like dot products
+ * and norms, vector updates, and the stopping criterion checks. The
+ * measurements are aggregated over all iterations and all applications of
+ * each solver type.
+ *
+ * Only the operations directly issued by a solver are classified, everything
+ * nested within them is attributed to the enclosing phase. In particular, the
+ * time spent in a solver used as preconditioner is reported as preconditioner
+ * time of the outer solver, in addition to being profiled on its own. Kernels
+ * whose name contains "dot" or "norm" count as reductions, all other kernels
+ * as vector updates. The remaining time, e.g. for workspace allocations and
+ * the application of other operators, is reported as "other".
+ *
+ * To keep the overhead low, the logger only records time points at the phase
+ * boundaries, and synchronizes with the timer once at the end of each solver
+ * application.
+ *
+ * The logger can be attached to an Executor to profile all solvers on it, or
+ * to individual solvers, matrices, preconditioners and stopping criteria.
+ *
+ * @note For this logger to provide reliable GPU timings, use
+ *       Timer::create_for_executor.
+ *
+ * @ingroup log
+ */
+class SolverProfiler : public Logger {
+public:
+    /** The phases of a solver iteration. */
+    enum class phase {
+        /** Application of the system matrix. */
+        spmv,
+        /** Application of the preconditioner. */
+        preconditioner,
+        /** Dot products and norms. */
+        reduction,
+        /** All other kernels launched by the solver. */
+        vector_update,
+        /** Stopping criterion checks. */
+        criterion,
+        /** Time not covered by any of the other phases. */
+        other
+    };
+
+    /** The number of phases. */
+    static constexpr int num_phases = 6;
+
+    /** Returns a human-readable name of a phase. */
+    static const char* get_phase_name(phase p);
+
+    /** The accumulated measurements for one solver type. */
+    struct summary {
+        /** The name of the solver type. */
+        std::string name;
+        /** The number of solver applications. */
+        int64 count{};
+        /** The total number of iterations of all applications. */
+        int64 iterations{};
+        /** The total runtime of all applications. */
+        std::chrono::nanoseconds time{};
+        /** The total runtime of every phase, indexed by phase. */
+        std::array<std::chrono::nanoseconds, num_phases> phase_time{};
+        /** The number of executions of every phase, indexed by phase. */
+        std::array<int64, num_phases> phase_count{};
+    };
+
+    void on_operation_launched(const Executor* exec,
+                               const Operation* operation) const override;
+
+    void on_operation_completed(const Executor* exec,
+                                const Operation* operation) const override;
+
+    void on_linop_apply_started(const LinOp* A, const LinOp* b,
+                                const LinOp* x) const override;
+
+    void on_linop_apply_completed(const LinOp* A, const LinOp* b,
+                                  const LinOp* x) const override;
+
+    void on_linop_advanced_apply_started(const LinOp* A, const LinOp* alpha,
+                                         const LinOp* b, const LinOp* beta,
+                                         const LinOp* x) const override;
+
+    void on_linop_advanced_apply_completed(const LinOp* A, const LinOp* alpha,
+                                           const LinOp* b, const LinOp* beta,
+                                           const LinOp* x) const override;
+
+    void on_criterion_check_started(const stop::Criterion* criterion,
+                                    const size_type& num_iterations,
+                                    const LinOp* residual,
+                                    const LinOp* residual_norm,
+                                    const LinOp* solution,
+                                    const uint8& stopping_id,
+                                    const bool& set_finalized) const override;
+
+    void on_criterion_check_completed(
+        const stop::Criterion* criterion, const size_type& num_iterations,
+        const LinOp* residual, const LinOp* residual_norm,
+        const LinOp* implicit_sq_residual_norm, const LinOp* solution,
+        const uint8& stopping_id, const bool& set_finalized,
+        const array<stopping_status>* status, const bool& one_changed,
+        const bool& all_converged) const override;
+
+    void on_iteration_complete(const LinOp* solver, const LinOp* b,
+                               const LinOp* x, const size_type& num_iterations,
+                               const LinOp* residual,
+                               const LinOp* residual_norm,
+                               const LinOp* implicit_resnorm_sq,
+                               const array<stopping_status>* status,
+                               bool stopped) const override;
+
+    bool needs_propagation() const override;
+
+    /**
+     * Returns the accumulated measurements of all solver types, in the order
+     * of their first application.
+     */
+    std::vector<summary> get_summaries() const;
+
+    /**
+     * Writes the measurements to an ASCII table in Markdown format. For every
+     * solver type, it contains the average time per iteration and the
+     * fraction of the runtime spent in every phase.
+     *
+     * @param output  the output stream to write the table to.
+     */
+    void write(std::ostream& output = std::cerr) const;
+
+    /**
+     * Creates a SolverProfiler logger.
+     *
+     * @param timer  the timer used to record time points.
+     *
+     * @return an std::unique_ptr to the the constructed object
+     */
+    static std::unique_ptr<SolverProfiler> create(
+        std::shared_ptr<Timer> timer = std::make_shared<CpuTimer>())
+    {
+        return std::unique_ptr<SolverProfiler>(
+            new SolverProfiler(std::move(timer)));
+    }
+
+protected:
+    explicit SolverProfiler(std::shared_ptr<Timer> timer);
+
+private:
+    struct interval {
+        phase p;
+        time_point start;
+        time_point stop;
+    };
+
+    struct frame {
+        const LinOp* solver;
+        const LinOp* system_matrix;
+        const LinOp* preconditioner;
+        int64 summary_id;
+        time_point start;
+        // the number of events nested in the current phase
+        int64 depth;
+        bool in_phase;
+        int64 iterations;
+        std::vector<interval> intervals;
+    };
+
+    void begin_solver(const LinOp* solver) const;
+
+    void end_solver() const;
+
+    void begin(bool classified, phase p) const;
+
+    void end() const;
+
+    void begin_linop(const LinOp* op) const;
+
+    void end_linop(const LinOp* op) const;
+
+    time_point get_time_point() const;
+
+    std::shared_ptr<Timer> timer_;
+    mutable std::mutex mutex_;
+    mutable std::vector<frame> stack_;
+    mutable std::vector<time_point> free_time_points_;
+    mutable std::unordered_map<std::string, int64> name_map_;
+    mutable std::vector<summary> summaries_;
+    static constexpr Logger::mask_type mask_ =
+        Logger::operation_events_mask | Logger::linop_apply_started_mask |
+        Logger::linop_apply_completed_mask |
+        Logger::linop_advanced_apply_started_mask |
+        Logger::linop_advanced_apply_completed_mask |
+        Logger::criterion_events_mask | Logger::iteration_complete_mask;
+};
+
+
+}  // namespace log
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_LOG_SOLVER_PROFILER_HPP_
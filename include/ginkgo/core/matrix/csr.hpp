@@ -45,6 +45,9 @@ class Csr;
 template <typename ValueType, typename IndexType>
 class Fbcsr;
 
+template <typename ValueType, typename IndexType>
+class DeltaCsr;
+
 template <typename ValueType, typename IndexType>
 class CsrBuilder;
 
@@ -90,6 +93,12 @@ void strategy_rebuild_helper(Csr<ValueType, IndexType>* result);
  * Both the SpGEMM and SpGEAM operation require the input matrices to be sorted
  * by column index, otherwise the algorithms will produce incorrect results.
  *
+ * To reduce the memory traffic of the SpMV, the matrix values can be stored in
+ * lower precision than the vectors: a Csr<float> (obtained e.g. by converting
+ * a Csr<double>) can be applied directly to Dense<double> vectors. The
+ * computation then happens in double precision without converting the
+ * vectors, even if Ginkgo was built without GINKGO_MIXED_PRECISION.
+ *
  * @tparam ValueType  precision of matrix elements
  * @tparam IndexType  precision of matrix indexes
  *
@@ -107,6 +116,7 @@ class Csr : public EnableLinOp<Csr<ValueType, IndexType>>,
             public ConvertibleTo<Hybrid<ValueType, IndexType>>,
             public ConvertibleTo<Sellp<ValueType, IndexType>>,
             public ConvertibleTo<SparsityCsr<ValueType, IndexType>>,
+            public ConvertibleTo<DeltaCsr<ValueType, IndexType>>,
             public DiagonalExtractable<ValueType>,
             public ReadableFromMatrixData<ValueType, IndexType>,
             public WritableToMatrixData<ValueType, IndexType>,
@@ -124,6 +134,7 @@ class Csr : public EnableLinOp<Csr<ValueType, IndexType>>,
     friend class Sellp<ValueType, IndexType>;
     friend class SparsityCsr<ValueType, IndexType>;
     friend class Fbcsr<ValueType, IndexType>;
+    friend class DeltaCsr<ValueType, IndexType>;
     friend class CsrBuilder<ValueType, IndexType>;
     friend class Csr<to_complex<ValueType>, IndexType>;
 
@@ -146,6 +157,8 @@ public:
     using ConvertibleTo<Sellp<ValueType, IndexType>>::move_to;
     using ConvertibleTo<SparsityCsr<ValueType, IndexType>>::convert_to;
     using ConvertibleTo<SparsityCsr<ValueType, IndexType>>::move_to;
+    using ConvertibleTo<DeltaCsr<ValueType, IndexType>>::convert_to;
+    using ConvertibleTo<DeltaCsr<ValueType, IndexType>>::move_to;
     using ReadableFromMatrixData<ValueType, IndexType>::read;
 
     using value_type = ValueType;
@@ -723,6 +736,10 @@ public:
 
     void move_to(SparsityCsr<ValueType, IndexType>* result) override;
 
+    void convert_to(DeltaCsr<ValueType, IndexType>* result) const override;
+
+    void move_to(DeltaCsr<ValueType, IndexType>* result) override;
+
     void read(const mat_data& data) override;
 
     void read(const device_mat_data& data) override;
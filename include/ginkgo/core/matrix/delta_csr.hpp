@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_PUBLIC_CORE_MATRIX_DELTA_CSR_HPP_
+#define GKO_PUBLIC_CORE_MATRIX_DELTA_CSR_HPP_
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/lin_op.hpp>
+
+
+namespace gko {
+namespace matrix {
+
+
+template <typename ValueType, typename IndexType>
+class Csr;
+
+
+/**
+ * DeltaCsr is a CSR matrix format with compressed column indices.
+ *
+ * The values and row pointers are stored like in the Csr format. Instead of
+ * storing the column index of every nonzero explicitly, each row stores a base
+ * column index (the smallest column index of the row), and every nonzero
+ * stores the difference of its column index to the row base. The differences
+ * of a row are stored with the smallest unsigned integer width (1, 2, 4 or 8
+ * bytes) that can represent all of them, so rows with a small column span
+ * (e.g. banded matrices or FEM discretizations with a good ordering) need only
+ * 8 or 16 bits per column index, while rows with a large span transparently
+ * fall back to wider deltas.
+ *
+ * The deltas of all rows are stored consecutively in a byte array, with the
+ * `delta_ptrs` array storing the offset of the first delta byte of each row.
+ * The width of the deltas of row `i` can thus be computed as
+ * `(delta_ptrs[i + 1] - delta_ptrs[i]) / (row_ptrs[i + 1] - row_ptrs[i])`.
+ *
+ * The format is intended for bandwidth-bound SpMV, where the column indices
+ * make up a significant fraction of the memory traffic. It can be created by
+ * converting a Csr matrix or by reading matrix data.
+ *
+ * @tparam ValueType  precision of matrix elements
+ * @tparam IndexType  precision of matrix indexes
+ *
+ * @ingroup delta_csr
+ * @ingroup mat_formats
+ * @ingroup LinOp
+ */
+template <typename ValueType = default_precision, typename IndexType = int32>
+class DeltaCsr : public EnableLinOp<DeltaCsr<ValueType, IndexType>>,
+                 public ConvertibleTo<Csr<ValueType, IndexType>>,
+                 public ReadableFromMatrixData<ValueType, IndexType>,
+                 public WritableToMatrixData<ValueType, IndexType> {
+    friend class EnablePolymorphicObject<DeltaCsr, LinOp>;
+    friend class Csr<ValueType, IndexType>;
+
+public:
+    using EnableLinOp<DeltaCsr>::convert_to;
+    using EnableLinOp<DeltaCsr>::move_to;
+    using ConvertibleTo<Csr<ValueType, IndexType>>::convert_to;
+    using ConvertibleTo<Csr<ValueType, IndexType>>::move_to;
+    using ReadableFromMatrixData<ValueType, IndexType>::read;
+
+    using value_type = ValueType;
+    using index_type = IndexType;
+    using delta_type = uint8;
+    using mat_data = matrix_data<ValueType, IndexType>;
+    using device_mat_data = device_matrix_data<ValueType, IndexType>;
+
+    void convert_to(Csr<ValueType, IndexType>* result) const override;
+
+    void move_to(Csr<ValueType, IndexType>* result) override;
+
+    void read(const mat_data& data) override;
+
+    void read(const device_mat_data& data) override;
+
+    void read(device_mat_data&& data) override;
+
+    void write(mat_data& data) const override;
+
+    /**
+     * Returns the values of the matrix.
+     *
+     * @return the values of the matrix.
+     */
+    value_type* get_values() noexcept { return values_.get_data(); }
+
+    /**
+     * @copydoc DeltaCsr::get_values()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const value_type* get_const_values() const noexcept
+    {
+        return values_.get_const_data();
+    }
+
+    /**
+     * Returns the row pointers of the matrix.
+     *
+     * @return the row pointers of the matrix.
+     */
+    index_type* get_row_ptrs() noexcept { return row_ptrs_.get_data(); }
+
+    /**
+     * @copydoc DeltaCsr::get_row_ptrs()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const index_type* get_const_row_ptrs() const noexcept
+    {
+        return row_ptrs_.get_const_data();
+    }
+
+    /**
+     * Returns the base column indices of the rows, i.e. the smallest column
+     * index of each row (or zero for empty rows).
+     *
+     * @return the base column indices of the rows.
+     */
+    index_type* get_row_bases() noexcept { return row_bases_.get_data(); }
+
+    /**
+     * @copydoc DeltaCsr::get_row_bases()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const index_type* get_const_row_bases() const noexcept
+    {
+        return row_bases_.get_const_data();
+    }
+
+    /**
+     * Returns the offsets of the first delta byte of each row.
+     *
+     * @return the offsets of the first delta byte of each row.
+     */
+    int64* get_delta_ptrs() noexcept { return delta_ptrs_.get_data(); }
+
+    /**
+     * @copydoc DeltaCsr::get_delta_ptrs()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const int64* get_const_delta_ptrs() const noexcept
+    {
+        return delta_ptrs_.get_const_data();
+    }
+
+    /**
+     * Returns the encoded column deltas of the matrix.
+     *
+     * @return the encoded column deltas of the matrix.
+     */
+    delta_type* get_deltas() noexcept { return deltas_.get_data(); }
+
+    /**
+     * @copydoc DeltaCsr::get_deltas()
+     *
+     * @note This is the constant version of the function, which can be
+     *       significantly more memory efficient than the non-constant version,
+     *       so always prefer this version.
+     */
+    const delta_type* get_const_deltas() const noexcept
+    {
+        return deltas_.get_const_data();
+    }
+
+    /**
+     * Returns the number of elements explicitly stored in the matrix.
+     *
+     * @return the number of elements explicitly stored in the matrix
+     */
+    size_type get_num_stored_elements() const noexcept
+    {
+        return values_.get_size();
+    }
+
+    /**
+     * Returns the number of bytes used to store the column deltas.
+     *
+     * @return the number of bytes used to store the column deltas
+     */
+    size_type get_num_delta_bytes() const noexcept
+    {
+        return deltas_.get_size();
+    }
+
+    /**
+     * Creates an empty DeltaCsr matrix of the specified size.
+     *
+     * @param exec  Executor associated to the matrix
+     * @param size  size of the matrix
+     *
+     * @return A smart pointer to the newly created matrix.
+     */
+    static std::unique_ptr<DeltaCsr> create(
+        std::shared_ptr<const Executor> exec, const dim<2>& size = dim<2>{});
+
+    /**
+     * Copy-assigns a DeltaCsr matrix. Preserves executor, copies everything
+     * else.
+     */
+    DeltaCsr& operator=(const DeltaCsr&);
+
+    /**
+     * Move-assigns a DeltaCsr matrix. Preserves executor, moves the data and
+     * leaves the moved-from object in an empty state (0x0 LinOp with unchanged
+     * executor, no nonzeros and valid row pointers).
+     */
+    DeltaCsr& operator=(DeltaCsr&&);
+
+    /**
+     * Copy-constructs a DeltaCsr matrix. Inherits executor and data.
+     */
+    DeltaCsr(const DeltaCsr&);
+
+    /**
+     * Move-constructs a DeltaCsr matrix. Inherits executor, moves the data
+     * and leaves the moved-from object in an empty state (0x0 LinOp with
+     * unchanged executor, no nonzeros and valid row pointers).
+     */
+    DeltaCsr(DeltaCsr&&);
+
+protected:
+    DeltaCsr(std::shared_ptr<const Executor> exec,
+             const dim<2>& size = dim<2>{});
+
+    void apply_impl(const LinOp* b, LinOp* x) const override;
+
+    void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
+                    LinOp* x) const override;
+
+private:
+    array<value_type> values_;
+    array<index_type> row_ptrs_;
+    array<index_type> row_bases_;
+    array<int64> delta_ptrs_;
+    array<delta_type> deltas_;
+};
+
+
+}  // namespace matrix
+}  // namespace gko
+
+
+#endif  // GKO_PUBLIC_CORE_MATRIX_DELTA_CSR_HPP_
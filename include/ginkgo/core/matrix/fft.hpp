@@ -19,7 +19,7 @@ namespace matrix {
  *
  * It implements forward and inverse DFT.
  *
- * For a power-of-two size n with corresponding root of unity
+ * For a size n with corresponding root of unity
  * $\omega = e^{-2\pi i / n}$ for forward DFT and $\omega = e^{2 \pi i / n}$
  * for inverse DFT it computes
  *
@@ -29,11 +29,15 @@ namespace matrix {
  *
  * without normalization factors.
  *
- * The Reference and OpenMP implementations support only power-of-two input
- * sizes, as they use the Radix-2 algorithm by J. W. Cooley and J. W. Tukey,
- * "An Algorithm for the Machine Calculation of Complex Fourier Series,"
- * Mathematics of Computation, vol. 19, no. 90, pp. 297–301, 1965,
- * doi: 10.2307/2003354.
+ * The Reference implementation uses the Radix-2 algorithm by J. W. Cooley and
+ * J. W. Tukey, "An Algorithm for the Machine Calculation of Complex Fourier
+ * Series," Mathematics of Computation, vol. 19, no. 90, pp. 297–301, 1965,
+ * doi: 10.2307/2003354, for power-of-two sizes and computes the DFT directly
+ * for all other sizes.
+ * The OpenMP implementation uses a mixed-radix Stockham algorithm for
+ * arbitrary input sizes, transforming multiple right-hand sides together.
+ * Its twiddle factors are computed on the first application and stored in
+ * this object, so they are reused by subsequent applications.
  * The CUDA and HIP implementations use cuSPARSE/hipSPARSE with full support for
  * non-power-of-two input sizes and special optimizations for products of
  * small prime powers.
@@ -105,6 +109,7 @@ protected:
                     LinOp* x) const override;
 
 private:
+    // workspace of the kernels, e.g. the plan of the OpenMP transform
     mutable array<char> buffer_;
     bool inverse_;
 };
@@ -116,7 +121,7 @@ private:
  *
  * It implements complex-to-complex forward and inverse FFT.
  *
- * For a power-of-two sizes $n_1, n_2$ with corresponding root of unity
+ * For sizes $n_1, n_2$ with corresponding root of unity
  * $\omega = e^{-2\pi i / (n_1 n_2)}$ for forward DFT and
  * $\omega = e^{2 \pi i / (n_1 n_2)}$ for inverse DFT it computes
  *
@@ -127,11 +132,15 @@ private:
  *
  * without normalization factors.
  *
- * The Reference and OpenMP implementations support only power-of-two input
- * sizes, as they use the Radix-2 algorithm by J. W. Cooley and J. W. Tukey,
- * "An Algorithm for the Machine Calculation of Complex Fourier Series,"
- * Mathematics of Computation, vol. 19, no. 90, pp. 297–301, 1965,
- * doi: 10.2307/2003354.
+ * The Reference implementation uses the Radix-2 algorithm by J. W. Cooley and
+ * J. W. Tukey, "An Algorithm for the Machine Calculation of Complex Fourier
+ * Series," Mathematics of Computation, vol. 19, no. 90, pp. 297–301, 1965,
+ * doi: 10.2307/2003354, for power-of-two sizes and computes the DFT directly
+ * for all other sizes.
+ * The OpenMP implementation uses a mixed-radix Stockham algorithm for
+ * arbitrary input sizes, transforming multiple right-hand sides together.
+ * Its twiddle factors are computed on the first application and stored in
+ * this object, so they are reused by subsequent applications.
  * The CUDA and HIP implementations use cuSPARSE/hipSPARSE with full support for
  * non-power-of-two input sizes and special optimizations for products of
  * small prime powers.
@@ -214,6 +223,7 @@ protected:
                     LinOp* x) const override;
 
 private:
+    // workspace of the kernels, e.g. the plan of the OpenMP transform
     mutable array<char> buffer_;
     dim<2> fft_size_;
     bool inverse_;
@@ -226,7 +236,7 @@ private:
  *
  * It implements complex-to-complex forward and inverse FFT.
  *
- * For a power-of-two sizes $n_1, n_2, n_3$ with corresponding root of unity
+ * For sizes $n_1, n_2, n_3$ with corresponding root of unity
  * $\omega = e^{-2\pi i / (n_1 n_2 n_3)}$ for forward DFT and
  * $\omega = e^{2 \pi i / (n_1 n_2 n_3)}$ for inverse DFT it computes
  *
@@ -239,11 +249,15 @@ private:
  *
  * without normalization factors.
  *
- * The Reference and OpenMP implementations support only power-of-two input
- * sizes, as they use the Radix-2 algorithm by J. W. Cooley and J. W. Tukey,
- * "An Algorithm for the Machine Calculation of Complex Fourier Series,"
- * Mathematics of Computation, vol. 19, no. 90, pp. 297–301, 1965,
- * doi: 10.2307/2003354.
+ * The Reference implementation uses the Radix-2 algorithm by J. W. Cooley and
+ * J. W. Tukey, "An Algorithm for the Machine Calculation of Complex Fourier
+ * Series," Mathematics of Computation, vol. 19, no. 90, pp. 297–301, 1965,
+ * doi: 10.2307/2003354, for power-of-two sizes and computes the DFT directly
+ * for all other sizes.
+ * The OpenMP implementation uses a mixed-radix Stockham algorithm for
+ * arbitrary input sizes, transforming multiple right-hand sides together.
+ * Its twiddle factors are computed on the first application and stored in
+ * this object, so they are reused by subsequent applications.
  * The CUDA and HIP implementations use cuSPARSE/hipSPARSE with full support for
  * non-power-of-two input sizes and special optimizations for products of
  * small prime powers.
@@ -327,6 +341,7 @@ protected:
                     LinOp* x) const override;
 
 private:
+    // workspace of the kernels, e.g. the plan of the OpenMP transform
     mutable array<char> buffer_;
     dim<3> fft_size_;
     bool inverse_;
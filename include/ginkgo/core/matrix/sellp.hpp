@@ -16,6 +16,7 @@ namespace matrix {
 
 constexpr int default_slice_size = 64;
 constexpr int default_stride_factor = 1;
+constexpr int default_sorting_window = 1;
 
 
 template <typename ValueType>
@@ -32,6 +33,14 @@ class Csr;
  * This implementation uses the column index value invalid_index<IndexType>()
  * to mark padding entries that are not part of the sparsity pattern.
  *
+ * If a sorting window $\sigma > 1$ is set, the matrix is stored in
+ * SELL-C-sigma layout: within each window of $\sigma$ consecutive rows, the
+ * rows are stored in order of decreasing number of nonzeros, which reduces the
+ * padding needed for slices with mixed row lengths. The resulting row
+ * permutation is stored alongside the matrix and undone transparently on
+ * apply, conversion and write, so the matrix behaves like the unpermuted
+ * matrix everywhere except in the raw storage accessors.
+ *
  * @tparam ValueType  precision of matrix elements
  * @tparam IndexType  precision of matrix indexes
  *
@@ -194,6 +203,26 @@ public:
      */
     size_type get_stride_factor() const noexcept { return stride_factor_; }
 
+    /**
+     * Returns the sorting window (sigma) of SELL-C-sigma.
+     *
+     * @return the sorting window (sigma) of SELL-C-sigma. A value of 1 means
+     *         that the rows are stored in their original order.
+     */
+    size_type get_sorting_window() const noexcept { return sorting_window_; }
+
+    /**
+     * Returns the row permutation of the stored matrix, i.e. the `i`-th
+     * stored row is row `get_const_permutation()[i]` of the matrix.
+     *
+     * @return the row permutation of the stored matrix, or nullptr if the rows
+     *         are stored in their original order.
+     */
+    const index_type* get_const_permutation() const noexcept
+    {
+        return permutation_.get_const_data();
+    }
+
     /**
      * Returns the total column number.
      *
@@ -302,6 +331,28 @@ public:
                                          size_type stride_factor,
                                          size_type total_cols);
 
+    /**
+     * Creates an uninitialized SELL-C-sigma matrix of the specified size.
+     *
+     * @param exec  Executor associated to the matrix
+     * @param size  size of the matrix
+     * @param slice_size  number of rows in each slice
+     * @param stride_factor  factor for the stride in each slice (strides
+     *                        should be multiples of the stride_factor)
+     * @param sorting_window  number of consecutive rows that are sorted by
+     *                        their number of nonzeros when filling the matrix
+     *                        (should be a multiple of the slice_size)
+     * @param total_cols   number of the sum of all cols in every slice.
+     *
+     * @return A smart pointer to the newly created matrix.
+     */
+    static std::unique_ptr<Sellp> create(std::shared_ptr<const Executor> exec,
+                                         const dim<2>& size,
+                                         size_type slice_size,
+                                         size_type stride_factor,
+                                         size_type sorting_window,
+                                         size_type total_cols);
+
     /**
      * Copy-assigns a Sellp matrix. Preserves the executor, copies the data and
      * parameters.
@@ -335,6 +386,10 @@ protected:
     Sellp(std::shared_ptr<const Executor> exec, const dim<2>& size,
           size_type slice_size, size_type stride_factor, size_type total_cols);
 
+    Sellp(std::shared_ptr<const Executor> exec, const dim<2>& size,
+          size_type slice_size, size_type stride_factor,
+          size_type sorting_window, size_type total_cols);
+
     void apply_impl(const LinOp* b, LinOp* x) const override;
 
     void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
@@ -353,6 +408,8 @@ private:
     array<size_type> slice_sets_;
     size_type slice_size_;
     size_type stride_factor_;
+    size_type sorting_window_;
+    array<index_type> permutation_;
 };
 
 
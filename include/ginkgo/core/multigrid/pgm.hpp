@@ -9,6 +9,7 @@
 #include <vector>
 
 
+#include <ginkgo/config.hpp>
 #include <ginkgo/core/base/composition.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/lin_op.hpp>
@@ -18,6 +19,18 @@
 #include <ginkgo/core/multigrid/multigrid_level.hpp>
 
 namespace gko {
+namespace experimental {
+namespace distributed {
+
+
+template <typename ValueType, typename LocalIndexType, typename GlobalIndexType>
+class Matrix;
+
+
+}  // namespace distributed
+}  // namespace experimental
+
+
 namespace multigrid {
 
 
@@ -36,6 +49,12 @@ namespace multigrid {
  * un-aggregated elements are assigned to an aggregated group
  * or are left alone.
  *
+ * Pgm also accepts an experimental::distributed::Matrix. In this case, every
+ * process aggregates the rows of its local matrix, and the coarse matrix,
+ * prolongation and restriction are distributed matrices again, so the whole
+ * hierarchy can be used within a distributed Multigrid. The coarse rows can
+ * be agglomerated onto fewer processes, see agglomeration_threshold.
+ *
  * @tparam ValueType  precision of matrix elements
  * @tparam IndexType  precision of matrix indexes
  *
@@ -68,7 +87,9 @@ public:
      *
      * Aggregate group whose size is same as the number of rows. Stores the
      * mapping information from row index to coarse row index.
-     * i.e., agg[row_idx] = coarse_row_idx.
+     * i.e., agg[row_idx] = coarse_row_idx. For a distributed matrix, it
+     * maps the local rows to the aggregates of this process, numbered from
+     * zero.
      *
      * @return the aggregate group.
      */
@@ -123,6 +144,19 @@ public:
          * incorrect.
          */
         bool GKO_FACTORY_PARAMETER_SCALAR(skip_sorting, false);
+
+        /**
+         * The minimum average number of coarse rows per process of a
+         * distributed coarse matrix. If the coarse matrix has fewer than
+         * `agglomeration_threshold * num_processes` rows, the coarse rows of
+         * neighboring processes are agglomerated onto
+         * `max(1, num_coarse_rows / agglomeration_threshold)` processes, and
+         * the other processes own no coarse rows. This keeps the
+         * communication on coarse levels from dominating the computation.
+         * The default value 0 disables agglomeration. Only used for
+         * distributed matrices.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(agglomeration_threshold, 0);
     };
     GKO_ENABLE_LIN_OP_FACTORY(Pgm, parameters, Factory);
     GKO_ENABLE_BUILD_METHOD(Factory);
@@ -161,6 +195,17 @@ protected:
 
     void generate();
 
+#if GINKGO_BUILD_MPI
+    /**
+     * Generates the distributed coarse matrix, prolongation and restriction
+     * from the aggregation of the local matrix.
+     */
+    template <typename GlobalIndexType>
+    void generate_distributed(
+        const experimental::distributed::Matrix<ValueType, IndexType,
+                                                GlobalIndexType>* fine_mtx);
+#endif
+
 private:
     std::shared_ptr<const LinOp> system_matrix_{};
     array<IndexType> agg_;
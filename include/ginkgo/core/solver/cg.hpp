@@ -37,6 +37,11 @@ namespace solver {
  * use of data locality. The inner operations in one iteration of CG are merged
  * into 2 separate steps.
  *
+ * On an OmpExecutor, the solver can optionally run the whole iteration loop
+ * inside a single OpenMP parallel region (see
+ * parameters_type::persistent_region), which avoids the fork/join overhead of
+ * the separate kernels for small and medium-sized systems.
+ *
  * @tparam ValueType  precision of matrix elements
  *
  * @ingroup solvers
@@ -68,7 +73,22 @@ public:
 
     struct parameters_type
         : enable_preconditioned_iterative_solver_factory_parameters<
-              parameters_type, Factory> {};
+              parameters_type, Factory> {
+        /**
+         * Run the iteration loop in a single persistent OpenMP parallel
+         * region, with thread-local partial reductions and barriers between
+         * the kernel phases.
+         *
+         * This is only used on an OmpExecutor (or ReferenceExecutor) for a
+         * non-distributed Csr system matrix without preconditioner (Identity)
+         * and stopping criteria consisting only of Iteration, ResidualNorm and
+         * ImplicitResidualNorm criteria. In all other cases, the solver falls
+         * back to the default implementation. Since the stopping criteria are
+         * evaluated inside the kernel, loggers only observe the final
+         * iteration.
+         */
+        bool GKO_FACTORY_PARAMETER_SCALAR(persistent_region, false);
+    };
 
     GKO_ENABLE_LIN_OP_FACTORY(Cg, parameters, Factory);
     GKO_ENABLE_BUILD_METHOD(Factory);
@@ -79,6 +99,12 @@ protected:
     template <typename VectorType>
     void apply_dense_impl(const VectorType* b, VectorType* x) const;
 
+    template <typename VectorType>
+    bool apply_persistent_impl(const VectorType* b, VectorType* x) const;
+
+    bool apply_persistent_impl(const matrix::Dense<ValueType>* b,
+                               matrix::Dense<ValueType>* x) const;
+
     void apply_impl(const LinOp* alpha, const LinOp* b, const LinOp* beta,
                     LinOp* x) const override;
 
@@ -133,6 +159,8 @@ struct workspace_traits<Cg<ValueType>> {
     constexpr static int one = 8;
     // constant -1.0 scalar
     constexpr static int minus_one = 9;
+    // residual norm scalar
+    constexpr static int residual_norm = 10;
 
     // stopping status array
     constexpr static int stop = 0;
@@ -44,6 +44,11 @@ enum class mode { absolute, initial_resnorm, rhs_norm };
  * residual norm against.
  * The provided check_impl uses the actual residual to check for convergence.
  *
+ * If the check interval is larger than one, the residual norm is only
+ * computed and compared in every check_interval-th iteration (starting with
+ * iteration 0), all other checks return immediately without launching a
+ * kernel or synchronizing with the executor.
+ *
  * @ingroup stop
  */
 template <typename ValueType>
@@ -68,9 +73,19 @@ protected:
 
     explicit ResidualNormBase(std::shared_ptr<const gko::Executor> exec,
                               const CriterionArgs& args,
-                              absolute_type reduction_factor, mode baseline);
+                              absolute_type reduction_factor, mode baseline,
+                              size_type check_interval = 1);
+
+    /**
+     * Returns true if the check for the given iteration can be skipped.
+     */
+    bool skip_check(const Criterion::Updater& updater) const
+    {
+        return updater.num_iterations_ % check_interval_ != 0;
+    }
 
     remove_complex<ValueType> reduction_factor_{};
+    size_type check_interval_{1};
     std::unique_ptr<NormVector> starting_tau_{};
     std::unique_ptr<NormVector> u_dense_tau_{};
     /* Contains device side: all_converged and one_changed booleans */
@@ -126,6 +141,15 @@ public:
          * "mode::rhs_norm", "mode::initial_resnorm" and "mode::absolute"
          */
         mode GKO_FACTORY_PARAMETER_SCALAR(baseline, mode::rhs_norm);
+
+        /**
+         * The residual norm is only checked every check_interval iterations.
+         * This avoids the norm computation and the synchronization with the
+         * executor in the other iterations, which is worthwhile for cheap
+         * iterations, at the cost of up to check_interval - 1 additional
+         * iterations. Must be at least 1.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(check_interval, 1u);
     };
     GKO_ENABLE_CRITERION_FACTORY(ResidualNorm<ValueType>, parameters, Factory);
     GKO_ENABLE_BUILD_METHOD(Factory);
@@ -139,7 +163,8 @@ protected:
         : ResidualNormBase<ValueType>(
               factory->get_executor(), args,
               factory->get_parameters().reduction_factor,
-              factory->get_parameters().baseline),
+              factory->get_parameters().baseline,
+              factory->get_parameters().check_interval),
           parameters_{factory->get_parameters()}
     {}
 };
@@ -182,6 +207,15 @@ public:
          * "mode::rhs_norm", "mode::initial_resnorm" and "mode::absolute"
          */
         mode GKO_FACTORY_PARAMETER_SCALAR(baseline, mode::rhs_norm);
+
+        /**
+         * The residual norm is only checked every check_interval iterations.
+         * This avoids the norm computation and the synchronization with the
+         * executor in the other iterations, which is worthwhile for cheap
+         * iterations, at the cost of up to check_interval - 1 additional
+         * iterations. Must be at least 1.
+         */
+        size_type GKO_FACTORY_PARAMETER_SCALAR(check_interval, 1u);
     };
     GKO_ENABLE_CRITERION_FACTORY(ImplicitResidualNorm<ValueType>, parameters,
                                  Factory);
@@ -203,7 +237,8 @@ protected:
         : ResidualNormBase<ValueType>(
               factory->get_executor(), args,
               factory->get_parameters().reduction_factor,
-              factory->get_parameters().baseline),
+              factory->get_parameters().baseline,
+              factory->get_parameters().check_interval),
           parameters_{factory->get_parameters()}
     {}
 };
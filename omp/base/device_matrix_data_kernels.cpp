@@ -14,6 +14,7 @@
 #include "core/base/allocator.hpp"
 #include "core/components/format_conversion_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -141,7 +142,7 @@ void sort_row_major(std::shared_ptr<const DefaultExecutor> exec,
     array<matrix_data_entry<ValueType, IndexType>> tmp{
         exec, data.get_num_stored_elements()};
     soa_to_aos(exec, data, tmp);
-    std::sort(tmp.get_data(), tmp.get_data() + tmp.get_size());
+    parallel_sort(exec, tmp.get_data(), tmp.get_size());
     aos_to_soa(exec, tmp, data);
 }
 
@@ -5,10 +5,25 @@
 #include <ginkgo/core/base/executor.hpp>
 
 
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <vector>
+
+
 #include <omp.h>
 
 
 namespace gko {
+namespace {
+
+
+// every thread has its own queue, so tasks enqueued from within a running
+// task are synchronized by that task
+thread_local std::vector<std::function<void()>> enqueued_tasks;
+
+
+}  // namespace
 
 
 int OmpExecutor::get_num_omp_threads()
@@ -21,4 +36,50 @@ int OmpExecutor::get_num_omp_threads()
 }
 
 
+void OmpExecutor::enqueue(std::function<void()> task) const
+{
+    // the reference executor keeps its sequential semantics
+    if (dynamic_cast<const ReferenceExecutor*>(this)) {
+        task();
+    } else {
+        enqueued_tasks.push_back(std::move(task));
+    }
+}
+
+
+void OmpExecutor::synchronize() const
+{
+    std::vector<std::function<void()>> tasks;
+    std::swap(tasks, enqueued_tasks);
+    if (tasks.empty()) {
+        return;
+    }
+    const auto num_tasks = static_cast<int64>(tasks.size());
+    const auto num_threads = static_cast<int64>(omp_get_max_threads());
+    const auto num_teams = std::min(num_tasks, num_threads);
+    const auto team_size =
+        static_cast<int>(std::max<int64>(num_threads / num_teams, 1));
+    // allow the kernels inside each task to use their share of the threads
+    const auto max_active_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(
+        std::max(max_active_levels, omp_get_active_level() + 2));
+    std::vector<std::exception_ptr> errors(tasks.size());
+#pragma omp parallel for num_threads(num_teams) schedule(dynamic, 1)
+    for (int64 i = 0; i < num_tasks; i++) {
+        omp_set_num_threads(team_size);
+        try {
+            tasks[i]();
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    }
+    omp_set_max_active_levels(max_active_levels);
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+
 }  // namespace gko
@@ -17,6 +17,7 @@
 
 
 #include "core/base/allocator.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -70,7 +71,7 @@ void populate_subsets(std::shared_ptr<const DefaultExecutor> exec,
     auto tmp_indices = gko::array<IndexType>(*indices);
     // Sort the indices if not sorted.
     if (!is_sorted) {
-        std::sort(tmp_indices.get_data(), tmp_indices.get_data() + num_indices);
+        parallel_sort(exec, tmp_indices.get_data(), num_indices);
     }
     GKO_ASSERT(tmp_indices.get_const_data()[num_indices - 1] <=
                index_space_size);
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_OMP_COMPONENTS_CSR_TRANSPOSE_HPP_
+#define GKO_OMP_COMPONENTS_CSR_TRANSPOSE_HPP_
+
+
+#include <algorithm>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+#include "core/components/fill_array_kernels.hpp"
+#include "core/components/prefix_sum_kernels.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+namespace transpose_detail {
+
+
+/**
+ * Inputs with fewer nonzeros than this are transposed sequentially, since the
+ * parallel passes would not amortize their overhead.
+ */
+constexpr size_type parallel_transpose_min_nnz = 1 << 14;
+
+
+}  // namespace transpose_detail
+
+
+/**
+ * Computes the sparsity pattern of the transpose of a CSR matrix with
+ * num_rows rows and num_cols columns, i.e. its CSC representation, and calls
+ * scatter_cb(nz, out_nz) for every nonzero, where nz is its position in the
+ * input and out_nz its position in the output. The column indices of every
+ * output row are sorted.
+ *
+ * The rows are split into one chunk with an equal share of the nonzeros per
+ * thread. Every chunk counts its entries per column, which gives every chunk
+ * a disjoint range of output positions within each output row, so the
+ * nonzeros can be scattered in parallel in the same order as the sequential
+ * algorithm. The number of chunks is limited so the per-chunk counts take at
+ * most as much memory as the column indices of the input.
+ *
+ * If scatter_cb is thread-safe for distinct output positions, the whole
+ * invocation is.
+ */
+template <typename IndexType, typename ScatterCallback>
+void transpose_pattern(std::shared_ptr<const OmpExecutor> exec,
+                       size_type num_rows, size_type num_cols,
+                       const IndexType* row_ptrs, const IndexType* col_idxs,
+                       IndexType* out_row_ptrs, IndexType* out_col_idxs,
+                       ScatterCallback scatter_cb)
+{
+    const auto nnz = static_cast<size_type>(row_ptrs[num_rows]);
+    const auto num_chunks = std::max<size_type>(
+        1, std::min({static_cast<size_type>(omp_get_max_threads()),
+                     nnz / std::max<size_type>(num_cols, 1), num_rows}));
+    components::fill_array(exec, out_row_ptrs, num_cols + 1, IndexType{});
+    if (nnz < transpose_detail::parallel_transpose_min_nnz ||
+        num_chunks <= 1) {
+        for (size_type nz = 0; nz < nnz; nz++) {
+            out_row_ptrs[col_idxs[nz] + 1]++;
+        }
+        components::prefix_sum_nonnegative(exec, out_row_ptrs + 1, num_cols);
+        const auto col_ptrs = out_row_ptrs + 1;
+        for (size_type row = 0; row < num_rows; row++) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                const auto out_nz = col_ptrs[col_idxs[nz]]++;
+                out_col_idxs[out_nz] = static_cast<IndexType>(row);
+                scatter_cb(nz, out_nz);
+            }
+        }
+        return;
+    }
+    // the first row of every chunk, balancing the nonzeros between chunks
+    array<IndexType> chunk_rows{exec, num_chunks + 1};
+    const auto chunk_row_data = chunk_rows.get_data();
+    for (size_type chunk = 0; chunk <= num_chunks; chunk++) {
+        const auto nz_begin = static_cast<IndexType>(nnz * chunk / num_chunks);
+        chunk_row_data[chunk] = static_cast<IndexType>(
+            std::lower_bound(row_ptrs, row_ptrs + num_rows, nz_begin) -
+            row_ptrs);
+    }
+    chunk_row_data[num_chunks] = static_cast<IndexType>(num_rows);
+    // counts[chunk * num_cols + col] first counts the entries of col in
+    // chunk, then stores the offset of the chunk within output row col
+    array<IndexType> counts{exec, num_chunks * num_cols};
+    const auto count_data = counts.get_data();
+    components::fill_array(exec, count_data, num_chunks * num_cols,
+                           IndexType{});
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; chunk++) {
+        const auto chunk_counts = count_data + chunk * num_cols;
+        for (auto nz = row_ptrs[chunk_row_data[chunk]];
+             nz < row_ptrs[chunk_row_data[chunk + 1]]; nz++) {
+            chunk_counts[col_idxs[nz]]++;
+        }
+    }
+#pragma omp parallel for
+    for (size_type col = 0; col < num_cols; col++) {
+        IndexType offset{};
+        for (size_type chunk = 0; chunk < num_chunks; chunk++) {
+            const auto count = count_data[chunk * num_cols + col];
+            count_data[chunk * num_cols + col] = offset;
+            offset += count;
+        }
+        out_row_ptrs[col] = offset;
+    }
+    components::prefix_sum_nonnegative(exec, out_row_ptrs, num_cols + 1);
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; chunk++) {
+        const auto chunk_offsets = count_data + chunk * num_cols;
+        for (auto row = chunk_row_data[chunk]; row < chunk_row_data[chunk + 1];
+             row++) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                const auto col = col_idxs[nz];
+                const auto out_nz = out_row_ptrs[col] + chunk_offsets[col]++;
+                out_col_idxs[out_nz] = row;
+                scatter_cb(nz, out_nz);
+            }
+        }
+    }
+}
+
+
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_OMP_COMPONENTS_CSR_TRANSPOSE_HPP_
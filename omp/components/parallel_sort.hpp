@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GKO_OMP_COMPONENTS_PARALLEL_SORT_HPP_
+#define GKO_OMP_COMPONENTS_PARALLEL_SORT_HPP_
+
+
+#include <algorithm>
+#include <functional>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+namespace sort_detail {
+
+
+/**
+ * Inputs smaller than this are sorted sequentially, since the parallel merge
+ * passes would not amortize their overhead.
+ */
+constexpr size_type parallel_sort_min_size = 1 << 14;
+
+
+/**
+ * Merges the sorted ranges [a, a + a_size) and [b, b + b_size) into out in
+ * parallel, using the merge path of both ranges to give every thread an equal
+ * share of the output. Equal elements are taken from a first, so the merge is
+ * stable.
+ */
+template <typename ValueType, typename Comparator>
+void parallel_merge(const ValueType* a, size_type a_size, const ValueType* b,
+                    size_type b_size, ValueType* out, Comparator comp)
+{
+    const auto size = a_size + b_size;
+    // finds the number of elements taken from a among the first diag outputs
+    const auto merge_path = [&](size_type diag) {
+        auto lo = diag > b_size ? diag - b_size : size_type{};
+        auto hi = std::min(diag, a_size);
+        while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2;
+            if (comp(b[diag - mid - 1], a[mid])) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    };
+#pragma omp parallel
+    {
+        const auto num_threads = static_cast<size_type>(omp_get_num_threads());
+        const auto tid = static_cast<size_type>(omp_get_thread_num());
+        const auto out_begin = size * tid / num_threads;
+        const auto out_end = size * (tid + 1) / num_threads;
+        const auto a_begin = merge_path(out_begin);
+        const auto a_end = merge_path(out_end);
+        const auto b_begin = out_begin - a_begin;
+        const auto b_end = out_end - a_end;
+        std::merge(a + a_begin, a + a_end, b + b_begin, b + b_end,
+                   out + out_begin, comp);
+    }
+}
+
+
+/**
+ * Sorts [data, data + size) by sorting one chunk per thread and merging the
+ * chunks pairwise in parallel. The result is stable if `stable` is true.
+ */
+template <bool stable, typename ValueType, typename Comparator>
+void parallel_merge_sort(std::shared_ptr<const OmpExecutor> exec,
+                         ValueType* data, size_type size, Comparator comp)
+{
+    const auto num_chunks = static_cast<size_type>(omp_get_max_threads());
+    if (size < parallel_sort_min_size || num_chunks <= 1) {
+        if (stable) {
+            std::stable_sort(data, data + size, comp);
+        } else {
+            std::sort(data, data + size, comp);
+        }
+        return;
+    }
+    const auto chunk_begin = [&](size_type chunk) {
+        return size * std::min(chunk, num_chunks) / num_chunks;
+    };
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; chunk++) {
+        const auto begin = data + chunk_begin(chunk);
+        const auto end = data + chunk_begin(chunk + 1);
+        if (stable) {
+            std::stable_sort(begin, end, comp);
+        } else {
+            std::sort(begin, end, comp);
+        }
+    }
+    array<ValueType> buffer{exec, size};
+    auto in = data;
+    auto out = buffer.get_data();
+    for (size_type width = 1; width < num_chunks; width *= 2) {
+        for (size_type chunk = 0; chunk < num_chunks; chunk += 2 * width) {
+            const auto begin = chunk_begin(chunk);
+            const auto middle = chunk_begin(chunk + width);
+            const auto end = chunk_begin(chunk + 2 * width);
+            parallel_merge(in + begin, middle - begin, in + middle,
+                           end - middle, out + begin, comp);
+        }
+        std::swap(in, out);
+    }
+    if (in != data) {
+#pragma omp parallel for
+        for (size_type i = 0; i < size; i++) {
+            data[i] = in[i];
+        }
+    }
+}
+
+
+}  // namespace sort_detail
+
+
+/**
+ * Sorts the elements [data, data + size), such that comp(data[i + 1], data[i])
+ * is false for all i up to size - 1. Small inputs are sorted sequentially,
+ * larger inputs by a parallel merge sort with a temporary buffer of the same
+ * size. The relative order of equivalent elements is not preserved.
+ */
+template <typename ValueType, typename Comparator>
+void parallel_sort(std::shared_ptr<const OmpExecutor> exec, ValueType* data,
+                   size_type size, Comparator comp)
+{
+    sort_detail::parallel_merge_sort<false>(exec, data, size, comp);
+}
+
+
+/**
+ * @copydoc parallel_sort(std::shared_ptr<const OmpExecutor>, ValueType*,
+ *                        size_type, Comparator)
+ *
+ * Uses operator< as comparator.
+ */
+template <typename ValueType>
+void parallel_sort(std::shared_ptr<const OmpExecutor> exec, ValueType* data,
+                   size_type size)
+{
+    parallel_sort(exec, data, size, std::less<ValueType>{});
+}
+
+
+/**
+ * Sorts the elements [data, data + size) like parallel_sort, but preserves the
+ * relative order of equivalent elements.
+ */
+template <typename ValueType, typename Comparator>
+void parallel_stable_sort(std::shared_ptr<const OmpExecutor> exec,
+                          ValueType* data, size_type size, Comparator comp)
+{
+    sort_detail::parallel_merge_sort<true>(exec, data, size, comp);
+}
+
+
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
+
+
+#endif  // GKO_OMP_COMPONENTS_PARALLEL_SORT_HPP_
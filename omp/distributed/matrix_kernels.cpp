@@ -5,15 +5,20 @@
 #include "core/distributed/matrix_kernels.hpp"
 
 
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
 #include <omp.h>
 
 
 #include <ginkgo/core/base/exception_helpers.hpp>
 
 
-#include "core/base/allocator.hpp"
-#include "core/base/device_matrix_data_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -41,9 +46,7 @@ void build_local_nonlocal(
 {
     using partition_type =
         experimental::distributed::Partition<LocalIndexType, GlobalIndexType>;
-    using range_index_type = GlobalIndexType;
-    using global_nonzero = matrix_data_entry<ValueType, GlobalIndexType>;
-    using local_nonzero = matrix_data_entry<ValueType, LocalIndexType>;
+    using non_local_column = std::pair<comm_index_type, GlobalIndexType>;
     auto input_row_idxs = input.get_const_row_idxs();
     auto input_col_idxs = input.get_const_col_idxs();
     auto input_vals = input.get_const_values();
@@ -51,10 +54,6 @@ void build_local_nonlocal(
     auto col_part_ids = col_partition->get_part_ids();
     auto num_parts = row_partition->get_num_parts();
     auto recv_sizes_ptr = recv_sizes.get_data();
-    size_type row_range_id_hint = 0;
-    size_type col_range_id_hint = 0;
-    // zero recv_sizes values
-    std::fill_n(recv_sizes_ptr, num_parts, comm_index_type{});
 
     auto find_range = [](GlobalIndexType idx, const partition_type* partition,
                          size_type hint) {
@@ -76,158 +75,167 @@ void build_local_nonlocal(
                range_starting_indices[range_id];
     };
 
-    // store non-local columns and their range indices
-    map<GlobalIndexType, range_index_type> non_local_cols(exec);
-    // store non-local entries with global column idxs
-    vector<global_nonzero> non_local_entries(exec);
-    vector<local_nonzero> local_entries(exec);
-
-    auto num_threads = static_cast<size_type>(omp_get_max_threads());
-    auto num_input = input.get_num_stored_elements();
-    auto size_per_thread = (num_input + num_threads - 1) / num_threads;
-    std::vector<size_type> local_entry_offsets(num_threads, 0);
-    std::vector<size_type> non_local_entry_offsets(num_threads, 0);
-
-#pragma omp parallel firstprivate(col_range_id_hint, row_range_id_hint)
-    {
-        std::unordered_map<GlobalIndexType, range_index_type>
-            thread_non_local_cols;
-        std::vector<global_nonzero> thread_non_local_entries;
-        std::vector<local_nonzero> thread_local_entries;
-        std::vector<comm_index_type> thread_recv_sizes;
-        auto thread_id = omp_get_thread_num();
-        auto thread_begin = thread_id * size_per_thread;
-        auto thread_end = std::min(thread_begin + size_per_thread, num_input);
-        // separate local and non-local entries for our input chunk
-        for (auto i = thread_begin; i < thread_end; ++i) {
+    // The input is split into one chunk per thread. Every chunk is
+    // classified twice: first to count its local and non-local entries, and
+    // after the exclusive prefix sum over these counts to write its entries
+    // directly to their final position. This keeps the input order without
+    // any synchronization between the threads.
+    const auto num_chunks = static_cast<size_type>(omp_get_max_threads());
+    const auto num_input = input.get_num_stored_elements();
+    const auto chunk_size = (num_input + num_chunks - 1) / num_chunks;
+    std::vector<size_type> local_entry_offsets(num_chunks + 1, 0);
+    std::vector<size_type> non_local_entry_offsets(num_chunks + 1, 0);
+    // calls fn(i, local_row, col_range_id) for every input entry i of the
+    // chunk in a locally owned row
+    auto for_each_owned_entry = [&](size_type chunk, auto fn) {
+        size_type row_range_id_hint = 0;
+        size_type col_range_id_hint = 0;
+        const auto begin = std::min(chunk * chunk_size, num_input);
+        const auto end = std::min(begin + chunk_size, num_input);
+        for (auto i = begin; i < end; ++i) {
             const auto global_row = input_row_idxs[i];
-            const auto global_col = input_col_idxs[i];
-            const auto value = input_vals[i];
             auto row_range_id =
                 find_range(global_row, row_partition, row_range_id_hint);
             row_range_id_hint = row_range_id;
             // skip non-local rows
             if (row_part_ids[row_range_id] == local_part) {
-                // map to part-local indices
-                auto local_row =
-                    map_to_local(global_row, row_partition, row_range_id);
-
-                auto col_range_id =
-                    find_range(global_col, col_partition, col_range_id_hint);
+                auto col_range_id = find_range(
+                    input_col_idxs[i], col_partition, col_range_id_hint);
                 col_range_id_hint = col_range_id;
-                if (col_part_ids[col_range_id] == local_part) {
-                    // store local entry
-                    auto local_col =
-                        map_to_local(global_col, col_partition, col_range_id);
-                    thread_local_entries.emplace_back(local_row, local_col,
-                                                      value);
-                } else {
-                    thread_non_local_cols.emplace(global_col, col_range_id);
-                    thread_non_local_entries.emplace_back(local_row, global_col,
-                                                          value);
-                }
+                fn(i, map_to_local(global_row, row_partition, row_range_id),
+                   col_range_id);
             }
         }
-        local_entry_offsets[thread_id] = thread_local_entries.size();
-        non_local_entry_offsets[thread_id] = thread_non_local_entries.size();
-
-#pragma omp critical
-        {
-            // collect global non-local columns
-            non_local_cols.insert(thread_non_local_cols.begin(),
-                                  thread_non_local_cols.end());
-        }
-#pragma omp barrier
-#pragma omp single
-        {
-            // assign output ranges to the individual threads
-            size_type local{};
-            size_type non_local{};
-            for (size_type thread = 0; thread < num_threads; ++thread) {
-                auto size_local = local_entry_offsets[thread];
-                auto size_non_local = non_local_entry_offsets[thread];
-                local_entry_offsets[thread] = local;
-                non_local_entry_offsets[thread] = non_local;
-                local += size_local;
-                non_local += size_non_local;
+    };
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        size_type local{};
+        size_type non_local{};
+        for_each_owned_entry(chunk, [&](size_type, LocalIndexType,
+                                        size_type col_range_id) {
+            if (col_part_ids[col_range_id] == local_part) {
+                local++;
+            } else {
+                non_local++;
             }
-            local_entries.resize(local);
-            non_local_entries.resize(non_local);
-        }
-        // write back the local data to the output ranges
-        auto local = local_entry_offsets[thread_id];
-        auto non_local = non_local_entry_offsets[thread_id];
-        for (const auto& entry : thread_local_entries) {
-            local_entries[local] = entry;
-            local++;
-        }
-        for (const auto& entry : thread_non_local_entries) {
-            non_local_entries[non_local] = entry;
-            non_local++;
+        });
+        local_entry_offsets[chunk] = local;
+        non_local_entry_offsets[chunk] = non_local;
+    }
+    components::prefix_sum_nonnegative(exec, local_entry_offsets.data(),
+                                       num_chunks + 1);
+    components::prefix_sum_nonnegative(exec, non_local_entry_offsets.data(),
+                                       num_chunks + 1);
+    const auto num_local_entries = local_entry_offsets[num_chunks];
+    const auto num_non_local_entries = non_local_entry_offsets[num_chunks];
+    local_row_idxs.resize_and_reset(num_local_entries);
+    local_col_idxs.resize_and_reset(num_local_entries);
+    local_values.resize_and_reset(num_local_entries);
+    non_local_row_idxs.resize_and_reset(num_non_local_entries);
+    non_local_col_idxs.resize_and_reset(num_non_local_entries);
+    non_local_values.resize_and_reset(num_non_local_entries);
+    // the non-local columns are identified by their owning part and global
+    // index, which is also the order in which they are numbered locally
+    array<non_local_column> non_local_entry_cols{exec, num_non_local_entries};
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        auto local = local_entry_offsets[chunk];
+        auto non_local = non_local_entry_offsets[chunk];
+        for_each_owned_entry(chunk, [&](size_type i, LocalIndexType local_row,
+                                        size_type col_range_id) {
+            const auto global_col = input_col_idxs[i];
+            const auto col_part = col_part_ids[col_range_id];
+            if (col_part == local_part) {
+                local_row_idxs.get_data()[local] = local_row;
+                local_col_idxs.get_data()[local] =
+                    map_to_local(global_col, col_partition, col_range_id);
+                local_values.get_data()[local] = input_vals[i];
+                local++;
+            } else {
+                non_local_row_idxs.get_data()[non_local] = local_row;
+                non_local_entry_cols.get_data()[non_local] = {col_part,
+                                                              global_col};
+                non_local_values.get_data()[non_local] = input_vals[i];
+                non_local++;
+            }
+        });
+    }
+
+    // collect the distinct non-local columns, sorted by part and index
+    array<non_local_column> non_local_cols{exec, non_local_entry_cols};
+    parallel_sort(exec, non_local_cols.get_data(), num_non_local_entries);
+    const auto non_local_cols_ptr = non_local_cols.get_const_data();
+    const auto is_distinct = [&](size_type i) {
+        return i == 0 || non_local_cols_ptr[i - 1] != non_local_cols_ptr[i];
+    };
+    const auto sorted_chunk_size =
+        (num_non_local_entries + num_chunks - 1) / num_chunks;
+    std::vector<size_type> distinct_offsets(num_chunks + 1, 0);
+#pragma omp parallel for
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto begin =
+            std::min(chunk * sorted_chunk_size, num_non_local_entries);
+        const auto end =
+            std::min(begin + sorted_chunk_size, num_non_local_entries);
+        size_type count{};
+        for (auto i = begin; i < end; ++i) {
+            count += is_distinct(i) ? 1 : 0;
         }
+        distinct_offsets[chunk] = count;
     }
-    // store local data to output
-    local_row_idxs.resize_and_reset(local_entries.size());
-    local_col_idxs.resize_and_reset(local_entries.size());
-    local_values.resize_and_reset(local_entries.size());
+    components::prefix_sum_nonnegative(exec, distinct_offsets.data(),
+                                       num_chunks + 1);
+    const auto num_non_local_cols = distinct_offsets[num_chunks];
+    array<non_local_column> distinct_cols{exec, num_non_local_cols};
+    const auto distinct_cols_ptr = distinct_cols.get_data();
 #pragma omp parallel for
-    for (size_type i = 0; i < local_entries.size(); ++i) {
-        const auto& entry = local_entries[i];
-        local_row_idxs.get_data()[i] = entry.row;
-        local_col_idxs.get_data()[i] = entry.column;
-        local_values.get_data()[i] = entry.value;
+    for (size_type chunk = 0; chunk < num_chunks; ++chunk) {
+        const auto begin =
+            std::min(chunk * sorted_chunk_size, num_non_local_entries);
+        const auto end =
+            std::min(begin + sorted_chunk_size, num_non_local_entries);
+        auto out = distinct_offsets[chunk];
+        for (auto i = begin; i < end; ++i) {
+            if (is_distinct(i)) {
+                distinct_cols_ptr[out] = non_local_cols_ptr[i];
+                out++;
+            }
+        }
     }
 
     // count non-local columns per part
-    for (const auto& entry : non_local_cols) {
-        auto col_range_id = entry.second;
-        recv_sizes_ptr[col_part_ids[col_range_id]]++;
+    const auto by_part = [](non_local_column a, non_local_column b) {
+        return a.first < b.first;
+    };
+#pragma omp parallel for
+    for (comm_index_type part = 0; part < num_parts; ++part) {
+        const auto part_range = std::equal_range(
+            distinct_cols_ptr, distinct_cols_ptr + num_non_local_cols,
+            non_local_column{part, GlobalIndexType{}}, by_part);
+        recv_sizes_ptr[part] = static_cast<comm_index_type>(
+            std::distance(part_range.first, part_range.second));
     }
-    const auto num_non_local_cols = std::accumulate(
-        recv_sizes_ptr, recv_sizes_ptr + num_parts, size_type{});
-    components::prefix_sum_nonnegative(exec, recv_sizes_ptr, num_parts);
 
-    // collect and renumber offdiagonal columns
+    // build the gather indices and local-to-global map for non-local columns
     local_gather_idxs.resize_and_reset(num_non_local_cols);
-    std::unordered_map<GlobalIndexType, LocalIndexType>
-        non_local_global_to_local;
-    for (const auto& entry : non_local_cols) {
-        auto range = entry.second;
-        auto part = col_part_ids[range];
-        auto idx = recv_sizes_ptr[part];
-        local_gather_idxs.get_data()[idx] =
-            map_to_local(entry.first, col_partition, entry.second);
-        non_local_global_to_local[entry.first] = idx;
-        ++recv_sizes_ptr[part];
-    }
-
-    // build local-to-global map for non-local columns
     non_local_to_global.resize_and_reset(num_non_local_cols);
-    std::fill_n(non_local_to_global.get_data(), non_local_to_global.get_size(),
-                invalid_index<GlobalIndexType>());
-    for (const auto& key_value : non_local_global_to_local) {
-        const auto global_idx = key_value.first;
-        const auto local_idx = key_value.second;
-        non_local_to_global.get_data()[local_idx] = global_idx;
-    }
-
-    // compute sizes from shifted offsets
-    for (size_type i = num_parts - 1; i > 0; --i) {
-        recv_sizes_ptr[i] -= recv_sizes_ptr[i - 1];
+#pragma omp parallel for
+    for (size_type i = 0; i < num_non_local_cols; ++i) {
+        const auto global_col = distinct_cols_ptr[i].second;
+        const auto range_id = find_range(global_col, col_partition, 0);
+        local_gather_idxs.get_data()[i] =
+            map_to_local(global_col, col_partition, range_id);
+        non_local_to_global.get_data()[i] = global_col;
     }
 
     // map non-local values to local column indices
-    non_local_row_idxs.resize_and_reset(non_local_entries.size());
-    non_local_col_idxs.resize_and_reset(non_local_entries.size());
-    non_local_values.resize_and_reset(non_local_entries.size());
 #pragma omp parallel for
-    for (size_type i = 0; i < non_local_entries.size(); i++) {
-        auto global = non_local_entries[i];
-        non_local_row_idxs.get_data()[i] =
-            static_cast<LocalIndexType>(global.row);
+    for (size_type i = 0; i < num_non_local_entries; i++) {
+        const auto it = std::lower_bound(
+            distinct_cols_ptr, distinct_cols_ptr + num_non_local_cols,
+            non_local_entry_cols.get_const_data()[i]);
         non_local_col_idxs.get_data()[i] =
-            non_local_global_to_local[global.column];
-        non_local_values.get_data()[i] = global.value;
+            static_cast<LocalIndexType>(std::distance(distinct_cols_ptr, it));
     }
 }
 
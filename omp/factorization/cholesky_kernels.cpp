@@ -18,6 +18,7 @@
 #include "core/factorization/elimination_forest.hpp"
 #include "core/factorization/lu_kernels.hpp"
 #include "core/matrix/csr_lookup.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -197,11 +198,10 @@ void initialize(std::shared_ptr<const DefaultExecutor> exec,
                                      factors->get_size()[0], row_idxs);
     components::fill_seq_array(exec, transpose_idxs, nnz);
     // compute nonzero permutation for sparse transpose
-    std::sort(transpose_idxs, transpose_idxs + nnz,
-              [&](IndexType i, IndexType j) {
-                  return std::tie(col_idxs[i], row_idxs[i]) <
-                         std::tie(col_idxs[j], row_idxs[j]);
-              });
+    parallel_sort(exec, transpose_idxs, nnz, [&](IndexType i, IndexType j) {
+        return std::tie(col_idxs[i], row_idxs[i]) <
+               std::tie(col_idxs[j], row_idxs[j]);
+    });
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_CHOLESKY_INITIALIZE);
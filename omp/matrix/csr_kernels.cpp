@@ -33,6 +33,8 @@
 #include "core/matrix/csr_accessor_helper.hpp"
 #include "core/matrix/csr_builder.hpp"
 #include "omp/components/csr_spgeam.hpp"
+#include "omp/components/csr_transpose.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -83,6 +85,8 @@ void spmv(std::shared_ptr<const OmpExecutor> exec,
 
 GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_SPMV_KERNEL);
+GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_SPMV_KERNEL);
 
 
 template <typename MatrixValueType, typename InputValueType,
@@ -124,6 +128,8 @@ void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
 
 GKO_INSTANTIATE_FOR_EACH_MIXED_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
+GKO_INSTANTIATE_FOR_EACH_REDUCED_STORAGE_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CSR_ADVANCED_SPMV_KERNEL);
 
 
 namespace {
@@ -598,8 +604,8 @@ void convert_to_fbcsr(std::shared_ptr<const DefaultExecutor> exec,
         return std::make_pair(a.row / bs, a.column / bs);
     };
     // sort by block in row-major order
-    std::sort(entries, entries + nnz,
-              [&](entry a, entry b) { return to_block(a) < to_block(b); });
+    parallel_sort(exec, entries, nnz,
+                  [&](entry a, entry b) { return to_block(a) < to_block(b); });
     // set row pointers by jumps in block row index
     gko::vector<IndexType> col_idx_vec{{exec}};
     gko::vector<ValueType> value_vec{{exec}};
@@ -641,49 +647,20 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_CSR_CONVERT_TO_FBCSR_KERNEL);
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator>
-inline void convert_csr_to_csc(size_type num_rows, const IndexType* row_ptrs,
-                               const IndexType* col_idxs,
-                               const ValueType* csr_vals, IndexType* row_idxs,
-                               IndexType* col_ptrs, ValueType* csc_vals,
-                               UnaryOperator op)
-{
-    for (size_type row = 0; row < num_rows; ++row) {
-        for (auto i = row_ptrs[row]; i < row_ptrs[row + 1]; ++i) {
-            const auto dest_idx = col_ptrs[col_idxs[i]]++;
-            row_idxs[dest_idx] = row;
-            csc_vals[dest_idx] = op(csr_vals[i]);
-        }
-    }
-}
-
-
 template <typename ValueType, typename IndexType, typename UnaryOperator>
 void transpose_and_transform(std::shared_ptr<const OmpExecutor> exec,
                              matrix::Csr<ValueType, IndexType>* trans,
                              const matrix::Csr<ValueType, IndexType>* orig,
                              UnaryOperator op)
 {
-    auto trans_row_ptrs = trans->get_row_ptrs();
-    auto orig_row_ptrs = orig->get_const_row_ptrs();
-    auto trans_col_idxs = trans->get_col_idxs();
-    auto orig_col_idxs = orig->get_const_col_idxs();
-    auto trans_vals = trans->get_values();
     auto orig_vals = orig->get_const_values();
-
-    auto orig_num_cols = orig->get_size()[1];
-    auto orig_num_rows = orig->get_size()[0];
-    auto orig_nnz = orig_row_ptrs[orig_num_rows];
-
-    components::fill_array(exec, trans_row_ptrs, orig_num_cols + 1,
-                           IndexType{});
-    for (size_type i = 0; i < orig_nnz; i++) {
-        trans_row_ptrs[orig_col_idxs[i] + 1]++;
-    }
-    components::prefix_sum_nonnegative(exec, trans_row_ptrs + 1, orig_num_cols);
-
-    convert_csr_to_csc(orig_num_rows, orig_row_ptrs, orig_col_idxs, orig_vals,
-                       trans_col_idxs, trans_row_ptrs + 1, trans_vals, op);
+    auto trans_vals = trans->get_values();
+    transpose_pattern(exec, orig->get_size()[0], orig->get_size()[1],
+                      orig->get_const_row_ptrs(), orig->get_const_col_idxs(),
+                      trans->get_row_ptrs(), trans->get_col_idxs(),
+                      [&](IndexType nz, IndexType out_nz) {
+                          trans_vals[out_nz] = op(orig_vals[nz]);
+                      });
 }
 
 
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "core/matrix/delta_csr_kernels.hpp"
+
+
+#include <algorithm>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/delta_csr_encoding.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The DeltaCsr matrix format namespace.
+ *
+ * @ingroup delta_csr
+ */
+namespace delta_csr {
+
+
+using matrix::delta_csr::dispatch_delta_width;
+using matrix::delta_csr::load_delta;
+using matrix::delta_csr::row_delta_width;
+using matrix::delta_csr::store_delta;
+
+
+/**
+ * Computes `out(row, rhs, (A * b)(row, rhs))` for all rows in parallel.
+ * The delta width is dispatched once per row, so the inner loops decode the
+ * column indices with a fixed-width load.
+ */
+template <typename ValueType, typename IndexType, typename OutFn>
+void spmv_impl(const matrix::DeltaCsr<ValueType, IndexType>* a,
+               const matrix::Dense<ValueType>* b, OutFn out)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto row_bases = a->get_const_row_bases();
+    const auto delta_ptrs = a->get_const_delta_ptrs();
+    const auto deltas = a->get_const_deltas();
+    const auto vals = a->get_const_values();
+    const auto num_rhs = b->get_size()[1];
+    const auto num_rows = static_cast<int64>(a->get_size()[0]);
+#pragma omp parallel for
+    for (int64 row = 0; row < num_rows; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto nnz = row_ptrs[row + 1] - begin;
+        const auto width =
+            row_delta_width(delta_ptrs[row], delta_ptrs[row + 1], nnz);
+        const auto row_deltas = deltas + delta_ptrs[row];
+        const auto row_vals = vals + begin;
+        const auto base = row_bases[row];
+        dispatch_delta_width(width, [&](auto delta_type) {
+            using delta_type_t = decltype(delta_type);
+            for (size_type j = 0; j < num_rhs; ++j) {
+                auto sum = zero<ValueType>();
+                for (IndexType k = 0; k < nnz; ++k) {
+                    const auto col =
+                        base + static_cast<IndexType>(
+                                   load_delta<delta_type_t>(row_deltas, k));
+                    sum += row_vals[k] * b->at(col, j);
+                }
+                out(row, j, sum);
+            }
+        });
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const DefaultExecutor> exec,
+          const matrix::DeltaCsr<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    spmv_impl(a, b, [c](int64 row, size_type col, ValueType value) {
+        c->at(row, col) = value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const DefaultExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::DeltaCsr<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    spmv_impl(a, b, [&](int64 row, size_type col, ValueType value) {
+        c->at(row, col) = vbeta * c->at(row, col) + valpha * value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compute_delta_sizes(std::shared_ptr<const DefaultExecutor> exec,
+                         const matrix::Csr<ValueType, IndexType>* source,
+                         IndexType* row_bases, int64* delta_sizes)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+#pragma omp parallel for
+    for (int64 row = 0; row < num_rows; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        if (begin == end) {
+            row_bases[row] = 0;
+            delta_sizes[row] = 0;
+            continue;
+        }
+        const auto minmax =
+            std::minmax_element(col_idxs + begin, col_idxs + end);
+        row_bases[row] = *minmax.first;
+        delta_sizes[row] =
+            static_cast<int64>(end - begin) *
+            matrix::delta_csr::delta_width(*minmax.second - *minmax.first);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_COMPUTE_DELTA_SIZES_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void fill_in_deltas(std::shared_ptr<const DefaultExecutor> exec,
+                    const matrix::Csr<ValueType, IndexType>* source,
+                    matrix::DeltaCsr<ValueType, IndexType>* result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto row_bases = result->get_const_row_bases();
+    const auto delta_ptrs = result->get_const_delta_ptrs();
+    const auto deltas = result->get_deltas();
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+#pragma omp parallel for
+    for (int64 row = 0; row < num_rows; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto nnz = row_ptrs[row + 1] - begin;
+        const auto width =
+            row_delta_width(delta_ptrs[row], delta_ptrs[row + 1], nnz);
+        const auto row_deltas = deltas + delta_ptrs[row];
+        dispatch_delta_width(width, [&](auto delta_type) {
+            using delta_type_t = decltype(delta_type);
+            for (IndexType k = 0; k < nnz; ++k) {
+                store_delta(row_deltas, k,
+                            static_cast<delta_type_t>(col_idxs[begin + k] -
+                                                      row_bases[row]));
+            }
+        });
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_FILL_IN_DELTAS_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const DefaultExecutor> exec,
+                    const matrix::DeltaCsr<ValueType, IndexType>* source,
+                    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto row_bases = source->get_const_row_bases();
+    const auto delta_ptrs = source->get_const_delta_ptrs();
+    const auto deltas = source->get_const_deltas();
+    const auto col_idxs = result->get_col_idxs();
+    const auto num_rows = static_cast<int64>(source->get_size()[0]);
+#pragma omp parallel for
+    for (int64 row = 0; row < num_rows; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto nnz = row_ptrs[row + 1] - begin;
+        const auto width =
+            row_delta_width(delta_ptrs[row], delta_ptrs[row + 1], nnz);
+        const auto row_deltas = deltas + delta_ptrs[row];
+        dispatch_delta_width(width, [&](auto delta_type) {
+            using delta_type_t = decltype(delta_type);
+            for (IndexType k = 0; k < nnz; ++k) {
+                const auto delta = load_delta<delta_type_t>(row_deltas, k);
+                col_idxs[begin + k] =
+                    row_bases[row] + static_cast<IndexType>(delta);
+            }
+        });
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace delta_csr
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
@@ -6,8 +6,10 @@
 
 
 #include <algorithm>
+#include <array>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 
 #include <omp.h>
@@ -28,6 +30,8 @@
 #include "core/components/fill_array_kernels.hpp"
 #include "core/components/prefix_sum_kernels.hpp"
 #include "core/synthesizer/implementation_selection.hpp"
+#include "omp/components/csr_transpose.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -41,44 +45,112 @@ namespace omp {
 namespace fbcsr {
 
 
-template <typename ValueType, typename IndexType>
-void spmv(std::shared_ptr<const OmpExecutor> exec,
-          const matrix::Fbcsr<ValueType, IndexType>* const a,
-          const matrix::Dense<ValueType>* const b,
-          matrix::Dense<ValueType>* const c)
+namespace {
+
+
+/**
+ * The block sizes with dedicated kernels, followed by 0, which selects the
+ * generic kernels that read the block size at runtime.
+ */
+using compiled_block_sizes =
+    syn::concatenate<fixedblock::compiled_kernels, syn::value_list<int, 0>>;
+
+
+/**
+ * Returns a predicate selecting the kernel for the given block size from
+ * compiled_block_sizes, falling back to the generic kernel.
+ */
+inline auto block_size_selector(int block_size)
 {
-    const int bs = a->get_block_size();
-    const auto nvecs = static_cast<IndexType>(b->get_size()[1]);
-    const IndexType nbrows = a->get_num_block_rows();
-    const size_type nbnz = a->get_num_stored_blocks();
-    auto row_ptrs = a->get_const_row_ptrs();
-    auto col_idxs = a->get_const_col_idxs();
-    const acc::range<acc::block_col_major<const ValueType, 3>> avalues{
-        to_std_array<acc::size_type>(nbnz, bs, bs), a->get_const_values()};
+    return [block_size](int compiled_block_size) {
+        return compiled_block_size == block_size || compiled_block_size == 0;
+    };
+}
 
-#pragma omp parallel for
-    for (IndexType ibrow = 0; ibrow < nbrows; ++ibrow) {
-        for (IndexType row = ibrow * bs; row < (ibrow + 1) * bs; ++row) {
-            for (IndexType rhs = 0; rhs < nvecs; rhs++) {
-                c->at(row, rhs) = zero<ValueType>();
-            }
-        }
-        for (IndexType inz = row_ptrs[ibrow]; inz < row_ptrs[ibrow + 1];
-             ++inz) {
-            for (int ib = 0; ib < bs; ib++) {
-                const IndexType row = ibrow * bs + ib;
-                for (int jb = 0; jb < bs; jb++) {
-                    const auto val = avalues(inz, ib, jb);
-                    const auto col = col_idxs[inz] * bs + jb;
-                    for (size_type j = 0; j < nvecs; ++j) {
-                        c->at(row, j) += val * b->at(col, j);
+
+/**
+ * Computes c = alpha * a * b + beta * c, or c = a * b if alpha and beta are
+ * nullptr. For mat_blk_sz > 0, the block size is a compile-time constant, so
+ * the loops over the blocks can be unrolled and vectorized.
+ */
+template <int mat_blk_sz, typename ValueType, typename IndexType>
+void spmv_impl(syn::value_list<int, mat_blk_sz>,
+               const matrix::Fbcsr<ValueType, IndexType>* const a,
+               const matrix::Dense<ValueType>* const b,
+               matrix::Dense<ValueType>* const c,
+               const matrix::Dense<ValueType>* const alpha,
+               const matrix::Dense<ValueType>* const beta)
+{
+    const int bs = mat_blk_sz > 0 ? mat_blk_sz : a->get_block_size();
+    const int bs2 = bs * bs;
+    const auto nvecs = b->get_size()[1];
+    const IndexType nbrows = a->get_num_block_rows();
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto values = a->get_const_values();
+    const auto b_values = b->get_const_values();
+    const auto b_stride = b->get_stride();
+    const auto c_values = c->get_values();
+    const auto c_stride = c->get_stride();
+    const auto valpha = alpha ? alpha->at(0, 0) : one<ValueType>();
+    const auto vbeta = beta ? beta->at(0, 0) : zero<ValueType>();
+
+#pragma omp parallel
+    {
+        // accumulator for one block row, on the stack for fixed block sizes
+        std::array<ValueType, (mat_blk_sz > 0 ? mat_blk_sz : 1)> fixed_sum;
+        std::vector<ValueType> generic_sum(mat_blk_sz > 0 ? 0 : bs);
+        const auto sum =
+            mat_blk_sz > 0 ? fixed_sum.data() : generic_sum.data();
+#pragma omp for
+        for (IndexType ibrow = 0; ibrow < nbrows; ++ibrow) {
+            // the block row stays in cache across the right-hand sides
+            for (size_type rhs = 0; rhs < nvecs; ++rhs) {
+                for (int ib = 0; ib < bs; ib++) {
+                    sum[ib] = zero<ValueType>();
+                }
+                for (auto inz = row_ptrs[ibrow]; inz < row_ptrs[ibrow + 1];
+                     ++inz) {
+                    // blocks are stored in column-major order
+                    const auto block = values + inz * bs2;
+                    const auto b_block =
+                        b_values + col_idxs[inz] * bs * b_stride + rhs;
+                    for (int jb = 0; jb < bs; jb++) {
+                        const auto b_val = b_block[jb * b_stride];
+                        for (int ib = 0; ib < bs; ib++) {
+                            sum[ib] += block[ib + jb * bs] * b_val;
+                        }
                     }
                 }
+                const auto c_block = c_values + ibrow * bs * c_stride + rhs;
+                for (int ib = 0; ib < bs; ib++) {
+                    auto& c_val = c_block[ib * c_stride];
+                    c_val = beta ? vbeta * c_val + valpha * sum[ib] : sum[ib];
+                }
             }
         }
     }
 }
 
+GKO_ENABLE_IMPLEMENTATION_SELECTION(select_spmv, spmv_impl);
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const OmpExecutor> exec,
+          const matrix::Fbcsr<ValueType, IndexType>* const a,
+          const matrix::Dense<ValueType>* const b,
+          matrix::Dense<ValueType>* const c)
+{
+    select_spmv(compiled_block_sizes(),
+                block_size_selector(a->get_block_size()),
+                syn::value_list<int>(), syn::type_list<>(), a, b, c,
+                static_cast<const matrix::Dense<ValueType>*>(nullptr),
+                static_cast<const matrix::Dense<ValueType>*>(nullptr));
+}
+
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_FBCSR_SPMV_KERNEL);
 
 
@@ -90,37 +162,10 @@ void advanced_spmv(std::shared_ptr<const OmpExecutor> exec,
                    const matrix::Dense<ValueType>* const beta,
                    matrix::Dense<ValueType>* const c)
 {
-    const int bs = a->get_block_size();
-    const auto nvecs = static_cast<IndexType>(b->get_size()[1]);
-    const IndexType nbrows = a->get_num_block_rows();
-    const size_type nbnz = a->get_num_stored_blocks();
-    auto row_ptrs = a->get_const_row_ptrs();
-    auto col_idxs = a->get_const_col_idxs();
-    auto valpha = alpha->at(0, 0);
-    auto vbeta = beta->at(0, 0);
-    const acc::range<acc::block_col_major<const ValueType, 3>> avalues{
-        to_std_array<acc::size_type>(nbnz, bs, bs), a->get_const_values()};
-
-#pragma omp parallel for
-    for (IndexType ibrow = 0; ibrow < nbrows; ++ibrow) {
-        for (IndexType row = ibrow * bs; row < (ibrow + 1) * bs; ++row) {
-            for (IndexType rhs = 0; rhs < nvecs; rhs++) {
-                c->at(row, rhs) *= vbeta;
-            }
-        }
-        for (IndexType inz = row_ptrs[ibrow]; inz < row_ptrs[ibrow + 1];
-             ++inz) {
-            for (int ib = 0; ib < bs; ib++) {
-                const IndexType row = ibrow * bs + ib;
-                for (int jb = 0; jb < bs; jb++) {
-                    const auto val = avalues(inz, ib, jb);
-                    const auto col = col_idxs[inz] * bs + jb;
-                    for (size_type j = 0; j < nvecs; ++j)
-                        c->at(row, j) += valpha * val * b->at(col, j);
-                }
-            }
-        }
-    }
+    select_spmv(compiled_block_sizes(),
+                block_size_selector(a->get_block_size()),
+                syn::value_list<int>(), syn::type_list<>(), a, b, c, alpha,
+                beta);
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
@@ -138,9 +183,8 @@ void fill_in_matrix_data(std::shared_ptr<const DefaultExecutor> exec,
     components::soa_to_aos(exec, data, block_ordered);
     const auto in_nnz = data.get_num_stored_elements();
     auto block_ordered_ptr = block_ordered.get_data();
-    std::sort(
-        block_ordered_ptr, block_ordered_ptr + in_nnz,
-        [block_size](auto a, auto b) {
+    parallel_sort(
+        exec, block_ordered_ptr, in_nnz, [block_size](auto a, auto b) {
             return std::make_tuple(a.row / block_size, a.column / block_size) <
                    std::make_tuple(b.row / block_size, b.column / block_size);
         });
@@ -264,45 +308,18 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_CONVERT_TO_CSR_KERNEL);
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator,
-          bool transpose_blocks>
-void convert_fbcsr_to_fbcsc(const IndexType num_blk_rows, const int blksz,
-                            const IndexType* const row_ptrs,
-                            const IndexType* const col_idxs,
-                            const ValueType* const fbcsr_vals,
-                            IndexType* const row_idxs,
-                            IndexType* const col_ptrs,
-                            ValueType* const csc_vals, UnaryOperator op)
-{
-    auto sizes =
-        gko::to_std_array<acc::size_type>(row_ptrs[num_blk_rows], blksz, blksz);
-    const acc::range<acc::block_col_major<const ValueType, 3>> rvalues(
-        sizes, fbcsr_vals);
-    acc::range<acc::block_col_major<ValueType, 3>> cvalues(sizes, csc_vals);
-    for (IndexType brow = 0; brow < num_blk_rows; ++brow) {
-        for (auto i = row_ptrs[brow]; i < row_ptrs[brow + 1]; ++i) {
-            const auto dest_idx = col_ptrs[col_idxs[i]];
-            col_ptrs[col_idxs[i]]++;
-            row_idxs[dest_idx] = brow;
-            for (int ib = 0; ib < blksz; ib++) {
-                for (int jb = 0; jb < blksz; jb++) {
-                    cvalues(dest_idx, ib, jb) =
-                        op(transpose_blocks ? rvalues(i, jb, ib)
-                                            : rvalues(i, ib, jb));
-                }
-            }
-        }
-    }
-}
+namespace {
 
 
-template <typename ValueType, typename IndexType, typename UnaryOperator>
-void transpose_and_transform(
-    std::shared_ptr<const OmpExecutor> exec,
+template <int mat_blk_sz, typename ValueType, typename IndexType,
+          typename UnaryOperator>
+void transpose_and_transform_impl(
+    syn::value_list<int, mat_blk_sz>, std::shared_ptr<const OmpExecutor> exec,
     matrix::Fbcsr<ValueType, IndexType>* const trans,
     const matrix::Fbcsr<ValueType, IndexType>* const orig, UnaryOperator op)
 {
-    const int bs = orig->get_block_size();
+    const int bs = mat_blk_sz > 0 ? mat_blk_sz : orig->get_block_size();
+    const int bs2 = bs * bs;
     auto trans_row_ptrs = trans->get_row_ptrs();
     auto orig_row_ptrs = orig->get_const_row_ptrs();
     auto trans_col_idxs = trans->get_col_idxs();
@@ -310,19 +327,38 @@ void transpose_and_transform(
     auto trans_vals = trans->get_values();
     auto orig_vals = orig->get_const_values();
 
-    const IndexType nbcols = orig->get_num_block_cols();
-    const IndexType nbrows = orig->get_num_block_rows();
-    auto orig_nbnz = orig_row_ptrs[nbrows];
+    transpose_pattern(
+        exec, orig->get_num_block_rows(), orig->get_num_block_cols(),
+        orig_row_ptrs, orig_col_idxs, trans_row_ptrs, trans_col_idxs,
+        [&](IndexType nz, IndexType out_nz) {
+            // blocks are stored in column-major order, so the transposed
+            // block is the original block in row-major order
+            const auto in_block = orig_vals + nz * bs2;
+            const auto out_block = trans_vals + out_nz * bs2;
+            for (int jb = 0; jb < bs; jb++) {
+                for (int ib = 0; ib < bs; ib++) {
+                    out_block[ib + jb * bs] = op(in_block[jb + ib * bs]);
+                }
+            }
+        });
+}
+
+GKO_ENABLE_IMPLEMENTATION_SELECTION(select_transpose_and_transform,
+                                    transpose_and_transform_impl);
 
-    components::fill_array(exec, trans_row_ptrs, nbcols + 1, IndexType{});
-    for (size_type i = 0; i < orig_nbnz; i++) {
-        trans_row_ptrs[orig_col_idxs[i] + 1]++;
-    }
-    components::prefix_sum_nonnegative(exec, trans_row_ptrs + 1, nbcols);
 
-    convert_fbcsr_to_fbcsc<ValueType, IndexType, UnaryOperator, true>(
-        nbrows, bs, orig_row_ptrs, orig_col_idxs, orig_vals, trans_col_idxs,
-        trans_row_ptrs + 1, trans_vals, op);
+}  // namespace
+
+
+template <typename ValueType, typename IndexType, typename UnaryOperator>
+void transpose_and_transform(
+    std::shared_ptr<const OmpExecutor> exec,
+    matrix::Fbcsr<ValueType, IndexType>* const trans,
+    const matrix::Fbcsr<ValueType, IndexType>* const orig, UnaryOperator op)
+{
+    select_transpose_and_transform(
+        compiled_block_sizes(), block_size_selector(orig->get_block_size()),
+        syn::value_list<int>(), syn::type_list<>(), exec, trans, orig, op);
 }
 
 
@@ -437,32 +473,34 @@ GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_SORT_BY_COLUMN_INDEX);
 
 
-template <typename ValueType, typename IndexType>
-void extract_diagonal(std::shared_ptr<const OmpExecutor> exec,
-                      const matrix::Fbcsr<ValueType, IndexType>* const orig,
-                      matrix::Diagonal<ValueType>* const diag)
+namespace {
+
+
+template <int mat_blk_sz, typename ValueType, typename IndexType>
+void extract_diagonal_impl(
+    syn::value_list<int, mat_blk_sz>,
+    const matrix::Fbcsr<ValueType, IndexType>* const orig,
+    matrix::Diagonal<ValueType>* const diag)
 {
+    const int bs = mat_blk_sz > 0 ? mat_blk_sz : orig->get_block_size();
+    const int bs2 = bs * bs;
     const auto row_ptrs = orig->get_const_row_ptrs();
     const auto col_idxs = orig->get_const_col_idxs();
     const auto values = orig->get_const_values();
-    const int bs = orig->get_block_size();
-    const IndexType nbrows = orig->get_num_block_rows();
     const IndexType nbdim_min =
         std::min(orig->get_num_block_rows(), orig->get_num_block_cols());
     auto diag_values = diag->get_values();
 
     assert(diag->get_size()[0] == nbdim_min * bs);
 
-    const acc::range<acc::block_col_major<const ValueType, 3>> vblocks(
-        gko::to_std_array<acc::size_type>(row_ptrs[nbrows], bs, bs), values);
-
 #pragma omp parallel for
     for (IndexType ibrow = 0; ibrow < nbdim_min; ++ibrow) {
         for (IndexType idx = row_ptrs[ibrow]; idx < row_ptrs[ibrow + 1];
              ++idx) {
             if (col_idxs[idx] == ibrow) {
+                const auto block = values + idx * bs2;
                 for (int ib = 0; ib < bs; ib++) {
-                    diag_values[ibrow * bs + ib] = vblocks(idx, ib, ib);
+                    diag_values[ibrow * bs + ib] = block[ib * (bs + 1)];
                 }
                 break;
             }
@@ -470,6 +508,23 @@ void extract_diagonal(std::shared_ptr<const OmpExecutor> exec,
     }
 }
 
+GKO_ENABLE_IMPLEMENTATION_SELECTION(select_extract_diagonal,
+                                    extract_diagonal_impl);
+
+
+}  // namespace
+
+
+template <typename ValueType, typename IndexType>
+void extract_diagonal(std::shared_ptr<const OmpExecutor> exec,
+                      const matrix::Fbcsr<ValueType, IndexType>* const orig,
+                      matrix::Diagonal<ValueType>* const diag)
+{
+    select_extract_diagonal(
+        compiled_block_sizes(), block_size_selector(orig->get_block_size()),
+        syn::value_list<int>(), syn::type_list<>(), orig, diag);
+}
+
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
     GKO_DECLARE_FBCSR_EXTRACT_DIAGONAL);
 
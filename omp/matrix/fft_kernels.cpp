@@ -5,6 +5,13 @@
 #include "core/matrix/fft_kernels.hpp"
 
 
+#include <algorithm>
+#include <array>
+
+
+#include <omp.h>
+
+
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
@@ -22,281 +29,449 @@ namespace omp {
  * @ingroup fft
  */
 namespace fft {
+namespace {
 
 
-template <typename InValueType, typename OutValueType>
-void bfly(const matrix::Dense<InValueType>* b, matrix::Dense<OutValueType>* x,
-          int64 lo, int64 hi, OutValueType root)
-{
-    for (size_type rhs = 0; rhs < x->get_size()[1]; rhs++) {
-        auto lo_val = b->at(lo, rhs);
-        auto hi_val = b->at(hi, rhs);
-        x->at(lo, rhs) = lo_val + hi_val;
-        x->at(hi, rhs) = (lo_val - hi_val) * root;
-    }
-}
+/**
+ * Header of the transform plan stored in the buffer of an Fft object. It
+ * identifies the transform the twiddle factors following it were computed
+ * for, so they can be reused by subsequent applications.
+ */
+struct plan_header {
+    int64 value_size;
+    int64 sign;
+    std::array<int64, 3> sizes;
+    int64 padding[3];
+};
 
 
-template <typename ValueType>
-void bfly(matrix::Dense<ValueType>* x, int64 lo, int64 hi, ValueType root)
-{
-    for (size_type rhs = 0; rhs < x->get_size()[1]; rhs++) {
-        auto lo_val = x->at(lo, rhs);
-        auto hi_val = x->at(hi, rhs);
-        x->at(lo, rhs) = lo_val + hi_val;
-        x->at(hi, rhs) = (lo_val - hi_val) * root;
-    }
-}
+/**
+ * The maximal number of batched values (right-hand sides and entries along
+ * the other dimensions) that are transformed together.
+ */
+constexpr int64 max_chunk_size = 16;
 
 
-template <typename ValueType>
-void bit_rev_swap(matrix::Dense<ValueType>* x, int64 i, int64 rev_i)
+/**
+ * Returns the radices of the Stockham stages for a transform of the given
+ * size. Radix 4 is used as often as possible, followed by radix 2 and the odd
+ * prime factors. Large prime factors lead to a quadratic number of operations
+ * in their stage.
+ */
+vector<int64> factorize(std::shared_ptr<const DefaultExecutor> exec,
+                        int64 size)
 {
-    for (size_type rhs = 0; rhs < x->get_size()[1]; rhs++) {
-        if (i < rev_i) {
-            std::swap(x->at(i, rhs), x->at(rev_i, rhs));
+    vector<int64> radices(exec);
+    while (size % 4 == 0) {
+        radices.push_back(4);
+        size /= 4;
+    }
+    if (size % 2 == 0) {
+        radices.push_back(2);
+        size /= 2;
+    }
+    for (int64 p = 3; p * p <= size; p += 2) {
+        while (size % p == 0) {
+            radices.push_back(p);
+            size /= p;
         }
     }
+    if (size > 1) {
+        radices.push_back(size);
+    }
+    return radices;
 }
 
 
-int64 bit_rev(int64 i, int64 size)
+/**
+ * Returns the number of twiddle factors stored for a transform of the given
+ * size: each stage of radix p and remaining size n stores the n / p * (p - 1)
+ * twiddle factors and the p roots of unity of its DFT.
+ */
+int64 num_twiddles(std::shared_ptr<const DefaultExecutor> exec, int64 size)
 {
-    int64 rev{};
-    for (int64 fwd = 1, bwd = size / 2; fwd < size; fwd *= 2, bwd /= 2) {
-        rev |= ((i / fwd) & 1) * bwd;
+    int64 result{};
+    auto cur_size = size;
+    for (auto p : factorize(exec, size)) {
+        result += cur_size / p * (p - 1) + p;
+        cur_size /= p;
     }
-    return rev;
+    return result;
 }
 
 
 template <typename ValueType>
-vector<ValueType> build_unit_roots(std::shared_ptr<const DefaultExecutor> exec,
-                                   int64 size, int64 sign)
+std::complex<ValueType> twiddle(int64 n, int64 k)
 {
-    vector<ValueType> roots(size / 2, {exec});
-    for (int64 i = 0; i < size / 2; i++) {
-        roots[i] = unit_root<ValueType>(size, sign * i);
-    }
-    return roots;
+    // compute in double precision to keep the rounding errors small
+    return static_cast<std::complex<ValueType>>(
+        unit_root<std::complex<double>>(n, k % n));
 }
 
 
+/**
+ * Returns the twiddle factors for the given transform sizes, reusing the
+ * plan stored in the buffer if it belongs to the same transform.
+ */
 template <typename ValueType>
-void fft(std::shared_ptr<const DefaultExecutor> exec,
-         const matrix::Dense<std::complex<ValueType>>* b,
-         matrix::Dense<std::complex<ValueType>>* x, bool inverse,
-         array<char>& buffer)
+const std::complex<ValueType>* get_plan(
+    std::shared_ptr<const DefaultExecutor> exec, array<char>& buffer,
+    std::array<int64, 3> sizes, int64 sign)
 {
     using complex_type = std::complex<ValueType>;
-    using real_type = ValueType;
-    const int64 sign = inverse ? 1 : -1;
-    const auto nrhs = b->get_size()[1];
-    const auto size = static_cast<int64>(b->get_size()[0]);
-    GKO_ASSERT_IS_POWER_OF_TWO(size);
-    auto roots = build_unit_roots<complex_type>(exec, size, sign);
-    // first butterfly step
-    auto d = size / 2;
-#pragma omp parallel for
-    for (int64 k = 0; k < size / 2; k++) {
-        bfly(b, x, k, k + d, roots[k]);
-    }
-    // remaining butterfly steps
-    for (d = size / 4; d > 0; d /= 2) {
-        // square roots
-        for (int64 i = 0; i < d; i++) {
-            roots[i] = roots[2 * i];
+    const plan_header header{static_cast<int64>(sizeof(ValueType)),
+                             sign,
+                             sizes,
+                             {}};
+    const auto twiddles_begin = [&] {
+        return reinterpret_cast<complex_type*>(buffer.get_data() +
+                                               sizeof(plan_header));
+    };
+    if (buffer.get_size() >= sizeof(plan_header)) {
+        const auto stored =
+            reinterpret_cast<const plan_header*>(buffer.get_const_data());
+        if (stored->value_size == header.value_size &&
+            stored->sign == header.sign && stored->sizes == header.sizes) {
+            return twiddles_begin();
         }
-#pragma omp parallel for
-        for (int64 base = 0; base < size; base += d * 2) {
-            for (int64 k = base; k < base + d; k++) {
-                bfly(x, k, k + d, roots[k - base]);
+    }
+    int64 total{};
+    for (auto size : sizes) {
+        total += num_twiddles(exec, size);
+    }
+    buffer.resize_and_reset(sizeof(plan_header) + total * sizeof(complex_type));
+    *reinterpret_cast<plan_header*>(buffer.get_data()) = header;
+    auto twiddles = twiddles_begin();
+    for (auto size : sizes) {
+        auto cur_size = size;
+        for (auto p : factorize(exec, size)) {
+            const auto m = cur_size / p;
+            for (int64 q = 0; q < m; q++) {
+                for (int64 t = 1; t < p; t++) {
+                    *twiddles++ = twiddle<ValueType>(cur_size, sign * q * t);
+                }
+            }
+            for (int64 t = 0; t < p; t++) {
+                *twiddles++ = twiddle<ValueType>(p, sign * t);
             }
+            cur_size = m;
         }
     }
-// bit reversal
-#pragma omp parallel for
-    for (int64 k = 0; k < size; k++) {
-        bit_rev_swap(x, k, bit_rev(k, size));
-    }
+    return twiddles_begin();
 }
 
-GKO_INSTANTIATE_FOR_EACH_NON_COMPLEX_VALUE_TYPE(GKO_DECLARE_FFT_KERNEL);
-
 
+/**
+ * Computes one butterfly of a Stockham stage for chunk_size batched values:
+ * y[s_idx + s * (p * q + t)] = w^(q * t) * sum_r x[s_idx + s * (q + m * r)]
+ * omega^(r * t), where w is the size-th and omega the p-th root of unity.
+ */
 template <typename ValueType>
-void fft2(std::shared_ptr<const DefaultExecutor> exec,
-          const matrix::Dense<std::complex<ValueType>>* b,
-          matrix::Dense<std::complex<ValueType>>* x, size_type size1,
-          size_type size2, bool inverse, array<char>& buffer)
+void butterfly(int64 p, int64 m, int64 s, int64 q, int64 s_idx,
+               const ValueType* tw, const ValueType* omega, const ValueType* x,
+               ValueType* y, int64 chunk_size)
 {
-    using complex_type = std::complex<ValueType>;
-    using real_type = ValueType;
-    const int64 sign = inverse ? 1 : -1;
-    const auto nrhs = b->get_size()[1];
-    const auto ssize1 = static_cast<int64>(size1);
-    const auto ssize2 = static_cast<int64>(size2);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize1);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize2);
-    const auto idx = [&](int64 x, int64 y) { return x * ssize2 + y; };
-    auto roots1 = build_unit_roots<complex_type>(exec, ssize1, sign);
-    auto roots2 = build_unit_roots<complex_type>(exec, ssize2, sign);
-    // minor dimension first: size1 FFTs
-    // first butterfly step
-    auto d = ssize2 / 2;
-#pragma omp parallel for
-    for (int64 k1 = 0; k1 < ssize1; k1++) {
-        for (int64 k2 = 0; k2 < ssize2 / 2; k2++) {
-            bfly(b, x, idx(k1, k2), idx(k1, k2 + d), roots2[k2]);
+    const auto in = [&](int64 r) {
+        return x + (s_idx + s * (q + m * r)) * chunk_size;
+    };
+    const auto out = [&](int64 t) {
+        return y + (s_idx + s * (p * q + t)) * chunk_size;
+    };
+    const auto q_tw = tw + q * (p - 1);
+    if (p == 2) {
+        const auto x0 = in(0);
+        const auto x1 = in(1);
+        const auto y0 = out(0);
+        const auto y1 = out(1);
+        const auto w1 = q_tw[0];
+        for (int64 l = 0; l < chunk_size; l++) {
+            const auto a0 = x0[l];
+            const auto a1 = x1[l];
+            y0[l] = a0 + a1;
+            y1[l] = (a0 - a1) * w1;
         }
-    }
-    // remaining butterfly steps
-    for (d = ssize2 / 4; d > 0; d /= 2) {
-        // square roots
-        for (int64 i = 0; i < d; i++) {
-            roots2[i] = roots2[2 * i];
+    } else if (p == 4) {
+        const auto x0 = in(0);
+        const auto x1 = in(1);
+        const auto x2 = in(2);
+        const auto x3 = in(3);
+        const auto y0 = out(0);
+        const auto y1 = out(1);
+        const auto y2 = out(2);
+        const auto y3 = out(3);
+        const auto w1 = q_tw[0];
+        const auto w2 = q_tw[1];
+        const auto w3 = q_tw[2];
+        const auto omega1 = omega[1];
+        for (int64 l = 0; l < chunk_size; l++) {
+            const auto sum02 = x0[l] + x2[l];
+            const auto diff02 = x0[l] - x2[l];
+            const auto sum13 = x1[l] + x3[l];
+            const auto diff13 = omega1 * (x1[l] - x3[l]);
+            y0[l] = sum02 + sum13;
+            y1[l] = (diff02 + diff13) * w1;
+            y2[l] = (sum02 - sum13) * w2;
+            y3[l] = (diff02 - diff13) * w3;
         }
-#pragma omp parallel for
-        for (int64 k1 = 0; k1 < ssize1; k1++) {
-            for (int64 base = 0; base < ssize2; base += d * 2) {
-                for (int64 k2 = base; k2 < base + d; k2++) {
-                    bfly(x, idx(k1, k2), idx(k1, k2 + d), roots2[k2 - base]);
+    } else {
+        for (int64 t = 0; t < p; t++) {
+            const auto yt = out(t);
+            const auto wt = t == 0 ? one<ValueType>() : q_tw[t - 1];
+            for (int64 l = 0; l < chunk_size; l++) {
+                auto sum = zero<ValueType>();
+                for (int64 r = 0; r < p; r++) {
+                    sum += in(r)[l] * omega[(r * t) % p];
                 }
+                yt[l] = sum * wt;
             }
         }
     }
-    // then major dimension: 1 ssize2-wide FFT
-    // butterfly steps
-    for (d = ssize1 / 2; d > 0; d /= 2) {
-#pragma omp parallel for
-        for (int64 base = 0; base < ssize1; base += d * 2) {
-            for (int64 k1 = base; k1 < base + d; k1++) {
-                auto root = roots1[k1 - base];
-                for (int64 k2 = 0; k2 < ssize2; k2++) {
-                    bfly(x, idx(k1, k2), idx(k1 + d, k2), root);
+}
+
+
+/**
+ * Runs all Stockham stages of a transform of the given size on chunk_size
+ * batched values stored in x, using y as temporary storage. No bit reversal
+ * is necessary, since the Stockham algorithm keeps the output ordered.
+ * If parallel is true, this needs to be called by all threads of a parallel
+ * region, and every stage is distributed among them.
+ *
+ * @return  the pointer (x or y) containing the result
+ */
+template <typename ValueType>
+ValueType* run_stages(const vector<int64>& radices, int64 size,
+                      const ValueType* twiddles, ValueType* x, ValueType* y,
+                      int64 chunk_size, bool parallel)
+{
+    int64 cur_size = size;
+    int64 s = 1;
+    for (auto p : radices) {
+        const auto m = cur_size / p;
+        const auto omega = twiddles + m * (p - 1);
+        const auto num_butterflies = m * s;
+        if (parallel) {
+#pragma omp for
+            for (int64 i = 0; i < num_butterflies; i++) {
+                butterfly(p, m, s, i / s, i % s, twiddles, omega, x, y,
+                          chunk_size);
+            }
+        } else {
+            for (int64 q = 0; q < m; q++) {
+                for (int64 s_idx = 0; s_idx < s; s_idx++) {
+                    butterfly(p, m, s, q, s_idx, twiddles, omega, x, y,
+                              chunk_size);
                 }
             }
         }
-        // square roots
-        for (int64 i = 0; i < d / 2; i++) {
-            roots1[i] = roots1[2 * i];
-        }
-    }
-// bit reversal
-#pragma omp parallel for
-    for (int64 k1 = 0; k1 < ssize1; k1++) {
-        for (int64 k2 = 0; k2 < ssize2; k2++) {
-            bit_rev_swap(x, idx(k1, k2),
-                         idx(bit_rev(k1, ssize1), bit_rev(k2, ssize2)));
-        }
+        twiddles = omega + p;
+        std::swap(x, y);
+        cur_size = m;
+        s *= p;
     }
+    return x;
 }
 
-GKO_INSTANTIATE_FOR_EACH_NON_COMPLEX_VALUE_TYPE(GKO_DECLARE_FFT2_KERNEL);
+
+/**
+ * Describes the lines along one dimension of a multi-dimensional transform:
+ * The entry k of line (outer, b) is stored in row (outer * size + k) *
+ * inner + b / nrhs and column b % nrhs.
+ */
+struct line_layout {
+    int64 outer;
+    int64 size;
+    int64 inner;
+    int64 nrhs;
+
+    int64 batch() const { return inner * nrhs; }
+
+    size_type offset(int64 o, int64 k, int64 b, size_type stride) const
+    {
+        return ((o * size + k) * inner + b / nrhs) * stride + b % nrhs;
+    }
+};
 
 
+/**
+ * Transforms all lines along one dimension from in to out. The lines are
+ * split into tasks of up to max_chunk_size batched values, which are either
+ * distributed among the threads if there are enough of them, or processed
+ * one after the other with every stage distributed among the threads.
+ */
 template <typename ValueType>
-void fft3(std::shared_ptr<const DefaultExecutor> exec,
-          const matrix::Dense<std::complex<ValueType>>* b,
-          matrix::Dense<std::complex<ValueType>>* x, size_type size1,
-          size_type size2, size_type size3, bool inverse, array<char>& buffer)
+void transform_lines(std::shared_ptr<const DefaultExecutor> exec,
+                     const matrix::Dense<std::complex<ValueType>>* in,
+                     matrix::Dense<std::complex<ValueType>>* out,
+                     line_layout layout,
+                     const std::complex<ValueType>* twiddles)
 {
     using complex_type = std::complex<ValueType>;
-    using real_type = ValueType;
-    const int64 sign = inverse ? 1 : -1;
-    const auto nrhs = b->get_size()[1];
-    const auto ssize1 = static_cast<int64>(size1);
-    const auto ssize2 = static_cast<int64>(size2);
-    const auto ssize3 = static_cast<int64>(size3);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize1);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize2);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize3);
-    const auto idx = [&](int64 x, int64 y, int64 z) {
-        return x * ssize2 * ssize3 + y * ssize3 + z;
-    };
-    auto roots1 = build_unit_roots<complex_type>(exec, ssize1, sign);
-    auto roots2 = build_unit_roots<complex_type>(exec, ssize2, sign);
-    auto roots3 = build_unit_roots<complex_type>(exec, ssize3, sign);
-    // minor dimension first: size1*size2 FFTs
-    // first butterfly step
-    auto d = ssize3 / 2;
-#pragma omp parallel for
-    for (int64 k1 = 0; k1 < ssize1; k1++) {
-        for (int64 k2 = 0; k2 < ssize2; k2++) {
-            for (int64 k3 = 0; k3 < ssize3 / 2; k3++) {
-                bfly(b, x, idx(k1, k2, k3), idx(k1, k2, k3 + d), roots3[k3]);
-            }
-        }
-    }
-    // remaining butterfly steps
-    for (d = ssize3 / 4; d > 0; d /= 2) {
-        // square roots
-        for (int64 i = 0; i < d; i++) {
-            roots3[i] = roots3[2 * i];
-        }
-#pragma omp parallel for
-        for (int64 k1 = 0; k1 < ssize1; k1++) {
-            for (int64 k2 = 0; k2 < ssize2; k2++) {
-                for (int64 base = 0; base < ssize3; base += d * 2) {
-                    for (int64 k3 = base; k3 < base + d; k3++) {
-                        bfly(x, idx(k1, k2, k3), idx(k1, k2, k3 + d),
-                             roots3[k3 - base]);
+    const auto size = layout.size;
+    const auto batch = layout.batch();
+    if (size <= 1 || batch == 0 || layout.outer == 0) {
+        if (in != out) {
+            for (int64 o = 0; o < layout.outer; o++) {
+                for (int64 k = 0; k < size; k++) {
+                    for (int64 b = 0; b < batch; b++) {
+                        out->get_values()[layout.offset(
+                            o, k, b, out->get_stride())] =
+                            in->get_const_values()[layout.offset(
+                                o, k, b, in->get_stride())];
                     }
                 }
             }
         }
+        return;
     }
-    // then second dimension: 1 ssize1*ssize3-wide FFT
-    // butterfly steps
-    for (d = ssize2 / 2; d > 0; d /= 2) {
-#pragma omp parallel for
-        for (int64 base = 0; base < ssize2; base += d * 2) {
-            for (int64 k2 = base; k2 < base + d; k2++) {
-                auto root = roots2[k2 - base];
-                for (int64 k1 = 0; k1 < ssize1; k1++) {
-                    for (int64 k3 = 0; k3 < ssize3; k3++) {
-                        bfly(x, idx(k1, k2, k3), idx(k1, k2 + d, k3), root);
-                    }
-                }
-            }
+    const auto radices = factorize(exec, size);
+    const auto chunk_size = std::min(batch, max_chunk_size);
+    const auto chunks_per_line = ceildiv(batch, chunk_size);
+    const auto num_tasks = layout.outer * chunks_per_line;
+    const auto in_values = in->get_const_values();
+    const auto in_stride = in->get_stride();
+    const auto out_values = out->get_values();
+    const auto out_stride = out->get_stride();
+    const auto gather = [&](int64 task, int64 k, complex_type* work) {
+        const auto o = task / chunks_per_line;
+        const auto b_begin = task % chunks_per_line * chunk_size;
+        const auto b_end = std::min(b_begin + chunk_size, batch);
+        for (auto b = b_begin; b < b_end; b++) {
+            work[k * chunk_size + b - b_begin] =
+                in_values[layout.offset(o, k, b, in_stride)];
         }
-        // square roots
-        for (int64 i = 0; i < d / 2; i++) {
-            roots2[i] = roots2[2 * i];
+        // pad the last chunk with zeros
+        for (auto b = b_end; b < b_begin + chunk_size; b++) {
+            work[k * chunk_size + b - b_begin] = zero<complex_type>();
         }
-    }
-    // then major dimension: 1 ssize2*ssize3-wide FFT
-    // butterfly steps
-    for (d = ssize1 / 2; d > 0; d /= 2) {
-#pragma omp parallel for
-        for (int64 base = 0; base < ssize1; base += d * 2) {
-            for (int64 k1 = base; k1 < base + d; k1++) {
-                auto root = roots1[k1 - base];
-                for (int64 k2 = 0; k2 < ssize2; k2++) {
-                    for (int64 k3 = 0; k3 < ssize3; k3++) {
-                        bfly(x, idx(k1, k2, k3), idx(k1 + d, k2, k3), root);
-                    }
+    };
+    const auto scatter = [&](int64 task, int64 k, const complex_type* work) {
+        const auto o = task / chunks_per_line;
+        const auto b_begin = task % chunks_per_line * chunk_size;
+        const auto b_end = std::min(b_begin + chunk_size, batch);
+        for (auto b = b_begin; b < b_end; b++) {
+            out_values[layout.offset(o, k, b, out_stride)] =
+                work[k * chunk_size + b - b_begin];
+        }
+    };
+    if (num_tasks >= omp_get_max_threads()) {
+#pragma omp parallel
+        {
+            vector<complex_type> x(size * chunk_size, {exec});
+            vector<complex_type> y(size * chunk_size, {exec});
+#pragma omp for
+            for (int64 task = 0; task < num_tasks; task++) {
+                for (int64 k = 0; k < size; k++) {
+                    gather(task, k, x.data());
+                }
+                const auto result = run_stages(radices, size, twiddles,
+                                               x.data(), y.data(), chunk_size,
+                                               false);
+                for (int64 k = 0; k < size; k++) {
+                    scatter(task, k, result);
                 }
             }
         }
-        // square roots
-        for (int64 i = 0; i < d / 2; i++) {
-            roots1[i] = roots1[2 * i];
+    } else {
+        vector<complex_type> x(size * chunk_size, {exec});
+        vector<complex_type> y(size * chunk_size, {exec});
+#pragma omp parallel
+        for (int64 task = 0; task < num_tasks; task++) {
+#pragma omp for
+            for (int64 k = 0; k < size; k++) {
+                gather(task, k, x.data());
+            }
+            const auto result = run_stages(radices, size, twiddles, x.data(),
+                                           y.data(), chunk_size, true);
+#pragma omp for
+            for (int64 k = 0; k < size; k++) {
+                scatter(task, k, result);
+            }
         }
     }
-// bit reversal
-#pragma omp parallel for
-    for (int64 k1 = 0; k1 < ssize1; k1++) {
-        for (int64 k2 = 0; k2 < ssize2; k2++) {
-            for (int64 k3 = 0; k3 < ssize3; k3++) {
-                bit_rev_swap(x, idx(k1, k2, k3),
-                             idx(bit_rev(k1, ssize1), bit_rev(k2, ssize2),
-                                 bit_rev(k3, ssize3)));
-            }
+}
+
+
+/**
+ * Computes the (inverse) DFT along all dimensions of a row-major
+ * size1 x size2 x size3 array.
+ */
+template <typename ValueType>
+void fft_nd(std::shared_ptr<const DefaultExecutor> exec,
+            const matrix::Dense<std::complex<ValueType>>* b,
+            matrix::Dense<std::complex<ValueType>>* x,
+            std::array<int64, 3> sizes, bool inverse, array<char>& buffer)
+{
+    const int64 sign = inverse ? 1 : -1;
+    const auto nrhs = static_cast<int64>(b->get_size()[1]);
+    if (b->get_size()[0] == 0 || nrhs == 0) {
+        return;
+    }
+    auto twiddles = get_plan<ValueType>(exec, buffer, sizes, sign);
+    // the minor dimension reads from b, all others work in-place on x
+    const matrix::Dense<std::complex<ValueType>>* in = b;
+    for (int dim = 2; dim >= 0; dim--) {
+        int64 outer = 1;
+        int64 inner = 1;
+        for (int i = 0; i < dim; i++) {
+            outer *= sizes[i];
+        }
+        for (int i = dim + 1; i < 3; i++) {
+            inner *= sizes[i];
+        }
+        const line_layout layout{outer, sizes[dim], inner, nrhs};
+        // the twiddles of each dimension are stored after the previous ones
+        auto dim_twiddles = twiddles;
+        for (int i = 0; i < dim; i++) {
+            dim_twiddles += num_twiddles(exec, sizes[i]);
         }
+        transform_lines(exec, in, x, layout, dim_twiddles);
+        in = x;
     }
 }
 
+
+}  // namespace
+
+
+template <typename ValueType>
+void fft(std::shared_ptr<const DefaultExecutor> exec,
+         const matrix::Dense<std::complex<ValueType>>* b,
+         matrix::Dense<std::complex<ValueType>>* x, bool inverse,
+         array<char>& buffer)
+{
+    const auto size = static_cast<int64>(b->get_size()[0]);
+    fft_nd(exec, b, x, {1, 1, size}, inverse, buffer);
+}
+
+GKO_INSTANTIATE_FOR_EACH_NON_COMPLEX_VALUE_TYPE(GKO_DECLARE_FFT_KERNEL);
+
+
+template <typename ValueType>
+void fft2(std::shared_ptr<const DefaultExecutor> exec,
+          const matrix::Dense<std::complex<ValueType>>* b,
+          matrix::Dense<std::complex<ValueType>>* x, size_type size1,
+          size_type size2, bool inverse, array<char>& buffer)
+{
+    fft_nd(exec, b, x,
+           {1, static_cast<int64>(size1), static_cast<int64>(size2)}, inverse,
+           buffer);
+}
+
+GKO_INSTANTIATE_FOR_EACH_NON_COMPLEX_VALUE_TYPE(GKO_DECLARE_FFT2_KERNEL);
+
+
+template <typename ValueType>
+void fft3(std::shared_ptr<const DefaultExecutor> exec,
+          const matrix::Dense<std::complex<ValueType>>* b,
+          matrix::Dense<std::complex<ValueType>>* x, size_type size1,
+          size_type size2, size_type size3, bool inverse, array<char>& buffer)
+{
+    fft_nd(exec, b, x,
+           {static_cast<int64>(size1), static_cast<int64>(size2),
+            static_cast<int64>(size3)},
+           inverse, buffer);
+}
+
 GKO_INSTANTIATE_FOR_EACH_NON_COMPLEX_VALUE_TYPE(GKO_DECLARE_FFT3_KERNEL);
 
 
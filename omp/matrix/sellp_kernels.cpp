@@ -5,6 +5,7 @@
 #include "core/matrix/sellp_kernels.hpp"
 
 
+#include <algorithm>
 #include <array>
 
 
@@ -25,47 +26,69 @@ namespace omp {
 namespace sellp {
 
 
-template <int num_rhs, typename ValueType, typename IndexType, typename OutFn>
-void spmv_small_rhs(std::shared_ptr<const OmpExecutor> exec,
-                    const matrix::Sellp<ValueType, IndexType>* a,
-                    const matrix::Dense<ValueType>* b,
-                    matrix::Dense<ValueType>* c, OutFn out)
+/**
+ * Number of rows of a slice that are processed together in a SIMD loop.
+ * The accumulators of one chunk are kept in registers across the whole slice.
+ */
+constexpr size_type simd_chunk_size = 8;
+
+
+/**
+ * Computes the rows of a single SIMD chunk of a slice for the right-hand
+ * sides [rhs_begin, rhs_begin + num_rhs), storing `out(row, rhs, value)` in c.
+ * Padding entries are masked out instead of branched over, so the innermost
+ * loop over the rows of the chunk can be vectorized.
+ */
+template <int max_rhs, typename ValueType, typename IndexType, typename OutFn>
+void spmv_chunk(const matrix::Sellp<ValueType, IndexType>* a,
+                const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c,
+                size_type slice, size_type chunk_begin, size_type chunk_rows,
+                size_type rhs_begin, size_type num_rhs, OutFn out)
 {
-    GKO_ASSERT(b->get_size()[1] == num_rhs);
-    auto slice_lengths = a->get_const_slice_lengths();
-    auto slice_sets = a->get_const_slice_sets();
-    auto slice_size = a->get_slice_size();
-    auto slice_num = ceildiv(a->get_size()[0] + slice_size - 1, slice_size);
-#pragma omp parallel for collapse(2)
-    for (size_type slice = 0; slice < slice_num; slice++) {
-        for (size_type row = 0; row < slice_size; row++) {
-            size_type global_row = slice * slice_size + row;
-            if (global_row < a->get_size()[0]) {
-                std::array<ValueType, num_rhs> partial_sum;
-                partial_sum.fill(zero<ValueType>());
-                for (size_type i = 0; i < slice_lengths[slice]; i++) {
-                    auto val = a->val_at(row, slice_sets[slice], i);
-                    auto col = a->col_at(row, slice_sets[slice], i);
-                    if (col != invalid_index<IndexType>()) {
-#pragma unroll
-                        for (size_type j = 0; j < num_rhs; j++) {
-                            partial_sum[j] += val * b->at(col, j);
-                        }
-                    }
-                }
+    const auto values = a->get_const_values();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto slice_size = a->get_slice_size();
+    const auto slice_set = a->get_const_slice_sets()[slice];
+    const auto slice_length = a->get_const_slice_lengths()[slice];
+    const auto b_vals = b->get_const_values() + rhs_begin;
+    const auto b_stride = b->get_stride();
+    std::array<std::array<ValueType, simd_chunk_size>, max_rhs> partial_sum;
+    for (auto& sum : partial_sum) {
+        sum.fill(zero<ValueType>());
+    }
+    for (size_type i = 0; i < slice_length; i++) {
+        const auto base = (slice_set + i) * slice_size + chunk_begin;
+#pragma omp simd
+        for (size_type row = 0; row < chunk_rows; row++) {
+            const auto col = col_idxs[base + row];
+            const auto valid = col != invalid_index<IndexType>();
+            const auto val = valid ? values[base + row] : zero<ValueType>();
+            const auto b_row = b_vals + (valid ? col : 0) * b_stride;
 #pragma unroll
-                for (size_type j = 0; j < num_rhs; j++) {
-                    [&] {
-                        c->at(global_row, j) =
-                            out(global_row, j, partial_sum[j]);
-                    }();
+            for (size_type j = 0; j < max_rhs; j++) {
+                if (j < num_rhs) {
+                    partial_sum[j][row] += val * b_row[j];
                 }
             }
         }
     }
+    const auto row_begin = slice * slice_size + chunk_begin;
+    for (size_type row = 0; row < chunk_rows; row++) {
+        for (size_type j = 0; j < num_rhs; j++) {
+            [&] {
+                c->at(row_begin + row, rhs_begin + j) =
+                    out(row_begin + row, rhs_begin + j, partial_sum[j][row]);
+            }();
+        }
+    }
 }
 
 
+/**
+ * Iterates over all SIMD chunks of all slices in parallel, with each thread
+ * owning whole slices to keep the accesses to the slice storage contiguous.
+ * The right-hand sides are processed in blocks of `block_size` columns.
+ */
 template <int block_size, typename ValueType, typename IndexType,
           typename OutFn>
 void spmv_blocked(std::shared_ptr<const OmpExecutor> exec,
@@ -73,62 +96,39 @@ void spmv_blocked(std::shared_ptr<const OmpExecutor> exec,
                   const matrix::Dense<ValueType>* b,
                   matrix::Dense<ValueType>* c, OutFn out)
 {
-    auto slice_lengths = a->get_const_slice_lengths();
-    auto slice_sets = a->get_const_slice_sets();
-    auto slice_size = a->get_slice_size();
-    auto slice_num = ceildiv(a->get_size()[0] + slice_size - 1, slice_size);
+    const auto num_rows = a->get_size()[0];
+    const auto slice_size = a->get_slice_size();
+    const auto slice_num = ceildiv(num_rows, slice_size);
     const auto num_rhs = b->get_size()[1];
-    const auto rounded_rhs = num_rhs / block_size * block_size;
-#pragma omp parallel for collapse(2)
+#pragma omp parallel for schedule(dynamic, 4)
     for (size_type slice = 0; slice < slice_num; slice++) {
-        for (size_type row = 0; row < slice_size; row++) {
-            size_type global_row = slice * slice_size + row;
-            if (global_row < a->get_size()[0]) {
-                std::array<ValueType, block_size> partial_sum;
-                for (size_type rhs_base = 0; rhs_base < rounded_rhs;
-                     rhs_base += block_size) {
-                    partial_sum.fill(zero<ValueType>());
-                    for (size_type i = 0; i < slice_lengths[slice]; i++) {
-                        auto val = a->val_at(row, slice_sets[slice], i);
-                        auto col = a->col_at(row, slice_sets[slice], i);
-                        if (col != invalid_index<IndexType>()) {
-#pragma unroll
-                            for (size_type j = 0; j < block_size; j++) {
-                                partial_sum[j] +=
-                                    val * b->at(col, j + rhs_base);
-                            }
-                        }
-                    }
-#pragma unroll
-                    for (size_type j = 0; j < block_size; j++) {
-                        [&] {
-                            c->at(global_row, j + rhs_base) =
-                                out(global_row, j + rhs_base, partial_sum[j]);
-                        }();
-                    }
-                }
-                partial_sum.fill(zero<ValueType>());
-                for (size_type i = 0; i < slice_lengths[slice]; i++) {
-                    auto val = a->val_at(row, slice_sets[slice], i);
-                    auto col = a->col_at(row, slice_sets[slice], i);
-                    if (col != invalid_index<IndexType>()) {
-                        for (size_type j = rounded_rhs; j < num_rhs; j++) {
-                            partial_sum[j - rounded_rhs] += val * b->at(col, j);
-                        }
-                    }
-                }
-                for (size_type j = rounded_rhs; j < num_rhs; j++) {
-                    [&] {
-                        c->at(global_row, j) =
-                            out(global_row, j, partial_sum[j - rounded_rhs]);
-                    }();
-                }
+        const auto slice_rows =
+            std::min(slice_size, num_rows - slice * slice_size);
+        for (size_type chunk = 0; chunk < slice_rows;
+             chunk += simd_chunk_size) {
+            const auto chunk_rows =
+                std::min(simd_chunk_size, slice_rows - chunk);
+            for (size_type rhs = 0; rhs < num_rhs; rhs += block_size) {
+                spmv_chunk<block_size>(
+                    a, b, c, slice, chunk, chunk_rows, rhs,
+                    std::min<size_type>(block_size, num_rhs - rhs), out);
             }
         }
     }
 }
 
 
+template <int num_rhs, typename ValueType, typename IndexType, typename OutFn>
+void spmv_small_rhs(std::shared_ptr<const OmpExecutor> exec,
+                    const matrix::Sellp<ValueType, IndexType>* a,
+                    const matrix::Dense<ValueType>* b,
+                    matrix::Dense<ValueType>* c, OutFn out)
+{
+    GKO_ASSERT(b->get_size()[1] == num_rhs);
+    spmv_blocked<num_rhs>(exec, a, b, c, out);
+}
+
+
 template <typename ValueType, typename IndexType>
 void spmv(std::shared_ptr<const OmpExecutor> exec,
           const matrix::Sellp<ValueType, IndexType>* a,
@@ -5,19 +5,22 @@
 #include "core/multigrid/pgm_kernels.hpp"
 
 
-#include <algorithm>
+#include <functional>
 #include <memory>
+#include <utility>
 
 
 #include <omp.h>
 
 
+#include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
 #include <ginkgo/core/multigrid/pgm.hpp>
 
 
-#include "core/base/iterator_factory.hpp"
+#include "omp/components/parallel_sort.hpp"
 
 
 namespace gko {
@@ -35,8 +38,19 @@ template <typename IndexType>
 void sort_agg(std::shared_ptr<const DefaultExecutor> exec, IndexType num,
               IndexType* row_idxs, IndexType* col_idxs)
 {
-    auto it = detail::make_zip_iterator(row_idxs, col_idxs);
-    std::sort(it, it + num);
+    array<std::pair<IndexType, IndexType>> tmp{exec,
+                                               static_cast<size_type>(num)};
+    auto entries = tmp.get_data();
+#pragma omp parallel for
+    for (IndexType i = 0; i < num; i++) {
+        entries[i] = std::make_pair(row_idxs[i], col_idxs[i]);
+    }
+    parallel_sort(exec, entries, tmp.get_size());
+#pragma omp parallel for
+    for (IndexType i = 0; i < num; i++) {
+        row_idxs[i] = entries[i].first;
+        col_idxs[i] = entries[i].second;
+    }
 }
 
 GKO_INSTANTIATE_FOR_EACH_INDEX_TYPE(GKO_DECLARE_PGM_SORT_AGG_KERNEL);
@@ -46,11 +60,20 @@ template <typename ValueType, typename IndexType>
 void sort_row_major(std::shared_ptr<const DefaultExecutor> exec, size_type nnz,
                     IndexType* row_idxs, IndexType* col_idxs, ValueType* vals)
 {
-    auto it = detail::make_zip_iterator(row_idxs, col_idxs, vals);
-    std::stable_sort(it, it + nnz, [](auto a, auto b) {
-        return std::tie(std::get<0>(a), std::get<1>(a)) <
-               std::tie(std::get<0>(b), std::get<1>(b));
-    });
+    array<matrix_data_entry<ValueType, IndexType>> tmp{exec, nnz};
+    auto entries = tmp.get_data();
+#pragma omp parallel for
+    for (size_type i = 0; i < nnz; i++) {
+        entries[i] = {row_idxs[i], col_idxs[i], vals[i]};
+    }
+    // matrix_data_entry only compares row and column index
+    parallel_stable_sort(exec, entries, nnz, std::less<>{});
+#pragma omp parallel for
+    for (size_type i = 0; i < nnz; i++) {
+        row_idxs[i] = entries[i].row;
+        col_idxs[i] = entries[i].column;
+        vals[i] = entries[i].value;
+    }
 }
 
 GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(GKO_DECLARE_PGM_SORT_ROW_MAJOR);
@@ -0,0 +1,179 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "core/solver/cg_kernels.hpp"
+
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
+#include <omp.h>
+
+
+#include <ginkgo/core/base/array.hpp>
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/base/types.hpp>
+
+
+namespace gko {
+namespace kernels {
+namespace omp {
+/**
+ * @brief The CG solver namespace.
+ *
+ * @ingroup cg
+ */
+namespace cg {
+
+
+template <typename ValueType, typename IndexType>
+void persistent_solve(
+    std::shared_ptr<const DefaultExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* a, matrix::Dense<ValueType>* x,
+    matrix::Dense<ValueType>* r, matrix::Dense<ValueType>* p,
+    matrix::Dense<ValueType>* q,
+    const matrix::Dense<remove_complex<ValueType>>* thresholds,
+    size_type max_iters, uint8 stopping_id, array<stopping_status>* stop_status,
+    size_type* num_iterations)
+{
+    const auto num_rows = x->get_size()[0];
+    const auto num_rhs = x->get_size()[1];
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    const auto max_threads = static_cast<size_type>(omp_get_max_threads());
+    // every thread writes its partial dot products, which are then summed up
+    // redundantly by all threads to avoid an additional barrier
+    array<ValueType> partial_rho{exec, max_threads * num_rhs};
+    array<ValueType> partial_beta{exec, max_threads * num_rhs};
+    const auto partial_rho_data = partial_rho.get_data();
+    const auto partial_beta_data = partial_beta.get_data();
+    size_type last_iter{};
+    // The whole iteration runs inside a single parallel region, with one
+    // barrier after each phase that reads data written by other threads:
+    // the rho reduction, the SpMV reading all of p and the beta reduction.
+#pragma omp parallel
+    {
+        const auto num_threads = static_cast<size_type>(omp_get_num_threads());
+        const auto tid = static_cast<size_type>(omp_get_thread_num());
+        // balance the rows by their number of nonzeros plus the vector work
+        const auto total_work =
+            num_rows + static_cast<size_type>(row_ptrs[num_rows]);
+        const auto split = [&](size_type thread) {
+            const auto target = total_work * thread / num_threads;
+            size_type lo{};
+            auto hi = num_rows;
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+                if (mid + static_cast<size_type>(row_ptrs[mid]) < target) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo;
+        };
+        const auto row_begin = split(tid);
+        const auto row_end = tid + 1 == num_threads ? num_rows : split(tid + 1);
+        std::vector<stopping_status> status(
+            stop_status->get_const_data(),
+            stop_status->get_const_data() + num_rhs);
+        std::vector<ValueType> local(num_rhs);
+        std::vector<ValueType> rho(num_rhs);
+        std::vector<ValueType> prev_rho(num_rhs, one<ValueType>());
+        std::vector<ValueType> beta(num_rhs);
+        const auto reduce = [&](const ValueType* partial,
+                                std::vector<ValueType>& result) {
+            std::fill(result.begin(), result.end(), zero<ValueType>());
+            for (size_type thread = 0; thread < num_threads; ++thread) {
+                for (size_type j = 0; j < num_rhs; ++j) {
+                    result[j] += partial[thread * num_rhs + j];
+                }
+            }
+        };
+        size_type iter = 0;
+        while (true) {
+            // rho = dot(r, r)
+            std::fill(local.begin(), local.end(), zero<ValueType>());
+            for (auto i = row_begin; i < row_end; ++i) {
+                for (size_type j = 0; j < num_rhs; ++j) {
+                    local[j] += conj(r->at(i, j)) * r->at(i, j);
+                }
+            }
+            std::copy(local.begin(), local.end(),
+                      partial_rho_data + tid * num_rhs);
+#pragma omp barrier
+            reduce(partial_rho_data, rho);
+            bool all_stopped = true;
+            for (size_type j = 0; j < num_rhs; ++j) {
+                if (sqrt(abs(rho[j])) <= thresholds->at(0, j)) {
+                    status[j].converge(stopping_id, true);
+                } else if (iter >= max_iters) {
+                    status[j].stop(stopping_id, true);
+                }
+                all_stopped = all_stopped && status[j].has_stopped();
+            }
+            if (all_stopped) {
+                break;
+            }
+            // p = r + rho / prev_rho * p
+            for (auto i = row_begin; i < row_end; ++i) {
+                for (size_type j = 0; j < num_rhs; ++j) {
+                    if (!status[j].has_stopped()) {
+                        const auto tmp = safe_divide(rho[j], prev_rho[j]);
+                        p->at(i, j) = r->at(i, j) + tmp * p->at(i, j);
+                    }
+                }
+            }
+#pragma omp barrier
+            // q = A * p
+            // beta = dot(p, q)
+            std::fill(local.begin(), local.end(), zero<ValueType>());
+            for (auto row = row_begin; row < row_end; ++row) {
+                for (size_type j = 0; j < num_rhs; ++j) {
+                    auto sum = zero<ValueType>();
+                    for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1];
+                         ++nz) {
+                        sum += vals[nz] * p->at(col_idxs[nz], j);
+                    }
+                    q->at(row, j) = sum;
+                    local[j] += conj(p->at(row, j)) * sum;
+                }
+            }
+            std::copy(local.begin(), local.end(),
+                      partial_beta_data + tid * num_rhs);
+#pragma omp barrier
+            reduce(partial_beta_data, beta);
+            // x = x + rho / beta * p
+            // r = r - rho / beta * q
+            for (auto i = row_begin; i < row_end; ++i) {
+                for (size_type j = 0; j < num_rhs; ++j) {
+                    if (!status[j].has_stopped()) {
+                        const auto tmp = safe_divide(rho[j], beta[j]);
+                        x->at(i, j) += tmp * p->at(i, j);
+                        r->at(i, j) -= tmp * q->at(i, j);
+                    }
+                }
+            }
+            std::swap(prev_rho, rho);
+            ++iter;
+        }
+        if (tid == 0) {
+            std::copy(status.begin(), status.end(), stop_status->get_data());
+            last_iter = iter;
+        }
+    }
+    *num_iterations = last_iter;
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CG_PERSISTENT_SOLVE_KERNEL);
+
+
+}  // namespace cg
+}  // namespace omp
+}  // namespace kernels
+}  // namespace gko
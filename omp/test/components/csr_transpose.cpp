@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "omp/components/csr_transpose.hpp"
+
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class CsrTranspose : public ::testing::Test {
+protected:
+    using index_type = gko::int32;
+
+    CsrTranspose() : omp(gko::OmpExecutor::create()), rng{4519} {}
+
+    // creates a random sorted CSR pattern with up to max_row_nnz per row
+    void create_random_pattern(gko::size_type num_rows, gko::size_type num_cols,
+                               index_type max_row_nnz)
+    {
+        std::uniform_int_distribution<index_type> nnz_dist(0, max_row_nnz);
+        std::uniform_int_distribution<index_type> col_dist(
+            0, static_cast<index_type>(num_cols) - 1);
+        rows = num_rows;
+        cols = num_cols;
+        row_ptrs.assign(1, 0);
+        col_idxs.clear();
+        for (gko::size_type row = 0; row < num_rows; row++) {
+            std::vector<index_type> row_cols(nnz_dist(rng));
+            for (auto& col : row_cols) {
+                col = col_dist(rng);
+            }
+            std::sort(row_cols.begin(), row_cols.end());
+            row_cols.erase(std::unique(row_cols.begin(), row_cols.end()),
+                           row_cols.end());
+            col_idxs.insert(col_idxs.end(), row_cols.begin(), row_cols.end());
+            row_ptrs.push_back(static_cast<index_type>(col_idxs.size()));
+        }
+    }
+
+    // checks the result of transpose_pattern against a sequential transpose,
+    // using the input positions as values
+    void assert_transpose_matches()
+    {
+        std::vector<std::tuple<index_type, index_type, index_type>> entries;
+        for (gko::size_type row = 0; row < rows; row++) {
+            for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; nz++) {
+                entries.emplace_back(col_idxs[nz], row, nz);
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        std::vector<index_type> expected_row_ptrs(cols + 1);
+        for (const auto& entry : entries) {
+            expected_row_ptrs[std::get<0>(entry) + 1]++;
+        }
+        std::partial_sum(expected_row_ptrs.begin(), expected_row_ptrs.end(),
+                         expected_row_ptrs.begin());
+        std::vector<index_type> out_row_ptrs(cols + 1);
+        std::vector<index_type> out_col_idxs(col_idxs.size());
+        std::vector<index_type> out_positions(col_idxs.size(), -1);
+
+        gko::kernels::omp::transpose_pattern(
+            omp, rows, cols, row_ptrs.data(), col_idxs.data(),
+            out_row_ptrs.data(), out_col_idxs.data(),
+            [&](index_type nz, index_type out_nz) {
+                out_positions[out_nz] = nz;
+            });
+
+        ASSERT_EQ(out_row_ptrs, expected_row_ptrs);
+        for (gko::size_type i = 0; i < entries.size(); i++) {
+            ASSERT_EQ(out_col_idxs[i], std::get<1>(entries[i]));
+            ASSERT_EQ(out_positions[i], std::get<2>(entries[i]));
+        }
+    }
+
+    std::shared_ptr<gko::OmpExecutor> omp;
+    std::default_random_engine rng;
+    gko::size_type rows;
+    gko::size_type cols;
+    std::vector<index_type> row_ptrs;
+    std::vector<index_type> col_idxs;
+};
+
+
+TEST_F(CsrTranspose, TransposesEmpty)
+{
+    create_random_pattern(10, 10, 0);
+
+    assert_transpose_matches();
+}
+
+
+TEST_F(CsrTranspose, TransposesSmall)
+{
+    create_random_pattern(100, 50, 10);
+
+    assert_transpose_matches();
+}
+
+
+TEST_F(CsrTranspose, TransposesLarge)
+{
+    create_random_pattern(20000, 3000, 20);
+
+    assert_transpose_matches();
+}
+
+
+TEST_F(CsrTranspose, TransposesLargeWide)
+{
+    create_random_pattern(2000, 200000, 40);
+
+    assert_transpose_matches();
+}
+
+
+TEST_F(CsrTranspose, TransposesLargeWithEmptyRows)
+{
+    create_random_pattern(50000, 100, 2);
+
+    assert_transpose_matches();
+}
+
+
+}  // namespace
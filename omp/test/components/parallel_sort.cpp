@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "omp/components/parallel_sort.hpp"
+
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/executor.hpp>
+
+
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+class ParallelSort : public ::testing::Test {
+protected:
+    using value_type = gko::int64;
+    using pair_type = std::pair<gko::int32, gko::int32>;
+
+    ParallelSort() : omp(gko::OmpExecutor::create()), rng{2913} {}
+
+    std::vector<value_type> create_random_values(gko::size_type size)
+    {
+        std::uniform_int_distribution<value_type> dist(-1000, 1000);
+        std::vector<value_type> values(size);
+        for (auto& value : values) {
+            value = dist(rng);
+        }
+        return values;
+    }
+
+    std::shared_ptr<gko::OmpExecutor> omp;
+    std::default_random_engine rng;
+};
+
+
+TEST_F(ParallelSort, SortsEmpty)
+{
+    std::vector<value_type> values;
+
+    gko::kernels::omp::parallel_sort(omp, values.data(), values.size());
+
+    ASSERT_TRUE(values.empty());
+}
+
+
+TEST_F(ParallelSort, SortsSmallLikeStdSort)
+{
+    auto values = create_random_values(100);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    gko::kernels::omp::parallel_sort(omp, values.data(), values.size());
+
+    ASSERT_EQ(values, expected);
+}
+
+
+TEST_F(ParallelSort, SortsLargeLikeStdSort)
+{
+    auto values = create_random_values(123457);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+
+    gko::kernels::omp::parallel_sort(omp, values.data(), values.size());
+
+    ASSERT_EQ(values, expected);
+}
+
+
+TEST_F(ParallelSort, SortsLargeWithComparator)
+{
+    auto values = create_random_values(123457);
+    auto expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<value_type>{});
+
+    gko::kernels::omp::parallel_sort(omp, values.data(), values.size(),
+                                     std::greater<value_type>{});
+
+    ASSERT_EQ(values, expected);
+}
+
+
+TEST_F(ParallelSort, StableSortsLargeLikeStdStableSort)
+{
+    std::uniform_int_distribution<gko::int32> dist(0, 100);
+    std::vector<pair_type> values(123457);
+    for (gko::size_type i = 0; i < values.size(); i++) {
+        values[i] = {dist(rng), static_cast<gko::int32>(i)};
+    }
+    auto expected = values;
+    const auto comp = [](pair_type a, pair_type b) {
+        return a.first < b.first;
+    };
+    std::stable_sort(expected.begin(), expected.end(), comp);
+
+    gko::kernels::omp::parallel_stable_sort(omp, values.data(), values.size(),
+                                            comp);
+
+    ASSERT_EQ(values, expected);
+}
+
+
+}  // namespace
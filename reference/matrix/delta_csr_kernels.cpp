@@ -0,0 +1,202 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "core/matrix/delta_csr_kernels.hpp"
+
+
+#include <algorithm>
+
+
+#include <ginkgo/core/base/math.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/delta_csr_encoding.hpp"
+
+
+namespace gko {
+namespace kernels {
+namespace reference {
+/**
+ * @brief The DeltaCsr matrix format namespace.
+ * @ref DeltaCsr
+ * @ingroup delta_csr
+ */
+namespace delta_csr {
+
+
+using matrix::delta_csr::dispatch_delta_width;
+using matrix::delta_csr::load_delta;
+using matrix::delta_csr::row_delta_width;
+using matrix::delta_csr::store_delta;
+
+
+template <typename ValueType, typename IndexType, typename OutFn>
+void spmv_impl(const matrix::DeltaCsr<ValueType, IndexType>* a,
+               const matrix::Dense<ValueType>* b, OutFn out)
+{
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto row_bases = a->get_const_row_bases();
+    const auto delta_ptrs = a->get_const_delta_ptrs();
+    const auto deltas = a->get_const_deltas();
+    const auto vals = a->get_const_values();
+    for (size_type row = 0; row < a->get_size()[0]; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto nnz = row_ptrs[row + 1] - begin;
+        const auto width =
+            row_delta_width(delta_ptrs[row], delta_ptrs[row + 1], nnz);
+        const auto row_deltas = deltas + delta_ptrs[row];
+        const auto base = row_bases[row];
+        for (size_type j = 0; j < b->get_size()[1]; ++j) {
+            auto sum = zero<ValueType>();
+            dispatch_delta_width(width, [&](auto delta_type) {
+                using delta_type_t = decltype(delta_type);
+                for (IndexType k = 0; k < nnz; ++k) {
+                    const auto col =
+                        base + static_cast<IndexType>(
+                                   load_delta<delta_type_t>(row_deltas, k));
+                    sum += vals[begin + k] * b->at(col, j);
+                }
+            });
+            out(row, j, sum);
+        }
+    }
+}
+
+
+template <typename ValueType, typename IndexType>
+void spmv(std::shared_ptr<const ReferenceExecutor> exec,
+          const matrix::DeltaCsr<ValueType, IndexType>* a,
+          const matrix::Dense<ValueType>* b, matrix::Dense<ValueType>* c)
+{
+    spmv_impl(a, b,
+              [c](size_type row, size_type col, ValueType value) {
+                  c->at(row, col) = value;
+              });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void advanced_spmv(std::shared_ptr<const ReferenceExecutor> exec,
+                   const matrix::Dense<ValueType>* alpha,
+                   const matrix::DeltaCsr<ValueType, IndexType>* a,
+                   const matrix::Dense<ValueType>* b,
+                   const matrix::Dense<ValueType>* beta,
+                   matrix::Dense<ValueType>* c)
+{
+    const auto valpha = alpha->at(0, 0);
+    const auto vbeta = beta->at(0, 0);
+    spmv_impl(a, b, [&](size_type row, size_type col, ValueType value) {
+        c->at(row, col) = vbeta * c->at(row, col) + valpha * value;
+    });
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_ADVANCED_SPMV_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void compute_delta_sizes(std::shared_ptr<const ReferenceExecutor> exec,
+                         const matrix::Csr<ValueType, IndexType>* source,
+                         IndexType* row_bases, int64* delta_sizes)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    for (size_type row = 0; row < source->get_size()[0]; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto end = row_ptrs[row + 1];
+        if (begin == end) {
+            row_bases[row] = 0;
+            delta_sizes[row] = 0;
+            continue;
+        }
+        const auto minmax =
+            std::minmax_element(col_idxs + begin, col_idxs + end);
+        row_bases[row] = *minmax.first;
+        delta_sizes[row] =
+            static_cast<int64>(end - begin) *
+            matrix::delta_csr::delta_width(*minmax.second - *minmax.first);
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_COMPUTE_DELTA_SIZES_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void fill_in_deltas(std::shared_ptr<const ReferenceExecutor> exec,
+                    const matrix::Csr<ValueType, IndexType>* source,
+                    matrix::DeltaCsr<ValueType, IndexType>* result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto col_idxs = source->get_const_col_idxs();
+    const auto row_bases = result->get_const_row_bases();
+    const auto delta_ptrs = result->get_const_delta_ptrs();
+    const auto deltas = result->get_deltas();
+    for (size_type row = 0; row < source->get_size()[0]; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto nnz = row_ptrs[row + 1] - begin;
+        if (nnz == 0) {
+            continue;
+        }
+        const auto width =
+            row_delta_width(delta_ptrs[row], delta_ptrs[row + 1], nnz);
+        const auto row_deltas = deltas + delta_ptrs[row];
+        dispatch_delta_width(width, [&](auto delta_type) {
+            using delta_type_t = decltype(delta_type);
+            for (IndexType k = 0; k < nnz; ++k) {
+                store_delta(row_deltas, k,
+                            static_cast<delta_type_t>(col_idxs[begin + k] -
+                                                      row_bases[row]));
+            }
+        });
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_FILL_IN_DELTAS_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void convert_to_csr(std::shared_ptr<const ReferenceExecutor> exec,
+                    const matrix::DeltaCsr<ValueType, IndexType>* source,
+                    matrix::Csr<ValueType, IndexType>* result)
+{
+    const auto row_ptrs = source->get_const_row_ptrs();
+    const auto row_bases = source->get_const_row_bases();
+    const auto delta_ptrs = source->get_const_delta_ptrs();
+    const auto deltas = source->get_const_deltas();
+    const auto col_idxs = result->get_col_idxs();
+    for (size_type row = 0; row < source->get_size()[0]; ++row) {
+        const auto begin = row_ptrs[row];
+        const auto nnz = row_ptrs[row + 1] - begin;
+        if (nnz == 0) {
+            continue;
+        }
+        const auto width =
+            row_delta_width(delta_ptrs[row], delta_ptrs[row + 1], nnz);
+        const auto row_deltas = deltas + delta_ptrs[row];
+        dispatch_delta_width(width, [&](auto delta_type) {
+            using delta_type_t = decltype(delta_type);
+            for (IndexType k = 0; k < nnz; ++k) {
+                const auto delta = load_delta<delta_type_t>(row_deltas, k);
+                col_idxs[begin + k] =
+                    row_bases[row] + static_cast<IndexType>(delta);
+            }
+        });
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_DELTA_CSR_CONVERT_TO_CSR_KERNEL);
+
+
+}  // namespace delta_csr
+}  // namespace reference
+}  // namespace kernels
+}  // namespace gko
@@ -5,6 +5,9 @@
 #include "core/matrix/fft_kernels.hpp"
 
 
+#include <array>
+
+
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
@@ -82,6 +85,67 @@ vector<ValueType> build_unit_roots(std::shared_ptr<const DefaultExecutor> exec,
 }
 
 
+bool is_power_of_two(int64 size)
+{
+    return size > 0 && (size & (size - 1)) == 0;
+}
+
+
+/**
+ * Computes the (inverse) DFT along all dimensions of a row-major
+ * size1 x size2 x size3 array by direct summation. This is used for sizes
+ * that are not a power of two.
+ */
+template <typename ValueType>
+void dft_nd(std::shared_ptr<const DefaultExecutor> exec,
+            const matrix::Dense<std::complex<ValueType>>* b,
+            matrix::Dense<std::complex<ValueType>>* x,
+            std::array<int64, 3> sizes, int64 sign)
+{
+    using complex_type = std::complex<ValueType>;
+    const auto nrhs = b->get_size()[1];
+    const auto total = static_cast<int64>(b->get_size()[0]);
+    if (total == 0) {
+        return;
+    }
+    for (int64 row = 0; row < total; row++) {
+        for (size_type rhs = 0; rhs < nrhs; rhs++) {
+            x->at(row, rhs) = b->at(row, rhs);
+        }
+    }
+    vector<complex_type> line(exec);
+    for (int dim = 0; dim < 3; dim++) {
+        const auto size = sizes[dim];
+        int64 inner = 1;
+        for (int i = dim + 1; i < 3; i++) {
+            inner *= sizes[i];
+        }
+        const auto outer = total / (size * inner);
+        line.resize(size);
+        for (int64 o = 0; o < outer; o++) {
+            for (int64 i = 0; i < inner; i++) {
+                const auto row = [&](int64 k) {
+                    return (o * size + k) * inner + i;
+                };
+                for (size_type rhs = 0; rhs < nrhs; rhs++) {
+                    for (int64 k = 0; k < size; k++) {
+                        line[k] = zero<complex_type>();
+                        for (int64 j = 0; j < size; j++) {
+                            line[k] += x->at(row(j), rhs) *
+                                       unit_root<complex_type>(
+                                           size, sign * ((j * k) % size));
+                        }
+                    }
+                    for (int64 k = 0; k < size; k++) {
+                        x->at(row(k), rhs) = line[k];
+                    }
+                }
+            }
+        }
+    }
+}
+
+
 template <typename ValueType>
 void fft(std::shared_ptr<const DefaultExecutor> exec,
          const matrix::Dense<std::complex<ValueType>>* b,
@@ -93,7 +157,10 @@ void fft(std::shared_ptr<const DefaultExecutor> exec,
     const int64 sign = inverse ? 1 : -1;
     const auto nrhs = b->get_size()[1];
     const auto size = static_cast<int64>(b->get_size()[0]);
-    GKO_ASSERT_IS_POWER_OF_TWO(size);
+    if (!is_power_of_two(size)) {
+        dft_nd(exec, b, x, {1, 1, size}, sign);
+        return;
+    }
     auto roots = build_unit_roots<complex_type>(exec, size, sign);
     // first butterfly step
     auto d = size / 2;
@@ -133,8 +200,10 @@ void fft2(std::shared_ptr<const DefaultExecutor> exec,
     const auto nrhs = b->get_size()[1];
     const auto ssize1 = static_cast<int64>(size1);
     const auto ssize2 = static_cast<int64>(size2);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize1);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize2);
+    if (!is_power_of_two(ssize1) || !is_power_of_two(ssize2)) {
+        dft_nd(exec, b, x, {1, ssize1, ssize2}, sign);
+        return;
+    }
     const auto idx = [&](int64 x, int64 y) { return x * ssize2 + y; };
     auto roots1 = build_unit_roots<complex_type>(exec, ssize1, sign);
     auto roots2 = build_unit_roots<complex_type>(exec, ssize2, sign);
@@ -201,9 +270,11 @@ void fft3(std::shared_ptr<const DefaultExecutor> exec,
     const auto ssize1 = static_cast<int64>(size1);
     const auto ssize2 = static_cast<int64>(size2);
     const auto ssize3 = static_cast<int64>(size3);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize1);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize2);
-    GKO_ASSERT_IS_POWER_OF_TWO(ssize3);
+    if (!is_power_of_two(ssize1) || !is_power_of_two(ssize2) ||
+        !is_power_of_two(ssize3)) {
+        dft_nd(exec, b, x, {ssize1, ssize2, ssize3}, sign);
+        return;
+    }
     const auto idx = [&](int64 x, int64 y, int64 z) {
         return x * ssize2 * ssize3 + y * ssize3 + z;
     };
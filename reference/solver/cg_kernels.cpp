@@ -5,6 +5,11 @@
 #include "core/solver/cg_kernels.hpp"
 
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+
 #include <ginkgo/core/base/array.hpp>
 #include <ginkgo/core/base/exception_helpers.hpp>
 #include <ginkgo/core/base/math.hpp>
@@ -97,6 +102,121 @@ void step_2(std::shared_ptr<const ReferenceExecutor> exec,
 GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_KERNEL);
 
 
+template <typename ValueType>
+void step_2_norm(std::shared_ptr<const ReferenceExecutor> exec,
+                 matrix::Dense<ValueType>* x, matrix::Dense<ValueType>* r,
+                 const matrix::Dense<ValueType>* p,
+                 const matrix::Dense<ValueType>* q,
+                 const matrix::Dense<ValueType>* beta,
+                 const matrix::Dense<ValueType>* rho,
+                 matrix::Dense<remove_complex<ValueType>>* residual_norm,
+                 array<char>& tmp, const array<stopping_status>* stop_status)
+{
+    for (size_type j = 0; j < x->get_size()[1]; ++j) {
+        residual_norm->at(0, j) = zero<remove_complex<ValueType>>();
+    }
+    for (size_type i = 0; i < x->get_size()[0]; ++i) {
+        for (size_type j = 0; j < x->get_size()[1]; ++j) {
+            if (!stop_status->get_const_data()[j].has_stopped() &&
+                is_nonzero(beta->at(j))) {
+                auto alpha = rho->at(j) / beta->at(j);
+                x->at(i, j) += alpha * p->at(i, j);
+                r->at(i, j) -= alpha * q->at(i, j);
+            }
+            residual_norm->at(0, j) += squared_norm(r->at(i, j));
+        }
+    }
+    for (size_type j = 0; j < x->get_size()[1]; ++j) {
+        residual_norm->at(0, j) = sqrt(residual_norm->at(0, j));
+    }
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_TYPE(GKO_DECLARE_CG_STEP_2_NORM_KERNEL);
+
+
+template <typename ValueType, typename IndexType>
+void persistent_solve(
+    std::shared_ptr<const ReferenceExecutor> exec,
+    const matrix::Csr<ValueType, IndexType>* a, matrix::Dense<ValueType>* x,
+    matrix::Dense<ValueType>* r, matrix::Dense<ValueType>* p,
+    matrix::Dense<ValueType>* q,
+    const matrix::Dense<remove_complex<ValueType>>* thresholds,
+    size_type max_iters, uint8 stopping_id, array<stopping_status>* stop_status,
+    size_type* num_iterations)
+{
+    const auto num_rows = x->get_size()[0];
+    const auto num_rhs = x->get_size()[1];
+    const auto row_ptrs = a->get_const_row_ptrs();
+    const auto col_idxs = a->get_const_col_idxs();
+    const auto vals = a->get_const_values();
+    auto status = stop_status->get_data();
+    std::vector<ValueType> rho(num_rhs);
+    std::vector<ValueType> prev_rho(num_rhs, one<ValueType>());
+    std::vector<ValueType> beta(num_rhs);
+    size_type iter = 0;
+    while (true) {
+        // rho = dot(r, r)
+        std::fill(rho.begin(), rho.end(), zero<ValueType>());
+        for (size_type i = 0; i < num_rows; ++i) {
+            for (size_type j = 0; j < num_rhs; ++j) {
+                rho[j] += conj(r->at(i, j)) * r->at(i, j);
+            }
+        }
+        bool all_stopped = true;
+        for (size_type j = 0; j < num_rhs; ++j) {
+            if (sqrt(abs(rho[j])) <= thresholds->at(0, j)) {
+                status[j].converge(stopping_id, true);
+            } else if (iter >= max_iters) {
+                status[j].stop(stopping_id, true);
+            }
+            all_stopped = all_stopped && status[j].has_stopped();
+        }
+        if (all_stopped) {
+            break;
+        }
+        // p = r + rho / prev_rho * p
+        for (size_type i = 0; i < num_rows; ++i) {
+            for (size_type j = 0; j < num_rhs; ++j) {
+                if (!status[j].has_stopped()) {
+                    const auto tmp = safe_divide(rho[j], prev_rho[j]);
+                    p->at(i, j) = r->at(i, j) + tmp * p->at(i, j);
+                }
+            }
+        }
+        // q = A * p
+        // beta = dot(p, q)
+        std::fill(beta.begin(), beta.end(), zero<ValueType>());
+        for (size_type row = 0; row < num_rows; ++row) {
+            for (size_type j = 0; j < num_rhs; ++j) {
+                auto sum = zero<ValueType>();
+                for (auto nz = row_ptrs[row]; nz < row_ptrs[row + 1]; ++nz) {
+                    sum += vals[nz] * p->at(col_idxs[nz], j);
+                }
+                q->at(row, j) = sum;
+                beta[j] += conj(p->at(row, j)) * sum;
+            }
+        }
+        // x = x + rho / beta * p
+        // r = r - rho / beta * q
+        for (size_type i = 0; i < num_rows; ++i) {
+            for (size_type j = 0; j < num_rhs; ++j) {
+                if (!status[j].has_stopped()) {
+                    const auto tmp = safe_divide(rho[j], beta[j]);
+                    x->at(i, j) += tmp * p->at(i, j);
+                    r->at(i, j) -= tmp * q->at(i, j);
+                }
+            }
+        }
+        std::swap(prev_rho, rho);
+        ++iter;
+    }
+    *num_iterations = iter;
+}
+
+GKO_INSTANTIATE_FOR_EACH_VALUE_AND_INDEX_TYPE(
+    GKO_DECLARE_CG_PERSISTENT_SOLVE_KERNEL);
+
+
 }  // namespace cg
 }  // namespace reference
 }  // namespace kernels
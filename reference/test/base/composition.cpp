@@ -11,7 +11,10 @@
 #include <gtest/gtest.h>
 
 
+#include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/matrix/diagonal.hpp>
+#include <ginkgo/core/matrix/permutation.hpp>
 
 
 #include "core/test/utils.hpp"
@@ -550,4 +553,120 @@ TYPED_TEST(Composition, AppliesToVectorWithInitialGuess5)
 }
 
 
+TYPED_TEST(Composition, AppliesFusedDiagonals)
+{
+    /*
+        cmp = diag(2 3 4) * diag(1 -1 2)
+    */
+    using Mtx = typename TestFixture::Mtx;
+    using Diagonal = gko::matrix::Diagonal<TypeParam>;
+    auto cmp = gko::Composition<TypeParam>::create(
+        Diagonal::create(this->exec, 3,
+                         gko::array<TypeParam>{this->exec, {2.0, 3.0, 4.0}}),
+        Diagonal::create(this->exec, 3,
+                         gko::array<TypeParam>{this->exec, {1.0, -1.0, 2.0}}));
+    auto x = gko::initialize<Mtx>({1.0, 2.0, 3.0}, this->exec);
+    auto res = clone(x);
+
+    cmp->apply(x, res);
+
+    GKO_ASSERT_MTX_NEAR(res, l({2.0, -6.0, 24.0}), r<TypeParam>::value);
+    ASSERT_EQ(cmp->get_operators().size(), 2);
+}
+
+
+TYPED_TEST(Composition, AppliesFusedPermutations)
+{
+    /*
+        cmp = P * P with P = perm(2 0 1)
+    */
+    using Mtx = typename TestFixture::Mtx;
+    using Permutation = gko::matrix::Permutation<gko::int32>;
+    auto perm = gko::share(Permutation::create(
+        this->exec, gko::array<gko::int32>{this->exec, {2, 0, 1}}));
+    auto cmp = gko::Composition<TypeParam>::create(perm, perm);
+    auto x = gko::initialize<Mtx>({1.0, 2.0, 3.0}, this->exec);
+    auto res = clone(x);
+
+    cmp->apply(x, res);
+
+    GKO_ASSERT_MTX_NEAR(res, l({2.0, 3.0, 1.0}), 0);
+}
+
+
+template <typename T>
+std::unique_ptr<gko::Composition<T>> create_fusable_composition(
+    std::shared_ptr<const gko::Executor> exec)
+{
+    /*
+        cmp = diag(2 3 4) * P * [ 1 2 0 ] * diag(1 -1 2) * P
+                                [ 0 3 4 ]
+                                [ 5 0 6 ]
+        with P = perm(2 0 1)
+    */
+    using Csr = gko::matrix::Csr<T, gko::int32>;
+    using Diagonal = gko::matrix::Diagonal<T>;
+    using Permutation = gko::matrix::Permutation<gko::int32>;
+    auto perm = gko::share(Permutation::create(
+        exec, gko::array<gko::int32>{exec, {2, 0, 1}}));
+    return gko::Composition<T>::create(
+        Diagonal::create(exec, 3, gko::array<T>{exec, {2.0, 3.0, 4.0}}), perm,
+        gko::initialize<Csr>(
+            {{1.0, 2.0, 0.0}, {0.0, 3.0, 4.0}, {5.0, 0.0, 6.0}}, exec),
+        Diagonal::create(exec, 3, gko::array<T>{exec, {1.0, -1.0, 2.0}}),
+        perm);
+}
+
+
+TYPED_TEST(Composition, AppliesFusedCsrToVector)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto cmp = create_fusable_composition<TypeParam>(this->exec);
+    auto x = gko::initialize<Mtx>({1.0, 2.0, 3.0}, this->exec);
+    auto res = clone(x);
+
+    cmp->apply(x, res);
+
+    GKO_ASSERT_MTX_NEAR(res, l({78.0, 3.0, 52.0}), r<TypeParam>::value);
+    ASSERT_EQ(cmp->get_operators().size(), 5);
+}
+
+
+TYPED_TEST(Composition, AppliesFusedCsrLinearCombinationToVector)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto cmp = create_fusable_composition<TypeParam>(this->exec);
+    auto alpha = gko::initialize<Mtx>({2.0}, this->exec);
+    auto beta = gko::initialize<Mtx>({-1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({1.0, 2.0, 3.0}, this->exec);
+    auto res = clone(x);
+
+    cmp->apply(alpha, x, beta, res);
+
+    GKO_ASSERT_MTX_NEAR(res, l({155.0, 4.0, 101.0}), r<TypeParam>::value);
+}
+
+
+TYPED_TEST(Composition, AppliesFusedCsrToChangingNumberOfRhs)
+{
+    using Mtx = typename TestFixture::Mtx;
+    auto cmp = create_fusable_composition<TypeParam>(this->exec);
+    auto x = gko::initialize<Mtx>({1.0, 2.0, 3.0}, this->exec);
+    auto x2 = gko::initialize<Mtx>(
+        {I<TypeParam>{1.0, 0.0}, I<TypeParam>{2.0, 1.0},
+         I<TypeParam>{3.0, 0.0}},
+        this->exec);
+    auto res = clone(x);
+    auto res2 = clone(x2);
+
+    cmp->apply(x, res);
+    cmp->apply(x2, res2);
+    cmp->apply(x, res);
+
+    GKO_ASSERT_MTX_NEAR(res, l({78.0, 3.0, 52.0}), r<TypeParam>::value);
+    GKO_ASSERT_MTX_NEAR(res2, l({{78.0, 24.0}, {3.0, 0.0}, {52.0, 32.0}}),
+                        r<TypeParam>::value);
+}
+
+
 }  // namespace
@@ -6,6 +6,7 @@
 
 
 #include <algorithm>
+#include <limits>
 
 
 #include <gtest/gtest.h>
@@ -415,6 +416,37 @@ TYPED_TEST(Csr, MixedAppliesToDenseVector3)
 }
 
 
+TYPED_TEST(Csr, MixedAppliesToDenseVectorInVectorPrecision)
+{
+    // A matrix with lower precision values is applied to the vectors without
+    // rounding them to the matrix precision
+    using T = typename TestFixture::value_type;
+    using next_T = gko::next_precision<T>;
+    using real_T = gko::remove_complex<T>;
+    using real_next_T = gko::remove_complex<next_T>;
+    using Vec = gko::matrix::Dense<next_T>;
+    if (sizeof(real_T) >= sizeof(real_next_T)) {
+        GTEST_SKIP() << "The matrix values are not stored in lower precision";
+    }
+    const auto eps =
+        static_cast<real_next_T>(std::numeric_limits<real_T>::epsilon()) / 4;
+    auto x = gko::initialize<Vec>({1.0 + eps, 0.0, 0.0}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{2, 1});
+    auto alpha = gko::initialize<Vec>({1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({0.0}, this->exec);
+    auto y2 = Vec::create(this->exec, gko::dim<2>{2, 1});
+    y2->fill(0.0);
+
+    this->mtx->apply(x, y);
+    this->mtx->apply(alpha, x, beta, y2);
+
+    EXPECT_EQ(y->at(0), next_T{1.0 + eps});
+    EXPECT_EQ(y->at(1), next_T{0.0});
+    EXPECT_EQ(y2->at(0), next_T{1.0 + eps});
+    EXPECT_EQ(y2->at(1), next_T{0.0});
+}
+
+
 TYPED_TEST(Csr, AppliesToDenseMatrix)
 {
     using Vec = typename TestFixture::Vec;
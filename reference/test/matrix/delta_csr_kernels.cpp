@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <ginkgo/core/matrix/delta_csr.hpp>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/matrix/delta_csr_kernels.hpp"
+#include "core/test/utils.hpp"
+
+
+namespace {
+
+
+template <typename ValueIndexType>
+class DeltaCsr : public ::testing::Test {
+protected:
+    using value_type =
+        typename std::tuple_element<0, decltype(ValueIndexType())>::type;
+    using index_type =
+        typename std::tuple_element<1, decltype(ValueIndexType())>::type;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Mtx = gko::matrix::DeltaCsr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    DeltaCsr()
+        : exec(gko::ReferenceExecutor::create()),
+          csr(Csr::create(exec, gko::dim<2>{4, 70000}, 7)),
+          mtx(Mtx::create(exec))
+    {
+        /*
+         * row 0: columns 1, 3, 2 (8-bit deltas, unsorted)
+         * row 1: empty
+         * row 2: columns 10, 600 (16-bit deltas)
+         * row 3: columns 0, 69999 (32-bit deltas)
+         */
+        auto r = csr->get_row_ptrs();
+        auto c = csr->get_col_idxs();
+        auto v = csr->get_values();
+        r[0] = 0;
+        r[1] = 3;
+        r[2] = 3;
+        r[3] = 5;
+        r[4] = 7;
+        c[0] = 1;
+        c[1] = 3;
+        c[2] = 2;
+        c[3] = 10;
+        c[4] = 600;
+        c[5] = 0;
+        c[6] = 69999;
+        v[0] = 1.0;
+        v[1] = 3.0;
+        v[2] = 2.0;
+        v[3] = 5.0;
+        v[4] = -1.0;
+        v[5] = 2.0;
+        v[6] = 4.0;
+        csr->convert_to(mtx);
+        x = Vec::create(exec, gko::dim<2>{70000, 2});
+        for (gko::size_type row = 0; row < x->get_size()[0]; ++row) {
+            x->at(row, 0) = static_cast<value_type>(row % 7);
+            x->at(row, 1) = static_cast<value_type>(row % 5) - value_type{2.0};
+        }
+    }
+
+    std::shared_ptr<const gko::ReferenceExecutor> exec;
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> x;
+};
+
+TYPED_TEST_SUITE(DeltaCsr, gko::test::ValueIndexTypes,
+                 PairTypenameNameGenerator);
+
+
+TYPED_TEST(DeltaCsr, ConvertsFromCsr)
+{
+    auto r = this->mtx->get_const_row_ptrs();
+    auto b = this->mtx->get_const_row_bases();
+    auto d = this->mtx->get_const_delta_ptrs();
+    auto deltas = this->mtx->get_const_deltas();
+
+    ASSERT_EQ(this->mtx->get_size(), gko::dim<2>(4, 70000));
+    ASSERT_EQ(this->mtx->get_num_stored_elements(), 7);
+    ASSERT_EQ(this->mtx->get_num_delta_bytes(), 15);
+    EXPECT_EQ(r[4], 7);
+    EXPECT_EQ(b[0], 1);
+    EXPECT_EQ(b[1], 0);
+    EXPECT_EQ(b[2], 10);
+    EXPECT_EQ(b[3], 0);
+    EXPECT_EQ(d[0], 0);
+    EXPECT_EQ(d[1], 3);
+    EXPECT_EQ(d[2], 3);
+    EXPECT_EQ(d[3], 7);
+    EXPECT_EQ(d[4], 15);
+    EXPECT_EQ(deltas[0], 0);
+    EXPECT_EQ(deltas[1], 2);
+    EXPECT_EQ(deltas[2], 1);
+    GKO_ASSERT_ARRAY_EQ(gko::make_const_array_view(
+                            this->exec, 7, this->mtx->get_const_values()),
+                        gko::make_const_array_view(
+                            this->exec, 7, this->csr->get_const_values()));
+}
+
+
+TYPED_TEST(DeltaCsr, ConvertsToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->convert_to(result);
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+    GKO_ASSERT_ARRAY_EQ(
+        gko::make_const_array_view(this->exec, 7, result->get_const_col_idxs()),
+        gko::make_const_array_view(this->exec, 7,
+                                   this->csr->get_const_col_idxs()));
+}
+
+
+TYPED_TEST(DeltaCsr, MovesToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto result = Csr::create(this->exec);
+
+    this->mtx->move_to(result);
+
+    GKO_ASSERT_MTX_NEAR(result, this->csr, 0.0);
+}
+
+
+TYPED_TEST(DeltaCsr, AppliesToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto result = Vec::create(this->exec, gko::dim<2>{4, 2});
+    auto expected = result->clone();
+    this->csr->apply(this->x, expected);
+
+    this->mtx->apply(this->x, result);
+
+    GKO_ASSERT_MTX_NEAR(result, expected, 0.0);
+    GKO_ASSERT_MTX_NEAR(result, l({{14.0, 2.0}, {0.0, 0.0}, {10.0, -8.0},
+                                   {24.0, 4.0}}),
+                        0.0);
+}
+
+
+TYPED_TEST(DeltaCsr, AppliesLinearCombinationToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    using value_type = typename TestFixture::value_type;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto result = gko::initialize<Vec>(
+        {I<value_type>{1.0, 2.0}, I<value_type>{3.0, 4.0},
+         I<value_type>{5.0, 6.0}, I<value_type>{7.0, 8.0}},
+        this->exec);
+    auto expected = result->clone();
+    this->csr->apply(alpha, this->x, beta, expected);
+
+    this->mtx->apply(alpha, this->x, beta, result);
+
+    GKO_ASSERT_MTX_NEAR(result, expected, 0.0);
+}
+
+
+TYPED_TEST(DeltaCsr, AppliesToMixedDenseVector)
+{
+    using value_type = gko::next_precision<typename TestFixture::value_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+    auto x = Vec::create(this->exec);
+    this->x->convert_to(x);
+    auto result = Vec::create(this->exec, gko::dim<2>{4, 2});
+
+    this->mtx->apply(x, result);
+
+    GKO_ASSERT_MTX_NEAR(result, l({{14.0, 2.0}, {0.0, 0.0}, {10.0, -8.0},
+                                   {24.0, 4.0}}),
+                        0.0);
+}
+
+
+TYPED_TEST(DeltaCsr, ApplyFailsOnWrongInnerDimension)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = Vec::create(this->exec, gko::dim<2>{2});
+    auto y = Vec::create(this->exec, gko::dim<2>{4});
+
+    ASSERT_THROW(this->mtx->apply(x, y), gko::DimensionMismatch);
+}
+
+
+TYPED_TEST(DeltaCsr, ConvertsEmptyCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    using Mtx = typename TestFixture::Mtx;
+    auto empty = Csr::create(this->exec);
+    auto result = Mtx::create(this->exec);
+
+    empty->convert_to(result);
+
+    ASSERT_EQ(result->get_size(), gko::dim<2>{});
+    ASSERT_EQ(result->get_num_stored_elements(), 0);
+    ASSERT_EQ(result->get_num_delta_bytes(), 0);
+}
+
+
+}  // namespace
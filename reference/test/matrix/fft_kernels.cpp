@@ -41,6 +41,22 @@ protected:
                                           -static_cast<int>((i * j) % n));
     }
 
+    std::unique_ptr<Vec> dense_dft(gko::size_type n1, gko::size_type n2,
+                                   gko::size_type n3)
+    {
+        const auto n = n1 * n2 * n3;
+        auto result = Vec::create(exec, gko::dim<2>{n, n});
+        for (gko::size_type i = 0; i < n; i++) {
+            for (gko::size_type j = 0; j < n; j++) {
+                result->at(i, j) =
+                    fourier_coef(n1, i / (n2 * n3), j / (n2 * n3)) *
+                    fourier_coef(n2, i / n3 % n2, j / n3 % n2) *
+                    fourier_coef(n3, i % n3, j % n3);
+            }
+        }
+        return result;
+    }
+
     Fft()
         : exec(gko::ReferenceExecutor::create()),
           rng{7381},
@@ -156,43 +172,52 @@ protected:
 TYPED_TEST_SUITE(Fft, gko::test::ComplexValueTypes, TypenameNameGenerator);
 
 
-TYPED_TEST(Fft, ThrowsOnNonPowerOfTwo1D)
+TYPED_TEST(Fft, AppliesNonPowerOfTwo1D)
 {
-    auto wrong_fft = TestFixture::Mtx::create(this->exec, 3);
-    auto wrong_vec = TestFixture::Vec::create(this->exec, gko::dim<2>(3, 1));
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto vec = gko::initialize<Vec>({T{1.0, 2.0}, T{-1.0, 0.5}, T{3.0, -1.0},
+                                     T{0.0, 1.0}, T{2.0, 0.0}, T{-0.5, -2.0}},
+                                    this->exec);
+    auto result = Vec::create(this->exec, vec->get_size());
+    auto expected = Vec::create(this->exec, vec->get_size());
+
+    TestFixture::Mtx::create(this->exec, 6)->apply(vec, result);
+    this->dense_dft(6, 1, 1)->apply(vec, expected);
 
-    ASSERT_THROW(wrong_fft->apply(wrong_vec, wrong_vec), gko::BadDimension);
+    GKO_ASSERT_MTX_NEAR(result, expected, r<T>::value);
 }
 
 
-TYPED_TEST(Fft, ThrowsOnNonPowerOfTwo2D)
+TYPED_TEST(Fft, AppliesNonPowerOfTwo2D)
 {
-    auto wrong_vec =
-        TestFixture::Vec::create(this->exec, gko::dim<2>(3 * 2, 1));
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto vec = gko::clone(this->exec, this->amplitude->create_submatrix(
+                                          gko::span{0, 12}, gko::span{0, 2}));
+    auto result = Vec::create(this->exec, vec->get_size());
+    auto expected = Vec::create(this->exec, vec->get_size());
 
-    ASSERT_THROW(TestFixture::Mtx2::create(this->exec, 3, 2)
-                     ->apply(wrong_vec, wrong_vec),
-                 gko::BadDimension);
-    ASSERT_THROW(TestFixture::Mtx2::create(this->exec, 2, 3)
-                     ->apply(wrong_vec, wrong_vec),
-                 gko::BadDimension);
+    TestFixture::Mtx2::create(this->exec, 4, 3)->apply(vec, result);
+    this->dense_dft(4, 3, 1)->apply(vec, expected);
+
+    GKO_ASSERT_MTX_NEAR(result, expected, r<T>::value);
 }
 
 
-TYPED_TEST(Fft, ThrowsOnNonPowerOfTwo3D)
+TYPED_TEST(Fft, AppliesNonPowerOfTwo3D)
 {
-    auto wrong_vec =
-        TestFixture::Vec::create(this->exec, gko::dim<2>(3 * 2 * 4, 1));
+    using Vec = typename TestFixture::Vec;
+    using T = typename TestFixture::value_type;
+    auto vec = gko::clone(this->exec, this->amplitude->create_submatrix(
+                                          gko::span{0, 30}, gko::span{0, 2}));
+    auto result = Vec::create(this->exec, vec->get_size());
+    auto expected = Vec::create(this->exec, vec->get_size());
+
+    TestFixture::Mtx3::create(this->exec, 3, 2, 5, true)->apply(vec, result);
+    this->dense_dft(3, 2, 5)->conj_transpose()->apply(vec, expected);
 
-    ASSERT_THROW(TestFixture::Mtx3::create(this->exec, 3, 2, 4)
-                     ->apply(wrong_vec, wrong_vec),
-                 gko::BadDimension);
-    ASSERT_THROW(TestFixture::Mtx3::create(this->exec, 2, 3, 4)
-                     ->apply(wrong_vec, wrong_vec),
-                 gko::BadDimension);
-    ASSERT_THROW(TestFixture::Mtx3::create(this->exec, 4, 2, 3)
-                     ->apply(wrong_vec, wrong_vec),
-                 gko::BadDimension);
+    GKO_ASSERT_MTX_NEAR(result, expected, r<T>::value);
 }
 
 
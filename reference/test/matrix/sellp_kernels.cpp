@@ -37,7 +37,8 @@ protected:
     Sellp()
         : exec(gko::ReferenceExecutor::create()),
           mtx1(Mtx::create(exec)),
-          mtx2(Mtx::create(exec))
+          mtx2(Mtx::create(exec)),
+          mtx3(Mtx::create(exec))
     {
         // clang-format off
         mtx1 = gko::initialize<Mtx>({{1.0, 3.0, 2.0},
@@ -45,12 +46,18 @@ protected:
         mtx2 = gko::initialize<Mtx>({{1.0, 3.0, 2.0},
                                      {0.0, 5.0, 0.0}}, exec,
                                      gko::dim<2>{}, 2, 2, 0);
+        mtx3 = gko::initialize<Mtx>({{1.0, 0.0, 0.0},
+                                     {2.0, 3.0, 4.0},
+                                     {0.0, 5.0, 0.0},
+                                     {6.0, 0.0, 7.0}}, exec,
+                                     gko::dim<2>{}, 2, 1, 4, 0);
         // clang-format on
     }
 
     std::shared_ptr<const gko::ReferenceExecutor> exec;
     std::unique_ptr<Mtx> mtx1;
     std::unique_ptr<Mtx> mtx2;
+    std::unique_ptr<Mtx> mtx3;
 };
 
 TYPED_TEST_SUITE(Sellp, gko::test::ValueIndexTypes, PairTypenameNameGenerator);
@@ -604,6 +611,181 @@ TYPED_TEST(Sellp, ExtractsDiagonalWithSliceSizeAndStrideFactor)
 }
 
 
+TYPED_TEST(Sellp, SortsRowsWithinSortingWindow)
+{
+    using index_type = typename TestFixture::index_type;
+    auto perm = this->mtx3->get_const_permutation();
+    auto slice_lengths = this->mtx3->get_const_slice_lengths();
+
+    ASSERT_EQ(this->mtx3->get_sorting_window(), 4);
+    ASSERT_EQ(this->mtx3->get_total_cols(), 4);
+    EXPECT_EQ(perm[0], index_type{1});
+    EXPECT_EQ(perm[1], index_type{3});
+    EXPECT_EQ(perm[2], index_type{0});
+    EXPECT_EQ(perm[3], index_type{2});
+    EXPECT_EQ(slice_lengths[0], 3);
+    EXPECT_EQ(slice_lengths[1], 1);
+}
+
+
+TYPED_TEST(Sellp, DoesNotSortRowsWithoutSortingWindow)
+{
+    ASSERT_EQ(this->mtx1->get_sorting_window(), 1);
+    ASSERT_EQ(this->mtx1->get_const_permutation(), nullptr);
+}
+
+
+TYPED_TEST(Sellp, ReadsWithSortingWindow)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using index_type = typename TestFixture::index_type;
+    auto mtx = Mtx::create(this->exec, gko::dim<2>{}, 2, 1, 4, 0);
+
+    mtx->read({{4, 3},
+               {{0, 0, 1.0},
+                {1, 0, 2.0},
+                {1, 1, 3.0},
+                {1, 2, 4.0},
+                {2, 1, 5.0},
+                {3, 0, 6.0},
+                {3, 2, 7.0}}});
+
+    GKO_ASSERT_MTX_NEAR(mtx, this->mtx3, 0.0);
+    ASSERT_EQ(mtx->get_total_cols(), 4);
+    EXPECT_EQ(mtx->get_const_permutation()[0], index_type{1});
+    EXPECT_EQ(mtx->get_const_permutation()[1], index_type{3});
+    EXPECT_EQ(mtx->get_const_permutation()[2], index_type{0});
+    EXPECT_EQ(mtx->get_const_permutation()[3], index_type{2});
+}
+
+
+TYPED_TEST(Sellp, AppliesWithSortingWindowToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto x = gko::initialize<Vec>({1.0, 2.0, 3.0}, this->exec);
+    auto y = Vec::create(this->exec, gko::dim<2>{4, 1});
+
+    this->mtx3->apply(x, y);
+
+    GKO_ASSERT_MTX_NEAR(y, l({1.0, 20.0, 10.0, 27.0}), 0.0);
+}
+
+
+TYPED_TEST(Sellp, AppliesLinearCombinationWithSortingWindowToDenseVector)
+{
+    using Vec = typename TestFixture::Vec;
+    auto alpha = gko::initialize<Vec>({-1.0}, this->exec);
+    auto beta = gko::initialize<Vec>({2.0}, this->exec);
+    auto x = gko::initialize<Vec>({1.0, 2.0, 3.0}, this->exec);
+    auto y = gko::initialize<Vec>({1.0, 2.0, 3.0, 4.0}, this->exec);
+
+    this->mtx3->apply(alpha, x, beta, y);
+
+    GKO_ASSERT_MTX_NEAR(y, l({1.0, -16.0, -4.0, -19.0}), 0.0);
+}
+
+
+TYPED_TEST(Sellp, ConvertsWithSortingWindowToDense)
+{
+    using Vec = typename TestFixture::Vec;
+    auto dense_mtx = Vec::create(this->mtx3->get_executor());
+
+    this->mtx3->convert_to(dense_mtx);
+
+    // clang-format off
+    GKO_ASSERT_MTX_NEAR(dense_mtx,
+                        l({{1.0, 0.0, 0.0},
+                           {2.0, 3.0, 4.0},
+                           {0.0, 5.0, 0.0},
+                           {6.0, 0.0, 7.0}}), 0.0);
+    // clang-format on
+}
+
+
+TYPED_TEST(Sellp, ConvertsWithSortingWindowToCsr)
+{
+    using Csr = typename TestFixture::Csr;
+    auto csr_mtx = Csr::create(this->mtx3->get_executor());
+
+    this->mtx3->convert_to(csr_mtx);
+
+    // clang-format off
+    GKO_ASSERT_MTX_NEAR(csr_mtx,
+                        l({{1.0, 0.0, 0.0},
+                           {2.0, 3.0, 4.0},
+                           {0.0, 5.0, 0.0},
+                           {6.0, 0.0, 7.0}}), 0.0);
+    // clang-format on
+}
+
+
+TYPED_TEST(Sellp, ConvertsWithSortingWindowToPrecision)
+{
+    using ValueType = typename TestFixture::value_type;
+    using IndexType = typename TestFixture::index_type;
+    using OtherType = gko::next_precision<ValueType>;
+    using Sellp = typename TestFixture::Mtx;
+    using OtherSellp = gko::matrix::Sellp<OtherType, IndexType>;
+    auto tmp = OtherSellp::create(this->exec);
+    auto res = Sellp::create(this->exec);
+
+    this->mtx3->convert_to(tmp);
+    tmp->convert_to(res);
+
+    GKO_ASSERT_MTX_NEAR(this->mtx3, res, 0.0);
+    ASSERT_EQ(res->get_sorting_window(), 4);
+}
+
+
+TYPED_TEST(Sellp, WritesWithSortingWindowInOriginalOrder)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    using tpl = typename gko::matrix_data<value_type, index_type>::nonzero_type;
+    gko::matrix_data<value_type, index_type> data;
+
+    this->mtx3->write(data);
+
+    ASSERT_EQ(data.size, gko::dim<2>(4, 3));
+    ASSERT_EQ(data.nonzeros.size(), 7);
+    EXPECT_EQ(data.nonzeros[0], tpl(0, 0, value_type{1.0}));
+    EXPECT_EQ(data.nonzeros[1], tpl(1, 0, value_type{2.0}));
+    EXPECT_EQ(data.nonzeros[2], tpl(1, 1, value_type{3.0}));
+    EXPECT_EQ(data.nonzeros[3], tpl(1, 2, value_type{4.0}));
+    EXPECT_EQ(data.nonzeros[4], tpl(2, 1, value_type{5.0}));
+    EXPECT_EQ(data.nonzeros[5], tpl(3, 0, value_type{6.0}));
+    EXPECT_EQ(data.nonzeros[6], tpl(3, 2, value_type{7.0}));
+}
+
+
+TYPED_TEST(Sellp, ExtractsDiagonalWithSortingWindow)
+{
+    using T = typename TestFixture::value_type;
+    auto diag = this->mtx3->extract_diagonal();
+
+    ASSERT_EQ(diag->get_size()[0], 3);
+    ASSERT_EQ(diag->get_size()[1], 3);
+    ASSERT_EQ(diag->get_values()[0], T{1.});
+    ASSERT_EQ(diag->get_values()[1], T{3.});
+    ASSERT_EQ(diag->get_values()[2], T{0.});
+}
+
+
+TYPED_TEST(Sellp, OutplaceAbsoluteWithSortingWindow)
+{
+    auto abs_mtx = this->mtx3->compute_absolute();
+
+    // clang-format off
+    GKO_ASSERT_MTX_NEAR(abs_mtx,
+                        l({{1.0, 0.0, 0.0},
+                           {2.0, 3.0, 4.0},
+                           {0.0, 5.0, 0.0},
+                           {6.0, 0.0, 7.0}}), 0.0);
+    // clang-format on
+    ASSERT_EQ(abs_mtx->get_sorting_window(), 4);
+}
+
+
 TYPED_TEST(Sellp, InplaceAbsolute)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -10,6 +10,8 @@
 
 #include <ginkgo/core/base/exception.hpp>
 #include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/log/convergence.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/stop/combined.hpp>
 #include <ginkgo/core/stop/iteration.hpp>
@@ -196,6 +198,34 @@ TYPED_TEST(Cg, KernelStep2)
 }
 
 
+TYPED_TEST(Cg, KernelStep2Norm)
+{
+    using value_type = typename TestFixture::value_type;
+    using NormVector = gko::matrix::Dense<gko::remove_complex<value_type>>;
+    auto norm = NormVector::create(this->exec, gko::dim<2>{1, 2});
+    gko::array<char> tmp{this->exec};
+    this->small_x->fill(-2);
+    this->small_p->fill(3);
+    this->small_r->fill(4);
+    this->small_q->fill(-5);
+    this->small_rho->at(0) = 2;
+    this->small_rho->at(1) = 3;
+    this->small_beta->at(0) = 8;
+    this->small_beta->at(1) = 3;
+    this->small_stop.get_data()[1] = this->stopped;
+
+    gko::kernels::reference::cg::step_2_norm(
+        this->exec, this->small_x.get(), this->small_r.get(),
+        this->small_p.get(), this->small_q.get(), this->small_beta.get(),
+        this->small_rho.get(), norm.get(), tmp, &this->small_stop);
+
+    GKO_ASSERT_MTX_NEAR(this->small_x, l({{-1.25, -2.0}, {-1.25, -2.0}}), 0);
+    GKO_ASSERT_MTX_NEAR(this->small_r, l({{5.25, 4.0}, {5.25, 4.0}}), 0);
+    GKO_ASSERT_MTX_NEAR(norm, l({{5.25 * std::sqrt(2.0), 4 * std::sqrt(2.0)}}),
+                        r<value_type>::value);
+}
+
+
 TYPED_TEST(Cg, KernelStep2DivByZero)
 {
     this->small_x->fill(-2);
@@ -305,6 +335,91 @@ TYPED_TEST(Cg, SolvesMultipleStencilSystems)
 }
 
 
+TYPED_TEST(Cg, SolvesMultipleStencilSystemsInPersistentRegion)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = gko::matrix::Csr<typename TestFixture::value_type, int>;
+    using value_type = typename TestFixture::value_type;
+    using T = value_type;
+    auto csr = Csr::create(this->exec);
+    this->mtx->convert_to(csr);
+    auto solver =
+        gko::solver::Cg<value_type>::build()
+            .with_criteria(gko::stop::Iteration::build().with_max_iters(400u),
+                           gko::stop::ResidualNorm<value_type>::build()
+                               .with_reduction_factor(r<value_type>::value))
+            .with_persistent_region(true)
+            .on(this->exec)
+            ->generate(std::move(csr));
+    auto b = gko::initialize<Mtx>(
+        {I<T>{-1.0, 1.0}, I<T>{3.0, 0.0}, I<T>{1.0, 1.0}}, this->exec);
+    auto x = gko::initialize<Mtx>(
+        {I<T>{0.0, 0.0}, I<T>{0.0, 0.0}, I<T>{0.0, 0.0}}, this->exec);
+
+    solver->apply(b, x);
+
+    GKO_ASSERT_MTX_NEAR(x, l({{1.0, 1.0}, {3.0, 1.0}, {2.0, 1.0}}),
+                        r<value_type>::value);
+}
+
+
+TYPED_TEST(Cg, PersistentRegionMatchesDefaultIterations)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Csr = gko::matrix::Csr<typename TestFixture::value_type, gko::int64>;
+    using value_type = typename TestFixture::value_type;
+    auto csr = gko::share(Csr::create(this->exec));
+    this->mtx_big->convert_to(csr);
+    auto factory =
+        gko::solver::Cg<value_type>::build()
+            .with_criteria(gko::stop::Iteration::build().with_max_iters(100u),
+                           gko::stop::ImplicitResidualNorm<value_type>::build()
+                               .with_reduction_factor(r<value_type>::value));
+    auto solver = factory.on(this->exec)->generate(csr);
+    auto persistent_solver =
+        factory.with_persistent_region(true).on(this->exec)->generate(csr);
+    auto logger = gko::share(gko::log::Convergence<value_type>::create());
+    auto persistent_logger =
+        gko::share(gko::log::Convergence<value_type>::create());
+    solver->add_logger(logger);
+    persistent_solver->add_logger(persistent_logger);
+    auto b = gko::initialize<Mtx>(
+        {1300083.0, 1018120.5, 906410.0, -42679.5, 846779.5, 1176858.5},
+        this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0, 0.0, 0.0, 0.0}, this->exec);
+    auto persistent_x = x->clone();
+
+    solver->apply(b, x);
+    persistent_solver->apply(b, persistent_x);
+
+    ASSERT_EQ(persistent_logger->get_num_iterations(),
+              logger->get_num_iterations());
+    ASSERT_TRUE(persistent_logger->has_converged());
+    GKO_ASSERT_MTX_NEAR(persistent_x, x, r<value_type>::value * 1e2);
+}
+
+
+TYPED_TEST(Cg, PersistentRegionFallsBackForUnsupportedMatrix)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    auto solver =
+        gko::solver::Cg<value_type>::build()
+            .with_criteria(gko::stop::Iteration::build().with_max_iters(400u),
+                           gko::stop::ResidualNorm<value_type>::build()
+                               .with_reduction_factor(r<value_type>::value))
+            .with_persistent_region(true)
+            .on(this->exec)
+            ->generate(this->mtx);
+    auto b = gko::initialize<Mtx>({-1.0, 3.0, 1.0}, this->exec);
+    auto x = gko::initialize<Mtx>({0.0, 0.0, 0.0}, this->exec);
+
+    solver->apply(b, x);
+
+    GKO_ASSERT_MTX_NEAR(x, l({1.0, 3.0, 2.0}), r<value_type>::value);
+}
+
+
 TYPED_TEST(Cg, SolvesStencilSystemUsingAdvancedApply)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -109,6 +109,60 @@ TYPED_TEST(ResidualNorm, CheckIfResZeroConverges)
 }
 
 
+TYPED_TEST(ResidualNorm, ChecksOnlyEveryCheckInterval)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using NormVector = typename TestFixture::NormVector;
+    using T = typename TestFixture::ValueType;
+    std::shared_ptr<gko::LinOp> rhs = gko::initialize<Mtx>({10.0}, this->exec_);
+    auto res_norm = gko::initialize<NormVector>({0.0}, this->exec_);
+    auto criterion = gko::stop::ResidualNorm<T>::build()
+                         .with_reduction_factor(r<T>::value)
+                         .with_check_interval(3u)
+                         .on(this->exec_)
+                         ->generate(nullptr, rhs, nullptr, nullptr);
+    constexpr gko::uint8 RelativeStoppingId{1};
+    bool one_changed{};
+    gko::array<gko::stopping_status> stop_status(this->exec_, 1);
+    stop_status.get_data()[0].reset();
+
+    ASSERT_FALSE(criterion->update()
+                     .num_iterations(1)
+                     .residual_norm(res_norm)
+                     .check(RelativeStoppingId, true, &stop_status,
+                            &one_changed));
+    ASSERT_FALSE(stop_status.get_data()[0].has_converged());
+    ASSERT_FALSE(one_changed);
+    ASSERT_FALSE(criterion->update()
+                     .num_iterations(2)
+                     .residual_norm(res_norm)
+                     .check(RelativeStoppingId, true, &stop_status,
+                            &one_changed));
+    ASSERT_FALSE(stop_status.get_data()[0].has_converged());
+    ASSERT_TRUE(criterion->update()
+                    .num_iterations(3)
+                    .residual_norm(res_norm)
+                    .check(RelativeStoppingId, true, &stop_status,
+                           &one_changed));
+    ASSERT_TRUE(stop_status.get_data()[0].has_converged());
+    ASSERT_TRUE(one_changed);
+}
+
+
+TYPED_TEST(ResidualNorm, ThrowsOnZeroCheckInterval)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using T = typename TestFixture::ValueType;
+    std::shared_ptr<gko::LinOp> rhs = gko::initialize<Mtx>({10.0}, this->exec_);
+    auto factory = gko::stop::ResidualNorm<T>::build()
+                       .with_check_interval(0u)
+                       .on(this->exec_);
+
+    ASSERT_THROW(factory->generate(nullptr, rhs, nullptr, nullptr),
+                 gko::InvalidStateError);
+}
+
+
 TYPED_TEST(ResidualNorm, CannotCreateCriterionWithoutNeededInput)
 {
     ASSERT_THROW(
@@ -926,6 +980,37 @@ TYPED_TEST(ImplicitResidualNorm, WaitsTillResidualGoal)
 }
 
 
+TYPED_TEST(ImplicitResidualNorm, ChecksOnlyEveryCheckInterval)
+{
+    using T = TypeParam;
+    using Mtx = typename TestFixture::Mtx;
+    std::shared_ptr<gko::LinOp> rhs = gko::initialize<Mtx>({10.0}, this->exec_);
+    auto res_norm = gko::initialize<Mtx>({0.0}, this->exec_);
+    auto criterion = gko::stop::ImplicitResidualNorm<T>::build()
+                         .with_reduction_factor(r<T>::value)
+                         .with_check_interval(2u)
+                         .on(this->exec_)
+                         ->generate(nullptr, rhs, nullptr, nullptr);
+    bool one_changed{};
+    constexpr gko::uint8 RelativeStoppingId{1};
+    gko::array<gko::stopping_status> stop_status(this->exec_, 1);
+    stop_status.get_data()[0].reset();
+
+    ASSERT_FALSE(criterion->update()
+                     .num_iterations(1)
+                     .implicit_sq_residual_norm(res_norm)
+                     .check(RelativeStoppingId, true, &stop_status,
+                            &one_changed));
+    ASSERT_FALSE(stop_status.get_data()[0].has_converged());
+    ASSERT_TRUE(criterion->update()
+                    .num_iterations(2)
+                    .implicit_sq_residual_norm(res_norm)
+                    .check(RelativeStoppingId, true, &stop_status,
+                           &one_changed));
+    ASSERT_TRUE(stop_status.get_data()[0].has_converged());
+}
+
+
 TYPED_TEST(ImplicitResidualNorm, WaitsTillResidualGoalMultipleRHS)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -295,6 +295,38 @@ TEST_F(Csr, AdvancedApplyToDenseMatrixIsEquivalentToRefWithClassical)
 }
 
 
+TEST_F(Csr, ReducedStorageApplyIsEquivalentToRef)
+{
+    using ReducedMtx =
+        gko::matrix::Csr<gko::next_precision<value_type>, Mtx::index_type>;
+    set_up_apply_data<Mtx::classical>(3);
+    auto reduced = ReducedMtx::create(ref);
+    mtx->convert_to(reduced);
+    auto dreduced = gko::clone(exec, reduced);
+
+    reduced->apply(y, expected);
+    dreduced->apply(dy, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Csr, ReducedStorageAdvancedApplyIsEquivalentToRef)
+{
+    using ReducedMtx =
+        gko::matrix::Csr<gko::next_precision<value_type>, Mtx::index_type>;
+    set_up_apply_data<Mtx::classical>(3);
+    auto reduced = ReducedMtx::create(ref);
+    mtx->convert_to(reduced);
+    auto dreduced = gko::clone(exec, reduced);
+
+    reduced->apply(alpha, y, beta, expected);
+    dreduced->apply(dalpha, dy, dbeta, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
 // OpenMP doesn't have strategies
 #ifndef GKO_COMPILING_OMP
 
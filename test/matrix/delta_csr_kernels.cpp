@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "core/matrix/delta_csr_kernels.hpp"
+
+
+#include <random>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/core/base/exception.hpp>
+#include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/delta_csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "test/utils/executor.hpp"
+
+
+class DeltaCsr : public CommonTestFixture {
+protected:
+    using Mtx = gko::matrix::DeltaCsr<value_type, index_type>;
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    using Vec = gko::matrix::Dense<value_type>;
+
+    DeltaCsr() : rand_engine(42) {}
+
+    template <typename MtxType = Vec>
+    std::unique_ptr<MtxType> gen_mtx(int num_rows, int num_cols,
+                                     int max_row_nnz)
+    {
+        return gko::test::generate_random_matrix<MtxType>(
+            num_rows, num_cols, std::uniform_int_distribution<>(0, max_row_nnz),
+            std::normal_distribution<value_type>(-1.0, 1.0), rand_engine, ref);
+    }
+
+    /**
+     * Uses a narrow matrix for 8-bit deltas, or a wide matrix where the rows
+     * need a mix of 8-, 16- and 32-bit deltas.
+     */
+    void set_up_apply_matrix(int num_cols, int num_rhs = 1)
+    {
+        csr = gen_mtx<Csr>(532, num_cols, 20);
+        mtx = Mtx::create(ref);
+        csr->convert_to(mtx);
+        expected = gen_mtx(532, num_rhs, num_rhs);
+        y = gen_mtx(num_cols, num_rhs, num_rhs);
+        alpha = gko::initialize<Vec>({2.0}, ref);
+        beta = gko::initialize<Vec>({-1.0}, ref);
+        dcsr = gko::clone(exec, csr);
+        dmtx = gko::clone(exec, mtx);
+        dresult = gko::clone(exec, expected);
+        dy = gko::clone(exec, y);
+        dalpha = gko::clone(exec, alpha);
+        dbeta = gko::clone(exec, beta);
+    }
+
+    std::default_random_engine rand_engine;
+
+    std::unique_ptr<Csr> csr;
+    std::unique_ptr<Mtx> mtx;
+    std::unique_ptr<Vec> expected;
+    std::unique_ptr<Vec> y;
+    std::unique_ptr<Vec> alpha;
+    std::unique_ptr<Vec> beta;
+
+    std::unique_ptr<Csr> dcsr;
+    std::unique_ptr<Mtx> dmtx;
+    std::unique_ptr<Vec> dresult;
+    std::unique_ptr<Vec> dy;
+    std::unique_ptr<Vec> dalpha;
+    std::unique_ptr<Vec> dbeta;
+};
+
+
+TEST_F(DeltaCsr, SimpleApplyIsEquivalentToRef)
+{
+    set_up_apply_matrix(231);
+
+    mtx->apply(y, expected);
+    dmtx->apply(dy, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(DeltaCsr, SimpleApplyWithWideDeltasIsEquivalentToRef)
+{
+    set_up_apply_matrix(100000);
+
+    mtx->apply(y, expected);
+    dmtx->apply(dy, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(DeltaCsr, AdvancedApplyWithWideDeltasIsEquivalentToRef)
+{
+    set_up_apply_matrix(100000);
+
+    mtx->apply(alpha, y, beta, expected);
+    dmtx->apply(dalpha, dy, dbeta, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(DeltaCsr, SimpleApplyMultipleRHSIsEquivalentToRef)
+{
+    set_up_apply_matrix(100000, 3);
+
+    mtx->apply(y, expected);
+    dmtx->apply(dy, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(DeltaCsr, AdvancedApplyMultipleRHSIsEquivalentToRef)
+{
+    set_up_apply_matrix(231, 4);
+
+    mtx->apply(alpha, y, beta, expected);
+    dmtx->apply(dalpha, dy, dbeta, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(DeltaCsr, ConversionFromCsrIsEquivalentToRef)
+{
+    set_up_apply_matrix(100000);
+    auto dresult = Mtx::create(exec);
+
+    dcsr->convert_to(dresult);
+
+    GKO_ASSERT_ARRAY_EQ(
+        gko::make_const_array_view(ref, mtx->get_size()[0],
+                                   mtx->get_const_row_bases()),
+        gko::make_const_array_view(exec, dresult->get_size()[0],
+                                   dresult->get_const_row_bases()));
+    GKO_ASSERT_ARRAY_EQ(
+        gko::make_const_array_view(ref, mtx->get_size()[0] + 1,
+                                   mtx->get_const_delta_ptrs()),
+        gko::make_const_array_view(exec, dresult->get_size()[0] + 1,
+                                   dresult->get_const_delta_ptrs()));
+    GKO_ASSERT_ARRAY_EQ(
+        gko::make_const_array_view(ref, mtx->get_num_delta_bytes(),
+                                   mtx->get_const_deltas()),
+        gko::make_const_array_view(exec, dresult->get_num_delta_bytes(),
+                                   dresult->get_const_deltas()));
+}
+
+
+TEST_F(DeltaCsr, ConversionToCsrIsEquivalentToRef)
+{
+    set_up_apply_matrix(100000);
+    auto dresult = Csr::create(exec);
+
+    dmtx->convert_to(dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, csr, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(dresult, csr);
+}
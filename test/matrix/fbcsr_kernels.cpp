@@ -226,6 +226,87 @@ TYPED_TEST(Fbcsr, AdvancedSpmvMultiIsEquivalentToRefSorted)
 }
 
 
+TYPED_TEST(Fbcsr, SpmvIsEquivalentToRefForAllBlockSizes)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using Dense = typename TestFixture::Dense;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+    auto alpha = gko::initialize<Dense>({2.5}, this->ref);
+    auto beta = gko::initialize<Dense>({-1.2}, this->ref);
+    auto dalpha = gko::clone(this->exec, alpha);
+    auto dbeta = gko::clone(this->exec, beta);
+
+    for (int block_size = 1; block_size <= 9; block_size++) {
+        SCOPED_TRACE(block_size);
+        auto rand = gko::test::generate_random_fbcsr<value_type, index_type>(
+            this->ref, 30, 20, block_size, false, false,
+            std::default_random_engine(43));
+        auto drand = gko::clone(this->exec, rand);
+        auto x = Dense::create(this->ref, gko::dim<2>(rand->get_size()[1], 3));
+        this->generate_sin(x);
+        auto dx = gko::clone(this->exec, x);
+        auto prod =
+            Dense::create(this->ref, gko::dim<2>(rand->get_size()[0], 3));
+        this->generate_sin(prod);
+        auto dprod = gko::clone(this->exec, prod);
+        auto adv_prod = prod->clone();
+        auto dadv_prod = dprod->clone();
+
+        rand->apply(x, prod);
+        drand->apply(dx, dprod);
+        rand->apply(alpha, x, beta, adv_prod);
+        drand->apply(dalpha, dx, dbeta, dadv_prod);
+
+        const double tol = r<value_type>::value;
+        GKO_ASSERT_MTX_NEAR(prod, dprod, 5 * tol);
+        GKO_ASSERT_MTX_NEAR(adv_prod, dadv_prod, 5 * tol);
+    }
+}
+
+
+TYPED_TEST(Fbcsr, ExtractDiagonalIsEquivalentToRefForAllBlockSizes)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+
+    for (int block_size = 1; block_size <= 9; block_size++) {
+        SCOPED_TRACE(block_size);
+        auto rand = gko::test::generate_random_fbcsr<value_type, index_type>(
+            this->ref, 30, 20, block_size, false, false,
+            std::default_random_engine(43));
+        auto drand = gko::clone(this->exec, rand);
+
+        auto diag = rand->extract_diagonal();
+        auto ddiag = drand->extract_diagonal();
+
+        GKO_ASSERT_MTX_NEAR(diag, ddiag, 0.0);
+    }
+}
+
+
+TYPED_TEST(Fbcsr, TransposeIsEquivalentToRefForCompiledBlockSizes)
+{
+    using Mtx = typename TestFixture::Mtx;
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::index_type;
+
+    for (int block_size = 2; block_size <= 8; block_size++) {
+        SCOPED_TRACE(block_size);
+        auto rand = gko::test::generate_random_fbcsr<value_type, index_type>(
+            this->ref, 30, 20, block_size, false, false,
+            std::default_random_engine(43));
+        auto drand = gko::clone(this->exec, rand);
+
+        auto trans = gko::as<Mtx>(rand->transpose());
+        auto dtrans = gko::as<Mtx>(drand->transpose());
+
+        GKO_ASSERT_MTX_EQ_SPARSITY(trans, dtrans);
+        GKO_ASSERT_MTX_NEAR(trans, dtrans, 0.0);
+    }
+}
+
+
 TYPED_TEST(Fbcsr, ConjTransposeIsEquivalentToRefSortedBS3)
 {
     using Mtx = typename TestFixture::Mtx;
@@ -233,3 +233,51 @@ TYPED_TEST(Fft, ApplyStrided3DInverseIsEqualToReference)
 
     GKO_ASSERT_MTX_NEAR(this->out_strided, this->dout_strided, r<T>::value);
 }
+
+
+TYPED_TEST(Fft, RepeatedApplyIsEqualToReference)
+{
+    using T = typename TestFixture::value_type;
+
+    this->fft3->apply(this->data, this->out);
+    this->dfft3->apply(this->ddata, this->dout);
+    this->dfft3->apply(this->ddata, this->dout);
+
+    GKO_ASSERT_MTX_NEAR(this->out, this->dout, r<T>::value);
+}
+
+
+TYPED_TEST(Fft, ApplyMixedRadixIsEqualToReference)
+{
+    using Vec = typename TestFixture::Vec;
+    using Mtx = typename TestFixture::Mtx;
+    using Mtx2 = typename TestFixture::Mtx2;
+    using Mtx3 = typename TestFixture::Mtx3;
+    using T = typename TestFixture::value_type;
+    // contains radix 4, 2, 3, 5 and 7 stages
+    const gko::size_type n1 = 24;
+    const gko::size_type n2 = 5;
+    const gko::size_type n3 = 7;
+    const auto n = n1 * n2 * n3;
+    auto data = gko::test::generate_random_matrix<Vec>(
+        n, this->cols, std::uniform_int_distribution<>(1, this->cols),
+        std::normal_distribution<>(-1.0, 1.0), this->rand_engine, this->ref);
+    auto ddata = gko::clone(this->exec, data);
+    auto out = data->clone();
+    auto dout = ddata->clone();
+    auto out2 = data->clone();
+    auto dout2 = ddata->clone();
+    auto out3 = data->clone();
+    auto dout3 = ddata->clone();
+
+    Mtx::create(this->ref, n)->apply(data, out);
+    Mtx::create(this->exec, n)->apply(ddata, dout);
+    Mtx2::create(this->ref, n1, n2 * n3, true)->apply(data, out2);
+    Mtx2::create(this->exec, n1, n2 * n3, true)->apply(ddata, dout2);
+    Mtx3::create(this->ref, n1, n2, n3)->apply(data, out3);
+    Mtx3::create(this->exec, n1, n2, n3)->apply(ddata, dout3);
+
+    GKO_ASSERT_MTX_NEAR(out, dout, 10 * r<T>::value);
+    GKO_ASSERT_MTX_NEAR(out2, dout2, 10 * r<T>::value);
+    GKO_ASSERT_MTX_NEAR(out3, dout3, 10 * r<T>::value);
+}
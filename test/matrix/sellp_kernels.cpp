@@ -26,6 +26,7 @@
 class Sellp : public CommonTestFixture {
 protected:
     using Mtx = gko::matrix::Sellp<value_type>;
+    using Csr = gko::matrix::Csr<value_type>;
     using Vec = gko::matrix::Dense<value_type>;
     using ComplexVec = gko::matrix::Dense<std::complex<value_type>>;
 
@@ -57,6 +58,22 @@ protected:
         dbeta = gko::clone(exec, beta);
     }
 
+    void set_up_sorted_apply_matrix(int total_cols, int slice_size,
+                                    int sorting_window)
+    {
+        set_up_apply_matrix(total_cols);
+        auto csr = gen_mtx<Csr>(532, 231);
+        auto dcsr = gko::clone(exec, csr);
+        mtx = Mtx::create(ref, gko::dim<2>{}, slice_size,
+                          gko::matrix::default_stride_factor, sorting_window,
+                          0);
+        dmtx = Mtx::create(exec, gko::dim<2>{}, slice_size,
+                           gko::matrix::default_stride_factor, sorting_window,
+                           0);
+        csr->convert_to(mtx);
+        dcsr->convert_to(dmtx);
+    }
+
     std::default_random_engine rand_engine;
 
     std::unique_ptr<Mtx> mtx;
@@ -165,6 +182,53 @@ TEST_F(Sellp,
 }
 
 
+TEST_F(Sellp, SimpleApplyWithSortingWindowIsEquivalentToRef)
+{
+    set_up_sorted_apply_matrix(1, 32, 128);
+
+    mtx->apply(y, expected);
+    dmtx->apply(dy, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Sellp, AdvancedApplyWithSortingWindowIsEquivalentToRef)
+{
+    set_up_sorted_apply_matrix(1, 32, 128);
+
+    mtx->apply(alpha, y, beta, expected);
+    dmtx->apply(dalpha, dy, dbeta, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Sellp, SimpleApplyMultipleRHSWithSortingWindowIsEquivalentToRef)
+{
+    set_up_sorted_apply_matrix(7, 32, 128);
+
+    mtx->apply(y, expected);
+    dmtx->apply(dy, dresult);
+
+    GKO_ASSERT_MTX_NEAR(dresult, expected, r<value_type>::value);
+}
+
+
+TEST_F(Sellp, ConvertToCsrWithSortingWindowIsEquivalentToRef)
+{
+    set_up_sorted_apply_matrix(1, 32, 128);
+    auto csr = Csr::create(ref);
+    auto dcsr = Csr::create(exec);
+
+    mtx->convert_to(csr);
+    dmtx->convert_to(dcsr);
+
+    GKO_ASSERT_MTX_NEAR(dcsr, csr, 0.0);
+    GKO_ASSERT_MTX_EQ_SPARSITY(dcsr, csr);
+}
+
+
 TEST_F(Sellp, ApplyToComplexIsEquivalentToRef)
 {
     set_up_apply_matrix(64);
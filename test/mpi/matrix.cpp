@@ -156,6 +156,116 @@ TYPED_TEST(MatrixCreation, ReadsDistributedWithColPartition)
 }
 
 
+TYPED_TEST(MatrixCreation, UpdatesValuesWithSamePattern)
+{
+    using value_type = typename TestFixture::value_type;
+    using csr = typename TestFixture::local_matrix_type;
+    I<I<value_type>> res_local[] = {{{4, 0}, {0, 0}}, {{0, 10}, {0, 0}}, {{0}}};
+    I<I<value_type>> res_non_local[] = {
+        {{2, 0}, {6, 8}}, {{0, 0, 12}, {16, 14, 0}}, {{20, 18}}};
+    auto rank = this->dist_mat->get_communicator().rank();
+    auto scaled_input = this->mat_input;
+    for (auto& entry : scaled_input.nonzeros) {
+        entry.value *= 2;
+    }
+    this->dist_mat->read_distributed(this->mat_input, this->row_part,
+                                     this->col_part);
+
+    this->dist_mat->update_values(scaled_input, this->row_part,
+                                  this->col_part);
+
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_local_matrix()),
+                        res_local[rank], 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(this->dist_mat->get_non_local_matrix()),
+                        res_non_local[rank], 0);
+}
+
+
+TYPED_TEST(MatrixCreation, ThrowsOnUpdateValuesWithDifferentPattern)
+{
+    using matrix_data = typename TestFixture::matrix_data;
+    this->dist_mat->read_distributed(this->mat_input, this->row_part,
+                                     this->col_part);
+
+    ASSERT_THROW(this->dist_mat->update_values(matrix_data{this->size},
+                                               this->row_part, this->col_part),
+                 gko::InvalidStateError);
+}
+
+
+TYPED_TEST(MatrixCreation, SharesIndexMap)
+{
+    using value_type = typename TestFixture::value_type;
+    using csr = typename TestFixture::local_matrix_type;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    I<I<value_type>> res_local[] = {{{4, 0}, {0, 0}}, {{0, 10}, {0, 0}}, {{0}}};
+    I<I<value_type>> res_non_local[] = {
+        {{2, 0}, {6, 8}}, {{0, 0, 12}, {16, 14, 0}}, {{20, 18}}};
+    auto rank = this->dist_mat->get_communicator().rank();
+    auto scaled_input = this->mat_input;
+    for (auto& entry : scaled_input.nonzeros) {
+        entry.value *= 2;
+    }
+    this->dist_mat->read_distributed(this->mat_input, this->row_part,
+                                     this->col_part);
+    auto other = dist_mtx_type::create(this->exec, this->comm);
+
+    other->read_distributed(scaled_input, this->row_part, this->col_part,
+                            this->dist_mat->get_index_map());
+
+    ASSERT_EQ(other->get_index_map(), this->dist_mat->get_index_map());
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(other->get_local_matrix()),
+                        res_local[rank], 0);
+    GKO_ASSERT_MTX_NEAR(gko::as<csr>(other->get_non_local_matrix()),
+                        res_non_local[rank], 0);
+}
+
+
+TYPED_TEST(MatrixCreation, BuildsIndexMap)
+{
+    using global_index_type = typename TestFixture::global_index_type;
+    using comm_index_type = gko::experimental::distributed::comm_index_type;
+    I<global_index_type> res_non_local_to_global[] = {
+        {1, 2}, {3, 4, 2}, {4, 0}};
+    std::vector<comm_index_type> res_recv_sizes[] = {
+        {0, 1, 1}, {2, 0, 1}, {1, 1, 0}};
+    std::vector<comm_index_type> res_send_sizes[] = {
+        {0, 2, 1}, {1, 0, 1}, {1, 1, 0}};
+    auto rank = this->dist_mat->get_communicator().rank();
+
+    this->dist_mat->read_distributed(this->mat_input, this->row_part,
+                                     this->col_part);
+
+    auto index_map = this->dist_mat->get_index_map();
+    ASSERT_EQ(index_map->get_global_size(), 5);
+    ASSERT_EQ(index_map->get_local_size(),
+              this->col_part->get_part_size(rank));
+    GKO_ASSERT_ARRAY_EQ(index_map->get_non_local_to_global(),
+                        gko::array<global_index_type>(
+                            this->exec, res_non_local_to_global[rank]));
+    ASSERT_EQ(index_map->get_recv_sizes(), res_recv_sizes[rank]);
+    ASSERT_EQ(index_map->get_send_sizes(), res_send_sizes[rank]);
+    ASSERT_EQ(index_map->get_gather_idxs().get_size(),
+              index_map->get_send_offsets().back());
+}
+
+
+TYPED_TEST(MatrixCreation, ThrowsOnReadWithDifferentIndexMap)
+{
+    using matrix_data = typename TestFixture::matrix_data;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    this->dist_mat->read_distributed(this->mat_input, this->row_part,
+                                     this->col_part);
+    auto other = dist_mtx_type::create(this->exec, this->comm);
+
+    ASSERT_THROW(
+        other->read_distributed(matrix_data{this->size}, this->row_part,
+                                this->col_part,
+                                this->dist_mat->get_index_map()),
+        gko::InvalidStateError);
+}
+
+
 #endif
 
 
@@ -331,6 +441,65 @@ TYPED_TEST(Matrix, CanApplyToSingleVector)
 }
 
 
+TYPED_TEST(Matrix, CanApplyAfterUpdatingValues)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::global_index_type;
+    using matrix_data = typename TestFixture::matrix_data;
+    auto vec_md = gko::matrix_data<value_type, index_type>{
+        I<I<value_type>>{{1}, {2}, {3}, {4}, {5}}};
+    I<I<value_type>> result[3] = {{{20}, {36}}, {{56}, {134}}, {{118}}};
+    auto rank = this->comm.rank();
+    matrix_data scaled_input;
+    this->csr_mat->write(scaled_input);
+    for (auto& entry : scaled_input.nonzeros) {
+        entry.value *= 2;
+    }
+    this->x->read_distributed(vec_md, this->col_part);
+    this->y->read_distributed(vec_md, this->row_part);
+
+    this->dist_mat->update_values(scaled_input, this->row_part,
+                                  this->col_part);
+    this->dist_mat->apply(this->x, this->y);
+
+    GKO_ASSERT_MTX_NEAR(this->y->get_local_vector(), result[rank], 0);
+}
+
+
+TYPED_TEST(Matrix, CanApplyWithSharedIndexMap)
+{
+    using value_type = typename TestFixture::value_type;
+    using index_type = typename TestFixture::global_index_type;
+    using matrix_data = typename TestFixture::matrix_data;
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using dist_vec_type = typename TestFixture::dist_vec_type;
+    auto vec_md = gko::matrix_data<value_type, index_type>{
+        I<I<value_type>>{{1}, {2}, {3}, {4}, {5}}};
+    I<I<value_type>> result[3] = {{{20}, {36}}, {{56}, {134}}, {{118}}};
+    auto rank = this->comm.rank();
+    matrix_data scaled_input;
+    this->csr_mat->write(scaled_input);
+    for (auto& entry : scaled_input.nonzeros) {
+        entry.value *= 2;
+    }
+    auto other = dist_mtx_type::create(this->exec, this->comm);
+    other->read_distributed(scaled_input, this->row_part, this->col_part,
+                            this->dist_mat->get_index_map());
+    auto x = dist_vec_type::create(this->exec, this->comm,
+                                   other->get_index_map().get());
+    this->x->read_distributed(vec_md, this->col_part);
+    x->copy_from(this->x);
+    this->y->read_distributed(vec_md, this->row_part);
+
+    other->apply(x, this->y);
+
+    GKO_ASSERT_EQUAL_DIMENSIONS(x->get_size(), gko::dim<2>(5, 1));
+    GKO_ASSERT_EQUAL_DIMENSIONS(x->get_local_vector()->get_size(),
+                                this->x->get_local_vector()->get_size());
+    GKO_ASSERT_MTX_NEAR(this->y->get_local_vector(), result[rank], 0);
+}
+
+
 TYPED_TEST(Matrix, CanApplyToMultipleVectors)
 {
     using value_type = typename TestFixture::value_type;
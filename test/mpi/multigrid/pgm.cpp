@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: 2017 - 2024 The Ginkgo authors
+//
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <memory>
+
+
+#include <mpi.h>
+
+
+#include <gtest/gtest.h>
+
+
+#include <ginkgo/config.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
+#include <ginkgo/core/distributed/partition.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/multigrid/pgm.hpp>
+#include <ginkgo/core/solver/multigrid.hpp>
+#include <ginkgo/core/stop/iteration.hpp>
+#include <ginkgo/core/stop/residual_norm.hpp>
+
+
+#include "core/test/utils.hpp"
+#include "test/utils/mpi/executor.hpp"
+
+
+template <typename ValueLocalGlobalIndexType>
+class Pgm : public CommonMpiTestFixture {
+protected:
+    using value_type = typename std::tuple_element<
+        0, decltype(ValueLocalGlobalIndexType())>::type;
+    using local_index_type = typename std::tuple_element<
+        1, decltype(ValueLocalGlobalIndexType())>::type;
+    using global_index_type = typename std::tuple_element<
+        2, decltype(ValueLocalGlobalIndexType())>::type;
+    using dist_mtx_type =
+        gko::experimental::distributed::Matrix<value_type, local_index_type,
+                                               global_index_type>;
+    using dist_vec_type = gko::experimental::distributed::Vector<value_type>;
+    using local_vec_type = gko::matrix::Dense<value_type>;
+    using pgm_type = gko::multigrid::Pgm<value_type, local_index_type>;
+    using Partition =
+        gko::experimental::distributed::Partition<local_index_type,
+                                                  global_index_type>;
+    using matrix_data = gko::matrix_data<value_type, global_index_type>;
+
+    Pgm() : CommonMpiTestFixture(), size{24, 24}, mat_input{size}
+    {
+        // 1D Laplacian
+        for (gko::size_type row = 0; row < size[0]; row++) {
+            if (row > 0) {
+                mat_input.nonzeros.emplace_back(row, row - 1, -1);
+            }
+            mat_input.nonzeros.emplace_back(row, row, 2);
+            if (row < size[0] - 1) {
+                mat_input.nonzeros.emplace_back(row, row + 1, -1);
+            }
+        }
+        row_part = Partition::build_from_contiguous(
+            exec, gko::array<global_index_type>(
+                      exec, I<global_index_type>{0, 8, 16, 24}));
+        dist_mat = gko::share(dist_mtx_type::create(exec, comm));
+        dist_mat->read_distributed(mat_input, row_part);
+    }
+
+    void SetUp() override { ASSERT_EQ(comm.size(), 3); }
+
+    std::unique_ptr<dist_vec_type> create_vector(const gko::LinOp* op,
+                                                 value_type value)
+    {
+        auto local_rows =
+            gko::as<dist_mtx_type>(op)->get_local_matrix()->get_size()[0];
+        auto vec = dist_vec_type::create(exec, comm,
+                                         gko::dim<2>{op->get_size()[0], 1},
+                                         gko::dim<2>{local_rows, 1});
+        vec->fill(value);
+        return vec;
+    }
+
+    void assert_is_galerkin_product(const pgm_type* pgm)
+    {
+        auto coarse = pgm->get_coarse_op();
+        auto prolong = pgm->get_prolong_op();
+        auto restrict_op = pgm->get_restrict_op();
+        auto coarse_x = create_vector(coarse.get(), gko::one<value_type>());
+        auto coarse_b = create_vector(coarse.get(), gko::zero<value_type>());
+        auto expected = create_vector(coarse.get(), gko::zero<value_type>());
+        auto fine_x = create_vector(dist_mat.get(), gko::zero<value_type>());
+        auto fine_b = create_vector(dist_mat.get(), gko::zero<value_type>());
+        // use a non-constant vector, a constant one lies in the near kernel
+        auto local_x = coarse_x->get_local_values();
+        for (gko::size_type i = 0;
+             i < coarse_x->get_local_vector()->get_size()[0]; i++) {
+            local_x[i] = static_cast<value_type>(i % 3);
+        }
+
+        coarse->apply(coarse_x, coarse_b);
+        prolong->apply(coarse_x, fine_x);
+        dist_mat->apply(fine_x, fine_b);
+        restrict_op->apply(fine_b, expected);
+
+        GKO_ASSERT_MTX_NEAR(coarse_b->get_local_vector(),
+                            expected->get_local_vector(),
+                            r<value_type>::value);
+    }
+
+    gko::dim<2> size;
+    matrix_data mat_input;
+    std::shared_ptr<Partition> row_part;
+    std::shared_ptr<dist_mtx_type> dist_mat;
+};
+
+TYPED_TEST_SUITE(Pgm, gko::test::ValueLocalGlobalIndexTypes,
+                 TupleTypenameNameGenerator);
+
+
+TYPED_TEST(Pgm, GeneratesDistributedLevel)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using pgm_type = typename TestFixture::pgm_type;
+
+    auto pgm = pgm_type::build()
+                   .with_deterministic(true)
+                   .on(this->exec)
+                   ->generate(this->dist_mat);
+
+    auto coarse = gko::as<dist_mtx_type>(pgm->get_coarse_op());
+    auto prolong = gko::as<dist_mtx_type>(pgm->get_prolong_op());
+    auto restrict_op = gko::as<dist_mtx_type>(pgm->get_restrict_op());
+    auto local_coarse_size = coarse->get_local_matrix()->get_size()[0];
+    auto global_coarse_size = local_coarse_size;
+    this->comm.all_reduce(this->ref, &global_coarse_size, 1, MPI_SUM);
+    ASSERT_GT(local_coarse_size, 0);
+    ASSERT_LT(local_coarse_size, 8);
+    ASSERT_EQ(coarse->get_size(),
+              gko::dim<2>(global_coarse_size, global_coarse_size));
+    ASSERT_EQ(prolong->get_size(), gko::dim<2>(24, global_coarse_size));
+    ASSERT_EQ(prolong->get_local_matrix()->get_size(),
+              gko::dim<2>(8, local_coarse_size));
+    ASSERT_EQ(restrict_op->get_size(), gko::dim<2>(global_coarse_size, 24));
+    ASSERT_EQ(restrict_op->get_local_matrix()->get_size(),
+              gko::dim<2>(local_coarse_size, 8));
+}
+
+
+TYPED_TEST(Pgm, CoarseMatrixIsGalerkinProduct)
+{
+    using pgm_type = typename TestFixture::pgm_type;
+
+    auto pgm = pgm_type::build()
+                   .with_deterministic(true)
+                   .on(this->exec)
+                   ->generate(this->dist_mat);
+
+    this->assert_is_galerkin_product(pgm.get());
+}
+
+
+TYPED_TEST(Pgm, AgglomeratesCoarseRows)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    using pgm_type = typename TestFixture::pgm_type;
+
+    auto pgm = pgm_type::build()
+                   .with_deterministic(true)
+                   .with_agglomeration_threshold(100u)
+                   .on(this->exec)
+                   ->generate(this->dist_mat);
+
+    auto coarse = gko::as<dist_mtx_type>(pgm->get_coarse_op());
+    auto local_coarse_size = coarse->get_local_matrix()->get_size()[0];
+    if (this->comm.rank() == 0) {
+        ASSERT_EQ(local_coarse_size, coarse->get_size()[0]);
+    } else {
+        ASSERT_EQ(local_coarse_size, 0);
+    }
+    this->assert_is_galerkin_product(pgm.get());
+}
+
+
+TYPED_TEST(Pgm, CanSolveWithDistributedMultigrid)
+{
+    using value_type = typename TestFixture::value_type;
+    using real_type = gko::remove_complex<value_type>;
+    using pgm_type = typename TestFixture::pgm_type;
+    using local_vec_type = typename TestFixture::local_vec_type;
+    using norm_vec_type = gko::matrix::Dense<real_type>;
+    const real_type reduction{1e-5};
+    auto solver =
+        gko::solver::Multigrid::build()
+            .with_mg_level(pgm_type::build().with_deterministic(true))
+            .with_min_coarse_rows(4u)
+            .with_criteria(
+                gko::stop::Iteration::build().with_max_iters(500u),
+                gko::stop::ResidualNorm<value_type>::build()
+                    .with_baseline(gko::stop::mode::initial_resnorm)
+                    .with_reduction_factor(reduction))
+            .on(this->exec)
+            ->generate(this->dist_mat);
+    auto b = this->create_vector(this->dist_mat.get(), gko::one<value_type>());
+    auto x = this->create_vector(this->dist_mat.get(), gko::zero<value_type>());
+    auto neg_one = gko::initialize<local_vec_type>({-1.0}, this->exec);
+    auto one = gko::initialize<local_vec_type>({1.0}, this->exec);
+    auto b_norm = norm_vec_type::create(this->ref, gko::dim<2>{1, 1});
+    auto res_norm = norm_vec_type::create(this->ref, gko::dim<2>{1, 1});
+    b->compute_norm2(b_norm);
+
+    solver->apply(b, x);
+
+    ASSERT_GT(solver->get_mg_level_list().size(), 1);
+    this->dist_mat->apply(neg_one, x, one, b);
+    b->compute_norm2(res_norm);
+    ASSERT_LE(res_norm->at(0, 0), 2 * reduction * b_norm->at(0, 0));
+}
@@ -2,8 +2,14 @@
 //
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include <ginkgo/config.hpp>
+#include <ginkgo/core/base/matrix_data.hpp>
+#include <ginkgo/core/distributed/matrix.hpp>
 #include <ginkgo/core/distributed/partition.hpp>
 #include <ginkgo/core/distributed/partition_helpers.hpp>
+#include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
+#include <ginkgo/core/matrix/dense.hpp>
 
 
 #include "core/test/utils.hpp"
@@ -102,3 +108,172 @@ TYPED_TEST(PartitionHelpers, CanBuildFromLocalSize)
                                          this->exec, expects_pid.get_size(),
                                          part->get_part_ids()));
 }
+
+
+template <typename ValueLocalGlobalIndexType>
+class Redistribute : public CommonMpiTestFixture {
+protected:
+    using value_type = typename std::tuple_element<
+        0, decltype(ValueLocalGlobalIndexType())>::type;
+    using local_index_type = typename std::tuple_element<
+        1, decltype(ValueLocalGlobalIndexType())>::type;
+    using global_index_type = typename std::tuple_element<
+        2, decltype(ValueLocalGlobalIndexType())>::type;
+    using dist_mtx_type =
+        gko::experimental::distributed::Matrix<value_type, local_index_type,
+                                               global_index_type>;
+    using dist_vec_type = gko::experimental::distributed::Vector<value_type>;
+    using local_matrix_type = gko::matrix::Csr<value_type, local_index_type>;
+    using Partition =
+        gko::experimental::distributed::Partition<local_index_type,
+                                                  global_index_type>;
+    using matrix_data = gko::matrix_data<value_type, global_index_type>;
+
+    Redistribute() : CommonMpiTestFixture(), mat_input{size}, vec_input{size}
+    {
+        // 2D 4x3 grid Laplacian
+        for (int row = 0; row < 12; row++) {
+            mat_input.nonzeros.emplace_back(row, row, 4);
+            if (row % 4 > 0) {
+                mat_input.nonzeros.emplace_back(row, row - 1, -1);
+            }
+            if (row % 4 < 3) {
+                mat_input.nonzeros.emplace_back(row, row + 1, -1);
+            }
+            if (row >= 4) {
+                mat_input.nonzeros.emplace_back(row, row - 4, -2);
+            }
+            if (row < 8) {
+                mat_input.nonzeros.emplace_back(row, row + 4, -3);
+            }
+        }
+        vec_input.size = gko::dim<2>{12, 2};
+        for (int row = 0; row < 12; row++) {
+            vec_input.nonzeros.emplace_back(row, 0, row);
+            vec_input.nonzeros.emplace_back(row, 1, -row);
+        }
+        old_part = Partition::build_from_contiguous(
+            exec, gko::array<global_index_type>(
+                      exec, I<global_index_type>{0, 4, 8, 12}));
+        new_part = Partition::build_from_mapping(
+            exec,
+            gko::array<comm_index_type>(
+                exec, I<comm_index_type>{2, 2, 0, 1, 0, 1, 1, 2, 0, 0, 1, 2}),
+            3);
+    }
+
+    void SetUp() override { ASSERT_EQ(comm.size(), 3); }
+
+    void assert_equal(const dist_mtx_type* result,
+                      const dist_mtx_type* expected)
+    {
+        ASSERT_EQ(result->get_size(), expected->get_size());
+        GKO_ASSERT_MTX_NEAR(
+            gko::as<local_matrix_type>(result->get_local_matrix()),
+            gko::as<local_matrix_type>(expected->get_local_matrix()), 0);
+        GKO_ASSERT_MTX_NEAR(
+            gko::as<local_matrix_type>(result->get_non_local_matrix()),
+            gko::as<local_matrix_type>(expected->get_non_local_matrix()), 0);
+    }
+
+    gko::dim<2> size{12, 12};
+    matrix_data mat_input;
+    matrix_data vec_input;
+    std::shared_ptr<Partition> old_part;
+    std::shared_ptr<Partition> new_part;
+};
+
+TYPED_TEST_SUITE(Redistribute, gko::test::ValueLocalGlobalIndexTypes,
+                 TupleTypenameNameGenerator);
+
+
+TYPED_TEST(Redistribute, CanRedistributeMatrix)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    auto mat = dist_mtx_type::create(this->exec, this->comm);
+    mat->read_distributed(this->mat_input, this->old_part);
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    expected->read_distributed(this->mat_input, this->new_part);
+
+    auto result = gko::experimental::distributed::redistribute(
+        mat.get(), this->old_part.get(), this->old_part.get(),
+        this->new_part.get(), this->new_part.get());
+
+    this->assert_equal(result.get(), expected.get());
+}
+
+
+TYPED_TEST(Redistribute, CanRedistributeMatrixRowsOnly)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    auto mat = dist_mtx_type::create(this->exec, this->comm);
+    mat->read_distributed(this->mat_input, this->old_part, this->new_part);
+    auto expected = dist_mtx_type::create(this->exec, this->comm);
+    expected->read_distributed(this->mat_input, this->new_part,
+                               this->old_part);
+
+    auto result = gko::experimental::distributed::redistribute(
+        mat.get(), this->old_part.get(), this->new_part.get(),
+        this->new_part.get(), this->old_part.get());
+
+    this->assert_equal(result.get(), expected.get());
+}
+
+
+TYPED_TEST(Redistribute, RedistributeRoundTripIsIdentity)
+{
+    using dist_mtx_type = typename TestFixture::dist_mtx_type;
+    auto mat = dist_mtx_type::create(this->exec, this->comm);
+    mat->read_distributed(this->mat_input, this->old_part);
+
+    auto tmp = gko::experimental::distributed::redistribute(
+        mat.get(), this->old_part.get(), this->old_part.get(),
+        this->new_part.get(), this->new_part.get());
+    auto result = gko::experimental::distributed::redistribute(
+        tmp.get(), this->new_part.get(), this->new_part.get(),
+        this->old_part.get(), this->old_part.get());
+
+    this->assert_equal(result.get(), mat.get());
+}
+
+
+TYPED_TEST(Redistribute, CanRedistributeVector)
+{
+    using dist_vec_type = typename TestFixture::dist_vec_type;
+    auto vec = dist_vec_type::create(this->exec, this->comm);
+    vec->read_distributed(this->vec_input, this->old_part);
+    auto expected = dist_vec_type::create(this->exec, this->comm);
+    expected->read_distributed(this->vec_input, this->new_part);
+
+    auto result = gko::experimental::distributed::redistribute(
+        vec.get(), this->old_part.get(), this->new_part.get());
+
+    ASSERT_EQ(result->get_size(), expected->get_size());
+    GKO_ASSERT_MTX_NEAR(result->get_local_vector(),
+                        expected->get_local_vector(), 0);
+}
+
+
+TYPED_TEST(Redistribute, BuildsPartitionFromGraph)
+{
+    using local_index_type = typename TestFixture::local_index_type;
+    using global_index_type = typename TestFixture::global_index_type;
+    // Hack because of multiple template arguments in macro
+    auto build_from_graph = [](auto... args) {
+        return gko::experimental::distributed::build_partition_from_graph<
+            local_index_type, global_index_type>(args...);
+    };
+
+#if GKO_HAVE_METIS
+    auto part = build_from_graph(this->exec, this->comm, this->mat_input);
+
+    ASSERT_EQ(part->get_size(), 12);
+    ASSERT_EQ(part->get_num_parts(), 3);
+    for (comm_index_type p = 0; p < 3; p++) {
+        ASSERT_GT(part->get_part_size(p), 0);
+    }
+#else
+    ASSERT_THROW(build_from_graph(this->exec, this->comm, this->mat_input),
+                 gko::NotCompiled);
+#endif
+}
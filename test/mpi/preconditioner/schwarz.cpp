@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <random>
@@ -20,12 +21,16 @@
 #include <ginkgo/core/distributed/partition.hpp>
 #include <ginkgo/core/distributed/preconditioner/schwarz.hpp>
 #include <ginkgo/core/distributed/vector.hpp>
+#include <ginkgo/core/factorization/lu.hpp>
+#include <ginkgo/core/log/convergence.hpp>
 #include <ginkgo/core/log/logger.hpp>
 #include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
+#include <ginkgo/core/multigrid/pgm.hpp>
 #include <ginkgo/core/preconditioner/jacobi.hpp>
 #include <ginkgo/core/solver/bicgstab.hpp>
 #include <ginkgo/core/solver/cg.hpp>
+#include <ginkgo/core/solver/direct.hpp>
 #include <ginkgo/core/stop/iteration.hpp>
 #include <ginkgo/core/stop/residual_norm.hpp>
 
@@ -130,6 +135,50 @@ protected:
     std::shared_ptr<gko::LinOpFactory> dist_solver_factory;
     std::shared_ptr<gko::LinOpFactory> local_solver_factory;
 
+    /**
+     * Computes the two-level Schwarz preconditioner applied to dist_b from
+     * its components.
+     */
+    std::shared_ptr<dist_vec_type> apply_two_level(
+        std::shared_ptr<const gko::LinOpFactory> coarse_level_factory,
+        std::shared_ptr<const gko::LinOpFactory> coarse_solver_factory,
+        bool multiplicative)
+    {
+        auto coarse_level = gko::as<gko::multigrid::MultigridLevel>(
+            gko::share(coarse_level_factory->generate(dist_mat)));
+        auto coarse_op = coarse_level->get_coarse_op();
+        auto coarse_solver = coarse_solver_factory->generate(coarse_op);
+        auto one_level = dist_prec_type::build()
+                             .with_local_solver(local_solver_factory)
+                             .on(exec)
+                             ->generate(dist_mat);
+        auto coarse_local_op =
+            gko::as<dist_mtx_type>(coarse_op)->get_local_matrix();
+        auto coarse_size = gko::dim<2>{coarse_op->get_size()[0], 1};
+        auto coarse_local_size =
+            gko::dim<2>{coarse_local_op->get_size()[0], 1};
+        auto coarse_b =
+            dist_vec_type::create(exec, comm, coarse_size, coarse_local_size);
+        auto coarse_x =
+            dist_vec_type::create(exec, comm, coarse_size, coarse_local_size);
+        auto correction = gko::clone(dist_x);
+        auto result = gko::share(gko::clone(dist_x));
+        auto residual = gko::clone(dist_b);
+        auto one = gko::initialize<local_vec_type>({1.0}, exec);
+        auto neg_one = gko::initialize<local_vec_type>({-1.0}, exec);
+        coarse_x->fill(gko::zero<value_type>());
+
+        coarse_level->get_restrict_op()->apply(dist_b, coarse_b);
+        coarse_solver->apply(coarse_b, coarse_x);
+        coarse_level->get_prolong_op()->apply(coarse_x, correction);
+        if (multiplicative) {
+            dist_mat->apply(neg_one, correction, one, residual);
+        }
+        one_level->apply(residual, result);
+        result->add_scaled(one, correction);
+        return result;
+    }
+
     void assert_equal_to_non_distributed_vector(
         std::shared_ptr<dist_vec_type> dist_vec,
         std::shared_ptr<local_vec_type> local_vec)
@@ -181,6 +230,28 @@ TYPED_TEST(SchwarzPreconditioner, GenerateFailsIfNoSolverProvided)
 }
 
 
+TYPED_TEST(SchwarzPreconditioner, GenerateFailsIfOverlapWithoutFactory)
+{
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using local_prec_type =
+        gko::preconditioner::Jacobi<value_type, local_index_type>;
+    using prec = typename TestFixture::dist_prec_type;
+
+    auto local_solver =
+        gko::share(local_prec_type::build()
+                       .with_max_block_size(1u)
+                       .on(this->exec)
+                       ->generate(this->dist_mat->get_local_matrix()));
+    auto schwarz = prec::build()
+                       .with_generated_local_solver(local_solver)
+                       .with_overlap(1u)
+                       .on(this->exec);
+
+    ASSERT_THROW(schwarz->generate(this->dist_mat), gko::InvalidStateError);
+}
+
+
 TYPED_TEST(SchwarzPreconditioner, CanApplyPreconditionedSolver)
 {
     using value_type = typename TestFixture::value_type;
@@ -300,3 +371,171 @@ TYPED_TEST(SchwarzPreconditioner, CanAdvancedApplyPreconditioner)
     this->assert_equal_to_non_distributed_vector(this->dist_x,
                                                  this->non_dist_x);
 }
+
+
+TYPED_TEST(SchwarzPreconditioner, CanApplyPreconditionerWithFullOverlap)
+{
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using global_index_type = typename TestFixture::global_index_type;
+    using prec = typename TestFixture::dist_prec_type;
+    using local_direct =
+        gko::experimental::solver::Direct<value_type, local_index_type>;
+    using local_lu =
+        gko::experimental::factorization::Lu<value_type, local_index_type>;
+    using direct =
+        gko::experimental::solver::Direct<value_type, global_index_type>;
+    using lu =
+        gko::experimental::factorization::Lu<value_type, global_index_type>;
+    // the overlapping subdomains cover the whole domain
+    auto precond = prec::build()
+                       .with_local_solver(local_direct::build()
+                                              .with_factorization(
+                                                  local_lu::build()))
+                       .with_overlap(8u)
+                       .on(this->exec)
+                       ->generate(this->dist_mat);
+    auto solver = direct::build()
+                      .with_factorization(lu::build())
+                      .on(this->exec)
+                      ->generate(this->non_dist_mat);
+
+    precond->apply(this->dist_b.get(), this->dist_x.get());
+    solver->apply(this->non_dist_b.get(), this->non_dist_x.get());
+
+    this->assert_equal_to_non_distributed_vector(this->dist_x,
+                                                 this->non_dist_x);
+}
+
+
+TYPED_TEST(SchwarzPreconditioner, CanApplyPreconditionerWithOverlap)
+{
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using local_vec_type = typename TestFixture::local_vec_type;
+    using local_matrix_type = typename TestFixture::local_matrix_type;
+    using prec = typename TestFixture::dist_prec_type;
+    using direct =
+        gko::experimental::solver::Direct<value_type, local_index_type>;
+    using lu =
+        gko::experimental::factorization::Lu<value_type, local_index_type>;
+    auto direct_factory = gko::share(
+        direct::build().with_factorization(lu::build()).on(this->exec));
+    auto precond = prec::build()
+                       .with_local_solver(direct_factory)
+                       .with_overlap(1u)
+                       .on(this->exec)
+                       ->generate(this->dist_mat);
+    // the subdomain of the tridiagonal matrix is extended by one row on
+    // each side
+    auto host_row_part = this->row_part->clone(this->ref);
+    auto rank = this->comm.rank();
+    auto start = host_row_part->get_range_bounds()[rank];
+    auto end = host_row_part->get_range_bounds()[rank + 1];
+    auto first = std::max<decltype(start)>(start - 1, 0);
+    auto last = std::min<decltype(end)>(end + 1, this->size[0]);
+    auto sub_size = static_cast<gko::size_type>(last - first);
+    gko::matrix_data<value_type, local_index_type> sub_data{
+        gko::dim<2>{sub_size, sub_size}};
+    for (const auto& entry : this->mat_input.nonzeros) {
+        if (entry.row >= first && entry.row < last && entry.column >= first &&
+            entry.column < last) {
+            sub_data.nonzeros.emplace_back(entry.row - first,
+                                           entry.column - first, entry.value);
+        }
+    }
+    auto sub_mtx = gko::share(local_matrix_type::create(this->exec));
+    sub_mtx->read(sub_data);
+    auto sub_b = local_vec_type::create(this->exec, gko::dim<2>{sub_size, 1});
+    auto sub_x = local_vec_type::create(this->exec, gko::dim<2>{sub_size, 1});
+    sub_b->fill(-gko::one<value_type>());
+    sub_x->fill(gko::zero<value_type>());
+
+    precond->apply(this->dist_b.get(), this->dist_x.get());
+    direct_factory->generate(sub_mtx)->apply(sub_b, sub_x);
+
+    GKO_ASSERT_MTX_NEAR(
+        this->dist_x->get_local_vector(),
+        sub_x->create_submatrix(
+            gko::span{static_cast<gko::size_type>(start - first),
+                      static_cast<gko::size_type>(end - first)},
+            gko::span{0, 1}),
+        r<value_type>::value);
+}
+
+
+TYPED_TEST(SchwarzPreconditioner, GenerateFailsIfCoarseSolverMissing)
+{
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using prec = typename TestFixture::dist_prec_type;
+    using pgm = gko::multigrid::Pgm<value_type, local_index_type>;
+
+    auto schwarz = prec::build()
+                       .with_local_solver(this->local_solver_factory)
+                       .with_coarse_level(pgm::build())
+                       .on(this->exec);
+
+    ASSERT_THROW(schwarz->generate(this->dist_mat), gko::InvalidStateError);
+}
+
+
+TYPED_TEST(SchwarzPreconditioner, CanApplyAdditiveTwoLevelPreconditioner)
+{
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using prec = typename TestFixture::dist_prec_type;
+    using pgm = gko::multigrid::Pgm<value_type, local_index_type>;
+    auto coarse_level_factory =
+        gko::share(pgm::build().with_deterministic(true).on(this->exec));
+    auto coarse_solver_factory =
+        gko::share(prec::build()
+                       .with_local_solver(this->local_solver_factory)
+                       .on(this->exec));
+    auto precond = prec::build()
+                       .with_local_solver(this->local_solver_factory)
+                       .with_coarse_level(coarse_level_factory)
+                       .with_coarse_solver(coarse_solver_factory)
+                       .on(this->exec)
+                       ->generate(this->dist_mat);
+
+    precond->apply(this->dist_b.get(), this->dist_x.get());
+
+    auto expected = this->apply_two_level(coarse_level_factory,
+                                          coarse_solver_factory, false);
+    GKO_ASSERT_MTX_NEAR(this->dist_x->get_local_vector(),
+                        expected->get_local_vector(), r<value_type>::value);
+}
+
+
+TYPED_TEST(SchwarzPreconditioner,
+           CanApplyMultiplicativeTwoLevelPreconditioner)
+{
+    using value_type = typename TestFixture::value_type;
+    using local_index_type = typename TestFixture::local_index_type;
+    using prec = typename TestFixture::dist_prec_type;
+    using pgm = gko::multigrid::Pgm<value_type, local_index_type>;
+    auto coarse_level_factory =
+        gko::share(pgm::build().with_deterministic(true).on(this->exec));
+    auto coarse_solver_factory =
+        gko::share(prec::build()
+                       .with_local_solver(this->local_solver_factory)
+                       .on(this->exec));
+    auto precond =
+        prec::build()
+            .with_local_solver(this->local_solver_factory)
+            .with_coarse_level(coarse_level_factory)
+            .with_coarse_solver(coarse_solver_factory)
+            .with_coarse_correction(gko::experimental::distributed::
+                                        preconditioner::coarse_correction_type::
+                                            multiplicative)
+            .on(this->exec)
+            ->generate(this->dist_mat);
+
+    precond->apply(this->dist_b.get(), this->dist_x.get());
+
+    auto expected = this->apply_two_level(coarse_level_factory,
+                                          coarse_solver_factory, true);
+    GKO_ASSERT_MTX_NEAR(this->dist_x->get_local_vector(),
+                        expected->get_local_vector(), r<value_type>::value);
+}
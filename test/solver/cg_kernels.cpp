@@ -13,6 +13,7 @@
 
 #include <ginkgo/core/base/exception.hpp>
 #include <ginkgo/core/base/executor.hpp>
+#include <ginkgo/core/matrix/csr.hpp>
 #include <ginkgo/core/matrix/dense.hpp>
 #include <ginkgo/core/solver/cg.hpp>
 #include <ginkgo/core/stop/combined.hpp>
@@ -160,6 +161,28 @@ TEST_F(Cg, CgStep2IsEquivalentToRef)
 }
 
 
+TEST_F(Cg, CgStep2NormIsEquivalentToRef)
+{
+    using NormVector = gko::matrix::Dense<gko::remove_complex<value_type>>;
+    initialize_data();
+    auto norm = NormVector::create(ref, gko::dim<2>{1, x->get_size()[1]});
+    auto d_norm = NormVector::create(exec, gko::dim<2>{1, x->get_size()[1]});
+    gko::array<char> tmp{ref};
+    gko::array<char> d_tmp{exec};
+
+    gko::kernels::reference::cg::step_2_norm(
+        ref, x.get(), r.get(), p.get(), q.get(), beta.get(), rho.get(),
+        norm.get(), tmp, stop_status.get());
+    gko::kernels::EXEC_NAMESPACE::cg::step_2_norm(
+        exec, d_x.get(), d_r.get(), d_p.get(), d_q.get(), d_beta.get(),
+        d_rho.get(), d_norm.get(), d_tmp, d_stop_status.get());
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(d_r, r, ::r<value_type>::value);
+    GKO_ASSERT_MTX_NEAR(d_norm, norm, ::r<value_type>::value);
+}
+
+
 TEST_F(Cg, ApplyIsEquivalentToRef)
 {
     auto data = gko::matrix_data<value_type, index_type>(
@@ -193,3 +216,33 @@ TEST_F(Cg, ApplyIsEquivalentToRef)
 
     GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value * 1000);
 }
+
+
+TEST_F(Cg, ApplyInPersistentRegionIsEquivalentToRef)
+{
+    using Csr = gko::matrix::Csr<value_type, index_type>;
+    auto data = gko::matrix_data<value_type, index_type>(
+        gko::dim<2>{50, 50}, std::normal_distribution<value_type>(-1.0, 1.0),
+        rand_engine);
+    gko::utils::make_hpd(data);
+    auto mtx = Csr::create(ref);
+    mtx->read(data);
+    auto x = gen_mtx(50, 3, 5);
+    auto b = gen_mtx(50, 3, 4);
+    auto d_mtx = gko::clone(exec, mtx);
+    auto d_x = gko::clone(exec, x);
+    auto d_b = gko::clone(exec, b);
+    auto cg_factory =
+        gko::solver::Cg<value_type>::build()
+            .with_criteria(gko::stop::Iteration::build().with_max_iters(50u),
+                           gko::stop::ResidualNorm<value_type>::build()
+                               .with_reduction_factor(::r<value_type>::value))
+            .with_persistent_region(true);
+    auto solver = cg_factory.on(ref)->generate(std::move(mtx));
+    auto d_solver = cg_factory.on(exec)->generate(std::move(d_mtx));
+
+    solver->apply(b, x);
+    d_solver->apply(d_b, d_x);
+
+    GKO_ASSERT_MTX_NEAR(d_x, x, ::r<value_type>::value * 1000);
+}